@@ -0,0 +1,89 @@
+/*
+
+    Crossover benchmark: standard kernel vs. Strassen-Winograd for square `TYPE_DOUBLE` matrices.
+
+    Usage: ./benchmark_main [max_size] [cutoff]
+
+    For every size n = 64, 128, ..., max_size the wall-clock time of both algorithms is printed,
+    together with the error of the Strassen-result relative to the standard kernel:
+
+        error = max|C_strassen - C_standard| / (n * max|A| * max|B|)
+
+*/
+
+#include "custom_dynamic_matrices.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+
+static double seconds_since(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) + (double)(now.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+// Multiply with the given algorithm and return the elapsed time in seconds.
+static double timed_multiply(MultiDimensionalMatrix* result, const MultiDimensionalMatrix* A, const MultiDimensionalMatrix* B,
+                             MultiplicationAlgorithm algorithm, size_t cutoff) {
+    struct timespec start;
+    set_multiplication_algorithm(algorithm, cutoff);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    ArithmeticOperationReturn response = multiply_2d_matrices(A, B);
+    double elapsed = seconds_since(&start);
+
+    if (response.error_code != ERR_NONE) {
+        fprintf(stderr, "Multiplication failed (error-code %d)\n", response.error_code);
+        exit(1);
+    }
+
+    *result = response.result_matrix;
+    return elapsed;
+}
+
+int main(int argc, char** argv) {
+    size_t max_size = argc > 1 ? strtoul(argv[1], NULL, 10) : 1024;
+    size_t cutoff = argc > 2 ? strtoul(argv[2], NULL, 10) : DEFAULT_STRASSEN_CUTOFF;
+
+    printf("Strassen-Winograd cutoff: %zu\n\n", cutoff);
+    printf("%8s %14s %14s %10s %12s\n", "n", "standard [s]", "strassen [s]", "speedup", "error");
+
+    unsigned int seed = 1;
+
+    for (size_t n = 64; n <= max_size; n *= 2) {
+        MultiDimensionalMatrix A, B, standard, strassen;
+        create_matrix(&A, 2, (size_t[]){n, n}, TYPE_DOUBLE);
+        create_matrix(&B, 2, (size_t[]){n, n}, TYPE_DOUBLE);
+
+        // Uniformly distributed values in [-1, 1]
+        for (size_t i = 0; i < n * n; i++) {
+            seed = seed * 1103515245u + 12345u;
+            ((double*)A.head_ptr->data)[i] = (double)(seed >> 8) / 8388607.5 - 1.0;
+            seed = seed * 1103515245u + 12345u;
+            ((double*)B.head_ptr->data)[i] = (double)(seed >> 8) / 8388607.5 - 1.0;
+        }
+
+        double standard_time = timed_multiply(&standard, &A, &B, MULTIPLICATION_STANDARD, cutoff);
+        double strassen_time = timed_multiply(&strassen, &A, &B, MULTIPLICATION_STRASSEN, cutoff);
+
+        double max_difference = 0;
+        for (size_t i = 0; i < n * n; i++) {
+            double difference = fabs(((double*)strassen.head_ptr->data)[i] - ((double*)standard.head_ptr->data)[i]);
+            max_difference = difference > max_difference ? difference : max_difference;
+        }
+
+        printf("%8zu %14.4f %14.4f %9.2fx %12.3e\n", n, standard_time, strassen_time,
+               standard_time / strassen_time, max_difference / (double)n);
+
+        clear_matrix(&A);
+        clear_matrix(&B);
+        clear_matrix(&standard);
+        clear_matrix(&strassen);
+    }
+
+    set_multiplication_algorithm(MULTIPLICATION_STANDARD, 0);
+
+    return 0;
+}
@@ -16,6 +16,12 @@ typedef enum ErrorCode {
     ERR_DIMENSION_SIZE_MISMATCH = 0xA,
     ERR_DIMENSION_COUNT_MISMATCH = 0xB,
     ERR_UNSUPPORTED_DATATYPE = 0xC,
+    ERR_NON_CONTIGUOUS_VIEW = 0xD,
+    ERR_READ_ONLY = 0xE,
+    ERR_FILE_IO = 0xF,
+    ERR_INVALID_FILE_FORMAT = 0x10,
+    ERR_SINGULAR_MATRIX = 0x11,
+    ERR_NOT_POSITIVE_DEFINITE = 0x12,
     ERR_UNKNOWN = 0xFF
 } ErrorCode;
 
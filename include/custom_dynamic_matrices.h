@@ -3,23 +3,85 @@
 
 #include "constants.h"
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 
+// Maximum number of dimensions a `MatrixView` can describe
+#define MAX_VIEW_DIMENSIONS 16
+
+// Default size below which the Strassen-Winograd recursion falls back to the standard kernel
+#define DEFAULT_STRASSEN_CUTOFF 128
+
+// Limits of a `MatrixExpression`
+#define MAX_EXPRESSION_NODES 32
+#define MAX_EXPRESSION_INPUTS 16
+#define INVALID_EXPRESSION_NODE ((size_t)-1)
+
+// Alignment (in bytes) of the data in files written by `save_matrix`
+#define MATRIX_FILE_ALIGNMENT 4096
+
+// Memory (in bytes), which `multiply_matrix_files` uses for its tiles by default
+#define DEFAULT_OUT_OF_CORE_MEMORY_BUDGET ((size_t)256 << 20)
+
+// Maximum number of spatial dimensions of a convolution
+#define MAX_CONVOLUTION_DIMENSIONS 3
+
+
 typedef enum DataType {
     TYPE_INT,
     TYPE_FLOAT,
-    TYPE_DOUBLE
+    TYPE_DOUBLE,
+    TYPE_INT8,                   // `int8_t`
+    TYPE_INT16,                  // `int16_t`
+    TYPE_INT64,                  // `int64_t`
+    TYPE_UINT8,                  // `uint8_t`
+    TYPE_FP16,                   // IEEE 754 half precision (`fp16_t`)
+    TYPE_BF16                    // bfloat16 (`bf16_t`)
 } DataType;
 
+// Bit-patterns of the 16-bit floating point types (see `fp16_to_float`, `float_to_fp16`, ...)
+typedef uint16_t fp16_t;
+typedef uint16_t bf16_t;
+
+
+// Rounding of floating point values, which are converted to an integer data-type
+typedef enum RoundingMode {
+    ROUND_TOWARD_ZERO,           // Truncate, like a C-cast (default)
+    ROUND_TO_NEAREST,            // Nearest integer, ties to even
+    ROUND_DOWN,                  // Toward negative infinity
+    ROUND_UP                     // Toward positive infinity
+} RoundingMode;
+
+
+// Owner of the data-buffer of a matrix
+typedef enum MatrixStorage {
+    STORAGE_HEAP,                // Allocated with `malloc` (default)
+    STORAGE_MAPPED_READ_ONLY,    // Read-only mapping of a matrix-file (see `open_matrix_mmap`)
+    STORAGE_MAPPED_PRIVATE,      // Copy-on-write mapping of a matrix-file, changes never reach the file
+    STORAGE_WORKSPACE            // Pooled buffer of a `MatrixWorkspace` (see `begin_workspace_scope`)
+} MatrixStorage;
+
+// Pool of size-classed data-buffers, which are reused by the matrices of its scopes
+typedef struct MatrixWorkspace MatrixWorkspace;
+
 
 typedef struct MultiDimensionalMatrixNode {
     void* data;
     size_t* dimensions;          // For example 3 x 2 x 2 matrix has the dimensions := {3, 2, 2}
     size_t number_of_dimensions; // `len(dimensions)`
+    size_t* strides;             // Elements between two neighbours in each dimension (in the allocation of `dimensions`)
     DataType data_type;
     size_t data_size;            // Size of the data-array (based on the data-type)
+    size_t capacity;             // Allocated bytes of the data-array (>= `data_size`, see `reserve_matrix_capacity`)
+    MatrixStorage storage;
+    void* mapping;               // Start of the mapped file (only mapped storage)
+    size_t mapping_size;
+    MatrixWorkspace* workspace;  // Workspace, whose scope clears the matrix (NULL outside of scopes)
+    size_t workspace_scope;      // Depth of that scope
+    struct MultiDimensionalMatrixNode* workspace_previous; // Matrices of the workspace, in order of creation
+    struct MultiDimensionalMatrixNode* workspace_next;
 } MultiDimensionalMatrixNode;
 
 typedef struct MultiDimensionalMatrix {
@@ -32,12 +94,138 @@ typedef struct IndexCalcReturn {
     ErrorCode error_code;
 } IndexCalcReturn;
 
+// Non-owning, strided window into the data-buffer of a `MultiDimensionalMatrix`.
+// Views are plain values: creating, slicing, transposing or reshaping a view never copies
+// or allocates anything. The parent matrix has to outlive all of its views.
+typedef struct MatrixView {
+    MultiDimensionalMatrixNode* parent;         // Matrix-Node, which owns the data-buffer
+    size_t offset;                              // Position (in elements) of the first element in the parent's buffer
+    size_t number_of_dimensions;
+    size_t dimensions[MAX_VIEW_DIMENSIONS];
+    size_t strides[MAX_VIEW_DIMENSIONS];        // Distance (in elements) between two neighbours in each dimension
+    DataType data_type;
+} MatrixView;
+
+typedef enum ReductionOperation {
+    REDUCE_SUM,
+    REDUCE_MIN,
+    REDUCE_MAX,
+    REDUCE_MEAN,
+    REDUCE_NORM_L1,                             // Sum of the absolute values
+    REDUCE_NORM_L2,                             // Square root of the sum of squares
+    REDUCE_NORM_MAX                             // Maximum of the absolute values
+} ReductionOperation;
+
+// Algorithm used by `multiply_2d_matrices`
+typedef enum MultiplicationAlgorithm {
+    MULTIPLICATION_STANDARD,                    // Classic O(n^3) kernels (default)
+    MULTIPLICATION_STRASSEN                     // Strassen-Winograd recursion above a cutoff (opt-in)
+} MultiplicationAlgorithm;
+
+typedef enum ExpressionOperation {
+    EXPRESSION_INPUT,
+    EXPRESSION_SCALAR,
+    EXPRESSION_ADD,
+    EXPRESSION_SUBTRACT,
+    EXPRESSION_MULTIPLY
+} ExpressionOperation;
+
+typedef struct MatrixExpressionNode {
+    ExpressionOperation operation;
+    size_t left;                                // Operand-nodes of binary operations
+    size_t right;
+    size_t input;                               // Position in `inputs` (only `EXPRESSION_INPUT`)
+    double scalar;                              // Value (only `EXPRESSION_SCALAR`)
+} MatrixExpressionNode;
+
+// Deferred chain of element-wise operations, which is evaluated in one fused pass.
+typedef struct MatrixExpression {
+    MatrixExpressionNode nodes[MAX_EXPRESSION_NODES];
+    size_t number_of_nodes;
+    MatrixView inputs[MAX_EXPRESSION_INPUTS];
+    size_t number_of_inputs;
+    ErrorCode error_code;                       // First error while recording the expression
+} MatrixExpression;
+
+// Writes `count` consecutive elements along the last dimension, the first one at the coordinates `indices`
+typedef void (*MatrixFillFunction)(void* elements, size_t count, const size_t* indices, void* context);
+
+// Distributions of `fill_matrix_random`
+typedef enum RandomDistribution {
+    RANDOM_UNIFORM,              // Between `first` and `second` (integers: both included)
+    RANDOM_NORMAL                // Mean `first`, standard deviation `second` (integers: rounded & saturated)
+} RandomDistribution;
+
+// Built-in operations of `matrix_map`
+typedef enum MapOperation {
+    MAP_NEGATE,
+    MAP_ABSOLUTE,
+    MAP_SQUARE
+} MapOperation;
+
+// Built-in operations of `matrix_zip` (comparisons give 1 or 0)
+typedef enum ZipOperation {
+    ZIP_ADD,
+    ZIP_SUBTRACT,
+    ZIP_MULTIPLY,
+    ZIP_DIVIDE,
+    ZIP_MINIMUM,
+    ZIP_MAXIMUM,
+    ZIP_EQUAL,
+    ZIP_NOT_EQUAL,
+    ZIP_LESS,
+    ZIP_LESS_EQUAL,
+    ZIP_GREATER,
+    ZIP_GREATER_EQUAL
+} ZipOperation;
+
+// Element-wise math functions of `matrix_math` (`TYPE_FLOAT` & `TYPE_DOUBLE`)
+typedef enum MathFunction {
+    MATH_EXP,
+    MATH_LOG,
+    MATH_TANH,
+    MATH_SIGMOID,
+    MATH_SQRT
+} MathFunction;
+
+// Algorithm used by `correlate_matrices`/`convolve_matrices`
+typedef enum ConvolutionAlgorithm {
+    CONVOLUTION_AUTO,                           // Direct for small filters and few channels, otherwise im2col (default)
+    CONVOLUTION_IM2COL,                         // Unfold the input and multiply it with the filters
+    CONVOLUTION_DIRECT                          // Accumulate each filter-tap along the output rows
+} ConvolutionAlgorithm;
+
+// Per spatial dimension; a zero-initialized struct means stride 1, no padding and dilation 1
+typedef struct ConvolutionParameters {
+    size_t stride[MAX_CONVOLUTION_DIMENSIONS];      // `0` means 1
+    size_t padding[MAX_CONVOLUTION_DIMENSIONS];     // Zeros on both sides
+    size_t dilation[MAX_CONVOLUTION_DIMENSIONS];    // `0` means 1
+    ConvolutionAlgorithm algorithm;
+} ConvolutionParameters;
+
+// Callbacks of `matrix_map_function`/`matrix_zip_function`: `count` contiguous elements per call
+typedef void (*MatrixMapFunction)(void* out, const void* in, size_t count, void* context);
+typedef void (*MatrixZipFunction)(void* out, const void* a, const void* b, size_t count, void* context);
+
 // Return-Object for every matrix-related arithmetic operation
 typedef struct ArithmeticOperationReturn {
     MultiDimensionalMatrix result_matrix;
     ErrorCode error_code;
 } ArithmeticOperationReturn;
 
+// Worker-threads, which run submitted matrix-operations (see `create_matrix_queue`)
+typedef struct MatrixQueue MatrixQueue;
+
+// Completion-handle of a submitted operation
+typedef struct MatrixOperation MatrixOperation;
+
+// Operations of `submit_matrix_operation`/`submit_binary_matrix_operation` (`add_matrices`, `multiply_2d_matrices`, ...)
+typedef ArithmeticOperationReturn (*MatrixOperationFunction)(void* context);
+typedef ArithmeticOperationReturn (*BinaryMatrixFunction)(const MultiDimensionalMatrix* matrix_A, const MultiDimensionalMatrix* matrix_B);
+
+// Called once an operation has finished (on the worker-thread, see `set_matrix_operation_callback`)
+typedef void (*MatrixOperationCallback)(MatrixOperation* operation, void* user_data);
+
 
 //
 // Functions
@@ -49,12 +237,161 @@ void clear_matrix(MultiDimensionalMatrix* matrix);
 void* get_element_by_indices(MultiDimensionalMatrix* matrix, size_t* indices);
 ErrorCode set_element_by_indices(MultiDimensionalMatrix* matrix, size_t* indices, void* value);
 //static ErrorCode set_element_by_linear_index(MultiDimensionalMatrix* matrix, size_t index, void* value);
+ErrorCode gather_elements_by_indices(const MultiDimensionalMatrix* matrix, const size_t* indices, size_t count, void* values);
+ErrorCode gather_elements_by_linear_indices(const MultiDimensionalMatrix* matrix, const size_t* linear_indices, size_t count, void* values);
+ErrorCode scatter_elements_by_indices(MultiDimensionalMatrix* matrix, const size_t* indices, size_t count, const void* values);
+ErrorCode scatter_elements_by_linear_indices(MultiDimensionalMatrix* matrix, const size_t* linear_indices, size_t count, const void* values);
 ErrorCode fill_matrix_from_static_array(MultiDimensionalMatrix* matrix, void* static_array);
+ErrorCode fill_matrix_with_value(MultiDimensionalMatrix* matrix, const void* value);
+ErrorCode fill_matrix_from_function(MultiDimensionalMatrix* matrix, MatrixFillFunction function, void* context);
+ErrorCode fill_matrix_from_array(MultiDimensionalMatrix* matrix, const void* source, DataType source_type, const size_t* source_strides);
+ErrorCode fill_matrix_random(MultiDimensionalMatrix* matrix, RandomDistribution distribution, double first, double second, uint64_t seed);
 ArithmeticOperationReturn add_matrices(const MultiDimensionalMatrix* matrix_A, const MultiDimensionalMatrix* matrix_B);
+ArithmeticOperationReturn multiply_matrices_elementwise(const MultiDimensionalMatrix* matrix_A, const MultiDimensionalMatrix* matrix_B);
 ArithmeticOperationReturn multiply_2d_matrices(const MultiDimensionalMatrix* matrix_A, const MultiDimensionalMatrix* matrix_B);
+ArithmeticOperationReturn multiply_2d_matrices_mixed(const MultiDimensionalMatrix* matrix_A, const MultiDimensionalMatrix* matrix_B, DataType output_type);
 ArithmeticOperationReturn scalar_multiply_matrix(const MultiDimensionalMatrix* matrix, void* scalar);
 ErrorCode resize_matrix(MultiDimensionalMatrix* matrix, size_t new_number_of_dimensions, size_t* new_dimensions);
+ErrorCode reserve_matrix_capacity(MultiDimensionalMatrix* matrix, size_t first_dimension_capacity);
 //static ErrorCode update_data_type(MultiDimensionalMatrix* matrix, DataType data_type);
 ErrorCode change_data_type(MultiDimensionalMatrix* matrix, DataType new_data_type);
+ErrorCode convert_matrix_data_type(MultiDimensionalMatrix* matrix, DataType new_data_type, RoundingMode rounding, int saturate);
+ArithmeticOperationReturn transpose_matrix(const MultiDimensionalMatrix* matrix);
+ArithmeticOperationReturn permute_matrix_axes(const MultiDimensionalMatrix* matrix, const size_t* axes);
+ErrorCode transpose_matrix_in_place(MultiDimensionalMatrix* matrix);
+size_t get_data_type_size(DataType data_type);
+float fp16_to_float(fp16_t value);
+fp16_t float_to_fp16(float value);
+float bf16_to_float(bf16_t value);
+bf16_t float_to_bf16(float value);
+void set_multiplication_algorithm(MultiplicationAlgorithm algorithm, size_t strassen_cutoff);
+MultiplicationAlgorithm get_multiplication_algorithm(void);
+size_t get_strassen_cutoff(void);
+
+//
+// Views
+//
+
+ErrorCode create_matrix_view(MatrixView* view, const MultiDimensionalMatrix* matrix);
+ErrorCode slice_matrix_view(MatrixView* result, const MatrixView* view, size_t dimension, size_t start, size_t stop, size_t step);
+ErrorCode select_matrix_view_index(MatrixView* result, const MatrixView* view, size_t dimension, size_t index);
+ErrorCode transpose_matrix_view(MatrixView* result, const MatrixView* view);
+ErrorCode permute_matrix_view_axes(MatrixView* result, const MatrixView* view, const size_t* axes);
+ErrorCode reshape_matrix_view(MatrixView* result, const MatrixView* view, size_t new_number_of_dimensions, const size_t* new_dimensions);
+ErrorCode broadcast_matrix_view(MatrixView* result, const MatrixView* view, size_t number_of_dimensions, const size_t* dimensions);
+int is_matrix_view_contiguous(const MatrixView* view);
+void* get_view_element_by_indices(const MatrixView* view, const size_t* indices);
+ErrorCode set_view_element_by_indices(const MatrixView* view, const size_t* indices, void* value);
+ArithmeticOperationReturn copy_matrix_view(const MatrixView* view);
+ArithmeticOperationReturn add_matrix_views(const MatrixView* view_A, const MatrixView* view_B);
+ArithmeticOperationReturn multiply_matrix_views_elementwise(const MatrixView* view_A, const MatrixView* view_B);
+ArithmeticOperationReturn multiply_2d_matrix_views(const MatrixView* view_A, const MatrixView* view_B);
+ArithmeticOperationReturn multiply_2d_matrix_views_mixed(const MatrixView* view_A, const MatrixView* view_B, DataType output_type);
+ArithmeticOperationReturn multiply_batched_matrix_views(const MatrixView* view_A, const MatrixView* view_B);
+ArithmeticOperationReturn multiply_batched_matrices(const MultiDimensionalMatrix* matrix_A, const MultiDimensionalMatrix* matrix_B);
+ArithmeticOperationReturn scalar_multiply_matrix_view(const MatrixView* view, void* scalar);
+
+//
+// Map & Zip
+//
+
+ErrorCode matrix_map(MultiDimensionalMatrix* out, const MultiDimensionalMatrix* in, MapOperation operation);
+ErrorCode matrix_clamp(MultiDimensionalMatrix* out, const MultiDimensionalMatrix* in, const void* minimum, const void* maximum);
+ErrorCode matrix_map_function(MultiDimensionalMatrix* out, const MultiDimensionalMatrix* in, MatrixMapFunction function, void* context);
+ErrorCode matrix_zip(MultiDimensionalMatrix* out, const MultiDimensionalMatrix* a, const MultiDimensionalMatrix* b, ZipOperation operation);
+ErrorCode matrix_zip_function(MultiDimensionalMatrix* out, const MultiDimensionalMatrix* a, const MultiDimensionalMatrix* b,
+                              MatrixZipFunction function, void* context);
+
+//
+// Math functions
+//
+
+ErrorCode matrix_math(MultiDimensionalMatrix* out, const MultiDimensionalMatrix* in, MathFunction function);
+ErrorCode matrix_math_in_place(MultiDimensionalMatrix* matrix, MathFunction function);
+
+//
+// Convolution
+//
+
+ArithmeticOperationReturn correlate_matrices(const MultiDimensionalMatrix* input, const MultiDimensionalMatrix* filters, const ConvolutionParameters* parameters);
+ArithmeticOperationReturn convolve_matrices(const MultiDimensionalMatrix* input, const MultiDimensionalMatrix* filters, const ConvolutionParameters* parameters);
+
+//
+// Linear systems
+//
+
+ErrorCode lu_decompose(MultiDimensionalMatrix* matrix, size_t* pivots);
+ErrorCode cholesky_decompose(MultiDimensionalMatrix* matrix);
+ErrorCode forward_substitution(const MultiDimensionalMatrix* lower, MultiDimensionalMatrix* rhs, int unit_diagonal);
+ErrorCode back_substitution(const MultiDimensionalMatrix* upper, MultiDimensionalMatrix* rhs);
+ErrorCode lu_solve(const MultiDimensionalMatrix* factors, const size_t* pivots, MultiDimensionalMatrix* rhs);
+ErrorCode cholesky_solve(const MultiDimensionalMatrix* factor, MultiDimensionalMatrix* rhs);
+ArithmeticOperationReturn solve_linear_system(const MultiDimensionalMatrix* matrix_A, const MultiDimensionalMatrix* matrix_B);
+
+//
+// Matrix-vector products
+//
+
+ArithmeticOperationReturn matrix_vector_multiply(const MultiDimensionalMatrix* matrix, const MultiDimensionalMatrix* vector);
+ArithmeticOperationReturn matrix_transposed_vector_multiply(const MultiDimensionalMatrix* matrix, const MultiDimensionalMatrix* vector);
+ErrorCode rank_one_update(MultiDimensionalMatrix* matrix, const void* alpha, const MultiDimensionalMatrix* vector_x, const MultiDimensionalMatrix* vector_y);
+
+//
+// Fused Expressions
+//
+
+void init_matrix_expression(MatrixExpression* expression);
+size_t expression_input(MatrixExpression* expression, const MultiDimensionalMatrix* matrix);
+size_t expression_input_view(MatrixExpression* expression, const MatrixView* view);
+size_t expression_scalar(MatrixExpression* expression, double value);
+size_t expression_add(MatrixExpression* expression, size_t left, size_t right);
+size_t expression_subtract(MatrixExpression* expression, size_t left, size_t right);
+size_t expression_multiply(MatrixExpression* expression, size_t left, size_t right);
+ArithmeticOperationReturn evaluate_matrix_expression(const MatrixExpression* expression, size_t root);
+
+//
+// Files
+//
+
+ErrorCode save_matrix(const MultiDimensionalMatrix* matrix, const char* path);
+ErrorCode load_matrix(MultiDimensionalMatrix* matrix, const char* path);
+ErrorCode open_matrix_mmap(MultiDimensionalMatrix* matrix, const char* path, MatrixStorage storage);
+ErrorCode multiply_matrix_files(const char* path_A, const char* path_B, const char* result_path, size_t memory_budget);
+
+//
+// Reductions
+//
+
+ArithmeticOperationReturn reduce_matrix(const MultiDimensionalMatrix* matrix, ReductionOperation operation);
+ArithmeticOperationReturn reduce_matrix_axes(const MultiDimensionalMatrix* matrix, ReductionOperation operation, size_t number_of_axes, const size_t* axes, int keep_dimensions);
+ArithmeticOperationReturn reduce_matrix_view_axes(const MatrixView* view, ReductionOperation operation, size_t number_of_axes, const size_t* axes, int keep_dimensions);
+
+//
+// Workspaces
+//
+
+ErrorCode create_workspace(MatrixWorkspace** workspace);
+void clear_workspace(MatrixWorkspace* workspace);
+ErrorCode begin_workspace_scope(MatrixWorkspace* workspace);
+ErrorCode end_workspace_scope(MatrixWorkspace* workspace);
+ErrorCode detach_matrix_from_workspace(MultiDimensionalMatrix* matrix);
+size_t get_workspace_reserved_bytes(const MatrixWorkspace* workspace);
+
+//
+// Asynchronous operations
+//
+
+ErrorCode create_matrix_queue(MatrixQueue** queue, size_t number_of_workers);
+void clear_matrix_queue(MatrixQueue* queue);
+ErrorCode submit_matrix_operation(MatrixQueue* queue, MatrixOperationFunction function, void* context,
+                                  MatrixOperation* const* dependencies, size_t number_of_dependencies, MatrixOperation** operation);
+ErrorCode submit_binary_matrix_operation(MatrixQueue* queue, BinaryMatrixFunction function,
+                                         const MultiDimensionalMatrix* matrix_A, const MultiDimensionalMatrix* matrix_B,
+                                         MatrixOperation* const* dependencies, size_t number_of_dependencies, MatrixOperation** operation);
+int poll_matrix_operation(MatrixOperation* operation);
+ArithmeticOperationReturn wait_matrix_operation(MatrixOperation* operation);
+ErrorCode set_matrix_operation_callback(MatrixOperation* operation, MatrixOperationCallback callback, void* user_data);
+const MultiDimensionalMatrix* get_matrix_operation_result(const MatrixOperation* operation);
+void release_matrix_operation(MatrixOperation* operation);
 
 #endif // CUSTOM_DYNAMIC_MATRICES_H
@@ -0,0 +1,54 @@
+#ifndef CUSTOM_SPARSE_MATRICES_H
+#define CUSTOM_SPARSE_MATRICES_H
+
+#include "constants.h"
+#include "custom_dynamic_matrices.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+// Storage-format of a `SparseMatrix`
+typedef enum SparseFormat {
+    SPARSE_COO,                     // Coordinate list: (row, column, value) per entry, unordered
+    SPARSE_CSR,                     // Compressed sparse rows
+    SPARSE_CSC                      // Compressed sparse columns
+} SparseFormat;
+
+// 2-Dimensional matrix, which only stores its non-zero entries.
+//
+// COO: `row_indices` & `col_indices` hold the position of every entry, `pointers` is NULL.
+// CSR: The entries of row `i` are [pointers[i], pointers[i + 1]), `col_indices` holds their columns
+//      (sorted and unique within a row), `row_indices` is NULL.
+// CSC: The entries of column `j` are [pointers[j], pointers[j + 1]), `row_indices` holds their rows
+//      (sorted and unique within a column), `col_indices` is NULL.
+typedef struct SparseMatrix {
+    SparseFormat format;
+    DataType data_type;
+    size_t rows;
+    size_t cols;
+    size_t number_of_nonzeros;      // Number of stored entries
+    size_t capacity;                // Number of entries, which fit into the allocated arrays
+    void* values;                   // `number_of_nonzeros` values of `data_type`
+    size_t* row_indices;
+    size_t* col_indices;
+    size_t* pointers;               // `rows + 1` (CSR) or `cols + 1` (CSC) offsets
+} SparseMatrix;
+
+
+//
+// Functions
+//
+
+ErrorCode create_sparse_matrix(SparseMatrix* matrix, size_t rows, size_t cols, DataType data_type, size_t capacity);
+void clear_sparse_matrix(SparseMatrix* matrix);
+ErrorCode append_sparse_entry(SparseMatrix* matrix, size_t row, size_t col, void* value);
+ErrorCode convert_sparse_matrix(SparseMatrix* result, const SparseMatrix* matrix, SparseFormat format);
+ErrorCode dense_to_sparse_matrix(SparseMatrix* result, const MultiDimensionalMatrix* matrix, SparseFormat format);
+ArithmeticOperationReturn sparse_to_dense_matrix(const SparseMatrix* matrix);
+ArithmeticOperationReturn sparse_multiply_dense_vector(const SparseMatrix* matrix, const MultiDimensionalMatrix* vector);
+ArithmeticOperationReturn sparse_multiply_dense_matrix(const SparseMatrix* matrix, const MultiDimensionalMatrix* dense_matrix);
+ErrorCode add_sparse_matrices(SparseMatrix* result, const SparseMatrix* matrix_A, const SparseMatrix* matrix_B);
+
+
+#endif // CUSTOM_SPARSE_MATRICES_H
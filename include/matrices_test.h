@@ -2,8 +2,16 @@
 #define TESTS_MATRICES_TEST_H
 
 #include "custom_dynamic_matrices.h"
+#include "matrix_parallel.h"
 #include "test_constants.h"
 
+#include <float.h>  // For `FLT_MAX` & `DBL_MAX`
+#include <limits.h> // For `INT_MIN` & `INT_MAX`
+#include <math.h>   // For `fabs`, `sqrt` & `expl`
+#include <stdatomic.h> // For `atomic_int`
+#include <stdio.h>  // For `fopen` & `remove`
+#include <unistd.h> // For `usleep`
+
 
 void test_create_matrix();
 void test_set_and_get_element();
@@ -13,6 +21,28 @@ void test_scalar_multiply_matrix();
 void test_multiply_2d_matrices();
 void test_resize_matrix();
 void test_change_data_type();
+void test_matrix_views();
+void test_broadcasting();
+void test_matrix_expression();
+void test_reductions();
+void test_multiply_batched_matrices();
+void test_strassen_multiplication();
+void test_compact_data_types();
+void test_mixed_precision_multiplication();
+void test_matrix_files();
+void test_out_of_core_multiplication();
+void test_element_batches();
+void test_bulk_fill();
+void test_blocked_transpose();
+void test_matrix_vector_products();
+void test_map_zip();
+void test_math_functions();
+void test_convolution();
+void test_linear_systems();
+void test_workspaces();
+void test_numa_placement();
+void test_matrix_queue();
+void test_fill_matrix_random();
 
 
 # endif // TESTS_MATRICES_TEST_H
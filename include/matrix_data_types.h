@@ -0,0 +1,155 @@
+#ifndef MATRIX_DATA_TYPES_H
+#define MATRIX_DATA_TYPES_H
+
+#include "custom_dynamic_matrices.h"
+
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+
+/*
+
+    Every data-type is described by one entry of `FOR_EACH_DATA_TYPE`:
+
+        X(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE)
+
+    Elements are stored as `STORAGE` and all arithmetic is done in `COMPUTE`. `LOAD(value)`
+    turns a stored element into a compute-value, `STORE(STORAGE, value)` turns it back.
+    Kernels and the `case`s of their selectors are generated from this list.
+
+    Direct types compute with plain C-arithmetic: narrow integers are promoted to `int` and
+    wrap around (modulo 2^bits) when the result is stored. The 16-bit floating point types
+    have no C-type, their elements are converted to `float` for every operation and rounded
+    back to nearest (ties to even).
+
+*/
+
+#define LOAD_VALUE(value) (value)
+#define STORE_VALUE(STORAGE, value) ((STORAGE)(value))
+#define LOAD_FP16(value) fp16_bits_to_float(value)
+#define STORE_FP16(STORAGE, value) float_to_fp16_bits(value)
+#define LOAD_BF16(value) bf16_bits_to_float(value)
+#define STORE_BF16(STORAGE, value) float_to_bf16_bits(value)
+
+// Types, whose elements take part in C-arithmetic directly
+#define FOR_EACH_DIRECT_DATA_TYPE(X)                                                                    \
+    X(TYPE_INT,    int,    int,     int,     LOAD_VALUE, STORE_VALUE)                                   \
+    X(TYPE_FLOAT,  float,  float,   float,   LOAD_VALUE, STORE_VALUE)                                   \
+    X(TYPE_DOUBLE, double, double,  double,  LOAD_VALUE, STORE_VALUE)                                   \
+    X(TYPE_INT8,   int8,   int8_t,  int,     LOAD_VALUE, STORE_VALUE)                                   \
+    X(TYPE_INT16,  int16,  int16_t, int,     LOAD_VALUE, STORE_VALUE)                                   \
+    X(TYPE_INT64,  int64,  int64_t, int64_t, LOAD_VALUE, STORE_VALUE)                                   \
+    X(TYPE_UINT8,  uint8,  uint8_t, int,     LOAD_VALUE, STORE_VALUE)
+
+// 16-bit floating point types, which are computed in `float`
+#define FOR_EACH_HALF_DATA_TYPE(X)                                                                      \
+    X(TYPE_FP16,   fp16,   fp16_t,  float,   LOAD_FP16,  STORE_FP16)                                    \
+    X(TYPE_BF16,   bf16,   bf16_t,  float,   LOAD_BF16,  STORE_BF16)
+
+#define FOR_EACH_DATA_TYPE(X) FOR_EACH_DIRECT_DATA_TYPE(X) FOR_EACH_HALF_DATA_TYPE(X)
+
+// Integer types with their range: X(ENUM, NAME, STORAGE, MINIMUM, MAXIMUM)
+#define FOR_EACH_INTEGER_DATA_TYPE(X)                                                                   \
+    X(TYPE_INT,    int,    int,     INT_MIN,   INT_MAX)                                                 \
+    X(TYPE_INT8,   int8,   int8_t,  INT8_MIN,  INT8_MAX)                                                \
+    X(TYPE_INT16,  int16,  int16_t, INT16_MIN, INT16_MAX)                                               \
+    X(TYPE_INT64,  int64,  int64_t, INT64_MIN, INT64_MAX)                                               \
+    X(TYPE_UINT8,  uint8,  uint8_t, 0,         UINT8_MAX)
+
+// Floating point types with their largest finite value: X(ENUM, NAME, STORAGE, LOAD, STORE, MAXIMUM)
+#define FOR_EACH_REAL_DATA_TYPE(X)                                                                      \
+    X(TYPE_FLOAT,  float,  float,   LOAD_VALUE, STORE_VALUE, FLT_MAX)                                   \
+    X(TYPE_DOUBLE, double, double,  LOAD_VALUE, STORE_VALUE, DBL_MAX)                                   \
+    X(TYPE_FP16,   fp16,   fp16_t,  LOAD_FP16,  STORE_FP16,  FP16_MAX)                                  \
+    X(TYPE_BF16,   bf16,   bf16_t,  LOAD_BF16,  STORE_BF16,  BF16_MAX)
+
+// Size of tables, which are indexed by the data-type
+#define NUMBER_OF_DATA_TYPES (TYPE_BF16 + 1)
+
+// Largest finite values of the 16-bit floating point types
+#define FP16_MAX 65504.0f
+#define BF16_MAX 3.38953139e38f
+
+
+static inline int is_integer_data_type(DataType data_type) {
+    return data_type == TYPE_INT || data_type == TYPE_INT8 || data_type == TYPE_INT16 ||
+           data_type == TYPE_INT64 || data_type == TYPE_UINT8;
+}
+
+static inline int is_half_data_type(DataType data_type) {
+    return data_type == TYPE_FP16 || data_type == TYPE_BF16;
+}
+
+
+//
+// 16-bit floating point conversions
+//
+
+/*
+
+    Branch-free bit manipulation (selects instead of jumps), so loops over these functions
+    are vectorized like every other conversion. Subnormals, infinities and NaN are handled.
+
+*/
+
+static inline uint32_t float_to_bits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static inline float float_from_bits(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static inline float fp16_bits_to_float(fp16_t value) {
+    uint32_t word = (uint32_t)value << 16;
+    uint32_t sign = word & 0x80000000u;
+    uint32_t doubled = word + word;     // Without the sign
+
+    // Normal numbers: move exponent & mantissa into place and rebias with a multiplication
+    // (which also turns the maximum exponent into infinity/NaN)
+    float normal = float_from_bits((doubled >> 4) + (0xE0u << 23)) * 0x1.0p-112f;
+
+    // Subnormal numbers: the mantissa becomes the fraction of 0.5 + mantissa * 2^-24
+    float subnormal = float_from_bits((doubled >> 17) | (126u << 23)) - 0.5f;
+
+    return float_from_bits(sign | float_to_bits(doubled < (1u << 27) ? subnormal : normal));
+}
+
+static inline fp16_t float_to_fp16_bits(float value) {
+    uint32_t word = float_to_bits(value);
+    uint32_t doubled = word + word;     // Without the sign
+    uint32_t sign = word & 0x80000000u;
+
+    // Scaling up and down lets the FPU round the mantissa to 10 bits (and overflow to infinity)
+    float base = (fabsf(value) * 0x1.0p+112f) * 0x1.0p-110f;
+    uint32_t bias = doubled & 0xFF000000u;
+    bias = bias < 0x71000000u ? 0x71000000u : bias;
+
+    base = float_from_bits((bias >> 1) + 0x07800000u) + base;
+    uint32_t bits = float_to_bits(base);
+    uint32_t nonsign = ((bits >> 13) & 0x00007C00u) + (bits & 0x00000FFFu);
+
+    return (fp16_t)((sign >> 16) | (doubled > 0xFF000000u ? 0x7E00u : nonsign));
+}
+
+static inline float bf16_bits_to_float(bf16_t value) {
+    return float_from_bits((uint32_t)value << 16);
+}
+
+static inline bf16_t float_to_bf16_bits(float value) {
+    uint32_t bits = float_to_bits(value);
+    uint32_t rounded = bits + 0x7FFFu + ((bits >> 16) & 1u);
+
+    // NaN stays a (quiet) NaN instead of rounding into infinity
+    return (bf16_t)((bits & 0x7FFFFFFFu) > 0x7F800000u ? (bits >> 16) | 0x0040u : rounded >> 16);
+}
+
+
+#endif // MATRIX_DATA_TYPES_H
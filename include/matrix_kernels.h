@@ -0,0 +1,37 @@
+#ifndef MATRIX_KERNELS_H
+#define MATRIX_KERNELS_H
+
+#include "custom_dynamic_matrices.h"
+
+
+/*
+
+    Kernels, which are shared between the matrix modules. They work on plain, contiguous
+    (row-major) buffers instead of matrices and are not part of the public interface.
+
+*/
+
+// Row-major strides of a matrix with the given dimensions.
+static inline void set_matrix_strides(size_t* strides, const size_t* dimensions, size_t number_of_dimensions) {
+    size_t stride = 1;
+
+    for (size_t i = number_of_dimensions; i-- > 0;) {
+        strides[i] = stride;
+        stride *= dimensions[i];
+    }
+}
+
+ErrorCode multiply_matrix_tiles(void* result, const void* data_A, const void* data_B,
+                                size_t rows_A, size_t cols_A, size_t cols_B, DataType data_type, void* workspace);
+ErrorCode multiply_matrix_vector_buffers(void* result, const void* matrix, const void* vector,
+                                         size_t rows, size_t cols, size_t row_stride, DataType data_type, int transposed);
+
+// Box-Muller: `out[2i]`, `out[2i + 1]` = mean + deviation * sqrt(-2 * log(radii[i])) * (cos, sin)(2 * pi * turns[i])
+// with `radii` in (0, 1] and `turns` in [0, 1).
+void box_muller_float_kernel(float* restrict out, const float* restrict radii, const float* restrict turns,
+                             size_t pairs, float mean, float deviation);
+void box_muller_double_kernel(double* restrict out, const double* restrict radii, const double* restrict turns,
+                              size_t pairs, double mean, double deviation);
+
+
+#endif // MATRIX_KERNELS_H
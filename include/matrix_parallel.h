@@ -0,0 +1,33 @@
+#ifndef MATRIX_PARALLEL_H
+#define MATRIX_PARALLEL_H
+
+#include <stddef.h>
+
+
+// Processes the items [begin, end) of a parallel loop.
+typedef void (*ParallelTask)(void* context, size_t begin, size_t end);
+
+// Placement of the pages of large data-buffers on NUMA-machines (see `set_matrix_memory_policy`)
+typedef enum MatrixMemoryPolicy {
+    MEMORY_POLICY_DEFAULT,       // Pages land on the node of the thread, which writes them first
+    MEMORY_POLICY_FIRST_TOUCH,   // New buffers are zeroed partition by partition by the threads of `parallel_for`
+    MEMORY_POLICY_INTERLEAVED    // Pages are spread round-robin over all NUMA-nodes
+} MatrixMemoryPolicy;
+
+
+//
+// Functions
+//
+
+void set_matrix_thread_count(size_t thread_count);
+size_t get_matrix_thread_count(void);
+void parallel_for(size_t count, size_t minimum_chunk_size, ParallelTask task, void* context);
+void set_matrix_memory_policy(MatrixMemoryPolicy policy, size_t minimum_bytes);
+MatrixMemoryPolicy get_matrix_memory_policy(void);
+void set_matrix_thread_affinity(int pin_threads);
+int get_matrix_thread_affinity(void);
+size_t get_numa_node_count(void);
+void place_matrix_data(void* data, size_t size);
+
+
+#endif // MATRIX_PARALLEL_H
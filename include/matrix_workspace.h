@@ -0,0 +1,28 @@
+#ifndef MATRIX_WORKSPACE_H
+#define MATRIX_WORKSPACE_H
+
+#include "custom_dynamic_matrices.h"
+
+
+/*
+
+    Hooks of the matrix modules into the workspace of the calling thread (see
+    `begin_workspace_scope`). They are not part of the public interface.
+
+*/
+
+// Adds a new matrix-node to the open scope (or marks it as not pooled outside of scopes).
+void track_workspace_matrix(MultiDimensionalMatrixNode* node);
+
+// Removes a matrix-node, which is about to be freed, from its scope.
+void untrack_workspace_matrix(MultiDimensionalMatrixNode* node);
+
+// Data-buffer of `size` bytes from the open scope (`storage` becomes `STORAGE_WORKSPACE`),
+// or NULL if no scope is open.
+void* allocate_workspace_data(MultiDimensionalMatrixNode* node, size_t size);
+
+// Returns a `STORAGE_WORKSPACE` buffer to its pool.
+void release_workspace_data(void* data);
+
+
+#endif // MATRIX_WORKSPACE_H
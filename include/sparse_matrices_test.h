@@ -0,0 +1,16 @@
+#ifndef TESTS_SPARSE_MATRICES_TEST_H
+#define TESTS_SPARSE_MATRICES_TEST_H
+
+#include "custom_sparse_matrices.h"
+#include "matrix_parallel.h"
+#include "test_constants.h"
+
+#include <math.h> // For `fabs`
+
+
+void test_sparse_conversion();
+void test_sparse_products();
+void test_add_sparse_matrices();
+
+
+# endif // TESTS_SPARSE_MATRICES_TEST_H
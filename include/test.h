@@ -2,6 +2,7 @@
 #define TEST_MATRICES_H
 
 #include "matrices_test.h"
+#include "sparse_matrices_test.h"
 #include "dynamic_array_test.h"
 #include "test_constants.h"
 
@@ -342,18 +342,18 @@ ErrorCode set_list_element_by_index(DynamicArray* dynamic_array, int index, void
         return ERR_INVALID_ARGS;
     }
 
-    void* new_element_pointer = NULL;
+    DynamicArrayNode* element_node = NULL;
 
     if (index == LIST_START_POS) {
-        new_element_pointer = dynamic_array->head_ptr->element;
+        element_node = dynamic_array->head_ptr;
     }
 
     if (index == LIST_END_POS) {
-        new_element_pointer = dynamic_array->tail_ptr->element;
+        element_node = dynamic_array->tail_ptr;
     }
 
 
-    if (!new_element_pointer) {
+    if (!element_node) {
         DynamicArrayNode* current_ptr = dynamic_array->head_ptr;
         int counter = 0;
         while (current_ptr != NULL && counter != index) {
@@ -366,14 +366,15 @@ ErrorCode set_list_element_by_index(DynamicArray* dynamic_array, int index, void
             return ERR_INVALID_INDEX;
         }
 
-        new_element_pointer = current_ptr->element;
+        element_node = current_ptr;
     }
 
-    void* this_element = realloc(new_element_pointer, element_size);
+    void* this_element = realloc(element_node->element, element_size);
     if (!this_element) {
         // Reallocation-Error
         return ERR_REALLOC_FAILED;
     }
-    memcpy(new_element_pointer, element, element_size);
+    element_node->element = this_element;
+    memcpy(this_element, element, element_size);
     return ERR_NONE;
 }
@@ -1,5 +1,56 @@
 #include "custom_dynamic_matrices.h"
+#include "matrix_data_types.h"
+#include "matrix_kernels.h"
+#include "matrix_parallel.h"
+#include "matrix_workspace.h"
 
+#include <float.h>  // For `FLT_MAX`
+#include <limits.h> // For `INT_MIN` & `INT_MAX`
+#include <math.h>   // For `rint`, `floor` & `ceil`
+#include <sys/mman.h> // For `munmap`
+
+
+// Size (in bytes) of a single element of the given data-type.
+size_t get_data_type_size(DataType data_type) {
+    /*
+
+        Returns the element-size in bytes.
+        Returns `0` if the given data-type is not supported.
+
+    */
+
+    #define DATA_TYPE_SIZE_CASE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE) case ENUM: return sizeof(STORAGE);
+
+    switch(data_type) {
+        FOR_EACH_DATA_TYPE(DATA_TYPE_SIZE_CASE)
+
+        default:
+            // Unsupported Data-Type
+            return 0;
+    }
+
+    #undef DATA_TYPE_SIZE_CASE
+}
+
+// Value of an IEEE 754 half precision bit-pattern.
+float fp16_to_float(fp16_t value) {
+    return fp16_bits_to_float(value);
+}
+
+// Nearest half precision value (ties to even); beyond +/-65504 the result is +/-infinity.
+fp16_t float_to_fp16(float value) {
+    return float_to_fp16_bits(value);
+}
+
+// Value of a bfloat16 bit-pattern.
+float bf16_to_float(bf16_t value) {
+    return bf16_bits_to_float(value);
+}
+
+// Nearest bfloat16 value (ties to even).
+bf16_t float_to_bf16(float value) {
+    return float_to_bf16_bits(value);
+}
 
 // Update data_type and allocates space for matrix-data.
 static ErrorCode update_data_type(MultiDimensionalMatrix* matrix, DataType data_type) {
@@ -24,29 +75,29 @@ static ErrorCode update_data_type(MultiDimensionalMatrix* matrix, DataType data_
         total_size *= matrix->head_ptr->dimensions[i];
     }
 
-    switch(data_type) {
-        case TYPE_INT:
-            matrix->head_ptr->data = malloc(total_size * sizeof(int));
-            matrix->head_ptr->data_size = total_size * sizeof(int);
-            break;
+    size_t element_size = get_data_type_size(data_type);
 
-        case TYPE_FLOAT:
-            matrix->head_ptr->data = malloc(total_size * sizeof(float));
-            matrix->head_ptr->data_size = total_size * sizeof(float);
-            break;
+    if (!element_size) {
+        // Given data_type is not supported.
+        matrix->head_ptr->data = NULL;
+        clear_matrix(matrix);
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
 
-        case TYPE_DOUBLE:
-            matrix->head_ptr->data = malloc(total_size * sizeof(double));
-            matrix->head_ptr->data_size = total_size * sizeof(double);
-            break;
+    matrix->head_ptr->storage = STORAGE_HEAP;
+    matrix->head_ptr->data = allocate_workspace_data(matrix->head_ptr, total_size * element_size);
 
-        default:
-            // Given data_type is not supported.
-            matrix->head_ptr->data = NULL;
-            clear_matrix(matrix);
-            return ERR_UNSUPPORTED_DATATYPE;
+    if (!matrix->head_ptr->data) {
+        // No open workspace-scope
+        matrix->head_ptr->data = malloc(total_size * element_size);
+        place_matrix_data(matrix->head_ptr->data, total_size * element_size);
     }
 
+    matrix->head_ptr->data_size = total_size * element_size;
+    matrix->head_ptr->capacity = total_size * element_size;
+    matrix->head_ptr->mapping = NULL;
+    matrix->head_ptr->mapping_size = 0;
+
     if (!matrix->head_ptr->data) {
         // Allocation-Error or invalid data_type
         clear_matrix(matrix);
@@ -92,24 +143,44 @@ ErrorCode create_matrix(MultiDimensionalMatrix* matrix, size_t number_of_dimensi
     }
 
     matrix->head_ptr = head_ptr;
+    track_workspace_matrix(head_ptr);
 
     head_ptr->number_of_dimensions = number_of_dimensions;
 
-    // Allocate space for the dimensions-array
-    head_ptr->dimensions = (size_t*) malloc(number_of_dimensions * sizeof(size_t));
+    // Allocate space for the dimensions- and the strides-array
+    head_ptr->dimensions = (size_t*) malloc(2 * number_of_dimensions * sizeof(size_t));
 
     if (!head_ptr->dimensions) {
         // Allocation-Error
+        head_ptr->data = NULL;
         clear_matrix(matrix);
         return ERR_MALLOC_FAILED;
     }
 
     memcpy(head_ptr->dimensions, dimensions, number_of_dimensions * sizeof(size_t));
+    head_ptr->strides = head_ptr->dimensions + number_of_dimensions;
+    set_matrix_strides(head_ptr->strides, dimensions, number_of_dimensions);
 
     return update_data_type(matrix, data_type);
 }
 
 
+// Free the data-buffer of a matrix-node (or unmap its file/return it to its workspace).
+static void release_matrix_data(MultiDimensionalMatrixNode* node) {
+    if (node->storage == STORAGE_HEAP) {
+        free(node->data);
+    } else if (node->storage == STORAGE_WORKSPACE) {
+        release_workspace_data(node->data);
+    } else {
+        munmap(node->mapping, node->mapping_size);
+    }
+
+    node->data = NULL;
+    node->storage = STORAGE_HEAP;
+    node->mapping = NULL;
+    node->mapping_size = 0;
+}
+
 // Free all allocated space.
 void clear_matrix(MultiDimensionalMatrix* matrix) {
     if (!matrix) {
@@ -123,27 +194,53 @@ void clear_matrix(MultiDimensionalMatrix* matrix) {
     }
 
     if (matrix->head_ptr->data) {
-        free(matrix->head_ptr->data);
-        matrix->head_ptr->data = NULL;
+        release_matrix_data(matrix->head_ptr);
     }
 
     if (matrix->head_ptr->dimensions) {
         free(matrix->head_ptr->dimensions);
         matrix->head_ptr->dimensions = NULL;
+        matrix->head_ptr->strides = NULL;
     }
 
+    untrack_workspace_matrix(matrix->head_ptr);
     free(matrix->head_ptr);
     matrix->head_ptr = NULL;
 
     return;
 }
 
+// Copy the data of a mapped (or pooled) matrix into an own buffer, so it can be reallocated.
+static ErrorCode detach_mapped_data(MultiDimensionalMatrixNode* node) {
+    if (node->storage == STORAGE_HEAP) {
+        return ERR_NONE;
+    }
+
+    void* data = malloc(node->data_size > 0 ? node->data_size : 1);
+
+    if (!data) {
+        // Allocation-Error
+        return ERR_MALLOC_FAILED;
+    }
+
+    memcpy(data, node->data, node->data_size);
+    release_matrix_data(node);
+
+    node->data = data;
+    node->capacity = node->data_size;
+
+    return ERR_NONE;
+}
+
 // Calculate the index of the 1-Dimensional-array with the given multidimensional indices.
 static IndexCalcReturn calc_index(MultiDimensionalMatrix* matrix, size_t* indices) {
     /*
 
         Returns the custom `IndexCalcReturn`-struct in order to return the index and
         a self-defined Error-Code, if something went wrong.
+
+        ERR_INVALID_ARGS  = No indices given or matrix does not exist;
+        ERR_INVALID_INDEX = An index is out of bounds of its dimension;
     */
 
     IndexCalcReturn return_data;
@@ -154,26 +251,17 @@ static IndexCalcReturn calc_index(MultiDimensionalMatrix* matrix, size_t* indice
         return return_data;
     }
 
+    const MultiDimensionalMatrixNode* node = matrix->head_ptr;
     size_t index = 0; // Calculated index
-    /*
-    
-        The offset is used to account for the size of each dimension and to calculate the 
-        correct position of an element in a flattened version of the multidimensional array.
-    
-    */
 
-    size_t offset = 1;
-
-    /*
-
-        The value `i` can't be a `size_t`, 
-        because the expression `i >= 0` would be always true.
-    
-    */
+    // The strides are computed once, when the dimensions of the matrix change
+    for (size_t i = 0; i < node->number_of_dimensions; i++) {
+        if (indices[i] >= node->dimensions[i]) {
+            return_data.error_code = ERR_INVALID_INDEX;
+            return return_data;
+        }
 
-    for (int i = matrix->head_ptr->number_of_dimensions - 1; i >= 0; --i) {
-        index += indices[i] * offset;
-        offset *= matrix->head_ptr->dimensions[i];
+        index += indices[i] * node->strides[i];
     }
 
     return_data.error_code = ERR_NONE;
@@ -206,37 +294,15 @@ void* get_element_by_indices(MultiDimensionalMatrix* matrix, size_t* indices) {
 
     size_t index = return_data.index;
     
-    // Check if calculated index is out of bounds
-    // And return requested value if index is valid
-    switch(matrix->head_ptr->data_type) {
-        case TYPE_INT:
-            if (index >= matrix->head_ptr->data_size / sizeof(int)) {
-                return NULL;
-            }
-            return (void*)((int*)matrix->head_ptr->data + index);
-            break; // Unreachable ???
-
-        case TYPE_FLOAT:
-            if (index >= matrix->head_ptr->data_size / sizeof(float)) {
-                return NULL;
-            }
-            return (void*)((float*)matrix->head_ptr->data + index);
-            break; // Unreachable ???
-        
-        case TYPE_DOUBLE:
-            if (index >= matrix->head_ptr->data_size / sizeof(double)) {
-                return NULL;
-            }
-            return (void*)((double*)matrix->head_ptr->data + index);
-            break; // Unreachable ???
+    size_t element_size = get_data_type_size(matrix->head_ptr->data_type);
 
-        default:
-            // Unsupported Data-Type
-            return NULL;
+    if (!element_size) {
+        // Unsupported Data-Type
+        return NULL;
     }
 
-    // Unreachable
-    return NULL;
+    // `calc_index` checked the bounds of every dimension
+    return (void*)((char*)matrix->head_ptr->data + index * element_size);
 }
 
 // Set an element at the given position, but by its flat/linear index in the struct.
@@ -249,6 +315,7 @@ static ErrorCode set_element_by_linear_index(MultiDimensionalMatrix* matrix, siz
         ERR_NULL_PTR              = Matrix does not exist; Value does not exist; Matrix-head pointer does not exist;
         ERR_INVALID_INDEX         = Given element-index is invalid;
         ERR_UNSUPPORTED_DATATYPE  = Unsupported Data-Type;
+        ERR_READ_ONLY             = The matrix is a read-only mapping of a file;
 
     */
 
@@ -257,35 +324,26 @@ static ErrorCode set_element_by_linear_index(MultiDimensionalMatrix* matrix, siz
         return ERR_NULL_PTR;
     }
 
-    // Check if calculated index is out of bounds
-    // Modifies the element with this index
-    switch(matrix->head_ptr->data_type) {
-        case TYPE_INT:
-            if (index >= matrix->head_ptr->data_size / sizeof(int)) {
-                return ERR_INVALID_INDEX;
-            }
-            ((int*)matrix->head_ptr->data)[index] = *(int*)value;
-            break;
+    if (matrix->head_ptr->storage == STORAGE_MAPPED_READ_ONLY) {
+        // Writing would fault
+        return ERR_READ_ONLY;
+    }
 
-        case TYPE_FLOAT:
-            if (index >= matrix->head_ptr->data_size / sizeof(float)) {
-                return ERR_INVALID_INDEX;
-            }
-            ((float*)matrix->head_ptr->data)[index] = *(float*)value;
-            break;
-        
-        case TYPE_DOUBLE:
-            if (index >= matrix->head_ptr->data_size / sizeof(double)) {
-                return ERR_INVALID_INDEX;
-            }
-            ((double*)matrix->head_ptr->data)[index] = *(double*)value;
-            break;
+    size_t element_size = get_data_type_size(matrix->head_ptr->data_type);
 
-        default:
-            // Unsupported Data-Type
-            return ERR_UNSUPPORTED_DATATYPE;
+    if (!element_size) {
+        // Unsupported Data-Type
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    // Check if calculated index is out of bounds
+    if (index >= matrix->head_ptr->data_size / element_size) {
+        return ERR_INVALID_INDEX;
     }
 
+    // Modifies the element with this index
+    memcpy((char*)matrix->head_ptr->data + index * element_size, value, element_size);
+
     return ERR_NONE;
 
 }
@@ -321,242 +379,4965 @@ ErrorCode set_element_by_indices(MultiDimensionalMatrix* matrix, size_t* indices
     return set_element_by_linear_index(matrix, index, value);
 }
 
+// Number of indices, which are converted at once by the batched element access
+#define INDEX_BLOCK_SIZE 256
+
+// Copy elements between the positions `linear_indices` of `data` and the contiguous `values`.
+#define DEFINE_GATHER_SCATTER_LOOPS(NAME, TYPE)                                                         \
+static void gather_##NAME##_elements(void* values, const void* data, const size_t* linear_indices, size_t count) { \
+    TYPE* result = (TYPE*)values;                                                                       \
+    const TYPE* elements = (const TYPE*)data;                                                           \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        result[i] = elements[linear_indices[i]];                                                        \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+static void scatter_##NAME##_elements(void* data, const void* values, const size_t* linear_indices, size_t count) { \
+    TYPE* elements = (TYPE*)data;                                                                       \
+    const TYPE* source = (const TYPE*)values;                                                           \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        elements[linear_indices[i]] = source[i];                                                        \
+    }                                                                                                   \
+}
 
-// Fill a given matrix with a static-array.
-ErrorCode fill_matrix_from_static_array(MultiDimensionalMatrix* matrix, void* static_array) {
-    /*
+// Elements are moved as unsigned integers of their size
+DEFINE_GATHER_SCATTER_LOOPS(byte, uint8_t)
+DEFINE_GATHER_SCATTER_LOOPS(short, uint16_t)
+DEFINE_GATHER_SCATTER_LOOPS(word, uint32_t)
+DEFINE_GATHER_SCATTER_LOOPS(long, uint64_t)
 
-        Assuming, that the given dimensions of the static-array are the same as of the matrix.
+typedef void (*ElementMoveLoop)(void* destination, const void* source, const size_t* linear_indices, size_t count);
 
-        Returns a custom `ErrorCode`.
+// Check the coordinate-tuples (or linear indices, if `indices` is `NULL`) of a batch at once.
+static ErrorCode check_element_batch(const MultiDimensionalMatrixNode* node, const size_t* indices,
+                                     const size_t* linear_indices, size_t count) {
+    size_t invalid = 0;
 
-        ERR_NONE                     = No error.
-        ERR_NULL_PTR                 = Matrix does not exist; Given static-array does not exist; Matrix head-pointer does not exist;
-        ERR_UNSUPPORTED_DATATYPE     = Unsupported data type;
+    if (indices) {
+        size_t number_of_dimensions = node->number_of_dimensions;
 
-        » For the other possible ErrorCodes, see what `set_element_by_linear_index` returns. «
+        // Branch-free: one comparison per coordinate, one check per batch
+        for (size_t i = 0; i < count; i++) {
+            for (size_t j = 0; j < number_of_dimensions; j++) {
+                invalid |= indices[i * number_of_dimensions + j] >= node->dimensions[j];
+            }
+        }
+    } else {
+        size_t number_of_elements = node->data_size / get_data_type_size(node->data_type);
+        size_t maximum = 0;
 
-    */
+        for (size_t i = 0; i < count; i++) {
+            maximum = linear_indices[i] > maximum ? linear_indices[i] : maximum;
+        }
 
-    if (!matrix || !static_array || !matrix->head_ptr) {
-        // NULL-Pointer
-        return ERR_NULL_PTR;
+        invalid = count > 0 && maximum >= number_of_elements;
     }
 
-    // Determine the size of each element
-    size_t element_size = 0;
+    return invalid ? ERR_INVALID_INDEX : ERR_NONE;
+}
+
+// Shared part of the batched element access.
+static ErrorCode move_element_batch(const MultiDimensionalMatrixNode* node, const size_t* indices, const size_t* linear_indices,
+                                    size_t count, void* values, int scatter) {
+    size_t element_size = get_data_type_size(node->data_type);
+    ElementMoveLoop loop;
+
+    switch(element_size) {
+        case 1: loop = scatter ? scatter_byte_elements : gather_byte_elements; break;
+        case 2: loop = scatter ? scatter_short_elements : gather_short_elements; break;
+        case 4: loop = scatter ? scatter_word_elements : gather_word_elements; break;
+        case 8: loop = scatter ? scatter_long_elements : gather_long_elements; break;
 
-    switch (matrix->head_ptr->data_type) {
-        case TYPE_INT:
-            element_size = sizeof(int);
-            break;
-        case TYPE_FLOAT:
-            element_size = sizeof(float);
-            break;
-        case TYPE_DOUBLE:
-            element_size = sizeof(double);
-            break;
         default:
-            // Unsupported data_type
+            // Unsupported Data-Type
             return ERR_UNSUPPORTED_DATATYPE;
     }
 
-    size_t total_size = matrix->head_ptr->data_size / element_size;
+    ErrorCode error = check_element_batch(node, indices, linear_indices, count);
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    void* data = node->data;
+    size_t block[INDEX_BLOCK_SIZE];
 
-    // Iterate through the array
-    void* this_element;
-    ErrorCode response;
+    for (size_t start = 0; start < count; start += INDEX_BLOCK_SIZE) {
+        size_t length = count - start < INDEX_BLOCK_SIZE ? count - start : INDEX_BLOCK_SIZE;
+        char* block_values = (char*)values + start * element_size;
+        const size_t* block_indices = linear_indices + start;
 
-    for (size_t i = 0; i < total_size; i++) {
-        // Iterate byte-wise
-        this_element = (void*) (((char*)static_array + (i * element_size)));
+        if (indices) {
+            // Linear indices of a block of coordinate-tuples, one dimension at a time
+            size_t number_of_dimensions = node->number_of_dimensions;
+            const size_t* tuples = indices + start * number_of_dimensions;
 
-        // Set element at specific position
-        response = set_element_by_linear_index(matrix, i, this_element);
-        
-        if (response != ERR_NONE) {
-            // Couldn't set element in matrix
-            return response;
+            for (size_t i = 0; i < length; i++) {
+                block[i] = 0;
+            }
+
+            for (size_t j = 0; j < number_of_dimensions; j++) {
+                size_t stride = node->strides[j];
+
+                for (size_t i = 0; i < length; i++) {
+                    block[i] += tuples[i * number_of_dimensions + j] * stride;
+                }
+            }
+
+            block_indices = block;
         }
 
+        if (scatter) {
+            loop(data, block_values, block_indices, length);
+        } else {
+            loop(block_values, data, block_indices, length);
+        }
     }
-    
-    return ERR_NONE;
 
+    return ERR_NONE;
 }
 
-
-// Change number of dimensions or/and the dimension sizes.
-ErrorCode resize_matrix(MultiDimensionalMatrix* matrix, size_t new_number_of_dimensions, size_t* new_dimensions) {
+// Get many elements at once by their indices.
+ErrorCode gather_elements_by_indices(const MultiDimensionalMatrix* matrix, const size_t* indices, size_t count, void* values) {
     /*
-        !!! ToDo !!!
-        Doesn't work at all.
+
+        `indices` holds `count` coordinate-tuples (`number_of_dimensions` indices each), the
+        elements are copied in this order into `values` (`count` elements of the data-type of
+        the matrix). All indices are checked before anything is copied.
 
         Returns a custom `ErrorCode`.
 
-        ERR_NONE            = No error.
-        ERR_NULL_PTR        = Matrix does not exist; Dimensions-array does not exist;
-        ERR_INVALID_ARGS    = Invalid number of dimensions; Invalid dimension-size;
+        ERR_NONE                 = No error.
+        ERR_NULL_PTR             = Matrix/Indices/Values do not exist;
+        ERR_INVALID_INDEX        = An index is out of bounds of its dimension;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported Data-Type;
 
     */
 
-    if (!matrix || !new_dimensions) {
-        // Matrix/dimensions-array does not exist
+    if (!matrix || !matrix->head_ptr || !matrix->head_ptr->data || !indices || !values) {
         return ERR_NULL_PTR;
     }
 
-    if (new_number_of_dimensions == 0) {
-        // Invalid number of dimensions
-        return ERR_INVALID_ARGS;
+    return move_element_batch(matrix->head_ptr, indices, NULL, count, values, 0);
+}
+
+// Get many elements at once by their flat/linear (row-major) indices.
+ErrorCode gather_elements_by_linear_indices(const MultiDimensionalMatrix* matrix, const size_t* linear_indices, size_t count, void* values) {
+    /*
+
+        Same as `gather_elements_by_indices`, but every element is addressed by a single index.
+
+    */
+
+    if (!matrix || !matrix->head_ptr || !matrix->head_ptr->data || !linear_indices || !values) {
+        return ERR_NULL_PTR;
     }
 
-    if (new_number_of_dimensions != matrix->head_ptr->number_of_dimensions) {
-        // Change number of dimensions
-        // Check if `new_dimensions`-array is valid
-        for (size_t i = 0; i < new_number_of_dimensions; i++) {
-            // Check dimension-size
-            if (new_dimensions[i] < 0) {
-                // Invalid dimension-size
-                //
-                // ??? Reachable ???
-                // Because, array has the data-type `size_t`
-                //
-                return ERR_INVALID_ARGS;
-            }
-        }
+    return move_element_batch(matrix->head_ptr, NULL, linear_indices, count, values, 0);
+}
 
+// Set many elements at once by their indices.
+ErrorCode scatter_elements_by_indices(MultiDimensionalMatrix* matrix, const size_t* indices, size_t count, const void* values) {
+    /*
 
-    } else {
-        // `new_number_of_dimensions` should equal the old one
-        // Check dimension-sizes
-        /*size_t equal = 1;
-        for (size_t i = 0; i < new_number_of_dimensions; i++) {
-            if (matrix->head_ptr->dimensions[i] != new_dimensions[i]) {
-                equal = 0;
-                break;
-            }
-        }*/
+        `indices` holds `count` coordinate-tuples (`number_of_dimensions` indices each), which
+        receive the elements of `values` in this order. If a position occurs several times,
+        the last value stays. All indices are checked before anything is written.
 
-        // Or use compare
-        if (memcmp(matrix->head_ptr->dimensions, new_dimensions, matrix->head_ptr->number_of_dimensions * sizeof(size_t))) {
-            // Nothing to change.
-            return ERR_NONE;
-        }
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                 = No error.
+        ERR_NULL_PTR             = Matrix/Indices/Values do not exist;
+        ERR_INVALID_INDEX        = An index is out of bounds of its dimension;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported Data-Type;
+        ERR_READ_ONLY            = The matrix is a read-only mapping of a file;
 
-        // !!!
-        //
-        // Shouldn't be reachable for now
-        // DEBUG
-        //
-        // !!!
+    */
 
-        //if (equal) {
-            // Nothing to change.
-        //    return ERR_NONE;
-        //}
+    if (!matrix || !matrix->head_ptr || !matrix->head_ptr->data || !indices || !values) {
+        return ERR_NULL_PTR;
     }
 
-    // Reallocate space for the dimensions-array
-    matrix->head_ptr->dimensions = (size_t*) realloc(matrix->head_ptr->dimensions, new_number_of_dimensions * sizeof(size_t));
-
-    if (!matrix->head_ptr->dimensions) {
-        // Reallocation failed
-        //
-        // Should the matrix be deleted, because `dimensions` should be `NULL`, right?
-        // ??? clear_matrix(&matrix); ???
-        //
-        return ERR_REALLOC_FAILED;
+    if (matrix->head_ptr->storage == STORAGE_MAPPED_READ_ONLY) {
+        return ERR_READ_ONLY;
     }
 
-    memcpy(matrix->head_ptr->dimensions, new_dimensions, new_number_of_dimensions * sizeof(size_t));
+    return move_element_batch(matrix->head_ptr, indices, NULL, count, (void*)values, 1);
+}
+
+// Set many elements at once by their flat/linear (row-major) indices.
+ErrorCode scatter_elements_by_linear_indices(MultiDimensionalMatrix* matrix, const size_t* linear_indices, size_t count, const void* values) {
+    /*
+
+        Same as `scatter_elements_by_indices`, but every element is addressed by a single index.
+
+    */
+
+    if (!matrix || !matrix->head_ptr || !matrix->head_ptr->data || !linear_indices || !values) {
+        return ERR_NULL_PTR;
+    }
 
-    // Changing the number of dimensions
-    matrix->head_ptr->number_of_dimensions = new_number_of_dimensions;
+    if (matrix->head_ptr->storage == STORAGE_MAPPED_READ_ONLY) {
+        return ERR_READ_ONLY;
+    }
 
-    // Resize `data`
-    return update_data_type(matrix, matrix->head_ptr->data_type);
+    return move_element_batch(matrix->head_ptr, NULL, linear_indices, count, (void*)values, 1);
 }
 
-// Change data type of given matrix.
-ErrorCode change_data_type(MultiDimensionalMatrix* matrix, DataType new_data_type) {
+
+// Fill a given matrix with a static-array.
+ErrorCode fill_matrix_from_static_array(MultiDimensionalMatrix* matrix, void* static_array) {
     /*
 
-        Returns an ErrorCode.
+        Assuming, that the given dimensions of the static-array are the same as of the matrix.
+        The elements are copied in one pass (see `fill_matrix_from_array`).
 
-        ERR_NONE            = No error.
-        ERR_NULL_PTR        = Matrix does not exist or head-pointer is NULL;
-        ERR_INVALID_ARGS    = Given new data_type equals the old one;
+        Returns a custom `ErrorCode`.
 
-        » For the other possible ErrorCodes, see what `update_data_type` returns. «
+        ERR_NONE                     = No error.
+        ERR_NULL_PTR                 = Matrix does not exist; Given static-array does not exist; Matrix head-pointer does not exist;
+
+        » For the other possible ErrorCodes, see what `fill_matrix_from_array` returns. «
 
     */
-    if (!matrix || !matrix->head_ptr) {
-        // Matrix does not exist or head-pointer is NULL.
-        return ERR_NULL_PTR;
-    }
 
-    if (new_data_type == matrix->head_ptr->data_type) {
-        // Nothing to change.
-        return ERR_INVALID_ARGS;
+    if (!matrix || !static_array || !matrix->head_ptr) {
+        // NULL-Pointer
+        return ERR_NULL_PTR;
     }
 
-    return update_data_type(matrix, new_data_type);
+    return fill_matrix_from_array(matrix, static_array, matrix->head_ptr->data_type, NULL);
 }
 
 
-//
-// Arithmetic Operations
-//
+// `*product = a * b`; returns 0 if the product does not fit into a `size_t`.
+static int multiply_sizes(size_t a, size_t b, size_t* product) {
+    if (b > 0 && a > SIZE_MAX / b) {
+        return 0;
+    }
 
+    *product = a * b;
+    return 1;
+}
 
-// Addition of two multidimensional-matrices.
-ArithmeticOperationReturn add_matrices(const MultiDimensionalMatrix* matrix_A, const MultiDimensionalMatrix* matrix_B) {
+// Resize given matrix, the elements keep their coordinates.
+ErrorCode resize_matrix(MultiDimensionalMatrix* matrix, size_t new_number_of_dimensions, size_t* new_dimensions) {
     /*
 
-        Returns a `ArithmeticOperationReturn` struct, which contains:
+        - Same number of elements: O(1) reshape, the data-buffer is not touched and the
+          elements keep their (row-major) order.
+        - Only the first dimension changes: the data-buffer grows geometrically, so growing
+          a matrix row by row costs amortized O(1) per row (see `reserve_matrix_capacity`).
+        - Otherwise every element keeps its coordinates, elements outside of the new shape
+          are dropped. A different number of dimensions is aligned at the last dimension:
+          a (2) matrix is treated as (1 x 2), for fewer dimensions only the index 0 of the
+          removed leading dimensions is kept.
 
-        - MultiDimensionalMatrix result_matrix: The result of this operation.
-        - ErrorCode error_code                : Indicating the operation status.
-        
+        New elements are 0. The data-buffer may move, so existing views become invalid.
+        A mapped matrix (see `open_matrix_mmap`) is copied into memory, unless only its shape
+        changes.
 
-        Possible `ErrorCodes`:
+        Returns a custom `ErrorCode`.
 
-        ERR_NONE                        = No error.
-        ERR_NULL_PTR                    = One or both matrices are NULL (head-pointer is invalid);
-        ERR_DIMENSION_COUNT_MISMATCH    = The number of dimensions of both matrices are not the same;
-        ERR_DIMENSION_SIZE_MISMATCH     = The size of each dimension in both matrices do not match;
-        ERR_DATATYPE_MISMATCH           = The data types of both matrices do not match;
-        ERR_UNSUPPORTED_DATATYPE        = Unsupported data-type;
+        ERR_NONE            = No error.
+        ERR_NULL_PTR        = Matrix does not exist; Dimensions-array does not exist;
+        ERR_INVALID_ARGS    = Invalid number of dimensions; Invalid dimension-size (0);
+                              The size of the new data-buffer does not fit into a `size_t`;
+        ERR_MALLOC_FAILED   = Space allocation with `malloc` failed;
+        ERR_REALLOC_FAILED  = Growing the data-buffer failed;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported data-type;
+
+        If an error occurs, the matrix is not changed.
 
     */
 
-    ArithmeticOperationReturn response;
-    response.error_code = ERR_NONE;
-    response.result_matrix.head_ptr = NULL;
+    if (!matrix || !new_dimensions || !matrix->head_ptr) {
+        // Matrix/dimensions-array does not exist
+        return ERR_NULL_PTR;
+    }
 
-    if (!matrix_A || !matrix_B || !matrix_A->head_ptr || !matrix_B->head_ptr) {
-        // Wether `matrix_A` or `matrix_B` (or both) is a NULL-Pointer
-        response.error_code = ERR_NULL_PTR;
-        return response;
+    if (new_number_of_dimensions == 0) {
+        // Invalid number of dimensions
+        return ERR_INVALID_ARGS;
     }
 
-    // Check dimensions
-    if (matrix_A->head_ptr->number_of_dimensions != matrix_B->head_ptr->number_of_dimensions) {
-        // Cannot add two matrices with different dimensions
-        response.error_code = ERR_DIMENSION_COUNT_MISMATCH;
-        return response;
+    MultiDimensionalMatrixNode* node = matrix->head_ptr;
+    size_t element_size = get_data_type_size(node->data_type);
+
+    if (!element_size) {
+        // Unsupported Data-Type
+        return ERR_UNSUPPORTED_DATATYPE;
     }
 
-    for (size_t i = 0; i < matrix_A->head_ptr->number_of_dimensions; i++) {
-        if (matrix_A->head_ptr->dimensions[i] != matrix_B->head_ptr->dimensions[i]) {
-            // Mismatch
-            response.error_code = ERR_DIMENSION_SIZE_MISMATCH;
-            return response;
+    size_t new_total_size = 1;
+
+    for (size_t i = 0; i < new_number_of_dimensions; i++) {
+        if (new_dimensions[i] == 0) {
+            // Invalid dimension-size
+            return ERR_INVALID_ARGS;
+        }
+
+        if (!multiply_sizes(new_total_size, new_dimensions[i], &new_total_size)) {
+            // Number of elements overflows
+            return ERR_INVALID_ARGS;
         }
     }
-    
-    // Check data_type
-    if (matrix_A->head_ptr->data_type != matrix_B->head_ptr->data_type) {
+
+    size_t new_data_size;
+
+    if (!multiply_sizes(new_total_size, element_size, &new_data_size)) {
+        // Size of the data-buffer overflows
+        return ERR_INVALID_ARGS;
+    }
+
+    size_t old_number_of_dimensions = node->number_of_dimensions;
+
+    if (new_number_of_dimensions == old_number_of_dimensions &&
+        !memcmp(node->dimensions, new_dimensions, new_number_of_dimensions * sizeof(size_t))) {
+        // Nothing to change.
+        return ERR_NONE;
+    }
+
+    if (new_data_size != node->data_size) {
+        // The buffer of a mapped file cannot grow or shrink
+        ErrorCode error = detach_mapped_data(node);
+
+        if (error != ERR_NONE) {
+            return error;
+        }
+    }
+
+    size_t* dimensions = (size_t*) malloc(2 * new_number_of_dimensions * sizeof(size_t));
+
+    if (!dimensions) {
+        // Allocation-Error
+        return ERR_MALLOC_FAILED;
+    }
+
+    memcpy(dimensions, new_dimensions, new_number_of_dimensions * sizeof(size_t));
+    set_matrix_strides(dimensions + new_number_of_dimensions, new_dimensions, new_number_of_dimensions);
+
+    int only_first_dimension = new_number_of_dimensions == old_number_of_dimensions &&
+        !memcmp(node->dimensions + 1, new_dimensions + 1, (new_number_of_dimensions - 1) * sizeof(size_t));
+
+    if (new_data_size == node->data_size) {
+        // Reshape: the data-buffer stays as it is
+
+    } else if (only_first_dimension) {
+        // Row-major: the rows are appended to/removed from the end of the buffer
+        if (new_data_size > node->capacity) {
+            size_t new_capacity = 2 * node->capacity > new_data_size ? 2 * node->capacity : new_data_size;
+            void* data = realloc(node->data, new_capacity);
+
+            if (!data) {
+                // Reallocation-Error
+                free(dimensions);
+                return ERR_REALLOC_FAILED;
+            }
+
+            node->data = data;
+            node->capacity = new_capacity;
+        }
+
+        if (new_data_size > node->data_size) {
+            memset((char*)node->data + node->data_size, 0, new_data_size - node->data_size);
+        }
+
+    } else {
+        // Copy the overlapping part into a new buffer
+        char* data = (char*) calloc(new_total_size, element_size);
+        size_t* counters = (size_t*) calloc(3 * new_number_of_dimensions, sizeof(size_t));
+
+        if (!data || !counters) {
+            // Allocation-Error
+            free(data);
+            free(counters);
+            free(dimensions);
+            return ERR_MALLOC_FAILED;
+        }
+
+        size_t* overlap = counters + new_number_of_dimensions;
+        size_t* old_strides = overlap + new_number_of_dimensions;
+        size_t old_stride = 1;
+        size_t number_of_runs = 1;
+
+        // Align both shapes at the last dimension
+        for (size_t i = new_number_of_dimensions; i-- > 0;) {
+            size_t distance = new_number_of_dimensions - 1 - i;
+            size_t old_size = 1;
+
+            if (distance < old_number_of_dimensions) {
+                old_size = node->dimensions[old_number_of_dimensions - 1 - distance];
+                old_strides[i] = old_stride;
+                old_stride *= old_size;
+            }
+
+            overlap[i] = old_size < new_dimensions[i] ? old_size : new_dimensions[i];
+
+            if (i + 1 < new_number_of_dimensions) {
+                number_of_runs *= overlap[i];
+            }
+        }
+
+        // Copy one run of the last dimension at a time
+        size_t last = new_number_of_dimensions - 1;
+        size_t run_size = overlap[last] * element_size;
+
+        for (size_t run = 0; run < number_of_runs; run++) {
+            size_t old_index = 0, new_index = 0;
+
+            for (size_t i = 0; i < last; i++) {
+                old_index += counters[i] * old_strides[i];
+                new_index = new_index * new_dimensions[i] + counters[i];
+            }
+
+            memcpy(data + new_index * new_dimensions[last] * element_size,
+                   (char*)node->data + old_index * element_size, run_size);
+
+            for (size_t i = last; i-- > 0;) {
+                if (++counters[i] < overlap[i]) {
+                    break;
+                }
+                counters[i] = 0;
+            }
+        }
+
+        free(counters);
+        free(node->data);
+        node->data = data;
+        node->capacity = new_data_size;
+    }
+
+    free(node->dimensions);
+    node->dimensions = dimensions;
+    node->strides = dimensions + new_number_of_dimensions;
+    node->number_of_dimensions = new_number_of_dimensions;
+    node->data_size = new_data_size;
+
+    return ERR_NONE;
+}
+
+// Reserve space, so the first dimension can grow without reallocations.
+ErrorCode reserve_matrix_capacity(MultiDimensionalMatrix* matrix, size_t first_dimension_capacity) {
+    /*
+
+        After reserving, `resize_matrix` can grow the first dimension up to
+        `first_dimension_capacity` without moving the data-buffer.
+        The shape and the elements of the matrix are not changed; a mapped matrix is
+        copied into memory.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE            = No error.
+        ERR_NULL_PTR        = Matrix does not exist or head-pointer is NULL;
+        ERR_INVALID_ARGS    = The first dimension has the size `0` (no size per entry is known);
+                              The capacity in bytes does not fit into a `size_t`;
+        ERR_MALLOC_FAILED   = Copying a mapped matrix into memory failed;
+        ERR_REALLOC_FAILED  = Growing the data-buffer failed;
+
+    */
+
+    if (!matrix || !matrix->head_ptr || !matrix->head_ptr->data) {
+        // Matrix does not exist or head-pointer is NULL.
+        return ERR_NULL_PTR;
+    }
+
+    MultiDimensionalMatrixNode* node = matrix->head_ptr;
+
+    if (node->dimensions[0] == 0) {
+        // Bytes per entry of the first dimension are unknown
+        return ERR_INVALID_ARGS;
+    }
+
+    size_t first_dimension_size = node->data_size / node->dimensions[0];
+    size_t new_capacity;
+
+    if (!multiply_sizes(first_dimension_capacity, first_dimension_size, &new_capacity)) {
+        // Capacity overflows
+        return ERR_INVALID_ARGS;
+    }
+
+    if (new_capacity <= node->capacity) {
+        // Enough space reserved
+        return ERR_NONE;
+    }
+
+    ErrorCode error = detach_mapped_data(node);
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    void* data = realloc(node->data, new_capacity);
+
+    if (!data) {
+        // Reallocation-Error
+        return ERR_REALLOC_FAILED;
+    }
+
+    node->data = data;
+    node->capacity = new_capacity;
+
+    return ERR_NONE;
+}
+
+//
+// Data-type conversion
+//
+
+/*
+
+    Every conversion is a plain loop over `restrict`-pointers, which the compiler turns into
+    SIMD conversion instructions. Conversions between `TYPE_INT`, `TYPE_FLOAT` & `TYPE_DOUBLE`
+    and between `TYPE_FLOAT` and the 16-bit floating point types take a single pass. All
+    other pairs go through an intermediate block of `int64_t` (integer sources) or `double`
+    (floating point sources), which stays in the L1-cache.
+
+    Conversions from floating point to integer types always saturate: values outside of the
+    target's range are clamped and NaN becomes 0 (a C-cast would be undefined).
+
+*/
+
+// Elements converted per block, when the result overwrites the source buffer
+#define CONVERSION_BLOCK_SIZE 512
+
+typedef void (*ConversionKernel)(void* restrict destination, const void* restrict source, size_t count);
+
+// Kernels of one conversion: either `direct`, or `decode` into the intermediate and `encode` from it
+typedef struct Conversion {
+    ConversionKernel direct;
+    ConversionKernel decode;
+    ConversionKernel encode;
+} Conversion;
+
+#define ROUND_IDENTITY(value) (value)
+
+// Floating point to `int` with the given rounding-function.
+#define DEFINE_TO_INT_CONVERSION(NAME, SOURCE, ROUND)                                                   \
+static void NAME(void* restrict destination, const void* restrict source, size_t count) {               \
+    int* restrict result = (int*)destination;                                                           \
+    const SOURCE* restrict values = (const SOURCE*)source;                                              \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        SOURCE value = ROUND(values[i]);                                                                \
+        result[i] = value != value ? 0 :                                                                \
+                    value <= (SOURCE)INT_MIN ? INT_MIN :                                                \
+                    value >= -(SOURCE)INT_MIN ? INT_MAX : (int)value;                                   \
+    }                                                                                                   \
+}
+
+DEFINE_TO_INT_CONVERSION(convert_float_to_int, float, ROUND_IDENTITY)
+DEFINE_TO_INT_CONVERSION(convert_float_to_int_nearest, float, rintf)
+DEFINE_TO_INT_CONVERSION(convert_float_to_int_down, float, floorf)
+DEFINE_TO_INT_CONVERSION(convert_float_to_int_up, float, ceilf)
+DEFINE_TO_INT_CONVERSION(convert_double_to_int, double, ROUND_IDENTITY)
+DEFINE_TO_INT_CONVERSION(convert_double_to_int_nearest, double, rint)
+DEFINE_TO_INT_CONVERSION(convert_double_to_int_down, double, floor)
+DEFINE_TO_INT_CONVERSION(convert_double_to_int_up, double, ceil)
+
+// Conversions, which are exact or rounded to nearest by the hardware.
+#define DEFINE_CAST_CONVERSION(NAME, SOURCE, TARGET)                                                    \
+static void NAME(void* restrict destination, const void* restrict source, size_t count) {               \
+    TARGET* restrict result = (TARGET*)destination;                                                     \
+    const SOURCE* restrict values = (const SOURCE*)source;                                              \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        result[i] = (TARGET)values[i];                                                                  \
+    }                                                                                                   \
+}
+
+DEFINE_CAST_CONVERSION(convert_int_to_float, int, float)
+DEFINE_CAST_CONVERSION(convert_int_to_double, int, double)
+DEFINE_CAST_CONVERSION(convert_float_to_double, float, double)
+DEFINE_CAST_CONVERSION(convert_double_to_float, double, float)
+
+// `double` to `float`, finite values beyond the range of `float` become +/-FLT_MAX instead of infinity.
+static void convert_double_to_float_saturated(void* restrict destination, const void* restrict source, size_t count) {
+    float* restrict result = (float*)destination;
+    const double* restrict values = (const double*)source;
+
+    for (size_t i = 0; i < count; i++) {
+        double value = values[i];
+        value = value > FLT_MAX && value != INFINITY ? FLT_MAX : value;
+        value = value < -FLT_MAX && value != -INFINITY ? -FLT_MAX : value;
+        result[i] = (float)value;
+    }
+}
+
+// `float` to/from a 16-bit floating point type in a single pass.
+#define DEFINE_HALF_CONVERSIONS(NAME, STORAGE, LOAD, STORE)                                             \
+static void convert_float_to_##NAME(void* restrict destination, const void* restrict source, size_t count) { \
+    STORAGE* restrict result = (STORAGE*)destination;                                                   \
+    const float* restrict values = (const float*)source;                                                \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        result[i] = STORE(STORAGE, values[i]);                                                          \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+static void convert_##NAME##_to_float(void* restrict destination, const void* restrict source, size_t count) { \
+    float* restrict result = (float*)destination;                                                       \
+    const STORAGE* restrict values = (const STORAGE*)source;                                            \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        result[i] = LOAD(values[i]);                                                                    \
+    }                                                                                                   \
+}
+
+DEFINE_HALF_CONVERSIONS(fp16, fp16_t, LOAD_FP16, STORE_FP16)
+DEFINE_HALF_CONVERSIONS(bf16, bf16_t, LOAD_BF16, STORE_BF16)
+
+// Integer types: to/from the `int64_t` intermediate (wrapping or saturated) and from the `double` intermediate.
+#define DEFINE_INTEGER_CONVERSIONS(ENUM, NAME, STORAGE, MINIMUM, MAXIMUM)                               \
+static void decode_##NAME(void* restrict destination, const void* restrict source, size_t count) {      \
+    int64_t* restrict result = (int64_t*)destination;                                                   \
+    const STORAGE* restrict values = (const STORAGE*)source;                                            \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        result[i] = values[i];                                                                          \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+static void encode_int64_to_##NAME(void* restrict destination, const void* restrict source, size_t count) { \
+    STORAGE* restrict result = (STORAGE*)destination;                                                   \
+    const int64_t* restrict values = (const int64_t*)source;                                            \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        result[i] = (STORAGE)values[i];                                                                 \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+static void encode_int64_to_##NAME##_saturated(void* restrict destination, const void* restrict source, size_t count) { \
+    STORAGE* restrict result = (STORAGE*)destination;                                                   \
+    const int64_t* restrict values = (const int64_t*)source;                                            \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        int64_t value = values[i];                                                                      \
+        result[i] = value < (int64_t)(MINIMUM) ? (MINIMUM) : value > (int64_t)(MAXIMUM) ? (MAXIMUM) : (STORAGE)value; \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+DEFINE_DOUBLE_TO_INTEGER_CONVERSION(encode_double_to_##NAME, STORAGE, MINIMUM, MAXIMUM, ROUND_IDENTITY) \
+DEFINE_DOUBLE_TO_INTEGER_CONVERSION(encode_double_to_##NAME##_nearest, STORAGE, MINIMUM, MAXIMUM, rint) \
+DEFINE_DOUBLE_TO_INTEGER_CONVERSION(encode_double_to_##NAME##_down, STORAGE, MINIMUM, MAXIMUM, floor)   \
+DEFINE_DOUBLE_TO_INTEGER_CONVERSION(encode_double_to_##NAME##_up, STORAGE, MINIMUM, MAXIMUM, ceil)
+
+// `double` to an integer type with the given rounding-function (always saturated).
+#define DEFINE_DOUBLE_TO_INTEGER_CONVERSION(NAME, STORAGE, MINIMUM, MAXIMUM, ROUND)                     \
+static void NAME(void* restrict destination, const void* restrict source, size_t count) {               \
+    STORAGE* restrict result = (STORAGE*)destination;                                                   \
+    const double* restrict values = (const double*)source;                                              \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        double value = ROUND(values[i]);                                                                \
+        result[i] = value != value ? 0 :                                                                \
+                    value <= (double)(MINIMUM) ? (MINIMUM) :                                            \
+                    value >= (double)(MAXIMUM) ? (MAXIMUM) : (STORAGE)value;                            \
+    }                                                                                                   \
+}
+
+// Floating point types: to/from the `double` intermediate and from the `int64_t` intermediate.
+#define DEFINE_REAL_CONVERSIONS(ENUM, NAME, STORAGE, LOAD, STORE, MAXIMUM)                              \
+static void decode_##NAME(void* restrict destination, const void* restrict source, size_t count) {      \
+    double* restrict result = (double*)destination;                                                     \
+    const STORAGE* restrict values = (const STORAGE*)source;                                            \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        result[i] = LOAD(values[i]);                                                                    \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+static void encode_double_to_##NAME(void* restrict destination, const void* restrict source, size_t count) { \
+    STORAGE* restrict result = (STORAGE*)destination;                                                   \
+    const double* restrict values = (const double*)source;                                              \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        result[i] = STORE(STORAGE, values[i]);                                                          \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+/* Finite values beyond the range become +/-MAXIMUM instead of infinity */                              \
+static void encode_double_to_##NAME##_saturated(void* restrict destination, const void* restrict source, size_t count) { \
+    STORAGE* restrict result = (STORAGE*)destination;                                                   \
+    const double* restrict values = (const double*)source;                                              \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        double value = values[i];                                                                       \
+        value = value > (MAXIMUM) && value != INFINITY ? (MAXIMUM) : value;                             \
+        value = value < -(MAXIMUM) && value != -INFINITY ? -(MAXIMUM) : value;                          \
+        result[i] = STORE(STORAGE, value);                                                              \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+static void encode_int64_to_##NAME(void* restrict destination, const void* restrict source, size_t count) { \
+    STORAGE* restrict result = (STORAGE*)destination;                                                   \
+    const int64_t* restrict values = (const int64_t*)source;                                            \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        result[i] = STORE(STORAGE, values[i]);                                                          \
+    }                                                                                                   \
+}
+
+FOR_EACH_INTEGER_DATA_TYPE(DEFINE_INTEGER_CONVERSIONS)
+FOR_EACH_REAL_DATA_TYPE(DEFINE_REAL_CONVERSIONS)
+
+// Pick the conversion-kernels for the given data-types.
+static int select_conversion(Conversion* conversion, DataType source_type, DataType target_type, RoundingMode rounding, int saturate) {
+    /*
+
+        Returns 0 if the conversion is not supported (unknown data-type or rounding-mode).
+
+    */
+
+    #define INTEGER_DECODER_ENTRY(ENUM, NAME, STORAGE, MINIMUM, MAXIMUM) [ENUM] = decode_##NAME,
+    #define INTEGER_ENCODER_ENTRY(ENUM, NAME, STORAGE, MINIMUM, MAXIMUM) [ENUM] = encode_int64_to_##NAME,
+    #define SATURATED_INTEGER_ENCODER_ENTRY(ENUM, NAME, STORAGE, MINIMUM, MAXIMUM) [ENUM] = encode_int64_to_##NAME##_saturated,
+    #define ROUNDED_INTEGER_ENCODER_ENTRY(ENUM, NAME, STORAGE, MINIMUM, MAXIMUM) \
+        [ENUM] = { encode_double_to_##NAME, encode_double_to_##NAME##_nearest, encode_double_to_##NAME##_down, encode_double_to_##NAME##_up },
+    #define REAL_DECODER_ENTRY(ENUM, NAME, STORAGE, LOAD, STORE, MAXIMUM) [ENUM] = decode_##NAME,
+    #define REAL_ENCODER_ENTRY(ENUM, NAME, STORAGE, LOAD, STORE, MAXIMUM) [ENUM] = encode_double_to_##NAME,
+    #define SATURATED_REAL_ENCODER_ENTRY(ENUM, NAME, STORAGE, LOAD, STORE, MAXIMUM) [ENUM] = encode_double_to_##NAME##_saturated,
+    #define INTEGER_TO_REAL_ENCODER_ENTRY(ENUM, NAME, STORAGE, LOAD, STORE, MAXIMUM) [ENUM] = encode_int64_to_##NAME,
+
+    static const ConversionKernel decoders[NUMBER_OF_DATA_TYPES] = {
+        FOR_EACH_INTEGER_DATA_TYPE(INTEGER_DECODER_ENTRY)
+        FOR_EACH_REAL_DATA_TYPE(REAL_DECODER_ENTRY)
+    };
+    static const ConversionKernel integer_encoders[NUMBER_OF_DATA_TYPES] = {
+        FOR_EACH_INTEGER_DATA_TYPE(INTEGER_ENCODER_ENTRY)
+        FOR_EACH_REAL_DATA_TYPE(INTEGER_TO_REAL_ENCODER_ENTRY)
+    };
+    static const ConversionKernel saturated_integer_encoders[NUMBER_OF_DATA_TYPES] = {
+        FOR_EACH_INTEGER_DATA_TYPE(SATURATED_INTEGER_ENCODER_ENTRY)
+        FOR_EACH_REAL_DATA_TYPE(INTEGER_TO_REAL_ENCODER_ENTRY)
+    };
+    static const ConversionKernel rounded_encoders[NUMBER_OF_DATA_TYPES][4] = {
+        FOR_EACH_INTEGER_DATA_TYPE(ROUNDED_INTEGER_ENCODER_ENTRY)
+    };
+    static const ConversionKernel real_encoders[NUMBER_OF_DATA_TYPES] = {
+        FOR_EACH_REAL_DATA_TYPE(REAL_ENCODER_ENTRY)
+    };
+    static const ConversionKernel saturated_real_encoders[NUMBER_OF_DATA_TYPES] = {
+        FOR_EACH_REAL_DATA_TYPE(SATURATED_REAL_ENCODER_ENTRY)
+    };
+
+    #undef INTEGER_DECODER_ENTRY
+    #undef INTEGER_ENCODER_ENTRY
+    #undef SATURATED_INTEGER_ENCODER_ENTRY
+    #undef ROUNDED_INTEGER_ENCODER_ENTRY
+    #undef REAL_DECODER_ENTRY
+    #undef REAL_ENCODER_ENTRY
+    #undef SATURATED_REAL_ENCODER_ENTRY
+    #undef INTEGER_TO_REAL_ENCODER_ENTRY
+
+    ConversionKernel float_to_int[] = {convert_float_to_int, convert_float_to_int_nearest, convert_float_to_int_down, convert_float_to_int_up};
+    ConversionKernel double_to_int[] = {convert_double_to_int, convert_double_to_int_nearest, convert_double_to_int_down, convert_double_to_int_up};
+
+    conversion->direct = NULL;
+    conversion->decode = NULL;
+    conversion->encode = NULL;
+
+    if ((unsigned)source_type >= NUMBER_OF_DATA_TYPES || (unsigned)target_type >= NUMBER_OF_DATA_TYPES) {
+        // Unsupported Data-Type
+        return 0;
+    }
+
+    if (is_integer_data_type(target_type) && (rounding < ROUND_TOWARD_ZERO || rounding > ROUND_UP)) {
+        // Unknown rounding-mode
+        return 0;
+    }
+
+    // Single pass between the classic data-types and between `float` and the 16-bit types
+    switch(source_type) {
+        case TYPE_INT:
+            conversion->direct = target_type == TYPE_FLOAT ? convert_int_to_float :
+                                 target_type == TYPE_DOUBLE ? convert_int_to_double : NULL;
+            break;
+
+        case TYPE_FLOAT:
+            conversion->direct = target_type == TYPE_INT ? float_to_int[rounding] :
+                                 target_type == TYPE_DOUBLE ? convert_float_to_double :
+                                 target_type == TYPE_FP16 && !saturate ? convert_float_to_fp16 :
+                                 target_type == TYPE_BF16 && !saturate ? convert_float_to_bf16 : NULL;
+            break;
+
+        case TYPE_FP16:
+            conversion->direct = target_type == TYPE_FLOAT ? convert_fp16_to_float : NULL;
+            break;
+
+        case TYPE_BF16:
+            conversion->direct = target_type == TYPE_FLOAT ? convert_bf16_to_float : NULL;
+            break;
+
+        case TYPE_DOUBLE:
+            if (target_type == TYPE_FLOAT) {
+                conversion->direct = saturate ? convert_double_to_float_saturated : convert_double_to_float;
+            } else if (target_type == TYPE_INT) {
+                conversion->direct = double_to_int[rounding];
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    if (conversion->direct) {
+        return 1;
+    }
+
+    // Two stages over the intermediate
+    conversion->decode = decoders[source_type];
+
+    if (is_integer_data_type(source_type)) {
+        conversion->encode = saturate ? saturated_integer_encoders[target_type] : integer_encoders[target_type];
+    } else if (is_integer_data_type(target_type)) {
+        conversion->encode = rounded_encoders[target_type][rounding];
+    } else {
+        conversion->encode = saturate ? saturated_real_encoders[target_type] : real_encoders[target_type];
+    }
+
+    return conversion->decode && conversion->encode;
+}
+
+// Convert `count` elements of `source_size` bytes into `destination`.
+static void run_conversion(const Conversion* conversion, void* restrict destination, const void* restrict source,
+                           size_t count, size_t source_size, size_t target_size) {
+    if (conversion->direct) {
+        conversion->direct(destination, source, count);
+        return;
+    }
+
+    // `int64_t` or `double`
+    double intermediate[CONVERSION_BLOCK_SIZE];
+
+    for (size_t i = 0; i < count; i += CONVERSION_BLOCK_SIZE) {
+        size_t length = count - i < CONVERSION_BLOCK_SIZE ? count - i : CONVERSION_BLOCK_SIZE;
+
+        conversion->decode(intermediate, (const char*)source + i * source_size, length);
+        conversion->encode((char*)destination + i * target_size, intermediate, length);
+    }
+}
+
+// Change data type of given matrix.
+ErrorCode change_data_type(MultiDimensionalMatrix* matrix, DataType new_data_type) {
+    /*
+
+        Same as `convert_matrix_data_type` with `ROUND_TOWARD_ZERO` and without saturation:
+        floating point values are truncated toward zero, but always saturate at the range of
+        an integer type (NaN becomes 0); narrowed integers wrap around like a C-cast.
+
+        Returns an ErrorCode.
+
+        ERR_NONE            = No error.
+        ERR_NULL_PTR        = Matrix does not exist or head-pointer is NULL;
+        ERR_INVALID_ARGS    = Given new data_type equals the old one;
+
+        » For the other possible ErrorCodes, see what `convert_matrix_data_type` returns. «
+
+    */
+
+    return convert_matrix_data_type(matrix, new_data_type, ROUND_TOWARD_ZERO, 0);
+}
+
+// Convert the values of given matrix into another data-type.
+ErrorCode convert_matrix_data_type(MultiDimensionalMatrix* matrix, DataType new_data_type, RoundingMode rounding, int saturate) {
+    /*
+
+        `rounding` is used for floating point values, which are converted to an integer type.
+        These results always saturate at the range of the integer type (NaN becomes 0).
+        With `saturate`:
+          - integers, which don't fit into a smaller integer type, are clamped to its range
+            (otherwise they wrap around like a C-cast);
+          - finite floating point values beyond the range of a smaller floating point type
+            become its largest finite value (e.g. +/-FLT_MAX or +/-65504 for `TYPE_FP16`)
+            instead of +/-infinity.
+        `TYPE_FP16`/`TYPE_BF16` results are rounded to nearest (ties to even); from `TYPE_DOUBLE`
+        and `TYPE_INT64` they are rounded twice (first to `float`).
+
+        If the new element-size is not larger, the values are converted in place (in blocks)
+        and the buffer is shrunk afterwards. Otherwise they are converted in a single pass
+        into a new buffer. A mapped matrix is converted into a new buffer as well, the file
+        is not changed. Views of the matrix become invalid.
+
+        Returns an ErrorCode.
+
+        ERR_NONE                 = No error.
+        ERR_NULL_PTR             = Matrix does not exist or head-pointer is NULL;
+        ERR_INVALID_ARGS         = Given new data_type equals the old one; Unknown rounding-mode;
+        ERR_MALLOC_FAILED        = Space allocation with `malloc` failed;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported data-type;
+
+    */
+
+    if (!matrix || !matrix->head_ptr || !matrix->head_ptr->data) {
+        // Matrix does not exist or head-pointer is NULL.
+        return ERR_NULL_PTR;
+    }
+
+    MultiDimensionalMatrixNode* node = matrix->head_ptr;
+
+    if (new_data_type == node->data_type) {
+        // Nothing to change.
+        return ERR_INVALID_ARGS;
+    }
+
+    size_t old_element_size = get_data_type_size(node->data_type);
+    size_t new_element_size = get_data_type_size(new_data_type);
+
+    if (!old_element_size || !new_element_size) {
+        // Unsupported Data-Type
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    Conversion conversion;
+
+    if (!select_conversion(&conversion, node->data_type, new_data_type, rounding, saturate)) {
+        // Unknown rounding-mode
+        return ERR_INVALID_ARGS;
+    }
+
+    size_t total_elements = node->data_size / old_element_size;
+
+    if (new_element_size > old_element_size || node->storage != STORAGE_HEAP) {
+        // Single pass into a new buffer
+        void* data = malloc(total_elements > 0 ? total_elements * new_element_size : 1);
+
+        if (!data) {
+            // Allocation-Error
+            return ERR_MALLOC_FAILED;
+        }
+
+        run_conversion(&conversion, data, node->data, total_elements, old_element_size, new_element_size);
+
+        release_matrix_data(node);
+        node->data = data;
+        node->capacity = total_elements * new_element_size;
+    } else {
+        // In place: block `i` of the result ends before block `i + 1` of the source begins,
+        // so every block is converted into a buffer and copied back.
+        double block[CONVERSION_BLOCK_SIZE];
+        char* data = (char*)node->data;
+
+        for (size_t i = 0; i < total_elements; i += CONVERSION_BLOCK_SIZE) {
+            size_t count = total_elements - i < CONVERSION_BLOCK_SIZE ? total_elements - i : CONVERSION_BLOCK_SIZE;
+
+            run_conversion(&conversion, block, data + i * old_element_size, count, old_element_size, new_element_size);
+            memcpy(data + i * new_element_size, block, count * new_element_size);
+        }
+
+        if (new_element_size < old_element_size) {
+            // Give back the memory, which isn't needed anymore (a reservation shrinks with the elements)
+            size_t new_capacity = node->capacity / old_element_size * new_element_size;
+            void* shrunk = realloc(node->data, new_capacity > 0 ? new_capacity : 1);
+
+            if (shrunk) {
+                node->data = shrunk;
+                node->capacity = new_capacity;
+            }
+        }
+    }
+
+    node->data_type = new_data_type;
+    node->data_size = total_elements * new_element_size;
+
+    return ERR_NONE;
+}
+
+
+//
+// Bulk fill
+//
+
+/*
+
+    Every fill writes the elements of a matrix in row-major order, split into ranges of
+    elements, which are processed by several threads. Values and contiguous arrays of the
+    same data-type are written with `memset`/`memcpy` or a store-loop of the element-size.
+    Functions and strided sources walk their range row by row (runs along the last
+    dimension), so the coordinates are only divided once per range. Random elements only
+    depend on the seed and their linear index, so any split gives the same matrix.
+
+*/
+
+// Minimum number of elements per thread of a fill
+#define PARALLEL_FILL_CHUNK 65536
+
+// Minimum number of elements per thread of `fill_matrix_from_function` (the callback may be expensive)
+#define PARALLEL_FILL_FUNCTION_CHUNK 4096
+
+// Minimum number of elements per thread of `fill_matrix_random`
+#define PARALLEL_FILL_RANDOM_CHUNK 16384
+
+// Philox4x32-10 constants: multipliers and the Weyl-sequence of the key
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+#define PHILOX_ROUNDS 10
+
+// Philox-blocks, which are generated (and transformed) at once
+#define RANDOM_BATCH_BLOCKS 128
+
+// Store the element `value` into `count` consecutive elements.
+#define DEFINE_FILL_VALUE_LOOP(NAME, TYPE)                                                              \
+static void fill_##NAME##_elements(void* data, const void* value, size_t count) {                      \
+    TYPE* restrict elements = (TYPE*)data;                                                              \
+    TYPE element;                                                                                       \
+    memcpy(&element, value, sizeof(TYPE));                                                              \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        elements[i] = element;                                                                          \
+    }                                                                                                   \
+}
+
+// Copy `count` elements, which are `stride` elements apart in `source`, into `destination`.
+#define DEFINE_STRIDED_COPY_LOOP(NAME, TYPE)                                                            \
+static void copy_strided_##NAME##_elements(void* restrict destination, const void* restrict source, size_t stride, size_t count) { \
+    TYPE* result = (TYPE*)destination;                                                                  \
+    const TYPE* elements = (const TYPE*)source;                                                         \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        result[i] = elements[i * stride];                                                               \
+    }                                                                                                   \
+}
+
+// Single bytes are written with `memset`
+DEFINE_FILL_VALUE_LOOP(short, uint16_t)
+DEFINE_FILL_VALUE_LOOP(word, uint32_t)
+DEFINE_FILL_VALUE_LOOP(long, uint64_t)
+
+DEFINE_STRIDED_COPY_LOOP(byte, uint8_t)
+DEFINE_STRIDED_COPY_LOOP(short, uint16_t)
+DEFINE_STRIDED_COPY_LOOP(word, uint32_t)
+DEFINE_STRIDED_COPY_LOOP(long, uint64_t)
+
+typedef void (*FillValueLoop)(void* data, const void* value, size_t count);
+typedef void (*StridedCopyLoop)(void* restrict destination, const void* restrict source, size_t stride, size_t count);
+
+typedef enum FillSource {
+    FILL_VALUE,
+    FILL_FUNCTION,
+    FILL_ARRAY,
+    FILL_RANDOM
+} FillSource;
+
+// Random words of a batch of Philox-blocks, word `w` of block `i` is `words[w][i]`
+typedef struct PhiloxBatch {
+    uint32_t words[4][RANDOM_BATCH_BLOCKS];
+} PhiloxBatch;
+
+// Work of a parallel fill, shared by all threads.
+typedef struct FillTask {
+    FillSource source_kind;
+    char* data;
+    size_t element_size;
+    const size_t* dimensions;
+    size_t number_of_dimensions;
+
+    // `FILL_VALUE`
+    const void* value;
+    FillValueLoop value_loop;           // `NULL` if all bytes of the value are equal (`memset`)
+
+    // `FILL_FUNCTION`
+    MatrixFillFunction function;
+    void* context;
+
+    // `FILL_ARRAY`
+    const char* source;
+    size_t source_element_size;
+    const size_t* source_strides;       // `NULL` for a contiguous row-major source
+    StridedCopyLoop copy_loop;
+    Conversion conversion;
+    int convert;                        // The source has another data-type
+
+    // `FILL_RANDOM` (converted from the staging type with `conversion`)
+    RandomDistribution distribution;
+    uint64_t seed;
+    int wide_random;                    // 64 random bits per element (2 per block) instead of 32 (4 per block)
+    DataType staging_type;              // `float`, `double` or `int64_t` (uniform integers)
+    double random_first;                // Uniform: lower bound, normal: mean
+    double random_second;               // Uniform: width, normal: standard deviation
+    int64_t integer_low;                // Uniform integers are in [integer_low, integer_low + integer_range)
+    uint64_t integer_range;             // `0` means 2^64
+} FillTask;
+
+// Check the matrix of a fill and describe it in `task`.
+static ErrorCode init_fill_task(FillTask* task, MultiDimensionalMatrix* matrix, FillSource source_kind) {
+    if (!matrix || !matrix->head_ptr || !matrix->head_ptr->data) {
+        // Matrix does not exist
+        return ERR_NULL_PTR;
+    }
+
+    MultiDimensionalMatrixNode* node = matrix->head_ptr;
+
+    if (node->storage == STORAGE_MAPPED_READ_ONLY) {
+        // Writing would fault
+        return ERR_READ_ONLY;
+    }
+
+    task->element_size = get_data_type_size(node->data_type);
+
+    if (!task->element_size) {
+        // Unsupported Data-Type
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    task->source_kind = source_kind;
+    task->data = (char*)node->data;
+    task->dimensions = node->dimensions;
+    task->number_of_dimensions = node->number_of_dimensions;
+    task->source_strides = NULL;
+    task->convert = 0;
+
+    return ERR_NONE;
+}
+
+// Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3"): a block of
+// 128 random bits is a function of its 64-bit counter and the 64-bit seed only.
+static void generate_philox_batch(PhiloxBatch* batch, uint64_t first_block, size_t count, uint64_t seed) {
+    uint32_t* restrict x0 = batch->words[0];
+    uint32_t* restrict x1 = batch->words[1];
+    uint32_t* restrict x2 = batch->words[2];
+    uint32_t* restrict x3 = batch->words[3];
+    uint32_t key0 = (uint32_t)seed;
+    uint32_t key1 = (uint32_t)(seed >> 32);
+
+    for (size_t i = 0; i < count; i++) {
+        x0[i] = (uint32_t)(first_block + i);
+        x1[i] = (uint32_t)((first_block + i) >> 32);
+        x2[i] = 0;
+        x3[i] = 0;
+    }
+
+    // Lanes are independent blocks, so every round is one vectorized loop
+    for (int round = 0; round < PHILOX_ROUNDS; round++) {
+        for (size_t i = 0; i < count; i++) {
+            uint64_t product0 = (uint64_t)PHILOX_M0 * x0[i];
+            uint64_t product1 = (uint64_t)PHILOX_M1 * x2[i];
+            uint32_t y0 = (uint32_t)(product1 >> 32) ^ x1[i] ^ key0;
+            uint32_t y2 = (uint32_t)(product0 >> 32) ^ x3[i] ^ key1;
+
+            x1[i] = (uint32_t)product1;
+            x3[i] = (uint32_t)product0;
+            x0[i] = y0;
+            x2[i] = y2;
+        }
+
+        key0 += PHILOX_W0;
+        key1 += PHILOX_W1;
+    }
+}
+
+// 64 random bits of the element `slot` (0 or 1) of a block.
+static inline uint64_t philox_wide_word(const PhiloxBatch* batch, size_t block, size_t slot) {
+    return (uint64_t)batch->words[2 * slot][block] | (uint64_t)batch->words[2 * slot + 1][block] << 32;
+}
+
+// Upper 64 bits of `a * b`.
+static inline uint64_t multiply_high_64(uint64_t a, uint64_t b) {
+    uint64_t low_a = (uint32_t)a, high_a = a >> 32;
+    uint64_t low_b = (uint32_t)b, high_b = b >> 32;
+    uint64_t middle = (low_a * low_b >> 32) + (uint32_t)(high_a * low_b) + low_a * high_b;
+
+    return high_a * high_b + (high_a * low_b >> 32) + (middle >> 32);
+}
+
+// Random values of `blocks` blocks in element order (4 or 2 per block), in the staging type of the task.
+static void transform_random_batch(const FillTask* task, const PhiloxBatch* batch, size_t blocks, void* values) {
+    if (task->staging_type == TYPE_INT64) {
+        int64_t* restrict integers = (int64_t*)values;
+        uint64_t low = (uint64_t)task->integer_low;
+        uint64_t range = task->integer_range;
+
+        if (!task->wide_random) {
+            // `range` <= 2^32: the upper half of `word * range` is in [0, range)
+            for (size_t i = 0; i < blocks; i++) {
+                for (size_t s = 0; s < 4; s++) {
+                    integers[4 * i + s] = (int64_t)(low + ((uint64_t)batch->words[s][i] * range >> 32));
+                }
+            }
+        } else {
+            for (size_t i = 0; i < blocks; i++) {
+                for (size_t s = 0; s < 2; s++) {
+                    uint64_t word = philox_wide_word(batch, i, s);
+                    integers[2 * i + s] = (int64_t)(low + (range ? multiply_high_64(word, range) : word));
+                }
+            }
+        }
+        return;
+    }
+
+    if (task->staging_type == TYPE_FLOAT) {
+        float* restrict reals = (float*)values;
+        float first = (float)task->random_first;
+        float second = (float)task->random_second;
+
+        if (task->distribution == RANDOM_UNIFORM) {
+            for (size_t i = 0; i < blocks; i++) {
+                for (size_t s = 0; s < 4; s++) {
+                    reals[4 * i + s] = first + (float)(batch->words[s][i] >> 8) * 0x1.0p-24f * second;
+                }
+            }
+        } else {
+            // Box-Muller: two uniform values (words 0/1 and 2/3 of a block) give two normal ones
+            float radii[2 * RANDOM_BATCH_BLOCKS], turns[2 * RANDOM_BATCH_BLOCKS];
+
+            for (size_t i = 0; i < blocks; i++) {
+                for (size_t p = 0; p < 2; p++) {
+                    radii[2 * i + p] = (float)((batch->words[2 * p][i] >> 8) + 1) * 0x1.0p-24f;
+                    turns[2 * i + p] = (float)(batch->words[2 * p + 1][i] >> 8) * 0x1.0p-24f;
+                }
+            }
+
+            box_muller_float_kernel(reals, radii, turns, 2 * blocks, first, second);
+        }
+        return;
+    }
+
+    double* restrict reals = (double*)values;
+    double first = task->random_first;
+    double second = task->random_second;
+
+    if (task->distribution == RANDOM_UNIFORM) {
+        for (size_t i = 0; i < blocks; i++) {
+            for (size_t s = 0; s < 2; s++) {
+                reals[2 * i + s] = first + (double)(philox_wide_word(batch, i, s) >> 11) * 0x1.0p-53 * second;
+            }
+        }
+    } else {
+        double radii[RANDOM_BATCH_BLOCKS], turns[RANDOM_BATCH_BLOCKS];
+
+        for (size_t i = 0; i < blocks; i++) {
+            radii[i] = (double)((philox_wide_word(batch, i, 0) >> 11) + 1) * 0x1.0p-53;
+            turns[i] = (double)(philox_wide_word(batch, i, 1) >> 11) * 0x1.0p-53;
+        }
+
+        box_muller_double_kernel(reals, radii, turns, blocks, first, second);
+    }
+}
+
+// Write the random elements [begin, begin + count) to `data`.
+static void fill_random_range(const FillTask* task, char* data, size_t begin, size_t count) {
+    PhiloxBatch batch;
+    int64_t values[4 * RANDOM_BATCH_BLOCKS];    // Staging type (`float`, `double` or `int64_t`)
+    size_t per_block = task->wide_random ? 2 : 4;
+    size_t staging_size = get_data_type_size(task->staging_type);
+    uint64_t block = begin / per_block;
+    size_t skip = begin % per_block;            // Elements of the first block before `begin`
+
+    while (count > 0) {
+        size_t blocks = (skip + count + per_block - 1) / per_block;
+        blocks = blocks < RANDOM_BATCH_BLOCKS ? blocks : RANDOM_BATCH_BLOCKS;
+
+        generate_philox_batch(&batch, block, blocks, task->seed);
+        transform_random_batch(task, &batch, blocks, values);
+
+        size_t length = blocks * per_block - skip;
+        length = length < count ? length : count;
+        const char* source = (const char*)values + skip * staging_size;
+
+        if (task->convert) {
+            run_conversion(&task->conversion, data, source, length, staging_size, task->element_size);
+        } else {
+            memcpy(data, source, length * task->element_size);
+        }
+
+        data += length * task->element_size;
+        count -= length;
+        block += blocks;
+        skip = 0;
+    }
+}
+
+// Write a run of `count` elements of a strided source, which starts at the coordinates `indices`.
+static void fill_strided_run(const FillTask* task, char* destination, const size_t* indices, size_t count) {
+    size_t offset = 0;
+
+    for (size_t j = 0; j < task->number_of_dimensions; j++) {
+        offset += indices[j] * task->source_strides[j];
+    }
+
+    const char* source = task->source + offset * task->source_element_size;
+    size_t stride = task->source_strides[task->number_of_dimensions - 1];
+
+    if (!task->convert) {
+        task->copy_loop(destination, source, stride, count);
+        return;
+    }
+
+    if (stride == 1) {
+        run_conversion(&task->conversion, destination, source, count, task->source_element_size, task->element_size);
+        return;
+    }
+
+    // Gather a block of the source, then convert it
+    double block[CONVERSION_BLOCK_SIZE];
+
+    for (size_t i = 0; i < count; i += CONVERSION_BLOCK_SIZE) {
+        size_t length = count - i < CONVERSION_BLOCK_SIZE ? count - i : CONVERSION_BLOCK_SIZE;
+
+        task->copy_loop(block, source + i * stride * task->source_element_size, stride, length);
+        run_conversion(&task->conversion, destination + i * task->element_size, block, length,
+                       task->source_element_size, task->element_size);
+    }
+}
+
+// Parallel task: fill the elements [begin, end).
+static void fill_element_range(void* context, size_t begin, size_t end) {
+    const FillTask* task = (const FillTask*)context;
+    char* data = task->data + begin * task->element_size;
+    size_t count = end - begin;
+
+    if (task->source_kind == FILL_VALUE) {
+        if (task->value_loop) {
+            task->value_loop(data, task->value, count);
+        } else {
+            memset(data, *(const unsigned char*)task->value, count * task->element_size);
+        }
+        return;
+    }
+
+    if (task->source_kind == FILL_RANDOM) {
+        fill_random_range(task, data, begin, count);
+        return;
+    }
+
+    if (task->source_kind == FILL_ARRAY && !task->source_strides) {
+        const char* source = task->source + begin * task->source_element_size;
+
+        if (task->convert) {
+            run_conversion(&task->conversion, data, source, count, task->source_element_size, task->element_size);
+        } else {
+            memcpy(data, source, count * task->element_size);
+        }
+        return;
+    }
+
+    // Coordinates of the first element
+    size_t indices[MAX_VIEW_DIMENSIONS];
+    size_t last = task->number_of_dimensions - 1;
+    size_t rest = begin;
+
+    for (size_t j = task->number_of_dimensions; j-- > 0;) {
+        indices[j] = rest % task->dimensions[j];
+        rest /= task->dimensions[j];
+    }
+
+    for (size_t position = begin; position < end;) {
+        size_t length = task->dimensions[last] - indices[last];
+        length = length < end - position ? length : end - position;
+
+        char* destination = task->data + position * task->element_size;
+
+        if (task->source_kind == FILL_FUNCTION) {
+            task->function(destination, length, indices, task->context);
+        } else {
+            fill_strided_run(task, destination, indices, length);
+        }
+
+        position += length;
+
+        // Carry into the next row
+        indices[last] += length;
+
+        for (size_t j = last; j > 0 && indices[j] == task->dimensions[j]; j--) {
+            indices[j] = 0;
+            indices[j - 1]++;
+        }
+    }
+}
+
+// Distribute the elements of a fill over the threads.
+static void run_fill_task(FillTask* task, size_t minimum_chunk) {
+    size_t total_elements = 1;
+
+    for (size_t j = 0; j < task->number_of_dimensions; j++) {
+        total_elements *= task->dimensions[j];
+    }
+
+    if (total_elements > 0) {
+        parallel_for(total_elements, minimum_chunk, fill_element_range, task);
+    }
+}
+
+// Set every element of given matrix to the same value.
+ErrorCode fill_matrix_with_value(MultiDimensionalMatrix* matrix, const void* value) {
+    /*
+
+        `value` points to one element of the data-type of the matrix.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                 = No error.
+        ERR_NULL_PTR             = Matrix/Value does not exist;
+        ERR_READ_ONLY            = The matrix is a read-only mapping of a file;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported data-type;
+
+    */
+
+    if (!value) {
+        // Value does not exist
+        return ERR_NULL_PTR;
+    }
+
+    FillTask task;
+    ErrorCode error = init_fill_task(&task, matrix, FILL_VALUE);
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    task.value = value;
+    task.value_loop = NULL;
+
+    // Values like 0 or -1 (all bytes equal) are written with `memset`
+    const unsigned char* bytes = (const unsigned char*)value;
+
+    for (size_t i = 1; i < task.element_size; i++) {
+        if (bytes[i] != bytes[0]) {
+            task.value_loop = task.element_size == 2 ? fill_short_elements :
+                              task.element_size == 4 ? fill_word_elements : fill_long_elements;
+            break;
+        }
+    }
+
+    run_fill_task(&task, PARALLEL_FILL_CHUNK);
+
+    return ERR_NONE;
+}
+
+// Fill given matrix with values, which are computed by a function.
+ErrorCode fill_matrix_from_function(MultiDimensionalMatrix* matrix, MatrixFillFunction function, void* context) {
+    /*
+
+        `function(elements, count, indices, context)` writes `count` consecutive elements of a
+        row: `indices` are the coordinates of the first one, the others follow along the last
+        dimension (a row may be split into several calls). The function is called by several
+        threads at the same time, each call writes different elements.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                 = No error.
+        ERR_NULL_PTR             = Matrix/Function does not exist;
+        ERR_INVALID_ARGS         = The matrix has more than `MAX_VIEW_DIMENSIONS` dimensions;
+        ERR_READ_ONLY            = The matrix is a read-only mapping of a file;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported data-type;
+
+    */
+
+    if (!function) {
+        // Function does not exist
+        return ERR_NULL_PTR;
+    }
+
+    FillTask task;
+    ErrorCode error = init_fill_task(&task, matrix, FILL_FUNCTION);
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    if (task.number_of_dimensions > MAX_VIEW_DIMENSIONS) {
+        // Too many coordinates
+        return ERR_INVALID_ARGS;
+    }
+
+    task.function = function;
+    task.context = context;
+
+    run_fill_task(&task, PARALLEL_FILL_FUNCTION_CHUNK);
+
+    return ERR_NONE;
+}
+
+// Fill given matrix from an array of any data-type and layout.
+ErrorCode fill_matrix_from_array(MultiDimensionalMatrix* matrix, const void* source, DataType source_type, const size_t* source_strides) {
+    /*
+
+        `source` holds elements of `source_type`, which are converted like in
+        `change_data_type` if it differs from the data-type of the matrix. The element at
+        the coordinates `indices` is read from `source[sum(indices[j] * source_strides[j])]`
+        (strides in elements, one per dimension of the matrix). Without `source_strides` the
+        source has the shape of the matrix and is contiguous (row-major), then the elements
+        are copied (or converted) in one pass. The source must not overlap the matrix.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                 = No error.
+        ERR_NULL_PTR             = Matrix/Source does not exist;
+        ERR_INVALID_ARGS         = Strided source and more than `MAX_VIEW_DIMENSIONS` dimensions;
+        ERR_READ_ONLY            = The matrix is a read-only mapping of a file;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported data-type (of the matrix or the source);
+
+    */
+
+    if (!source) {
+        // Source does not exist
+        return ERR_NULL_PTR;
+    }
+
+    FillTask task;
+    ErrorCode error = init_fill_task(&task, matrix, FILL_ARRAY);
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    task.source = (const char*)source;
+    task.source_element_size = get_data_type_size(source_type);
+    task.source_strides = source_strides;
+
+    if (!task.source_element_size) {
+        // Unsupported Data-Type
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    if (source_type != matrix->head_ptr->data_type) {
+        task.convert = 1;
+
+        if (!select_conversion(&task.conversion, source_type, matrix->head_ptr->data_type, ROUND_TOWARD_ZERO, 0)) {
+            return ERR_UNSUPPORTED_DATATYPE;
+        }
+    }
+
+    if (source_strides) {
+        if (task.number_of_dimensions > MAX_VIEW_DIMENSIONS) {
+            // Too many coordinates
+            return ERR_INVALID_ARGS;
+        }
+
+        // Elements are gathered with the size of the source
+        switch(task.source_element_size) {
+            case 1: task.copy_loop = copy_strided_byte_elements; break;
+            case 2: task.copy_loop = copy_strided_short_elements; break;
+            case 4: task.copy_loop = copy_strided_word_elements; break;
+            default: task.copy_loop = copy_strided_long_elements; break;
+        }
+    }
+
+    run_fill_task(&task, PARALLEL_FILL_CHUNK);
+
+    return ERR_NONE;
+}
+
+// Fill given matrix with random numbers of a distribution.
+ErrorCode fill_matrix_random(MultiDimensionalMatrix* matrix, RandomDistribution distribution, double first, double second, uint64_t seed) {
+    /*
+
+        RANDOM_UNIFORM = Reals in [first, second) (narrow types may round up to `second`),
+                         integers in [ceil(first), floor(second)] (clamped to the data-type);
+        RANDOM_NORMAL  = Mean `first` and standard deviation `second` (Box-Muller); integers
+                         are rounded to nearest and saturated.
+
+        The elements are generated by the counter-based Philox4x32-10 generator: element `i`
+        (row-major) only depends on `seed` and `i`, so the result is the same for every number
+        of threads. `double`, `int` and `int64_t` use 64 random bits per element, the other
+        data-types 32. Matrices with the same seed start with the same values.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                 = No error.
+        ERR_NULL_PTR             = Matrix does not exist;
+        ERR_INVALID_ARGS         = Unknown distribution; Parameters aren't finite; `second` < `first`
+                                   (uniform) or `second` < 0 (normal); No integer in the range;
+        ERR_READ_ONLY            = The matrix is a read-only mapping of a file;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported data-type;
+
+    */
+
+    FillTask task;
+    ErrorCode error = init_fill_task(&task, matrix, FILL_RANDOM);
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    if ((distribution != RANDOM_UNIFORM && distribution != RANDOM_NORMAL) || !isfinite(first) || !isfinite(second) ||
+        (distribution == RANDOM_UNIFORM ? second < first || !isfinite(second - first) : second < 0.0)) {
+        // Invalid distribution or parameters
+        return ERR_INVALID_ARGS;
+    }
+
+    DataType data_type = matrix->head_ptr->data_type;
+
+    task.distribution = distribution;
+    task.seed = seed;
+    task.wide_random = data_type == TYPE_DOUBLE || data_type == TYPE_INT || data_type == TYPE_INT64;
+    task.staging_type = task.wide_random ? TYPE_DOUBLE : TYPE_FLOAT;
+    task.random_first = first;
+    task.random_second = distribution == RANDOM_UNIFORM ? second - first : second;
+
+    if (distribution == RANDOM_UNIFORM && is_integer_data_type(data_type)) {
+        int64_t minimum = 0, maximum = 0;
+
+        #define INTEGER_RANGE_CASE(ENUM, NAME, STORAGE, MINIMUM, MAXIMUM) \
+            case ENUM: minimum = (int64_t)(MINIMUM); maximum = (int64_t)(MAXIMUM); break;
+
+        switch(data_type) {
+            FOR_EACH_INTEGER_DATA_TYPE(INTEGER_RANGE_CASE)
+            default: break;
+        }
+
+        #undef INTEGER_RANGE_CASE
+
+        double low = ceil(first), high = floor(second);
+
+        if (low > high) {
+            // No integer in [first, second]
+            return ERR_INVALID_ARGS;
+        }
+
+        task.integer_low = low <= (double)minimum ? minimum : low >= (double)maximum ? maximum : (int64_t)low;
+        int64_t integer_high = high <= (double)minimum ? minimum : high >= (double)maximum ? maximum : (int64_t)high;
+        task.integer_range = (uint64_t)integer_high - (uint64_t)task.integer_low + 1;
+        task.staging_type = TYPE_INT64;
+    }
+
+    if (task.staging_type != data_type) {
+        task.convert = 1;
+
+        if (!select_conversion(&task.conversion, task.staging_type, data_type, ROUND_TO_NEAREST, 0)) {
+            return ERR_UNSUPPORTED_DATATYPE;
+        }
+    }
+
+    run_fill_task(&task, PARALLEL_FILL_RANDOM_CHUNK);
+
+    return ERR_NONE;
+}
+
+
+//
+// Strided iteration
+//
+
+/*
+
+    Shared machinery of all element-wise operations on views.
+
+    Operand `0` is always the output, the remaining operands are inputs. All operands
+    share one shape; the strides are stored in bytes, so a stride of `0` repeats the
+    same element (used for scalars). Before iterating, size-1 dimensions are dropped and
+    neighbouring dimensions, which every operand walks as one block, are merged. A fully
+    contiguous tensor therefore becomes a single call of the inner loop.
+
+*/
+
+#define MAX_STRIDED_OPERANDS (1 + MAX_EXPRESSION_INPUTS)
+
+typedef struct StridedOperands {
+    size_t number_of_operands;
+    size_t number_of_dimensions;
+    size_t dimensions[MAX_VIEW_DIMENSIONS];
+    char* data[MAX_STRIDED_OPERANDS];
+    size_t strides[MAX_STRIDED_OPERANDS][MAX_VIEW_DIMENSIONS];
+} StridedOperands;
+
+// Processes one innermost row of `count` elements; operand `i` advances by `strides[i]` bytes.
+typedef void (*StridedInnerLoop)(char** data, const size_t* strides, size_t count, const void* context);
+
+typedef enum BinaryOperation {
+    BINARY_ADD,
+    BINARY_MULTIPLY
+} BinaryOperation;
+
+
+// Initialize the operand-list with the shape of the iteration.
+static void init_strided_operands(StridedOperands* operands, const MatrixView* shape) {
+    operands->number_of_operands = 0;
+    operands->number_of_dimensions = shape->number_of_dimensions;
+    memcpy(operands->dimensions, shape->dimensions, shape->number_of_dimensions * sizeof(size_t));
+}
+
+// Append a view as an operand.
+static void add_view_operand(StridedOperands* operands, const MatrixView* view) {
+    size_t element_size = get_data_type_size(view->data_type);
+    size_t operand = operands->number_of_operands++;
+
+    operands->data[operand] = (char*)view->parent->data + view->offset * element_size;
+
+    for (size_t i = 0; i < operands->number_of_dimensions; i++) {
+        operands->strides[operand][i] = view->strides[i] * element_size;
+    }
+}
+
+// Append a single value as an operand, which is repeated for every element.
+static void add_scalar_operand(StridedOperands* operands, void* scalar) {
+    size_t operand = operands->number_of_operands++;
+
+    operands->data[operand] = (char*)scalar;
+
+    for (size_t i = 0; i < operands->number_of_dimensions; i++) {
+        operands->strides[operand][i] = 0;
+    }
+}
+
+// Drop size-1 dimensions and merge neighbouring dimensions, which are contiguous for every operand.
+static void coalesce_strided_dimensions(StridedOperands* operands) {
+    size_t count = 0;
+
+    for (size_t i = 0; i < operands->number_of_dimensions; i++) {
+        if (operands->dimensions[i] == 1) {
+            continue;
+        }
+        operands->dimensions[count] = operands->dimensions[i];
+        for (size_t op = 0; op < operands->number_of_operands; op++) {
+            operands->strides[op][count] = operands->strides[op][i];
+        }
+        count++;
+    }
+
+    if (count == 0) {
+        // Single element
+        operands->dimensions[0] = 1;
+        for (size_t op = 0; op < operands->number_of_operands; op++) {
+            operands->strides[op][0] = 0;
+        }
+        operands->number_of_dimensions = 1;
+        return;
+    }
+
+    size_t merged = 0;
+
+    for (size_t i = 1; i < count; i++) {
+        int mergeable = 1;
+
+        for (size_t op = 0; op < operands->number_of_operands; op++) {
+            if (operands->strides[op][merged] != operands->strides[op][i] * operands->dimensions[i]) {
+                mergeable = 0;
+                break;
+            }
+        }
+
+        if (mergeable) {
+            operands->dimensions[merged] *= operands->dimensions[i];
+        } else {
+            merged++;
+            operands->dimensions[merged] = operands->dimensions[i];
+        }
+
+        for (size_t op = 0; op < operands->number_of_operands; op++) {
+            operands->strides[op][merged] = operands->strides[op][i];
+        }
+    }
+
+    operands->number_of_dimensions = merged + 1;
+}
+
+// Call `inner_loop` for every innermost row of the operands.
+static void run_strided_loop(StridedOperands* operands, StridedInnerLoop inner_loop, const void* context) {
+    for (size_t i = 0; i < operands->number_of_dimensions; i++) {
+        if (operands->dimensions[i] == 0) {
+            // Nothing to iterate
+            return;
+        }
+    }
+
+    coalesce_strided_dimensions(operands);
+
+    size_t inner_dimension = operands->number_of_dimensions - 1;
+    size_t counters[MAX_VIEW_DIMENSIONS] = {0};
+    size_t inner_strides[MAX_STRIDED_OPERANDS];
+    char* pointers[MAX_STRIDED_OPERANDS];
+
+    for (size_t op = 0; op < operands->number_of_operands; op++) {
+        pointers[op] = operands->data[op];
+        inner_strides[op] = operands->strides[op][inner_dimension];
+    }
+
+    for (;;) {
+        inner_loop(pointers, inner_strides, operands->dimensions[inner_dimension], context);
+
+        // Advance the outer dimensions like an odometer
+        size_t dimension = inner_dimension;
+
+        for (;;) {
+            if (dimension == 0) {
+                // Every outer dimension wrapped around
+                return;
+            }
+            dimension--;
+
+            counters[dimension]++;
+            for (size_t op = 0; op < operands->number_of_operands; op++) {
+                pointers[op] += operands->strides[op][dimension];
+            }
+
+            if (counters[dimension] < operands->dimensions[dimension]) {
+                break;
+            }
+
+            for (size_t op = 0; op < operands->number_of_operands; op++) {
+                pointers[op] -= operands->strides[op][dimension] * operands->dimensions[dimension];
+            }
+            counters[dimension] = 0;
+        }
+    }
+}
+
+// Inner loop for `out = a OPERATOR b` with fast paths for contiguous and scalar operands.
+#define DEFINE_BINARY_LOOP(NAME, STORAGE, COMPUTE, LOAD, STORE, OPERATOR)                               \
+static void NAME(char** data, const size_t* strides, size_t count, const void* context) {              \
+    (void)context;                                                                                      \
+    STORAGE* out = (STORAGE*)data[0];                                                                   \
+    const STORAGE* a = (const STORAGE*)data[1];                                                         \
+    const STORAGE* b = (const STORAGE*)data[2];                                                         \
+    if (strides[0] == sizeof(STORAGE) && strides[1] == sizeof(STORAGE) && strides[2] == sizeof(STORAGE)) { \
+        for (size_t i = 0; i < count; i++) {                                                            \
+            out[i] = STORE(STORAGE, LOAD(a[i]) OPERATOR LOAD(b[i]));                                    \
+        }                                                                                               \
+    } else if (strides[0] == sizeof(STORAGE) && strides[1] == sizeof(STORAGE) && strides[2] == 0) {     \
+        const COMPUTE scalar = LOAD(*b);                                                                \
+        for (size_t i = 0; i < count; i++) {                                                            \
+            out[i] = STORE(STORAGE, LOAD(a[i]) OPERATOR scalar);                                        \
+        }                                                                                               \
+    } else if (strides[0] == sizeof(STORAGE) && strides[1] == 0 && strides[2] == sizeof(STORAGE)) {     \
+        const COMPUTE scalar = LOAD(*a);                                                                \
+        for (size_t i = 0; i < count; i++) {                                                            \
+            out[i] = STORE(STORAGE, scalar OPERATOR LOAD(b[i]));                                        \
+        }                                                                                               \
+    } else {                                                                                            \
+        char* out_bytes = data[0];                                                                      \
+        const char* a_bytes = data[1];                                                                  \
+        const char* b_bytes = data[2];                                                                  \
+        for (size_t i = 0; i < count; i++) {                                                            \
+            *(STORAGE*)out_bytes = STORE(STORAGE, LOAD(*(const STORAGE*)a_bytes) OPERATOR LOAD(*(const STORAGE*)b_bytes)); \
+            out_bytes += strides[0];                                                                    \
+            a_bytes += strides[1];                                                                      \
+            b_bytes += strides[2];                                                                      \
+        }                                                                                               \
+    }                                                                                                   \
+}
+
+// Inner loop for `out = in`.
+#define DEFINE_COPY_LOOP(NAME, TYPE)                                                                    \
+static void NAME(char** data, const size_t* strides, size_t count, const void* context) {              \
+    (void)context;                                                                                      \
+    if (strides[0] == sizeof(TYPE) && strides[1] == sizeof(TYPE)) {                                     \
+        memcpy(data[0], data[1], count * sizeof(TYPE));                                                 \
+        return;                                                                                         \
+    }                                                                                                   \
+    char* out_bytes = data[0];                                                                          \
+    const char* in_bytes = data[1];                                                                     \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        *(TYPE*)out_bytes = *(const TYPE*)in_bytes;                                                     \
+        out_bytes += strides[0];                                                                        \
+        in_bytes += strides[1];                                                                         \
+    }                                                                                                   \
+}
+
+// Element-wise loops of one data-type (see `FOR_EACH_DATA_TYPE`)
+#define DEFINE_ELEMENTWISE_LOOPS(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE)                             \
+    DEFINE_BINARY_LOOP(add_##NAME##_loop, STORAGE, COMPUTE, LOAD, STORE, +)                             \
+    DEFINE_BINARY_LOOP(multiply_##NAME##_loop, STORAGE, COMPUTE, LOAD, STORE, *)                        \
+    DEFINE_COPY_LOOP(copy_##NAME##_loop, STORAGE)
+
+FOR_EACH_DATA_TYPE(DEFINE_ELEMENTWISE_LOOPS)
+
+// Pick the inner loop of a binary operation for the given data-type.
+static StridedInnerLoop select_binary_loop(BinaryOperation operation, DataType data_type) {
+    /*
+
+        Returns NULL if the data-type or the operation is not supported.
+
+    */
+
+    #define BINARY_LOOP_CASE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE) \
+        case ENUM: return operation == BINARY_ADD ? add_##NAME##_loop : multiply_##NAME##_loop;
+
+    switch(data_type) {
+        FOR_EACH_DATA_TYPE(BINARY_LOOP_CASE)
+
+        default:
+            // Unsupported Data-Type
+            return NULL;
+    }
+
+    #undef BINARY_LOOP_CASE
+}
+
+// Pick the copy loop for the given data-type.
+static StridedInnerLoop select_copy_loop(DataType data_type) {
+    #define COPY_LOOP_CASE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE) case ENUM: return copy_##NAME##_loop;
+
+    switch(data_type) {
+        FOR_EACH_DATA_TYPE(COPY_LOOP_CASE)
+
+        default:
+            // Unsupported Data-Type
+            return NULL;
+    }
+
+    #undef COPY_LOOP_CASE
+}
+
+// `result = A * B` for two strided 2-D operands, the rows of `result` are `row_stride_C` elements apart.
+#define DEFINE_MATMUL_KERNEL(NAME, TYPE)                                                                \
+static void NAME(void* result, const void* data_A, const void* data_B,                                  \
+                 size_t rows_A, size_t cols_A, size_t cols_B,                                           \
+                 size_t row_stride_A, size_t col_stride_A, size_t row_stride_B, size_t col_stride_B,    \
+                 size_t row_stride_C) {                                                                 \
+    TYPE* C = (TYPE*)result;                                                                            \
+    const TYPE* A = (const TYPE*)data_A;                                                                \
+    const TYPE* B = (const TYPE*)data_B;                                                                \
+    /* i-k-j order: the innermost loop streams through one row of B and C */                            \
+    for (size_t i = 0; i < rows_A; i++) {                                                               \
+        TYPE* c_row = C + i * row_stride_C;                                                             \
+        memset(c_row, 0, cols_B * sizeof(TYPE));                                                        \
+        for (size_t k = 0; k < cols_A; k++) {                                                           \
+            const TYPE a = A[i * row_stride_A + k * col_stride_A];                                      \
+            const TYPE* b_row = B + k * row_stride_B;                                                   \
+            if (col_stride_B == 1) {                                                                    \
+                for (size_t j = 0; j < cols_B; j++) {                                                   \
+                    c_row[j] += a * b_row[j];                                                           \
+                }                                                                                       \
+            } else {                                                                                    \
+                for (size_t j = 0; j < cols_B; j++) {                                                   \
+                    c_row[j] += a * b_row[j * col_stride_B];                                            \
+                }                                                                                       \
+            }                                                                                           \
+        }                                                                                               \
+    }                                                                                                   \
+}
+
+// Columns of a result row, which the converting kernel accumulates at once
+#define MATMUL_ROW_BLOCK 256
+
+// Matmul-kernel for types, which are stored in another type than they are computed in:
+// blocks of each result row are accumulated in `COMPUTE` and rounded once at the end.
+#define DEFINE_CONVERTING_MATMUL_KERNEL(NAME, STORAGE, COMPUTE, LOAD, STORE)                            \
+static void NAME(void* result, const void* data_A, const void* data_B,                                  \
+                 size_t rows_A, size_t cols_A, size_t cols_B,                                           \
+                 size_t row_stride_A, size_t col_stride_A, size_t row_stride_B, size_t col_stride_B,    \
+                 size_t row_stride_C) {                                                                 \
+    STORAGE* C = (STORAGE*)result;                                                                      \
+    const STORAGE* A = (const STORAGE*)data_A;                                                          \
+    const STORAGE* B = (const STORAGE*)data_B;                                                          \
+    COMPUTE sums[MATMUL_ROW_BLOCK];                                                                     \
+    for (size_t i = 0; i < rows_A; i++) {                                                               \
+        for (size_t start = 0; start < cols_B; start += MATMUL_ROW_BLOCK) {                             \
+            size_t length = cols_B - start < MATMUL_ROW_BLOCK ? cols_B - start : MATMUL_ROW_BLOCK;      \
+            for (size_t j = 0; j < length; j++) {                                                       \
+                sums[j] = 0;                                                                            \
+            }                                                                                           \
+            for (size_t k = 0; k < cols_A; k++) {                                                       \
+                const COMPUTE a = LOAD(A[i * row_stride_A + k * col_stride_A]);                         \
+                const STORAGE* b_row = B + k * row_stride_B + start * col_stride_B;                     \
+                for (size_t j = 0; j < length; j++) {                                                   \
+                    sums[j] += a * LOAD(b_row[j * col_stride_B]);                                       \
+                }                                                                                       \
+            }                                                                                           \
+            STORAGE* c_row = C + i * row_stride_C + start;                                              \
+            for (size_t j = 0; j < length; j++) {                                                       \
+                c_row[j] = STORE(STORAGE, sums[j]);                                                     \
+            }                                                                                           \
+        }                                                                                               \
+    }                                                                                                   \
+}
+
+// Same as the matmul-kernel, but every result element is summed in a register (for small matrices).
+#define DEFINE_SMALL_MATMUL_KERNEL(NAME, STORAGE, COMPUTE, LOAD, STORE)                                 \
+static void NAME(void* result, const void* data_A, const void* data_B,                                  \
+                 size_t rows_A, size_t cols_A, size_t cols_B,                                           \
+                 size_t row_stride_A, size_t col_stride_A, size_t row_stride_B, size_t col_stride_B,    \
+                 size_t row_stride_C) {                                                                 \
+    STORAGE* C = (STORAGE*)result;                                                                      \
+    const STORAGE* A = (const STORAGE*)data_A;                                                          \
+    const STORAGE* B = (const STORAGE*)data_B;                                                          \
+    for (size_t i = 0; i < rows_A; i++) {                                                               \
+        for (size_t j = 0; j < cols_B; j++) {                                                           \
+            COMPUTE sum = 0;                                                                            \
+            for (size_t k = 0; k < cols_A; k++) {                                                       \
+                sum += LOAD(A[i * row_stride_A + k * col_stride_A]) * LOAD(B[k * row_stride_B + j * col_stride_B]); \
+            }                                                                                           \
+            C[i * row_stride_C + j] = STORE(STORAGE, sum);                                              \
+        }                                                                                               \
+    }                                                                                                   \
+}
+
+// Direct types accumulate in the result, 16-bit floating point types in `float`
+#define DEFINE_DIRECT_MATMUL_KERNELS(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE)                         \
+    DEFINE_MATMUL_KERNEL(matmul_##NAME##_kernel, STORAGE)                                               \
+    DEFINE_SMALL_MATMUL_KERNEL(small_matmul_##NAME##_kernel, STORAGE, COMPUTE, LOAD, STORE)
+
+#define DEFINE_HALF_MATMUL_KERNELS(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE)                           \
+    DEFINE_CONVERTING_MATMUL_KERNEL(matmul_##NAME##_kernel, STORAGE, COMPUTE, LOAD, STORE)              \
+    DEFINE_SMALL_MATMUL_KERNEL(small_matmul_##NAME##_kernel, STORAGE, COMPUTE, LOAD, STORE)
+
+FOR_EACH_DIRECT_DATA_TYPE(DEFINE_DIRECT_MATMUL_KERNELS)
+FOR_EACH_HALF_DATA_TYPE(DEFINE_HALF_MATMUL_KERNELS)
+
+// Multiply-adds up to which the register-kernel is faster than streaming rows
+#define SMALL_MATMUL_LIMIT 4096
+
+typedef void (*MatmulKernel)(void* result, const void* data_A, const void* data_B,
+                             size_t rows_A, size_t cols_A, size_t cols_B,
+                             size_t row_stride_A, size_t col_stride_A, size_t row_stride_B, size_t col_stride_B,
+                             size_t row_stride_C);
+
+// Pick the multiplication-kernel for the given data-type and problem-size.
+static MatmulKernel select_matmul_kernel(DataType data_type, size_t rows_A, size_t cols_A, size_t cols_B) {
+    /*
+
+        Returns NULL if the data-type is not supported.
+
+    */
+
+    int small = rows_A * cols_A * cols_B <= SMALL_MATMUL_LIMIT;
+
+    #define MATMUL_KERNEL_CASE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE) \
+        case ENUM: return small ? small_matmul_##NAME##_kernel : matmul_##NAME##_kernel;
+
+    switch(data_type) {
+        FOR_EACH_DATA_TYPE(MATMUL_KERNEL_CASE)
+
+        default:
+            // Unsupported Data-Type
+            return NULL;
+    }
+
+    #undef MATMUL_KERNEL_CASE
+}
+
+
+//
+// Mixed precision multiplication
+//
+
+// Inner dimension, for which 8-bit products can be summed in `int32_t` without overflowing
+// (32768 * 255 * 255 < 2^31)
+#define INT8_ACCUMULATOR_BLOCK 32768
+#define UNLIMITED_ACCUMULATOR_BLOCK ((size_t)-1)
+
+// Input-types with their accumulators: X(ENUM, NAME, STORAGE, LOAD, ACCUMULATOR, TOTAL, TOTAL_ENUM, BLOCK)
+// Products are summed in `ACCUMULATOR` over at most `BLOCK` values of the inner dimension,
+// these partial sums are added up in `TOTAL`.
+#define FOR_EACH_MIXED_MATMUL_TYPE(X)                                                                   \
+    X(TYPE_INT8,   int8,   int8_t,  LOAD_VALUE, int32_t, int64_t, TYPE_INT64,  INT8_ACCUMULATOR_BLOCK)      \
+    X(TYPE_UINT8,  uint8,  uint8_t, LOAD_VALUE, int32_t, int64_t, TYPE_INT64,  INT8_ACCUMULATOR_BLOCK)      \
+    X(TYPE_INT16,  int16,  int16_t, LOAD_VALUE, int64_t, int64_t, TYPE_INT64,  UNLIMITED_ACCUMULATOR_BLOCK) \
+    X(TYPE_INT,    int,    int,     LOAD_VALUE, int64_t, int64_t, TYPE_INT64,  UNLIMITED_ACCUMULATOR_BLOCK) \
+    X(TYPE_INT64,  int64,  int64_t, LOAD_VALUE, int64_t, int64_t, TYPE_INT64,  UNLIMITED_ACCUMULATOR_BLOCK) \
+    X(TYPE_FP16,   fp16,   fp16_t,  LOAD_FP16,  float,   float,   TYPE_FLOAT,  UNLIMITED_ACCUMULATOR_BLOCK) \
+    X(TYPE_BF16,   bf16,   bf16_t,  LOAD_BF16,  float,   float,   TYPE_FLOAT,  UNLIMITED_ACCUMULATOR_BLOCK) \
+    X(TYPE_FLOAT,  float,  float,   LOAD_VALUE, double,  double,  TYPE_DOUBLE, UNLIMITED_ACCUMULATOR_BLOCK) \
+    X(TYPE_DOUBLE, double, double,  LOAD_VALUE, double,  double,  TYPE_DOUBLE, UNLIMITED_ACCUMULATOR_BLOCK)
+
+// `result = A * B` with wide accumulators: blocks of each result row are summed up and
+// converted into the output data-type once (see `output`).
+// The inner loops widen and multiply contiguous rows of B, so they are vectorized.
+#define DEFINE_MIXED_MATMUL_KERNEL(ENUM, NAME, STORAGE, LOAD, ACCUMULATOR, TOTAL, TOTAL_ENUM, BLOCK)    \
+static void mixed_matmul_##NAME##_kernel(void* result, const void* data_A, const void* data_B,          \
+                 size_t rows_A, size_t cols_A, size_t cols_B,                                           \
+                 size_t row_stride_A, size_t col_stride_A, size_t row_stride_B, size_t col_stride_B,    \
+                 size_t row_stride_C, const Conversion* output, size_t output_size) {                   \
+    const STORAGE* A = (const STORAGE*)data_A;                                                          \
+    const STORAGE* B = (const STORAGE*)data_B;                                                          \
+    ACCUMULATOR sums[MATMUL_ROW_BLOCK];                                                                 \
+    TOTAL totals[MATMUL_ROW_BLOCK];                                                                     \
+    for (size_t i = 0; i < rows_A; i++) {                                                               \
+        for (size_t start = 0; start < cols_B; start += MATMUL_ROW_BLOCK) {                             \
+            size_t length = cols_B - start < MATMUL_ROW_BLOCK ? cols_B - start : MATMUL_ROW_BLOCK;      \
+            for (size_t j = 0; j < length; j++) {                                                       \
+                totals[j] = 0;                                                                          \
+            }                                                                                           \
+            for (size_t block = 0; block < cols_A; block += (BLOCK)) {                                  \
+                size_t block_end = cols_A - block < (BLOCK) ? cols_A : block + (BLOCK);                 \
+                for (size_t j = 0; j < length; j++) {                                                   \
+                    sums[j] = 0;                                                                        \
+                }                                                                                       \
+                for (size_t k = block; k < block_end; k++) {                                            \
+                    const ACCUMULATOR a = (ACCUMULATOR)LOAD(A[i * row_stride_A + k * col_stride_A]);    \
+                    const STORAGE* b_row = B + k * row_stride_B + start * col_stride_B;                 \
+                    if (col_stride_B == 1) {                                                            \
+                        for (size_t j = 0; j < length; j++) {                                           \
+                            sums[j] += a * (ACCUMULATOR)LOAD(b_row[j]);                                 \
+                        }                                                                               \
+                    } else {                                                                            \
+                        for (size_t j = 0; j < length; j++) {                                           \
+                            sums[j] += a * (ACCUMULATOR)LOAD(b_row[j * col_stride_B]);                  \
+                        }                                                                               \
+                    }                                                                                   \
+                }                                                                                       \
+                for (size_t j = 0; j < length; j++) {                                                   \
+                    totals[j] += sums[j];                                                               \
+                }                                                                                       \
+            }                                                                                           \
+            run_conversion(output, (char*)result + (i * row_stride_C + start) * output_size, totals,    \
+                           length, sizeof(TOTAL), output_size);                                         \
+        }                                                                                               \
+    }                                                                                                   \
+}
+
+FOR_EACH_MIXED_MATMUL_TYPE(DEFINE_MIXED_MATMUL_KERNEL)
+
+typedef void (*MixedMatmulKernel)(void* result, const void* data_A, const void* data_B,
+                                  size_t rows_A, size_t cols_A, size_t cols_B,
+                                  size_t row_stride_A, size_t col_stride_A, size_t row_stride_B, size_t col_stride_B,
+                                  size_t row_stride_C, const Conversion* output, size_t output_size);
+
+// Pick the mixed precision kernel and the data-type of its sums for the given input data-type.
+static MixedMatmulKernel select_mixed_matmul_kernel(DataType data_type, DataType* total_type) {
+    /*
+
+        Returns NULL if the data-type is not supported.
+
+    */
+
+    #define MIXED_MATMUL_KERNEL_CASE(ENUM, NAME, STORAGE, LOAD, ACCUMULATOR, TOTAL, TOTAL_ENUM, BLOCK) \
+        case ENUM: *total_type = TOTAL_ENUM; return mixed_matmul_##NAME##_kernel;
+
+    switch(data_type) {
+        FOR_EACH_MIXED_MATMUL_TYPE(MIXED_MATMUL_KERNEL_CASE)
+
+        default:
+            // Unsupported Data-Type
+            return NULL;
+    }
+
+    #undef MIXED_MATMUL_KERNEL_CASE
+}
+
+
+//
+// Strassen-Winograd
+//
+
+
+// Algorithm and cutoff used by `multiply_2d_matrices`
+static MultiplicationAlgorithm multiplication_algorithm = MULTIPLICATION_STANDARD;
+static size_t strassen_cutoff = DEFAULT_STRASSEN_CUTOFF;
+
+// Select the algorithm, which is used by `multiply_2d_matrices`.
+void set_multiplication_algorithm(MultiplicationAlgorithm algorithm, size_t cutoff) {
+    /*
+
+        `MULTIPLICATION_STRASSEN` recursively splits the operands into quadrants and computes
+        the product with 7 instead of 8 half-sized multiplications (Winograd's variant: 15
+        additions per level). As soon as one dimension of a sub-problem is <= `cutoff`, the
+        standard kernel is used. A `cutoff` of 0 selects `DEFAULT_STRASSEN_CUTOFF`.
+
+        Numerical trade-off: the result is not computed with the same summation order as the
+        standard kernel. The normwise error bound grows by a factor of up to ~18 per recursion
+        level (instead of the factor 2 of a doubled inner dimension). For square operands of
+        size `n = 2^L * n0` (`L` levels, leaves of size `n0 <= cutoff`), Winograd's variant
+        satisfies (Higham, "Accuracy and Stability of Numerical Algorithms", Theorem 23.3):
+
+            ||C - fl(C)|| <= ((18^L * (n0^2 + 6 * n0) - 6 * n) * u + O(u^2)) * ||A|| * ||B||
+
+        with `||X|| = max |x_ij|` and the unit roundoff `u`.
+
+        Component-wise accuracy is lost, so small entries of `C` can have large relative errors.
+        For `TYPE_INT` & `TYPE_INT64` the result is exact (as long as no intermediate value
+        overflows), narrow integer types wrap around exactly like the standard kernel.
+        `TYPE_FP16`/`TYPE_BF16` always use the standard kernel (accumulated in `float`).
+
+        This setting is global and should not be changed while a multiplication is running.
+
+    */
+
+    multiplication_algorithm = algorithm;
+    strassen_cutoff = cutoff ? cutoff : DEFAULT_STRASSEN_CUTOFF;
+}
+
+MultiplicationAlgorithm get_multiplication_algorithm(void) {
+    return multiplication_algorithm;
+}
+
+size_t get_strassen_cutoff(void) {
+    return strassen_cutoff;
+}
+
+// Number of elements of the workspace, which is needed by the recursion for a (m x k) * (k x n) product.
+static size_t strassen_workspace_size(size_t m, size_t k, size_t n, size_t cutoff) {
+    size_t elements = 0;
+
+    // Every level needs one (m/2 x max(k/2, n/2)) and one (k/2 x n/2) temporary. The levels
+    // are processed depth-first, so each level reuses its own slice for all 7 products.
+    while (m > cutoff && k > cutoff && n > cutoff) {
+        m /= 2;
+        k /= 2;
+        n /= 2;
+        elements += m * (k > n ? k : n) + k * n;
+    }
+
+    return elements;
+}
+
+// Strassen-Winograd recursion for row-major operands with the leading dimensions `ld*`.
+#define DEFINE_STRASSEN_KERNELS(NAME, TYPE, BASE_KERNEL)                                                \
+static void NAME##_add(TYPE* out, size_t ld_out, const TYPE* a, size_t ld_a, const TYPE* b, size_t ld_b, \
+                       size_t rows, size_t cols) {                                                      \
+    for (size_t i = 0; i < rows; i++) {                                                                 \
+        for (size_t j = 0; j < cols; j++) {                                                             \
+            out[i * ld_out + j] = a[i * ld_a + j] + b[i * ld_b + j];                                    \
+        }                                                                                               \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+static void NAME##_subtract(TYPE* out, size_t ld_out, const TYPE* a, size_t ld_a, const TYPE* b,        \
+                            size_t ld_b, size_t rows, size_t cols) {                                    \
+    for (size_t i = 0; i < rows; i++) {                                                                 \
+        for (size_t j = 0; j < cols; j++) {                                                             \
+            out[i * ld_out + j] = a[i * ld_a + j] - b[i * ld_b + j];                                    \
+        }                                                                                               \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+static void NAME(TYPE* C, size_t ldc, const TYPE* A, size_t lda, const TYPE* B, size_t ldb,            \
+                 size_t m, size_t k, size_t n, TYPE* workspace, size_t cutoff) {                        \
+    if (m <= cutoff || k <= cutoff || n <= cutoff) {                                                    \
+        BASE_KERNEL(C, A, B, m, k, n, lda, 1, ldb, 1, ldc);                                             \
+        return;                                                                                         \
+    }                                                                                                   \
+                                                                                                        \
+    size_t hm = m / 2, hk = k / 2, hn = n / 2;                                                          \
+    size_t ldx = hk > hn ? hk : hn;                                                                     \
+    TYPE* X = workspace;                                                                                \
+    TYPE* Y = X + hm * ldx;                                                                             \
+    TYPE* next = Y + hk * hn;                                                                           \
+                                                                                                        \
+    const TYPE* A11 = A;                                                                                \
+    const TYPE* A12 = A + hk;                                                                           \
+    const TYPE* A21 = A + hm * lda;                                                                     \
+    const TYPE* A22 = A21 + hk;                                                                         \
+    const TYPE* B11 = B;                                                                                \
+    const TYPE* B12 = B + hn;                                                                           \
+    const TYPE* B21 = B + hk * ldb;                                                                     \
+    const TYPE* B22 = B21 + hn;                                                                         \
+    TYPE* C11 = C;                                                                                      \
+    TYPE* C12 = C + hn;                                                                                 \
+    TYPE* C21 = C + hm * ldc;                                                                           \
+    TYPE* C22 = C21 + hn;                                                                               \
+                                                                                                        \
+    /* Schedule with two temporaries (Boyer, Dumas, Pernet & Zhou, 2009) */                             \
+    NAME##_subtract(X, ldx, A11, lda, A21, lda, hm, hk);        /* S3 = A11 - A21 */                    \
+    NAME##_subtract(Y, hn, B22, ldb, B12, ldb, hk, hn);         /* T3 = B22 - B12 */                    \
+    NAME(C21, ldc, X, ldx, Y, hn, hm, hk, hn, next, cutoff);    /* P7 = S3 * T3   */                    \
+    NAME##_add(X, ldx, A21, lda, A22, lda, hm, hk);             /* S1 = A21 + A22 */                    \
+    NAME##_subtract(Y, hn, B12, ldb, B11, ldb, hk, hn);         /* T1 = B12 - B11 */                    \
+    NAME(C22, ldc, X, ldx, Y, hn, hm, hk, hn, next, cutoff);    /* P5 = S1 * T1   */                    \
+    NAME##_subtract(X, ldx, X, ldx, A11, lda, hm, hk);          /* S2 = S1 - A11  */                    \
+    NAME##_subtract(Y, hn, B22, ldb, Y, hn, hk, hn);            /* T2 = B22 - T1  */                    \
+    NAME(C12, ldc, X, ldx, Y, hn, hm, hk, hn, next, cutoff);    /* P6 = S2 * T2   */                    \
+    NAME##_subtract(X, ldx, A12, lda, X, ldx, hm, hk);          /* S4 = A12 - S2  */                    \
+    NAME(C11, ldc, X, ldx, B22, ldb, hm, hk, hn, next, cutoff); /* P3 = S4 * B22  */                    \
+    NAME(X, ldx, A11, lda, B11, ldb, hm, hk, hn, next, cutoff); /* P1 = A11 * B11 */                    \
+    NAME##_add(C12, ldc, X, ldx, C12, ldc, hm, hn);             /* U2 = P1 + P6   */                    \
+    NAME##_add(C21, ldc, C12, ldc, C21, ldc, hm, hn);           /* U3 = U2 + P7   */                    \
+    NAME##_add(C12, ldc, C12, ldc, C22, ldc, hm, hn);           /* U4 = U2 + P5   */                    \
+    NAME##_add(C22, ldc, C21, ldc, C22, ldc, hm, hn);           /* U7 = U3 + P5   */                    \
+    NAME##_add(C12, ldc, C12, ldc, C11, ldc, hm, hn);           /* U5 = U4 + P3   */                    \
+    NAME##_subtract(Y, hn, Y, hn, B21, ldb, hk, hn);            /* T4 = T2 - B21  */                    \
+    NAME(C11, ldc, A22, lda, Y, hn, hm, hk, hn, next, cutoff);  /* P4 = A22 * T4  */                    \
+    NAME##_subtract(C21, ldc, C21, ldc, C11, ldc, hm, hn);      /* U6 = U3 - P4   */                    \
+    NAME(C11, ldc, A12, lda, B21, ldb, hm, hk, hn, next, cutoff); /* P2 = A12 * B21 */                  \
+    NAME##_add(C11, ldc, X, ldx, C11, ldc, hm, hn);             /* U1 = P1 + P2   */                    \
+                                                                                                        \
+    /* Dynamic peeling: fix up the last row / column of odd dimensions */                               \
+    if (k & 1) {                                                                                        \
+        for (size_t i = 0; i < 2 * hm; i++) {                                                           \
+            const TYPE a = A[i * lda + k - 1];                                                          \
+            const TYPE* b_row = B + (k - 1) * ldb;                                                      \
+            TYPE* c_row = C + i * ldc;                                                                  \
+            for (size_t j = 0; j < 2 * hn; j++) {                                                       \
+                c_row[j] += a * b_row[j];                                                               \
+            }                                                                                           \
+        }                                                                                               \
+    }                                                                                                   \
+                                                                                                        \
+    if (n & 1) {                                                                                        \
+        BASE_KERNEL(C + n - 1, A, B + n - 1, 2 * hm, k, 1, lda, 1, ldb, 1, ldc);                        \
+    }                                                                                                   \
+                                                                                                        \
+    if (m & 1) {                                                                                        \
+        BASE_KERNEL(C + (m - 1) * ldc, A + (m - 1) * lda, B, 1, k, n, lda, 1, ldb, 1, ldc);             \
+    }                                                                                                   \
+}
+
+// The recursion needs exact subtraction and addition in the storage type, so it only exists for direct types
+#define DEFINE_TYPE_STRASSEN_KERNELS(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE)                         \
+    DEFINE_STRASSEN_KERNELS(strassen_##NAME##_kernel, STORAGE, matmul_##NAME##_kernel)
+
+FOR_EACH_DIRECT_DATA_TYPE(DEFINE_TYPE_STRASSEN_KERNELS)
+
+// Compute `result = A * B` for contiguous (row-major) operands with the Strassen-Winograd recursion.
+static ErrorCode strassen_multiply(void* result, const void* data_A, const void* data_B,
+                                   size_t rows_A, size_t cols_A, size_t cols_B, DataType data_type) {
+    /*
+
+        The workspace for all recursion levels is allocated once.
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                        = No error.
+        ERR_MALLOC_FAILED               = Allocating the workspace failed;
+        ERR_UNSUPPORTED_DATATYPE        = Unsupported data-type;
+
+    */
+
+    size_t element_size = get_data_type_size(data_type);
+
+    if (!element_size) {
+        // Unsupported Data-Type
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    size_t workspace_size = strassen_workspace_size(rows_A, cols_A, cols_B, strassen_cutoff);
+    void* workspace = malloc((workspace_size ? workspace_size : 1) * element_size);
+
+    if (!workspace) {
+        // Allocating the workspace failed
+        return ERR_MALLOC_FAILED;
+    }
+
+    #define STRASSEN_CASE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE)                                \
+        case ENUM:                                                                                  \
+            strassen_##NAME##_kernel(result, cols_B, data_A, cols_A, data_B, cols_B,                \
+                                     rows_A, cols_A, cols_B, workspace, strassen_cutoff);           \
+            break;
+
+    switch(data_type) {
+        FOR_EACH_DIRECT_DATA_TYPE(STRASSEN_CASE)
+
+        default:
+            // Unsupported Data-Type
+            free(workspace);
+            return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    #undef STRASSEN_CASE
+
+    free(workspace);
+
+    return ERR_NONE;
+}
+
+
+//
+// Matrix-Views
+//
+
+
+// Create a view, which covers the whole given matrix.
+ErrorCode create_matrix_view(MatrixView* view, const MultiDimensionalMatrix* matrix) {
+    /*
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                 = No error.
+        ERR_NULL_PTR             = View/Matrix does not exist; Matrix head-pointer is NULL;
+        ERR_INVALID_ARGS         = The matrix has more than `MAX_VIEW_DIMENSIONS` dimensions;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported data-type;
+
+    */
+
+    if (!view || !matrix || !matrix->head_ptr || !matrix->head_ptr->data) {
+        // View/Matrix does not exist
+        return ERR_NULL_PTR;
+    }
+
+    if (matrix->head_ptr->number_of_dimensions > MAX_VIEW_DIMENSIONS) {
+        // Too many dimensions for a view
+        return ERR_INVALID_ARGS;
+    }
+
+    if (get_data_type_size(matrix->head_ptr->data_type) == 0) {
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    view->parent = matrix->head_ptr;
+    view->offset = 0;
+    view->number_of_dimensions = matrix->head_ptr->number_of_dimensions;
+    view->data_type = matrix->head_ptr->data_type;
+
+    memcpy(view->dimensions, matrix->head_ptr->dimensions, view->number_of_dimensions * sizeof(size_t));
+    memcpy(view->strides, matrix->head_ptr->strides, view->number_of_dimensions * sizeof(size_t));
+
+    return ERR_NONE;
+}
+
+// Restrict one dimension of a view to the range [start, stop) with the given step.
+ErrorCode slice_matrix_view(MatrixView* result, const MatrixView* view, size_t dimension, size_t start, size_t stop, size_t step) {
+    /*
+
+        `result` may be the same view as `view`.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE          = No error.
+        ERR_NULL_PTR      = One of the views does not exist;
+        ERR_INVALID_ARGS  = Invalid dimension; `step` is zero; `start > stop`;
+        ERR_INVALID_INDEX = `stop` is out of bounds;
+
+    */
+
+    if (!result || !view || !view->parent) {
+        return ERR_NULL_PTR;
+    }
+
+    if (dimension >= view->number_of_dimensions || step == 0 || start > stop) {
+        return ERR_INVALID_ARGS;
+    }
+
+    if (stop > view->dimensions[dimension]) {
+        return ERR_INVALID_INDEX;
+    }
+
+    MatrixView sliced = *view;
+
+    sliced.offset += start * view->strides[dimension];
+    sliced.dimensions[dimension] = (stop - start + step - 1) / step;
+    sliced.strides[dimension] *= step;
+
+    *result = sliced;
+
+    return ERR_NONE;
+}
+
+// Fix one dimension of a view to a single index, which removes that dimension.
+ErrorCode select_matrix_view_index(MatrixView* result, const MatrixView* view, size_t dimension, size_t index) {
+    /*
+
+        For example selecting index `2` of dimension `0` of a 4 x 3 x 2 view results in the 3 x 2 view `view[2]`.
+        `result` may be the same view as `view`.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE          = No error.
+        ERR_NULL_PTR      = One of the views does not exist;
+        ERR_INVALID_ARGS  = Invalid dimension; The view has only one dimension;
+        ERR_INVALID_INDEX = Index is out of bounds;
+
+    */
+
+    if (!result || !view || !view->parent) {
+        return ERR_NULL_PTR;
+    }
+
+    if (dimension >= view->number_of_dimensions || view->number_of_dimensions < 2) {
+        return ERR_INVALID_ARGS;
+    }
+
+    if (index >= view->dimensions[dimension]) {
+        return ERR_INVALID_INDEX;
+    }
+
+    MatrixView selected = *view;
+
+    selected.offset += index * view->strides[dimension];
+
+    for (size_t i = dimension; i + 1 < view->number_of_dimensions; i++) {
+        selected.dimensions[i] = view->dimensions[i + 1];
+        selected.strides[i] = view->strides[i + 1];
+    }
+
+    selected.number_of_dimensions--;
+
+    *result = selected;
+
+    return ERR_NONE;
+}
+
+// Swap the last two dimensions of a view.
+ErrorCode transpose_matrix_view(MatrixView* result, const MatrixView* view) {
+    /*
+
+        For a 2-D view this is the matrix-transposition. Leading dimensions of an N-D view are kept,
+        so every inner matrix is transposed. A 1-D view is returned unchanged.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE     = No error.
+        ERR_NULL_PTR = One of the views does not exist;
+
+    */
+
+    if (!result || !view || !view->parent) {
+        return ERR_NULL_PTR;
+    }
+
+    MatrixView transposed = *view;
+
+    if (view->number_of_dimensions >= 2) {
+        size_t last = view->number_of_dimensions - 1;
+
+        transposed.dimensions[last] = view->dimensions[last - 1];
+        transposed.dimensions[last - 1] = view->dimensions[last];
+        transposed.strides[last] = view->strides[last - 1];
+        transposed.strides[last - 1] = view->strides[last];
+    }
+
+    *result = transposed;
+
+    return ERR_NONE;
+}
+
+// Reorder the dimensions of a view: dimension `i` of the result is dimension `axes[i]` of `view`.
+ErrorCode permute_matrix_view_axes(MatrixView* result, const MatrixView* view, const size_t* axes) {
+    /*
+
+        `axes` has to contain every dimension of the view exactly once.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE         = No error.
+        ERR_NULL_PTR     = One of the views does not exist; Axes-array does not exist;
+        ERR_INVALID_ARGS = `axes` is not a permutation of the dimensions;
+
+    */
+
+    if (!result || !view || !axes || !view->parent) {
+        return ERR_NULL_PTR;
+    }
+
+    int seen[MAX_VIEW_DIMENSIONS] = {0};
+    MatrixView permuted = *view;
+
+    for (size_t i = 0; i < view->number_of_dimensions; i++) {
+        if (axes[i] >= view->number_of_dimensions || seen[axes[i]]) {
+            // Invalid or repeated axis
+            return ERR_INVALID_ARGS;
+        }
+        seen[axes[i]] = 1;
+
+        permuted.dimensions[i] = view->dimensions[axes[i]];
+        permuted.strides[i] = view->strides[axes[i]];
+    }
+
+    *result = permuted;
+
+    return ERR_NONE;
+}
+
+// Give a view a new shape with the same number of elements, without copying.
+ErrorCode reshape_matrix_view(MatrixView* result, const MatrixView* view, size_t new_number_of_dimensions, const size_t* new_dimensions) {
+    /*
+
+        Works for every view, whose elements can be addressed with the new shape by strides alone,
+        e.g. contiguous views or views, where only dimensions are split/merged that are contiguous
+        among themselves. Otherwise the view has to be copied first (see `copy_matrix_view`).
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                    = No error.
+        ERR_NULL_PTR                = One of the views does not exist; Dimensions-array does not exist;
+        ERR_INVALID_ARGS            = Invalid number of dimensions;
+        ERR_DIMENSION_SIZE_MISMATCH = The number of elements differs;
+        ERR_NON_CONTIGUOUS_VIEW     = The view cannot be reshaped without copying;
+
+    */
+
+    if (!result || !view || !new_dimensions || !view->parent) {
+        return ERR_NULL_PTR;
+    }
+
+    if (new_number_of_dimensions == 0 || new_number_of_dimensions > MAX_VIEW_DIMENSIONS) {
+        return ERR_INVALID_ARGS;
+    }
+
+    size_t old_total = 1, new_total = 1;
+
+    for (size_t i = 0; i < view->number_of_dimensions; i++) {
+        old_total *= view->dimensions[i];
+    }
+
+    for (size_t i = 0; i < new_number_of_dimensions; i++) {
+        new_total *= new_dimensions[i];
+    }
+
+    if (old_total != new_total) {
+        return ERR_DIMENSION_SIZE_MISMATCH;
+    }
+
+    MatrixView reshaped = *view;
+    reshaped.number_of_dimensions = new_number_of_dimensions;
+    memcpy(reshaped.dimensions, new_dimensions, new_number_of_dimensions * sizeof(size_t));
+
+    if (old_total == 0) {
+        // No element is ever addressed
+        for (size_t i = 0; i < new_number_of_dimensions; i++) {
+            reshaped.strides[i] = 0;
+        }
+        *result = reshaped;
+        return ERR_NONE;
+    }
+
+    // Size-1 dimensions don't constrain the strides
+    size_t old_dimensions[MAX_VIEW_DIMENSIONS], old_strides[MAX_VIEW_DIMENSIONS];
+    size_t old_count = 0;
+
+    for (size_t i = 0; i < view->number_of_dimensions; i++) {
+        if (view->dimensions[i] != 1) {
+            old_dimensions[old_count] = view->dimensions[i];
+            old_strides[old_count] = view->strides[i];
+            old_count++;
+        }
+    }
+
+    /*
+
+        Match groups of old dimensions with groups of new dimensions, which have the same
+        number of elements. Every group of old dimensions has to be contiguous among itself,
+        then the new dimensions of that group get strides derived from its innermost stride.
+
+    */
+
+    size_t new_index = 0, old_index = 0;
+
+    while (new_index < new_number_of_dimensions && old_index < old_count) {
+        size_t new_end = new_index + 1, old_end = old_index + 1;
+        size_t new_product = new_dimensions[new_index], old_product = old_dimensions[old_index];
+
+        while (new_product != old_product) {
+            if (new_product < old_product) {
+                new_product *= new_dimensions[new_end++];
+            } else {
+                old_product *= old_dimensions[old_end++];
+            }
+        }
+
+        for (size_t i = old_index; i + 1 < old_end; i++) {
+            if (old_strides[i] != old_dimensions[i + 1] * old_strides[i + 1]) {
+                // Group is not contiguous
+                return ERR_NON_CONTIGUOUS_VIEW;
+            }
+        }
+
+        reshaped.strides[new_end - 1] = old_strides[old_end - 1];
+
+        for (size_t i = new_end - 1; i > new_index; i--) {
+            reshaped.strides[i - 1] = reshaped.strides[i] * new_dimensions[i];
+        }
+
+        new_index = new_end;
+        old_index = old_end;
+    }
+
+    // Remaining new dimensions have size 1
+    for (; new_index < new_number_of_dimensions; new_index++) {
+        reshaped.strides[new_index] = 1;
+    }
+
+    *result = reshaped;
+
+    return ERR_NONE;
+}
+
+// Check, wether the elements of a view are laid out densely in row-major order.
+int is_matrix_view_contiguous(const MatrixView* view) {
+    /*
+
+        Returns `1` if the view is contiguous, otherwise `0`.
+
+    */
+
+    if (!view) {
+        return 0;
+    }
+
+    size_t expected_stride = 1;
+
+    for (size_t i = view->number_of_dimensions; i-- > 0;) {
+        if (view->dimensions[i] == 1) {
+            continue;
+        }
+        if (view->strides[i] != expected_stride) {
+            return 0;
+        }
+        expected_stride *= view->dimensions[i];
+    }
+
+    return 1;
+}
+
+// Get a reference to an element of a view by its indices.
+void* get_view_element_by_indices(const MatrixView* view, const size_t* indices) {
+    /*
+
+        Returns the element as a void-Pointer into the parent's buffer.
+        Returns a NULL-Pointer if something went wrong.
+
+    */
+
+    if (!view || !indices || !view->parent || !view->parent->data) {
+        return NULL;
+    }
+
+    size_t index = view->offset;
+
+    for (size_t i = 0; i < view->number_of_dimensions; i++) {
+        if (indices[i] >= view->dimensions[i]) {
+            // Index is out of bounds
+            return NULL;
+        }
+        index += indices[i] * view->strides[i];
+    }
+
+    size_t element_size = get_data_type_size(view->data_type);
+
+    if (element_size == 0 || index >= view->parent->data_size / element_size) {
+        return NULL;
+    }
+
+    return (void*)((char*)view->parent->data + index * element_size);
+}
+
+// Set an element of a view (and therefore of its parent matrix) by its indices.
+ErrorCode set_view_element_by_indices(const MatrixView* view, const size_t* indices, void* value) {
+    /*
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE          = No error.
+        ERR_NULL_PTR      = View/Indices/Value does not exist;
+        ERR_INVALID_INDEX = Indices are out of bounds;
+        ERR_READ_ONLY     = The parent matrix is a read-only mapping of a file;
+
+    */
+
+    if (!view || !indices || !value || !view->parent) {
+        return ERR_NULL_PTR;
+    }
+
+    if (view->parent->storage == STORAGE_MAPPED_READ_ONLY) {
+        return ERR_READ_ONLY;
+    }
+
+    void* element = get_view_element_by_indices(view, indices);
+
+    if (!element) {
+        return ERR_INVALID_INDEX;
+    }
+
+    memcpy(element, value, get_data_type_size(view->data_type));
+
+    return ERR_NONE;
+}
+
+//
+// Blocked transposition
+//
+
+/*
+
+    A copy, whose source is contiguous along another dimension than the result, would read
+    (or write) with a large stride in its innermost loop and touch a new cache-line and page
+    for every element. Such copies are done as 2-D transpositions (source-contiguous
+    dimension x last dimension) of every batch. A transposition is halved recursively along
+    its longer side until a block fits into the L1-cache (cache-oblivious), and blocks are
+    processed in 8x8 tiles: a full tile is read row by row into a local array with constant
+    bounds, which the compiler keeps in (vector) registers, and written back column by column.
+
+*/
+
+// Edge of the tiles, which are transposed in registers
+#define TRANSPOSE_TILE 8
+
+// Maximum number of elements of a block, which isn't split anymore (32 x 32)
+#define TRANSPOSE_LEAF 1024
+
+// Rows of a transposition per parallel work-item
+#define TRANSPOSE_STRIP 64
+
+// Minimum number of elements per thread of a transposition
+#define PARALLEL_TRANSPOSE_CHUNK 65536
+
+// Edge of the blocks, which are swapped by the in-place transposition
+#define IN_PLACE_TRANSPOSE_BLOCK 32
+
+// `destination[i * destination_row + j] = source[i * source_row + j * source_col]` (strides in elements)
+#define DEFINE_TRANSPOSE_KERNELS(NAME, TYPE)                                                            \
+static void transpose_##NAME##_block(char* destination, const char* source, size_t rows, size_t cols,  \
+                                     size_t destination_row, size_t source_row, size_t source_col) {    \
+    TYPE* restrict result = (TYPE*)destination;                                                         \
+    const TYPE* restrict elements = (const TYPE*)source;                                                \
+    for (size_t i0 = 0; i0 < rows; i0 += TRANSPOSE_TILE) {                                              \
+        for (size_t j0 = 0; j0 < cols; j0 += TRANSPOSE_TILE) {                                          \
+            if (i0 + TRANSPOSE_TILE <= rows && j0 + TRANSPOSE_TILE <= cols && source_row == 1) {        \
+                TYPE tile[TRANSPOSE_TILE][TRANSPOSE_TILE];                                              \
+                for (size_t j = 0; j < TRANSPOSE_TILE; j++) {                                           \
+                    for (size_t i = 0; i < TRANSPOSE_TILE; i++) {                                       \
+                        tile[i][j] = elements[(j0 + j) * source_col + i0 + i];                          \
+                    }                                                                                   \
+                }                                                                                       \
+                for (size_t i = 0; i < TRANSPOSE_TILE; i++) {                                           \
+                    for (size_t j = 0; j < TRANSPOSE_TILE; j++) {                                       \
+                        result[(i0 + i) * destination_row + j0 + j] = tile[i][j];                       \
+                    }                                                                                   \
+                }                                                                                       \
+                continue;                                                                               \
+            }                                                                                           \
+            size_t i_end = i0 + TRANSPOSE_TILE < rows ? i0 + TRANSPOSE_TILE : rows;                     \
+            size_t j_end = j0 + TRANSPOSE_TILE < cols ? j0 + TRANSPOSE_TILE : cols;                     \
+            for (size_t i = i0; i < i_end; i++) {                                                       \
+                for (size_t j = j0; j < j_end; j++) {                                                   \
+                    result[i * destination_row + j] = elements[i * source_row + j * source_col];        \
+                }                                                                                       \
+            }                                                                                           \
+        }                                                                                               \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+static void transpose_##NAME##_rows_in_place(char* data, size_t n, size_t first_block, size_t last_block) { \
+    TYPE* elements = (TYPE*)data;                                                                       \
+    for (size_t block = first_block; block < last_block; block++) {                                     \
+        size_t i0 = block * IN_PLACE_TRANSPOSE_BLOCK;                                                   \
+        size_t i_end = i0 + IN_PLACE_TRANSPOSE_BLOCK < n ? i0 + IN_PLACE_TRANSPOSE_BLOCK : n;           \
+        /* Diagonal block */                                                                            \
+        for (size_t i = i0; i < i_end; i++) {                                                           \
+            for (size_t j = i + 1; j < i_end; j++) {                                                    \
+                TYPE swap = elements[i * n + j];                                                        \
+                elements[i * n + j] = elements[j * n + i];                                              \
+                elements[j * n + i] = swap;                                                             \
+            }                                                                                           \
+        }                                                                                               \
+        /* Swap the blocks right of the diagonal with the ones below it */                              \
+        for (size_t j0 = i_end; j0 < n; j0 += IN_PLACE_TRANSPOSE_BLOCK) {                               \
+            size_t j_end = j0 + IN_PLACE_TRANSPOSE_BLOCK < n ? j0 + IN_PLACE_TRANSPOSE_BLOCK : n;       \
+            for (size_t i = i0; i < i_end; i++) {                                                       \
+                for (size_t j = j0; j < j_end; j++) {                                                   \
+                    TYPE swap = elements[i * n + j];                                                    \
+                    elements[i * n + j] = elements[j * n + i];                                          \
+                    elements[j * n + i] = swap;                                                         \
+                }                                                                                       \
+            }                                                                                           \
+        }                                                                                               \
+    }                                                                                                   \
+}
+
+// Elements are moved as unsigned integers of their size
+DEFINE_TRANSPOSE_KERNELS(byte, uint8_t)
+DEFINE_TRANSPOSE_KERNELS(short, uint16_t)
+DEFINE_TRANSPOSE_KERNELS(word, uint32_t)
+DEFINE_TRANSPOSE_KERNELS(long, uint64_t)
+
+typedef void (*TransposeKernel)(char* destination, const char* source, size_t rows, size_t cols,
+                                size_t destination_row, size_t source_row, size_t source_col);
+typedef void (*InPlaceTransposeKernel)(char* data, size_t n, size_t first_block, size_t last_block);
+
+// Work of a blocked transposition, shared by all threads (strides in elements).
+typedef struct TransposeTask {
+    TransposeKernel kernel;
+    InPlaceTransposeKernel in_place_kernel;
+    char* destination;
+    const char* source;
+    size_t element_size;
+    size_t rows, cols;                  // Of every 2-D transposition
+    size_t destination_row;
+    size_t source_row, source_col;
+    size_t strips_per_batch;            // Parallel work-items of one transposition
+    size_t number_of_batch_dimensions;
+    size_t batch_dimensions[MAX_VIEW_DIMENSIONS];
+    size_t destination_batch_strides[MAX_VIEW_DIMENSIONS];
+    size_t source_batch_strides[MAX_VIEW_DIMENSIONS];
+} TransposeTask;
+
+// Pick the kernels for the element-size.
+static int select_transpose_kernels(TransposeTask* task, size_t element_size) {
+    switch(element_size) {
+        case 1: task->kernel = transpose_byte_block; task->in_place_kernel = transpose_byte_rows_in_place; break;
+        case 2: task->kernel = transpose_short_block; task->in_place_kernel = transpose_short_rows_in_place; break;
+        case 4: task->kernel = transpose_word_block; task->in_place_kernel = transpose_word_rows_in_place; break;
+        case 8: task->kernel = transpose_long_block; task->in_place_kernel = transpose_long_rows_in_place; break;
+
+        default:
+            // Unsupported Data-Type
+            return 0;
+    }
+
+    task->element_size = element_size;
+
+    return 1;
+}
+
+// Transpose `rows x cols` elements, split along the longer side until a block is small enough.
+static void transpose_recursive(const TransposeTask* task, char* destination, const char* source, size_t rows, size_t cols) {
+    if (rows * cols <= TRANSPOSE_LEAF) {
+        task->kernel(destination, source, rows, cols, task->destination_row, task->source_row, task->source_col);
+        return;
+    }
+
+    // Halves are multiples of the tile-edge, so only the last tiles are partial
+    if (rows >= cols) {
+        size_t half = (rows / 2 + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE * TRANSPOSE_TILE;
+
+        transpose_recursive(task, destination, source, half, cols);
+        transpose_recursive(task, destination + half * task->destination_row * task->element_size,
+                            source + half * task->source_row * task->element_size, rows - half, cols);
+    } else {
+        size_t half = (cols / 2 + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE * TRANSPOSE_TILE;
+
+        transpose_recursive(task, destination, source, rows, half);
+        transpose_recursive(task, destination + half * task->element_size,
+                            source + half * task->source_col * task->element_size, rows, cols - half);
+    }
+}
+
+// Offsets (in elements) of the batch `batch` in the destination and the source.
+static void get_transpose_batch_offsets(const TransposeTask* task, size_t batch, size_t* destination_offset, size_t* source_offset) {
+    *destination_offset = 0;
+    *source_offset = 0;
+
+    for (size_t j = task->number_of_batch_dimensions; j-- > 0;) {
+        size_t index = batch % task->batch_dimensions[j];
+        batch /= task->batch_dimensions[j];
+
+        *destination_offset += index * task->destination_batch_strides[j];
+        *source_offset += index * task->source_batch_strides[j];
+    }
+}
+
+// Parallel task: transpose the strips [begin, end) of all batches.
+static void transpose_strips(void* context, size_t begin, size_t end) {
+    const TransposeTask* task = (const TransposeTask*)context;
+
+    for (size_t item = begin; item < end; item++) {
+        size_t destination_offset, source_offset;
+        get_transpose_batch_offsets(task, item / task->strips_per_batch, &destination_offset, &source_offset);
+
+        size_t first_row = item % task->strips_per_batch * TRANSPOSE_STRIP;
+        size_t rows = task->rows - first_row < TRANSPOSE_STRIP ? task->rows - first_row : TRANSPOSE_STRIP;
+
+        destination_offset += first_row * task->destination_row;
+        source_offset += first_row * task->source_row;
+
+        transpose_recursive(task, task->destination + destination_offset * task->element_size,
+                            task->source + source_offset * task->element_size, rows, task->cols);
+    }
+}
+
+// Copy operand `1` into the contiguous operand `0` by blocked transpositions.
+static int copy_strided_operands_transposed(StridedOperands* operands, size_t element_size) {
+    /*
+
+        Returns 0 (without copying anything) if the source is already contiguous along the
+        last dimension, or no dimension is contiguous enough to be worth a transposition.
+
+    */
+
+    for (size_t i = 0; i < operands->number_of_dimensions; i++) {
+        if (operands->dimensions[i] == 0) {
+            // Nothing to copy
+            return 0;
+        }
+    }
+
+    TransposeTask task;
+
+    if (!select_transpose_kernels(&task, element_size)) {
+        return 0;
+    }
+
+    coalesce_strided_dimensions(operands);
+
+    size_t number_of_dimensions = operands->number_of_dimensions;
+
+    if (number_of_dimensions < 2) {
+        return 0;
+    }
+
+    // Dimension, along which the source is (nearly) contiguous
+    size_t last = number_of_dimensions - 1;
+    size_t contiguous = 0;
+
+    for (size_t i = 1; i < last; i++) {
+        if (operands->strides[1][i] < operands->strides[1][contiguous]) {
+            contiguous = i;
+        }
+    }
+
+    size_t source_stride = operands->strides[1][contiguous];
+
+    if (source_stride == 0 || source_stride >= operands->strides[1][last] ||
+        operands->dimensions[contiguous] < TRANSPOSE_TILE || operands->dimensions[last] < TRANSPOSE_TILE) {
+        // The row-wise copy is already cache-friendly (or the transpositions are too small)
+        return 0;
+    }
+
+    task.destination = operands->data[0];
+    task.source = operands->data[1];
+    task.rows = operands->dimensions[contiguous];
+    task.cols = operands->dimensions[last];
+    task.destination_row = operands->strides[0][contiguous] / element_size;
+    task.source_row = source_stride / element_size;
+    task.source_col = operands->strides[1][last] / element_size;
+    task.strips_per_batch = (task.rows + TRANSPOSE_STRIP - 1) / TRANSPOSE_STRIP;
+    task.number_of_batch_dimensions = 0;
+
+    size_t number_of_batches = 1;
+
+    for (size_t i = 0; i < last; i++) {
+        if (i == contiguous) {
+            continue;
+        }
+
+        size_t j = task.number_of_batch_dimensions++;
+        task.batch_dimensions[j] = operands->dimensions[i];
+        task.destination_batch_strides[j] = operands->strides[0][i] / element_size;
+        task.source_batch_strides[j] = operands->strides[1][i] / element_size;
+        number_of_batches *= operands->dimensions[i];
+    }
+
+    size_t minimum_chunk = PARALLEL_TRANSPOSE_CHUNK / (TRANSPOSE_STRIP * task.cols);
+
+    parallel_for(number_of_batches * task.strips_per_batch, minimum_chunk > 0 ? minimum_chunk : 1, transpose_strips, &task);
+
+    return 1;
+}
+
+// Parallel task: transpose the block-rows [begin, end) of the square matrices in place.
+static void transpose_block_rows_in_place(void* context, size_t begin, size_t end) {
+    const TransposeTask* task = (const TransposeTask*)context;
+
+    for (size_t item = begin; item < end;) {
+        size_t batch = item / task->strips_per_batch;
+        size_t first_block = item % task->strips_per_batch;
+        size_t last_block = first_block + (end - item);
+
+        last_block = last_block < task->strips_per_batch ? last_block : task->strips_per_batch;
+
+        task->in_place_kernel(task->destination + batch * task->rows * task->rows * task->element_size,
+                              task->rows, first_block, last_block);
+
+        item += last_block - first_block;
+    }
+}
+
+
+// Create a new contiguous matrix with the shape of the given view.
+static ErrorCode create_matrix_for_view(MultiDimensionalMatrix* matrix, const MatrixView* view, MatrixView* matrix_view) {
+    ErrorCode error = create_matrix(matrix, view->number_of_dimensions, (size_t*)view->dimensions, view->data_type);
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    return create_matrix_view(matrix_view, matrix);
+}
+
+// Copy the elements of a view into a new contiguous matrix.
+ArithmeticOperationReturn copy_matrix_view(const MatrixView* view) {
+    /*
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: Contiguous copy of the view.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                 = No error.
+        ERR_NULL_PTR             = View does not exist;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported data-type;
+
+        » For the other possible ErrorCodes, see what `create_matrix` returns. «
+
+    */
+
+    ArithmeticOperationReturn response;
+    response.error_code = ERR_NONE;
+    response.result_matrix.head_ptr = NULL;
+
+    if (!view || !view->parent || !view->parent->data) {
+        response.error_code = ERR_NULL_PTR;
+        return response;
+    }
+
+    StridedInnerLoop loop = select_copy_loop(view->data_type);
+
+    if (!loop) {
+        response.error_code = ERR_UNSUPPORTED_DATATYPE;
+        return response;
+    }
+
+    MatrixView result_view;
+    response.error_code = create_matrix_for_view(&response.result_matrix, view, &result_view);
+
+    if (response.error_code != ERR_NONE) {
+        clear_matrix(&response.result_matrix);
+        return response;
+    }
+
+    StridedOperands operands;
+    init_strided_operands(&operands, view);
+    add_view_operand(&operands, &result_view);
+    add_view_operand(&operands, view);
+
+    // Transposed sources are copied in blocks, everything else row by row
+    if (!copy_strided_operands_transposed(&operands, get_data_type_size(view->data_type))) {
+        run_strided_loop(&operands, loop, NULL);
+    }
+
+    return response;
+}
+
+// Transpose the last two dimensions of given matrix into a new matrix.
+ArithmeticOperationReturn transpose_matrix(const MultiDimensionalMatrix* matrix) {
+    /*
+
+        Materializes `transpose_matrix_view`: a 2-D matrix is transposed, the inner matrices
+        of an N-D matrix are transposed each (a 1-D matrix is copied). The elements are moved
+        in cache-sized blocks by several threads.
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The transposed matrix.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                 = No error.
+
+        » For the other possible ErrorCodes, see what `create_matrix_view` & `copy_matrix_view` return. «
+
+    */
+
+    ArithmeticOperationReturn response;
+    response.error_code = ERR_NONE;
+    response.result_matrix.head_ptr = NULL;
+
+    MatrixView view;
+    response.error_code = create_matrix_view(&view, matrix);
+
+    if (response.error_code == ERR_NONE) {
+        response.error_code = transpose_matrix_view(&view, &view);
+    }
+
+    if (response.error_code != ERR_NONE) {
+        return response;
+    }
+
+    return copy_matrix_view(&view);
+}
+
+// Reorder the dimensions of given matrix into a new matrix.
+ArithmeticOperationReturn permute_matrix_axes(const MultiDimensionalMatrix* matrix, const size_t* axes) {
+    /*
+
+        Dimension `i` of the result is dimension `axes[i]` of the matrix (see
+        `permute_matrix_view_axes`). The elements are moved in cache-sized blocks by several
+        threads.
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The permuted matrix.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                 = No error.
+        ERR_INVALID_ARGS         = `axes` is not a permutation of the dimensions;
+
+        » For the other possible ErrorCodes, see what `create_matrix_view` & `copy_matrix_view` return. «
+
+    */
+
+    ArithmeticOperationReturn response;
+    response.error_code = ERR_NONE;
+    response.result_matrix.head_ptr = NULL;
+
+    MatrixView view;
+    response.error_code = create_matrix_view(&view, matrix);
+
+    if (response.error_code == ERR_NONE) {
+        response.error_code = permute_matrix_view_axes(&view, &view, axes);
+    }
+
+    if (response.error_code != ERR_NONE) {
+        return response;
+    }
+
+    return copy_matrix_view(&view);
+}
+
+// Transpose the square inner matrices of given matrix without a second buffer.
+ErrorCode transpose_matrix_in_place(MultiDimensionalMatrix* matrix) {
+    /*
+
+        The last two dimensions have to be equal (leading dimensions are batches, like in
+        `transpose_matrix`). Blocks above the diagonal are swapped with the transposed blocks
+        below it, block-rows are distributed over several threads. A 1-D matrix is unchanged.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                    = No error.
+        ERR_NULL_PTR                = Matrix does not exist or head-pointer is NULL;
+        ERR_DIMENSION_SIZE_MISMATCH = The last two dimensions are not equal;
+        ERR_READ_ONLY               = The matrix is a read-only mapping of a file;
+        ERR_UNSUPPORTED_DATATYPE    = Unsupported data-type;
+
+    */
+
+    if (!matrix || !matrix->head_ptr || !matrix->head_ptr->data) {
+        // Matrix does not exist or head-pointer is NULL.
+        return ERR_NULL_PTR;
+    }
+
+    MultiDimensionalMatrixNode* node = matrix->head_ptr;
+    TransposeTask task;
+
+    if (!select_transpose_kernels(&task, get_data_type_size(node->data_type))) {
+        // Unsupported Data-Type
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    if (node->number_of_dimensions < 2) {
+        // Nothing to transpose
+        return ERR_NONE;
+    }
+
+    size_t n = node->dimensions[node->number_of_dimensions - 1];
+
+    if (node->dimensions[node->number_of_dimensions - 2] != n) {
+        // Not square
+        return ERR_DIMENSION_SIZE_MISMATCH;
+    }
+
+    if (node->storage == STORAGE_MAPPED_READ_ONLY) {
+        // Writing would fault
+        return ERR_READ_ONLY;
+    }
+
+    size_t number_of_batches = 1;
+
+    for (size_t i = 0; i + 2 < node->number_of_dimensions; i++) {
+        number_of_batches *= node->dimensions[i];
+    }
+
+    if (n < 2 || number_of_batches == 0) {
+        return ERR_NONE;
+    }
+
+    task.destination = (char*)node->data;
+    task.rows = n;
+    task.strips_per_batch = (n + IN_PLACE_TRANSPOSE_BLOCK - 1) / IN_PLACE_TRANSPOSE_BLOCK;
+
+    // A block-row swaps up to `n * IN_PLACE_TRANSPOSE_BLOCK` elements
+    size_t minimum_chunk = PARALLEL_TRANSPOSE_CHUNK / (n * IN_PLACE_TRANSPOSE_BLOCK);
+
+    parallel_for(number_of_batches * task.strips_per_batch, minimum_chunk > 0 ? minimum_chunk : 1, transpose_block_rows_in_place, &task);
+
+    return ERR_NONE;
+}
+
+// Stretch a view to the given shape by repeating its size-1 and missing leading dimensions.
+ErrorCode broadcast_matrix_view(MatrixView* result, const MatrixView* view, size_t number_of_dimensions, const size_t* dimensions) {
+    /*
+
+        Broadcasting follows the NumPy-rules: the shapes are aligned at their last dimension,
+        every dimension of the view has to be either equal to the target-size or `1`.
+        Stretched dimensions get the stride `0`, so no element is copied.
+        __Caution__: Writing through a broadcasted view modifies the same element several times.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                    = No error.
+        ERR_NULL_PTR                = One of the views does not exist; Dimensions-array does not exist;
+        ERR_INVALID_ARGS            = Invalid number of dimensions;
+        ERR_DIMENSION_SIZE_MISMATCH = The view cannot be stretched to the given shape;
+
+    */
+
+    if (!result || !view || !dimensions || !view->parent) {
+        return ERR_NULL_PTR;
+    }
+
+    if (number_of_dimensions < view->number_of_dimensions || number_of_dimensions > MAX_VIEW_DIMENSIONS) {
+        return ERR_INVALID_ARGS;
+    }
+
+    MatrixView broadcasted = *view;
+    size_t missing = number_of_dimensions - view->number_of_dimensions;
+
+    broadcasted.number_of_dimensions = number_of_dimensions;
+
+    for (size_t i = 0; i < number_of_dimensions; i++) {
+        broadcasted.dimensions[i] = dimensions[i];
+
+        if (i < missing) {
+            // Missing leading dimension
+            broadcasted.strides[i] = 0;
+            continue;
+        }
+
+        size_t size = view->dimensions[i - missing];
+
+        if (size == dimensions[i]) {
+            broadcasted.strides[i] = view->strides[i - missing];
+        } else if (size == 1) {
+            broadcasted.strides[i] = 0;
+        } else {
+            return ERR_DIMENSION_SIZE_MISMATCH;
+        }
+    }
+
+    *result = broadcasted;
+
+    return ERR_NONE;
+}
+
+// Merge the shape of a view into an accumulated broadcast-shape.
+static ErrorCode broadcast_shape_with_view(size_t* number_of_dimensions, size_t* dimensions, const MatrixView* view) {
+    size_t count = *number_of_dimensions > view->number_of_dimensions ? *number_of_dimensions : view->number_of_dimensions;
+    size_t shift = count - *number_of_dimensions;
+
+    // Align the accumulated shape at its last dimension
+    for (size_t i = count; i-- > 0;) {
+        dimensions[i] = i < shift ? 1 : dimensions[i - shift];
+    }
+
+    size_t missing = count - view->number_of_dimensions;
+
+    for (size_t i = missing; i < count; i++) {
+        size_t size = view->dimensions[i - missing];
+
+        if (dimensions[i] == 1) {
+            dimensions[i] = size;
+        } else if (size != 1 && size != dimensions[i]) {
+            // Incompatible dimension-sizes
+            return ERR_DIMENSION_SIZE_MISMATCH;
+        }
+    }
+
+    *number_of_dimensions = count;
+
+    return ERR_NONE;
+}
+
+// Calculate the shape both views broadcast to.
+static ErrorCode broadcast_shapes(const MatrixView* view_A, const MatrixView* view_B, size_t* number_of_dimensions, size_t* dimensions) {
+    *number_of_dimensions = 0;
+
+    ErrorCode error = broadcast_shape_with_view(number_of_dimensions, dimensions, view_A);
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    return broadcast_shape_with_view(number_of_dimensions, dimensions, view_B);
+}
+
+// Evaluate `result = A <operation> B` element-wise with broadcasting.
+static ArithmeticOperationReturn broadcast_binary_operation(const MatrixView* view_A, const MatrixView* view_B, BinaryOperation operation) {
+    ArithmeticOperationReturn response;
+    response.error_code = ERR_NONE;
+    response.result_matrix.head_ptr = NULL;
+
+    if (!view_A || !view_B || !view_A->parent || !view_B->parent || !view_A->parent->data || !view_B->parent->data) {
+        response.error_code = ERR_NULL_PTR;
+        return response;
+    }
+
+    size_t number_of_dimensions;
+    size_t dimensions[MAX_VIEW_DIMENSIONS];
+
+    response.error_code = broadcast_shapes(view_A, view_B, &number_of_dimensions, dimensions);
+
+    if (response.error_code != ERR_NONE) {
+        return response;
+    }
+
+    if (view_A->data_type != view_B->data_type) {
+        response.error_code = ERR_DATATYPE_MISMATCH;
+        return response;
+    }
+
+    StridedInnerLoop loop = select_binary_loop(operation, view_A->data_type);
+
+    if (!loop) {
+        response.error_code = ERR_UNSUPPORTED_DATATYPE;
+        return response;
+    }
+
+    // Stretch both operands virtually, the result has the full shape
+    MatrixView stretched_A, stretched_B, result_view;
+    broadcast_matrix_view(&stretched_A, view_A, number_of_dimensions, dimensions);
+    broadcast_matrix_view(&stretched_B, view_B, number_of_dimensions, dimensions);
+
+    response.error_code = create_matrix_for_view(&response.result_matrix, &stretched_A, &result_view);
+
+    if (response.error_code != ERR_NONE) {
+        clear_matrix(&response.result_matrix);
+        return response;
+    }
+
+    StridedOperands operands;
+    init_strided_operands(&operands, &result_view);
+    add_view_operand(&operands, &result_view);
+    add_view_operand(&operands, &stretched_A);
+    add_view_operand(&operands, &stretched_B);
+
+    run_strided_loop(&operands, loop, NULL);
+
+    return response;
+}
+
+// Element-wise sum of two views.
+ArithmeticOperationReturn add_matrix_views(const MatrixView* view_A, const MatrixView* view_B) {
+    /*
+
+        Same as `add_matrices`, but the operands can be arbitrary (e.g. sliced or transposed) views.
+        The shapes of both views are broadcasted (see `broadcast_matrix_view`).
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The result of this operation.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                        = No error.
+        ERR_NULL_PTR                    = One or both views do not exist;
+        ERR_DIMENSION_SIZE_MISMATCH     = The shapes of both views are not broadcastable;
+        ERR_DATATYPE_MISMATCH           = The data types of both views do not match;
+        ERR_UNSUPPORTED_DATATYPE        = Unsupported data-type;
+
+    */
+
+    return broadcast_binary_operation(view_A, view_B, BINARY_ADD);
+}
+
+// Element-wise (Hadamard) product of two views.
+ArithmeticOperationReturn multiply_matrix_views_elementwise(const MatrixView* view_A, const MatrixView* view_B) {
+    /*
+
+        The shapes of both views are broadcasted (see `broadcast_matrix_view`).
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The result of this operation.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                        = No error.
+        ERR_NULL_PTR                    = One or both views do not exist;
+        ERR_DIMENSION_SIZE_MISMATCH     = The shapes of both views are not broadcastable;
+        ERR_DATATYPE_MISMATCH           = The data types of both views do not match;
+        ERR_UNSUPPORTED_DATATYPE        = Unsupported data-type;
+
+    */
+
+    return broadcast_binary_operation(view_A, view_B, BINARY_MULTIPLY);
+}
+
+//
+// Map & Zip
+//
+
+/*
+
+    `matrix_map`/`matrix_zip` run one inner loop per data-type and operation over the
+    strided iteration (so broadcasting and non-contiguous operands work like in
+    `add_matrices`). Callbacks get whole rows of contiguous elements: rows of strided or
+    broadcasted operands are gathered into blocks first and scattered back afterwards.
+
+*/
+
+// Elements, which are gathered per callback of a non-contiguous row
+#define MAP_BLOCK_SIZE 256
+
+// Built-in operations on compute-values
+#define MAP_NEGATE_VALUE(x) (-(x))
+#define MAP_ABSOLUTE_VALUE(x) ((x) < 0 ? -(x) : (x))
+#define MAP_SQUARE_VALUE(x) ((x) * (x))
+
+// Integers are negated and squared in `unsigned`, so overflows (e.g. -MIN) wrap instead of being undefined
+#define MAP_NEGATE_INTEGER(x) ((long long)(0ull - (unsigned long long)(x)))
+#define MAP_ABSOLUTE_INTEGER(x) ((x) < 0 ? MAP_NEGATE_INTEGER(x) : (long long)(x))
+#define MAP_SQUARE_INTEGER(x) ((long long)((unsigned long long)(x) * (unsigned long long)(x)))
+#define ZIP_SUBTRACT_VALUES(x, y) ((x) - (y))
+#define ZIP_DIVIDE_VALUES(x, y) ((x) / (y))
+// Division by zero gives 0; dividing by -1 negates in `unsigned`, so MIN / -1 wraps to MIN instead of trapping
+#define ZIP_DIVIDE_INTEGERS(x, y) ((y) == 0 ? 0 : (y) == -1 ? MAP_NEGATE_INTEGER(x) : (x) / (y))
+#define ZIP_MINIMUM_VALUES(x, y) ((x) < (y) ? (x) : (y))
+#define ZIP_MAXIMUM_VALUES(x, y) ((x) > (y) ? (x) : (y))
+#define ZIP_EQUAL_VALUES(x, y) ((x) == (y))
+#define ZIP_NOT_EQUAL_VALUES(x, y) ((x) != (y))
+#define ZIP_LESS_VALUES(x, y) ((x) < (y))
+#define ZIP_LESS_EQUAL_VALUES(x, y) ((x) <= (y))
+#define ZIP_GREATER_VALUES(x, y) ((x) > (y))
+#define ZIP_GREATER_EQUAL_VALUES(x, y) ((x) >= (y))
+
+// Inner loop for `out = EXPRESSION(in)` with a fast path for contiguous operands.
+#define DEFINE_MAP_LOOP(NAME, STORAGE, COMPUTE, LOAD, STORE, EXPRESSION)                                \
+static void NAME(char** data, const size_t* strides, size_t count, const void* context) {              \
+    (void)context;                                                                                      \
+    if (strides[0] == sizeof(STORAGE) && strides[1] == sizeof(STORAGE)) {                               \
+        STORAGE* out = (STORAGE*)data[0];                                                               \
+        const STORAGE* in = (const STORAGE*)data[1];                                                    \
+        for (size_t i = 0; i < count; i++) {                                                            \
+            const COMPUTE x = LOAD(in[i]);                                                              \
+            out[i] = STORE(STORAGE, EXPRESSION(x));                                                     \
+        }                                                                                               \
+        return;                                                                                         \
+    }                                                                                                   \
+    char* out_bytes = data[0];                                                                          \
+    const char* in_bytes = data[1];                                                                     \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        const COMPUTE x = LOAD(*(const STORAGE*)in_bytes);                                              \
+        *(STORAGE*)out_bytes = STORE(STORAGE, EXPRESSION(x));                                           \
+        out_bytes += strides[0];                                                                        \
+        in_bytes += strides[1];                                                                         \
+    }                                                                                                   \
+}
+
+// Inner loop for `out = min(max(in, lower), upper)`; the bounds are operands `2` & `3` (scalars).
+#define DEFINE_CLAMP_LOOP(NAME, STORAGE, COMPUTE, LOAD, STORE)                                          \
+static void NAME(char** data, const size_t* strides, size_t count, const void* context) {              \
+    (void)context;                                                                                      \
+    const COMPUTE lower = LOAD(*(const STORAGE*)data[2]);                                               \
+    const COMPUTE upper = LOAD(*(const STORAGE*)data[3]);                                               \
+    char* out_bytes = data[0];                                                                          \
+    const char* in_bytes = data[1];                                                                     \
+    if (strides[0] == sizeof(STORAGE) && strides[1] == sizeof(STORAGE)) {                               \
+        STORAGE* out = (STORAGE*)out_bytes;                                                             \
+        const STORAGE* in = (const STORAGE*)in_bytes;                                                   \
+        for (size_t i = 0; i < count; i++) {                                                            \
+            const COMPUTE x = LOAD(in[i]);                                                              \
+            out[i] = STORE(STORAGE, x < lower ? lower : x > upper ? upper : x);                         \
+        }                                                                                               \
+        return;                                                                                         \
+    }                                                                                                   \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        const COMPUTE x = LOAD(*(const STORAGE*)in_bytes);                                              \
+        *(STORAGE*)out_bytes = STORE(STORAGE, x < lower ? lower : x > upper ? upper : x);               \
+        out_bytes += strides[0];                                                                        \
+        in_bytes += strides[1];                                                                         \
+    }                                                                                                   \
+}
+
+// Inner loop for `out = EXPRESSION(a, b)` with fast paths for contiguous and scalar operands.
+#define DEFINE_ZIP_LOOP(NAME, STORAGE, COMPUTE, LOAD, STORE, EXPRESSION)                                \
+static void NAME(char** data, const size_t* strides, size_t count, const void* context) {              \
+    (void)context;                                                                                      \
+    STORAGE* out = (STORAGE*)data[0];                                                                   \
+    const STORAGE* a = (const STORAGE*)data[1];                                                         \
+    const STORAGE* b = (const STORAGE*)data[2];                                                         \
+    if (strides[0] == sizeof(STORAGE) && strides[1] == sizeof(STORAGE) && strides[2] == sizeof(STORAGE)) { \
+        for (size_t i = 0; i < count; i++) {                                                            \
+            const COMPUTE x = LOAD(a[i]), y = LOAD(b[i]);                                               \
+            out[i] = STORE(STORAGE, EXPRESSION(x, y));                                                  \
+        }                                                                                               \
+    } else if (strides[0] == sizeof(STORAGE) && strides[1] == sizeof(STORAGE) && strides[2] == 0) {     \
+        const COMPUTE y = LOAD(*b);                                                                     \
+        for (size_t i = 0; i < count; i++) {                                                            \
+            const COMPUTE x = LOAD(a[i]);                                                               \
+            out[i] = STORE(STORAGE, EXPRESSION(x, y));                                                  \
+        }                                                                                               \
+    } else if (strides[0] == sizeof(STORAGE) && strides[1] == 0 && strides[2] == sizeof(STORAGE)) {     \
+        const COMPUTE x = LOAD(*a);                                                                     \
+        for (size_t i = 0; i < count; i++) {                                                            \
+            const COMPUTE y = LOAD(b[i]);                                                               \
+            out[i] = STORE(STORAGE, EXPRESSION(x, y));                                                  \
+        }                                                                                               \
+    } else {                                                                                            \
+        char* out_bytes = data[0];                                                                      \
+        const char* a_bytes = data[1];                                                                  \
+        const char* b_bytes = data[2];                                                                  \
+        for (size_t i = 0; i < count; i++) {                                                            \
+            const COMPUTE x = LOAD(*(const STORAGE*)a_bytes), y = LOAD(*(const STORAGE*)b_bytes);       \
+            *(STORAGE*)out_bytes = STORE(STORAGE, EXPRESSION(x, y));                                    \
+            out_bytes += strides[0];                                                                    \
+            a_bytes += strides[1];                                                                      \
+            b_bytes += strides[2];                                                                      \
+        }                                                                                               \
+    }                                                                                                   \
+}
+
+// Map- & zip-loops of one data-type (see `FOR_EACH_DATA_TYPE`)
+#define DEFINE_MAP_ZIP_LOOPS(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE, NEGATE, ABSOLUTE, SQUARE, DIVIDE) \
+    DEFINE_MAP_LOOP(negate_##NAME##_loop, STORAGE, COMPUTE, LOAD, STORE, NEGATE)                        \
+    DEFINE_MAP_LOOP(absolute_##NAME##_loop, STORAGE, COMPUTE, LOAD, STORE, ABSOLUTE)                    \
+    DEFINE_MAP_LOOP(square_##NAME##_loop, STORAGE, COMPUTE, LOAD, STORE, SQUARE)                        \
+    DEFINE_CLAMP_LOOP(clamp_##NAME##_loop, STORAGE, COMPUTE, LOAD, STORE)                               \
+    DEFINE_ZIP_LOOP(subtract_##NAME##_loop, STORAGE, COMPUTE, LOAD, STORE, ZIP_SUBTRACT_VALUES)         \
+    DEFINE_ZIP_LOOP(divide_##NAME##_loop, STORAGE, COMPUTE, LOAD, STORE, DIVIDE)                        \
+    DEFINE_ZIP_LOOP(minimum_##NAME##_loop, STORAGE, COMPUTE, LOAD, STORE, ZIP_MINIMUM_VALUES)           \
+    DEFINE_ZIP_LOOP(maximum_##NAME##_loop, STORAGE, COMPUTE, LOAD, STORE, ZIP_MAXIMUM_VALUES)           \
+    DEFINE_ZIP_LOOP(equal_##NAME##_loop, STORAGE, COMPUTE, LOAD, STORE, ZIP_EQUAL_VALUES)               \
+    DEFINE_ZIP_LOOP(not_equal_##NAME##_loop, STORAGE, COMPUTE, LOAD, STORE, ZIP_NOT_EQUAL_VALUES)       \
+    DEFINE_ZIP_LOOP(less_##NAME##_loop, STORAGE, COMPUTE, LOAD, STORE, ZIP_LESS_VALUES)                 \
+    DEFINE_ZIP_LOOP(less_equal_##NAME##_loop, STORAGE, COMPUTE, LOAD, STORE, ZIP_LESS_EQUAL_VALUES)     \
+    DEFINE_ZIP_LOOP(greater_##NAME##_loop, STORAGE, COMPUTE, LOAD, STORE, ZIP_GREATER_VALUES)           \
+    DEFINE_ZIP_LOOP(greater_equal_##NAME##_loop, STORAGE, COMPUTE, LOAD, STORE, ZIP_GREATER_EQUAL_VALUES)
+
+// Integers are divided with `ZIP_DIVIDE_INTEGERS`, so a division by zero gives 0 instead of a trap
+#define DEFINE_MAP_ZIP_LOOPS_OF_TYPE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE)                         \
+    DEFINE_MAP_ZIP_LOOPS(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE,                                     \
+                         MAP_NEGATE_VALUE, MAP_ABSOLUTE_VALUE, MAP_SQUARE_VALUE, ZIP_DIVIDE_VALUES)
+#define DEFINE_MAP_ZIP_LOOPS_OF_INTEGER_TYPE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE)                 \
+    DEFINE_MAP_ZIP_LOOPS(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE,                                     \
+                         MAP_NEGATE_INTEGER, MAP_ABSOLUTE_INTEGER, MAP_SQUARE_INTEGER, ZIP_DIVIDE_INTEGERS)
+
+DEFINE_MAP_ZIP_LOOPS_OF_INTEGER_TYPE(TYPE_INT,   int,    int,     int,     LOAD_VALUE, STORE_VALUE)
+DEFINE_MAP_ZIP_LOOPS_OF_TYPE(TYPE_FLOAT,         float,  float,   float,   LOAD_VALUE, STORE_VALUE)
+DEFINE_MAP_ZIP_LOOPS_OF_TYPE(TYPE_DOUBLE,        double, double,  double,  LOAD_VALUE, STORE_VALUE)
+DEFINE_MAP_ZIP_LOOPS_OF_INTEGER_TYPE(TYPE_INT8,  int8,   int8_t,  int,     LOAD_VALUE, STORE_VALUE)
+DEFINE_MAP_ZIP_LOOPS_OF_INTEGER_TYPE(TYPE_INT16, int16,  int16_t, int,     LOAD_VALUE, STORE_VALUE)
+DEFINE_MAP_ZIP_LOOPS_OF_INTEGER_TYPE(TYPE_INT64, int64,  int64_t, int64_t, LOAD_VALUE, STORE_VALUE)
+DEFINE_MAP_ZIP_LOOPS_OF_INTEGER_TYPE(TYPE_UINT8, uint8,  uint8_t, int,     LOAD_VALUE, STORE_VALUE)
+FOR_EACH_HALF_DATA_TYPE(DEFINE_MAP_ZIP_LOOPS_OF_TYPE)
+
+// Pick the inner loop of a map-operation for the given data-type.
+static StridedInnerLoop select_map_loop(MapOperation operation, DataType data_type) {
+    /*
+
+        Returns NULL if the data-type or the operation is not supported.
+
+    */
+
+    #define MAP_LOOP_CASE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE)                                    \
+        case ENUM:                                                                                      \
+            return operation == MAP_NEGATE ? negate_##NAME##_loop :                                     \
+                   operation == MAP_ABSOLUTE ? absolute_##NAME##_loop :                                 \
+                   operation == MAP_SQUARE ? square_##NAME##_loop : NULL;
+
+    switch(data_type) {
+        FOR_EACH_DATA_TYPE(MAP_LOOP_CASE)
+
+        default:
+            // Unsupported Data-Type
+            return NULL;
+    }
+
+    #undef MAP_LOOP_CASE
+}
+
+static StridedInnerLoop select_clamp_loop(DataType data_type) {
+    #define CLAMP_LOOP_CASE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE) case ENUM: return clamp_##NAME##_loop;
+
+    switch(data_type) {
+        FOR_EACH_DATA_TYPE(CLAMP_LOOP_CASE)
+
+        default:
+            // Unsupported Data-Type
+            return NULL;
+    }
+
+    #undef CLAMP_LOOP_CASE
+}
+
+// Pick the inner loop of a zip-operation for the given data-type.
+static StridedInnerLoop select_zip_loop(ZipOperation operation, DataType data_type) {
+    /*
+
+        Returns NULL if the data-type or the operation is not supported.
+
+    */
+
+    if (operation == ZIP_ADD || operation == ZIP_MULTIPLY) {
+        return select_binary_loop(operation == ZIP_ADD ? BINARY_ADD : BINARY_MULTIPLY, data_type);
+    }
+
+    #define ZIP_LOOP_CASE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE)                                    \
+        case ENUM: {                                                                                    \
+            static const StridedInnerLoop loops[] = {                                                   \
+                [ZIP_SUBTRACT] = subtract_##NAME##_loop,           [ZIP_DIVIDE] = divide_##NAME##_loop, \
+                [ZIP_MINIMUM] = minimum_##NAME##_loop,             [ZIP_MAXIMUM] = maximum_##NAME##_loop, \
+                [ZIP_EQUAL] = equal_##NAME##_loop,                 [ZIP_NOT_EQUAL] = not_equal_##NAME##_loop, \
+                [ZIP_LESS] = less_##NAME##_loop,                   [ZIP_LESS_EQUAL] = less_equal_##NAME##_loop, \
+                [ZIP_GREATER] = greater_##NAME##_loop,             [ZIP_GREATER_EQUAL] = greater_equal_##NAME##_loop \
+            };                                                                                          \
+            return (unsigned)operation <= ZIP_GREATER_EQUAL ? loops[operation] : NULL;                 \
+        }
+
+    switch(data_type) {
+        FOR_EACH_DATA_TYPE(ZIP_LOOP_CASE)
+
+        default:
+            // Unsupported Data-Type
+            return NULL;
+    }
+
+    #undef ZIP_LOOP_CASE
+}
+
+// Callback of `matrix_map_function`/`matrix_zip_function` with its arguments.
+typedef struct MapFunctionContext {
+    MatrixMapFunction map_function;
+    MatrixZipFunction zip_function;
+    void* context;
+    size_t element_size;
+    size_t number_of_inputs;
+} MapFunctionContext;
+
+// Inner loop, which passes contiguous rows (or gathered blocks of a row) to a callback.
+static void map_function_loop(char** data, const size_t* strides, size_t count, const void* context) {
+    const MapFunctionContext* function = (const MapFunctionContext*)context;
+    size_t element_size = function->element_size;
+    size_t number_of_operands = function->number_of_inputs + 1;
+    int contiguous = 1;
+
+    for (size_t op = 0; op < number_of_operands; op++) {
+        contiguous &= strides[op] == element_size;
+    }
+
+    if (contiguous) {
+        if (function->map_function) {
+            function->map_function(data[0], data[1], count, function->context);
+        } else {
+            function->zip_function(data[0], data[1], data[2], count, function->context);
+        }
+        return;
+    }
+
+    // Gather every operand into a block (`double` keeps it aligned for every data-type), the result is scattered afterwards
+    double blocks[3][MAP_BLOCK_SIZE];
+
+    for (size_t start = 0; start < count; start += MAP_BLOCK_SIZE) {
+        size_t length = count - start < MAP_BLOCK_SIZE ? count - start : MAP_BLOCK_SIZE;
+
+        for (size_t op = 1; op < number_of_operands; op++) {
+            for (size_t i = 0; i < length; i++) {
+                memcpy((char*)blocks[op] + i * element_size, data[op] + (start + i) * strides[op], element_size);
+            }
+        }
+
+        if (function->map_function) {
+            function->map_function(blocks[0], blocks[1], length, function->context);
+        } else {
+            function->zip_function(blocks[0], blocks[1], blocks[2], length, function->context);
+        }
+
+        for (size_t i = 0; i < length; i++) {
+            memcpy(data[0] + (start + i) * strides[0], (char*)blocks[0] + i * element_size, element_size);
+        }
+    }
+}
+
+// Check the output of a map/zip, which has to have the given shape and data-type.
+static ErrorCode check_map_output(const MultiDimensionalMatrix* out, size_t number_of_dimensions, const size_t* dimensions, DataType data_type) {
+    if (out->head_ptr->number_of_dimensions != number_of_dimensions) {
+        return ERR_DIMENSION_COUNT_MISMATCH;
+    }
+
+    for (size_t i = 0; i < number_of_dimensions; i++) {
+        if (out->head_ptr->dimensions[i] != dimensions[i]) {
+            return ERR_DIMENSION_SIZE_MISMATCH;
+        }
+    }
+
+    if (out->head_ptr->data_type != data_type) {
+        return ERR_DATATYPE_MISMATCH;
+    }
+
+    if (out->head_ptr->storage == STORAGE_MAPPED_READ_ONLY) {
+        // Writing would fault
+        return ERR_READ_ONLY;
+    }
+
+    return ERR_NONE;
+}
+
+// Shared part of the map-functions: `out = loop(in, scalars...)`.
+static ErrorCode run_map(MultiDimensionalMatrix* out, const MultiDimensionalMatrix* in, StridedInnerLoop loop,
+                         const void* context, void* lower, void* upper) {
+    if (!out || !in || !out->head_ptr || !in->head_ptr || !out->head_ptr->data || !in->head_ptr->data) {
+        // Matrix does not exist
+        return ERR_NULL_PTR;
+    }
+
+    MatrixView view_in, view_out;
+    ErrorCode error = create_matrix_view(&view_in, in);
+
+    if (error == ERR_NONE) {
+        error = create_matrix_view(&view_out, out);
+    }
+
+    if (error == ERR_NONE) {
+        error = check_map_output(out, view_in.number_of_dimensions, view_in.dimensions, view_in.data_type);
+    }
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    if (!loop) {
+        // Unsupported Data-Type (or operation)
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    StridedOperands operands;
+    init_strided_operands(&operands, &view_out);
+    add_view_operand(&operands, &view_out);
+    add_view_operand(&operands, &view_in);
+
+    if (lower) {
+        add_scalar_operand(&operands, lower);
+        add_scalar_operand(&operands, upper);
+    }
+
+    run_strided_loop(&operands, loop, context);
+
+    return ERR_NONE;
+}
+
+// Shared part of the zip-functions: `out = loop(a, b)` with broadcasting.
+static ErrorCode run_zip(MultiDimensionalMatrix* out, const MultiDimensionalMatrix* a, const MultiDimensionalMatrix* b,
+                         StridedInnerLoop loop, const void* context) {
+    if (!out || !a || !b || !out->head_ptr || !a->head_ptr || !b->head_ptr ||
+        !out->head_ptr->data || !a->head_ptr->data || !b->head_ptr->data) {
+        // Matrix does not exist
+        return ERR_NULL_PTR;
+    }
+
+    MatrixView view_A, view_B, view_out;
+    ErrorCode error = create_matrix_view(&view_A, a);
+
+    if (error == ERR_NONE) {
+        error = create_matrix_view(&view_B, b);
+    }
+
+    if (error == ERR_NONE) {
+        error = create_matrix_view(&view_out, out);
+    }
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    size_t number_of_dimensions;
+    size_t dimensions[MAX_VIEW_DIMENSIONS];
+
+    error = broadcast_shapes(&view_A, &view_B, &number_of_dimensions, dimensions);
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    if (view_A.data_type != view_B.data_type) {
+        return ERR_DATATYPE_MISMATCH;
+    }
+
+    error = check_map_output(out, number_of_dimensions, dimensions, view_A.data_type);
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    if (!loop) {
+        // Unsupported Data-Type (or operation)
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    MatrixView stretched_A, stretched_B;
+    broadcast_matrix_view(&stretched_A, &view_A, number_of_dimensions, dimensions);
+    broadcast_matrix_view(&stretched_B, &view_B, number_of_dimensions, dimensions);
+
+    StridedOperands operands;
+    init_strided_operands(&operands, &view_out);
+    add_view_operand(&operands, &view_out);
+    add_view_operand(&operands, &stretched_A);
+    add_view_operand(&operands, &stretched_B);
+
+    run_strided_loop(&operands, loop, context);
+
+    return ERR_NONE;
+}
+
+// Apply a built-in operation to every element of a matrix.
+ErrorCode matrix_map(MultiDimensionalMatrix* out, const MultiDimensionalMatrix* in, MapOperation operation) {
+    /*
+
+        `out` has to have the shape and data-type of `in`, it may be `in` itself (in place).
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                        = No error.
+        ERR_NULL_PTR                    = One of the matrices does not exist;
+        ERR_DIMENSION_COUNT_MISMATCH    = `out` has another number of dimensions than `in`;
+        ERR_DIMENSION_SIZE_MISMATCH     = `out` has another shape than `in`;
+        ERR_DATATYPE_MISMATCH           = `out` has another data-type than `in`;
+        ERR_READ_ONLY                   = `out` is a read-only mapping of a file;
+        ERR_UNSUPPORTED_DATATYPE        = Unsupported data-type or operation;
+
+        » For the other possible ErrorCodes, see what `create_matrix_view` returns. «
+
+    */
+
+    StridedInnerLoop loop = in && in->head_ptr ? select_map_loop(operation, in->head_ptr->data_type) : NULL;
+
+    return run_map(out, in, loop, NULL, NULL, NULL);
+}
+
+// Limit every element of a matrix to the range [minimum, maximum].
+ErrorCode matrix_clamp(MultiDimensionalMatrix* out, const MultiDimensionalMatrix* in, const void* minimum, const void* maximum) {
+    /*
+
+        `minimum` & `maximum` point to values of the data-type of the matrices.
+
+        Returns ERR_NULL_PTR if one of the bounds does not exist.
+
+        » For the other possible ErrorCodes, see what `matrix_map` returns. «
+
+    */
+
+    if (!minimum || !maximum) {
+        return ERR_NULL_PTR;
+    }
+
+    StridedInnerLoop loop = in && in->head_ptr ? select_clamp_loop(in->head_ptr->data_type) : NULL;
+
+    return run_map(out, in, loop, NULL, (void*)minimum, (void*)maximum);
+}
+
+// Apply a callback to every element of a matrix.
+ErrorCode matrix_map_function(MultiDimensionalMatrix* out, const MultiDimensionalMatrix* in, MatrixMapFunction function, void* context) {
+    /*
+
+        `function(out, in, count, context)` gets `count` contiguous elements of the data-type
+        of the matrices and writes `count` results. Strided rows are passed in blocks of at
+        most `MAP_BLOCK_SIZE` elements.
+
+        Returns ERR_NULL_PTR if the function does not exist.
+
+        » For the other possible ErrorCodes, see what `matrix_map` returns. «
+
+    */
+
+    if (!function) {
+        return ERR_NULL_PTR;
+    }
+
+    MapFunctionContext map_context = { function, NULL, context, 0, 1 };
+    StridedInnerLoop loop = NULL;
+
+    if (in && in->head_ptr && get_data_type_size(in->head_ptr->data_type)) {
+        map_context.element_size = get_data_type_size(in->head_ptr->data_type);
+        loop = map_function_loop;
+    }
+
+    return run_map(out, in, loop, &map_context, NULL, NULL);
+}
+
+// Combine the elements of two matrices with a built-in operation.
+ErrorCode matrix_zip(MultiDimensionalMatrix* out, const MultiDimensionalMatrix* a, const MultiDimensionalMatrix* b, ZipOperation operation) {
+    /*
+
+        The shapes of `a` and `b` are broadcasted (see `broadcast_matrix_view`), `out` has to
+        have the broadcasted shape and their data-type. It may be one of the inputs, if that
+        one has the full shape. Comparisons write `1` or `0`. Integer divisions by zero give `0`.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                        = No error.
+        ERR_NULL_PTR                    = One of the matrices does not exist;
+        ERR_DIMENSION_COUNT_MISMATCH    = `out` has another number of dimensions than the broadcasted shape;
+        ERR_DIMENSION_SIZE_MISMATCH     = The inputs are not broadcastable; `out` has another shape;
+        ERR_DATATYPE_MISMATCH           = The data-types of the matrices do not match;
+        ERR_READ_ONLY                   = `out` is a read-only mapping of a file;
+        ERR_UNSUPPORTED_DATATYPE        = Unsupported data-type or operation;
+
+        » For the other possible ErrorCodes, see what `create_matrix_view` returns. «
+
+    */
+
+    StridedInnerLoop loop = a && a->head_ptr ? select_zip_loop(operation, a->head_ptr->data_type) : NULL;
+
+    return run_zip(out, a, b, loop, NULL);
+}
+
+// Combine the elements of two matrices with a callback.
+ErrorCode matrix_zip_function(MultiDimensionalMatrix* out, const MultiDimensionalMatrix* a, const MultiDimensionalMatrix* b,
+                              MatrixZipFunction function, void* context) {
+    /*
+
+        `function(out, a, b, count, context)` gets `count` contiguous elements of both inputs
+        (broadcasted elements are repeated) and writes `count` results.
+
+        Returns ERR_NULL_PTR if the function does not exist.
+
+        » For the other possible ErrorCodes, see what `matrix_zip` returns. «
+
+    */
+
+    if (!function) {
+        return ERR_NULL_PTR;
+    }
+
+    MapFunctionContext zip_context = { NULL, function, context, 0, 2 };
+    StridedInnerLoop loop = NULL;
+
+    if (a && a->head_ptr && get_data_type_size(a->head_ptr->data_type)) {
+        zip_context.element_size = get_data_type_size(a->head_ptr->data_type);
+        loop = map_function_loop;
+    }
+
+    return run_zip(out, a, b, loop, &zip_context);
+}
+
+// Compute `result = A * B` for two 2-D views into an already created, contiguous result-matrix.
+static ErrorCode multiply_2d_views_into(MultiDimensionalMatrix* result_matrix, const MatrixView* view_A, const MatrixView* view_B) {
+    size_t element_size = get_data_type_size(view_A->data_type);
+    const char* data_A = (const char*)view_A->parent->data + view_A->offset * element_size;
+    const char* data_B = (const char*)view_B->parent->data + view_B->offset * element_size;
+
+    size_t rows_A = view_A->dimensions[0], cols_A = view_A->dimensions[1];
+    size_t cols_B = view_B->dimensions[1];
+
+    // A single column (or row) of the result is a matrix-vector product
+    if (cols_B == 1 && view_A->strides[1] == 1 && view_B->strides[0] == 1) {
+        return multiply_matrix_vector_buffers(result_matrix->head_ptr->data, data_A, data_B,
+                                              rows_A, cols_A, view_A->strides[0], view_A->data_type, 0);
+    }
+
+    if (rows_A == 1 && view_A->strides[1] == 1 && view_B->strides[1] == 1) {
+        return multiply_matrix_vector_buffers(result_matrix->head_ptr->data, data_B, data_A,
+                                              cols_A, cols_B, view_B->strides[0], view_A->data_type, 1);
+    }
+
+    MatmulKernel kernel = select_matmul_kernel(view_A->data_type, rows_A, cols_A, cols_B);
+
+    if (!kernel) {
+        // Unsupported Data-Type
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    kernel(result_matrix->head_ptr->data, data_A, data_B, rows_A, cols_A, cols_B,
+           view_A->strides[0], view_A->strides[1], view_B->strides[0], view_B->strides[1], cols_B);
+
+    return ERR_NONE;
+}
+
+// Multiplication of two 2-D views.
+ArithmeticOperationReturn multiply_2d_matrix_views(const MatrixView* view_A, const MatrixView* view_B) {
+    /*
+
+        Same as `multiply_2d_matrices`, but the operands can be arbitrary views, e.g.
+        `A * B^T` can be computed with `transpose_matrix_view` instead of a copy.
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The result of this operation.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                 = No error.
+        ERR_NULL_PTR             = One or both views do not exist;
+        ERR_INVALID_ARGS         = The views are not 2-Dimensional; Columns of A don't match rows of B; Data-types don't match;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported data-type;
+
+        » For the other possible ErrorCodes, see what `create_matrix` returns. «
+
+    */
+
+    ArithmeticOperationReturn response;
+    response.error_code = ERR_NONE;
+    response.result_matrix.head_ptr = NULL;
+
+    if (!view_A || !view_B || !view_A->parent || !view_B->parent || !view_A->parent->data || !view_B->parent->data) {
+        response.error_code = ERR_NULL_PTR;
+        return response;
+    }
+
+    if (view_A->number_of_dimensions != 2 || view_B->number_of_dimensions != 2) {
+        response.error_code = ERR_INVALID_ARGS;
+        return response;
+    }
+
+    if (view_A->dimensions[1] != view_B->dimensions[0] || view_A->data_type != view_B->data_type) {
+        response.error_code = ERR_INVALID_ARGS;
+        return response;
+    }
+
+    size_t result_dimensions[] = { view_A->dimensions[0], view_B->dimensions[1] };
+
+    response.error_code = create_matrix(&response.result_matrix, 2, result_dimensions, view_A->data_type);
+
+    if (response.error_code != ERR_NONE) {
+        clear_matrix(&response.result_matrix);
+        return response;
+    }
+
+    response.error_code = multiply_2d_views_into(&response.result_matrix, view_A, view_B);
+
+    if (response.error_code != ERR_NONE) {
+        clear_matrix(&response.result_matrix);
+    }
+
+    return response;
+}
+
+// Mixed precision multiplication of two 2-D views.
+ArithmeticOperationReturn multiply_2d_matrix_views_mixed(const MatrixView* view_A, const MatrixView* view_B, DataType output_type) {
+    /*
+
+        Both operands have the same (low precision) data-type, the products are accumulated in
+        a wider type and the result has the data-type `output_type`:
+
+        - TYPE_INT8 / TYPE_UINT8                : `int32_t` (partial sums) and `int64_t`
+        - TYPE_INT16 / TYPE_INT / TYPE_INT64    : `int64_t`
+        - TYPE_FP16 / TYPE_BF16                 : `float`
+        - TYPE_FLOAT / TYPE_DOUBLE              : `double`
+
+        The sums are rounded once into `output_type` (to nearest, integer outputs saturate),
+        e.g. int8 x int8 -> TYPE_INT or fp16 x fp16 -> TYPE_FLOAT.
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The result of this operation.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                 = No error.
+        ERR_NULL_PTR             = One or both views do not exist;
+        ERR_INVALID_ARGS         = The views are not 2-Dimensional; Columns of A don't match rows of B; Data-types don't match;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported input- or output data-type;
+
+        » For the other possible ErrorCodes, see what `create_matrix` returns. «
+
+    */
+
+    ArithmeticOperationReturn response;
+    response.error_code = ERR_NONE;
+    response.result_matrix.head_ptr = NULL;
+
+    if (!view_A || !view_B || !view_A->parent || !view_B->parent || !view_A->parent->data || !view_B->parent->data) {
+        response.error_code = ERR_NULL_PTR;
+        return response;
+    }
+
+    if (view_A->number_of_dimensions != 2 || view_B->number_of_dimensions != 2) {
+        response.error_code = ERR_INVALID_ARGS;
+        return response;
+    }
+
+    if (view_A->dimensions[1] != view_B->dimensions[0] || view_A->data_type != view_B->data_type) {
+        response.error_code = ERR_INVALID_ARGS;
+        return response;
+    }
+
+    DataType total_type;
+    Conversion output;
+    MixedMatmulKernel kernel = select_mixed_matmul_kernel(view_A->data_type, &total_type);
+
+    if (!kernel || !select_conversion(&output, total_type, output_type, ROUND_TO_NEAREST, is_integer_data_type(output_type))) {
+        // Unsupported Data-Type
+        response.error_code = ERR_UNSUPPORTED_DATATYPE;
+        return response;
+    }
+
+    size_t result_dimensions[] = { view_A->dimensions[0], view_B->dimensions[1] };
+
+    response.error_code = create_matrix(&response.result_matrix, 2, result_dimensions, output_type);
+
+    if (response.error_code != ERR_NONE) {
+        clear_matrix(&response.result_matrix);
+        return response;
+    }
+
+    size_t element_size = get_data_type_size(view_A->data_type);
+
+    kernel(response.result_matrix.head_ptr->data,
+           (const char*)view_A->parent->data + view_A->offset * element_size,
+           (const char*)view_B->parent->data + view_B->offset * element_size,
+           view_A->dimensions[0], view_A->dimensions[1], view_B->dimensions[1],
+           view_A->strides[0], view_A->strides[1], view_B->strides[0], view_B->strides[1],
+           view_B->dimensions[1], &output, get_data_type_size(output_type));
+
+    return response;
+}
+
+// Work of a batched multiplication, shared by all threads.
+typedef struct BatchedMatmulTask {
+    MatmulKernel kernel;
+    const char* data_A;
+    const char* data_B;
+    char* result;
+    size_t element_size;
+    size_t number_of_batch_dimensions;
+    size_t batch_dimensions[MAX_VIEW_DIMENSIONS];
+    size_t batch_strides_A[MAX_VIEW_DIMENSIONS];    // Elements, `0` for broadcasted dimensions
+    size_t batch_strides_B[MAX_VIEW_DIMENSIONS];
+    size_t rows_A, cols_A, cols_B;
+    size_t row_stride_A, col_stride_A, row_stride_B, col_stride_B;
+} BatchedMatmulTask;
+
+// Parallel task: multiply the matrices of the batches [begin, end).
+static void multiply_batch_range(void* context, size_t begin, size_t end) {
+    const BatchedMatmulTask* task = (const BatchedMatmulTask*)context;
+    size_t counters[MAX_VIEW_DIMENSIONS];
+    size_t offset_A = 0, offset_B = 0, remainder = begin;
+
+    // Position of the first batch
+    for (size_t i = task->number_of_batch_dimensions; i-- > 0;) {
+        counters[i] = remainder % task->batch_dimensions[i];
+        remainder /= task->batch_dimensions[i];
+        offset_A += counters[i] * task->batch_strides_A[i];
+        offset_B += counters[i] * task->batch_strides_B[i];
+    }
+
+    size_t result_size = task->rows_A * task->cols_B * task->element_size;
+
+    for (size_t batch = begin; batch < end; batch++) {
+        task->kernel(task->result + batch * result_size,
+                     task->data_A + offset_A * task->element_size, task->data_B + offset_B * task->element_size,
+                     task->rows_A, task->cols_A, task->cols_B,
+                     task->row_stride_A, task->col_stride_A, task->row_stride_B, task->col_stride_B,
+                     task->cols_B);
+
+        // Advance to the next batch
+        for (size_t i = task->number_of_batch_dimensions; i-- > 0;) {
+            counters[i]++;
+            offset_A += task->batch_strides_A[i];
+            offset_B += task->batch_strides_B[i];
+
+            if (counters[i] < task->batch_dimensions[i]) {
+                break;
+            }
+
+            offset_A -= task->batch_strides_A[i] * task->batch_dimensions[i];
+            offset_B -= task->batch_strides_B[i] * task->batch_dimensions[i];
+            counters[i] = 0;
+        }
+    }
+}
+
+// Batched multiplication: the last two dimensions are matrices, all leading dimensions are batches.
+ArithmeticOperationReturn multiply_batched_matrix_views(const MatrixView* view_A, const MatrixView* view_B) {
+    /*
+
+        For A with the shape (..., n, k) and B with the shape (..., k, m) the result has the shape
+        (..., n, m). The batch-dimensions are broadcasted (see `broadcast_matrix_view`), e.g. a
+        batch of 2 x 8 x 4 matrices can be multiplied with a single 4 x 3 matrix.
+        The batches are distributed over several threads; many small matrices are multiplied
+        with a register-kernel.
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The result of this operation.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                    = No error.
+        ERR_NULL_PTR                = One or both views do not exist;
+        ERR_INVALID_ARGS            = A view has less than two dimensions;
+        ERR_DIMENSION_SIZE_MISMATCH = Columns of A don't match rows of B; The batch-dimensions are not broadcastable;
+        ERR_DATATYPE_MISMATCH       = The data types of both views do not match;
+        ERR_UNSUPPORTED_DATATYPE    = Unsupported data-type;
+
+        » For the other possible ErrorCodes, see what `create_matrix` returns. «
+
+    */
+
+    ArithmeticOperationReturn response;
+    response.error_code = ERR_NONE;
+    response.result_matrix.head_ptr = NULL;
+
+    if (!view_A || !view_B || !view_A->parent || !view_B->parent || !view_A->parent->data || !view_B->parent->data) {
+        response.error_code = ERR_NULL_PTR;
+        return response;
+    }
+
+    if (view_A->number_of_dimensions < 2 || view_B->number_of_dimensions < 2) {
+        response.error_code = ERR_INVALID_ARGS;
+        return response;
+    }
+
+    size_t last_A = view_A->number_of_dimensions - 1, last_B = view_B->number_of_dimensions - 1;
+
+    if (view_A->dimensions[last_A] != view_B->dimensions[last_B - 1]) {
+        // Columns of A aren't equal to the rows of B
+        response.error_code = ERR_DIMENSION_SIZE_MISMATCH;
+        return response;
+    }
+
+    if (view_A->data_type != view_B->data_type) {
+        response.error_code = ERR_DATATYPE_MISMATCH;
+        return response;
+    }
+
+    // Broadcast the batch-dimensions
+    MatrixView batches_A = *view_A, batches_B = *view_B;
+    batches_A.number_of_dimensions -= 2;
+    batches_B.number_of_dimensions -= 2;
+
+    size_t number_of_dimensions = 0;
+    size_t dimensions[MAX_VIEW_DIMENSIONS];
+
+    response.error_code = broadcast_shapes(&batches_A, &batches_B, &number_of_dimensions, dimensions);
+
+    if (response.error_code != ERR_NONE) {
+        return response;
+    }
+
+    BatchedMatmulTask task;
+    task.rows_A = view_A->dimensions[last_A - 1];
+    task.cols_A = view_A->dimensions[last_A];
+    task.cols_B = view_B->dimensions[last_B];
+    task.row_stride_A = view_A->strides[last_A - 1];
+    task.col_stride_A = view_A->strides[last_A];
+    task.row_stride_B = view_B->strides[last_B - 1];
+    task.col_stride_B = view_B->strides[last_B];
+    task.kernel = select_matmul_kernel(view_A->data_type, task.rows_A, task.cols_A, task.cols_B);
+
+    if (!task.kernel) {
+        response.error_code = ERR_UNSUPPORTED_DATATYPE;
+        return response;
+    }
+
+    MatrixView stretched_A, stretched_B;
+    broadcast_matrix_view(&stretched_A, &batches_A, number_of_dimensions, dimensions);
+    broadcast_matrix_view(&stretched_B, &batches_B, number_of_dimensions, dimensions);
+
+    task.number_of_batch_dimensions = number_of_dimensions;
+    memcpy(task.batch_dimensions, dimensions, number_of_dimensions * sizeof(size_t));
+    memcpy(task.batch_strides_A, stretched_A.strides, number_of_dimensions * sizeof(size_t));
+    memcpy(task.batch_strides_B, stretched_B.strides, number_of_dimensions * sizeof(size_t));
+
+    size_t number_of_batches = 1;
+
+    for (size_t i = 0; i < number_of_dimensions; i++) {
+        number_of_batches *= dimensions[i];
+    }
+
+    // Result: (batch..., rows_A, cols_B)
+    if (number_of_dimensions + 2 > MAX_VIEW_DIMENSIONS) {
+        response.error_code = ERR_INVALID_ARGS;
+        return response;
+    }
+
+    dimensions[number_of_dimensions] = task.rows_A;
+    dimensions[number_of_dimensions + 1] = task.cols_B;
+
+    response.error_code = create_matrix(&response.result_matrix, number_of_dimensions + 2, dimensions, view_A->data_type);
+
+    if (response.error_code != ERR_NONE) {
+        return response;
+    }
+
+    task.element_size = get_data_type_size(view_A->data_type);
+    task.data_A = (const char*)view_A->parent->data + view_A->offset * task.element_size;
+    task.data_B = (const char*)view_B->parent->data + view_B->offset * task.element_size;
+    task.result = (char*)response.result_matrix.head_ptr->data;
+
+    // Hand out enough batches per thread to outweigh the thread start-up
+    size_t work_per_batch = task.rows_A * task.cols_A * task.cols_B + 1;
+    size_t minimum_chunk = (1 << 16) / work_per_batch;
+
+    parallel_for(number_of_batches, minimum_chunk > 0 ? minimum_chunk : 1, multiply_batch_range, &task);
+
+    return response;
+}
+
+// Batched multiplication of two N-D matrices (see `multiply_batched_matrix_views`).
+ArithmeticOperationReturn multiply_batched_matrices(const MultiDimensionalMatrix* matrix_A, const MultiDimensionalMatrix* matrix_B) {
+    ArithmeticOperationReturn response;
+    response.result_matrix.head_ptr = NULL;
+
+    MatrixView view_A, view_B;
+    response.error_code = create_matrix_view(&view_A, matrix_A);
+
+    if (response.error_code == ERR_NONE) {
+        response.error_code = create_matrix_view(&view_B, matrix_B);
+    }
+
+    if (response.error_code != ERR_NONE) {
+        return response;
+    }
+
+    return multiply_batched_matrix_views(&view_A, &view_B);
+}
+
+// Work of a tile multiplication, shared by all threads.
+typedef struct TileMatmulTask {
+    MatmulKernel kernel;
+    const char* data_A;
+    const char* data_B;
+    char* result;
+    size_t element_size;
+    size_t cols_A, cols_B;
+} TileMatmulTask;
+
+// Parallel task: multiply the rows [begin, end) of A with B.
+static void multiply_tile_rows(void* context, size_t begin, size_t end) {
+    const TileMatmulTask* task = (const TileMatmulTask*)context;
+
+    task->kernel(task->result + begin * task->cols_B * task->element_size,
+                 task->data_A + begin * task->cols_A * task->element_size, task->data_B,
+                 end - begin, task->cols_A, task->cols_B, task->cols_A, 1, task->cols_B, 1, task->cols_B);
+}
+
+// `result = A * B` (or `result += A * B`) for contiguous row-major buffers.
+ErrorCode multiply_matrix_tiles(void* result, const void* data_A, const void* data_B,
+                                size_t rows_A, size_t cols_A, size_t cols_B, DataType data_type, void* workspace) {
+    /*
+
+        Without a `workspace` the product overwrites `result`. Otherwise the product is
+        written into the `workspace` (`rows_A * cols_B` elements) and added to `result`,
+        which lets callers sum up the product of several panels of the inner dimension.
+        The rows of A are distributed over several threads.
+
+        Returns ERR_UNSUPPORTED_DATATYPE for an unsupported data-type.
+
+    */
+
+    TileMatmulTask task;
+    task.kernel = select_matmul_kernel(data_type, rows_A, cols_A, cols_B);
+    task.element_size = get_data_type_size(data_type);
+
+    StridedInnerLoop add_loop = select_binary_loop(BINARY_ADD, data_type);
+
+    if (!task.kernel || !add_loop) {
+        // Unsupported Data-Type
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    task.data_A = (const char*)data_A;
+    task.data_B = (const char*)data_B;
+    task.result = (char*)(workspace ? workspace : result);
+    task.cols_A = cols_A;
+    task.cols_B = cols_B;
+
+    size_t work_per_row = cols_A * cols_B + 1;
+    size_t minimum_chunk = (1 << 16) / work_per_row;
+
+    parallel_for(rows_A, minimum_chunk > 0 ? minimum_chunk : 1, multiply_tile_rows, &task);
+
+    if (workspace) {
+        char* operands[] = { (char*)result, (char*)result, (char*)workspace };
+        size_t strides[] = { task.element_size, task.element_size, task.element_size };
+
+        add_loop(operands, strides, rows_A * cols_B, NULL);
+    }
+
+    return ERR_NONE;
+}
+
+// Multiplication of a view and a scalar.
+ArithmeticOperationReturn scalar_multiply_matrix_view(const MatrixView* view, void* scalar) {
+    /*
+
+        Same as `scalar_multiply_matrix`, but the operand can be an arbitrary view.
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The result of this operation.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                 = No error.
+        ERR_NULL_PTR             = View/Scalar does not exist;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported data-type;
+
+        » For the other possible ErrorCodes, see what `create_matrix` returns. «
+
+    */
+
+    ArithmeticOperationReturn response;
+    response.error_code = ERR_NONE;
+    response.result_matrix.head_ptr = NULL;
+
+    if (!view || !scalar || !view->parent || !view->parent->data) {
+        response.error_code = ERR_NULL_PTR;
+        return response;
+    }
+
+    StridedInnerLoop loop = select_binary_loop(BINARY_MULTIPLY, view->data_type);
+
+    if (!loop) {
+        response.error_code = ERR_UNSUPPORTED_DATATYPE;
+        return response;
+    }
+
+    MatrixView result_view;
+    response.error_code = create_matrix_for_view(&response.result_matrix, view, &result_view);
+
+    if (response.error_code != ERR_NONE) {
+        clear_matrix(&response.result_matrix);
+        return response;
+    }
+
+    StridedOperands operands;
+    init_strided_operands(&operands, view);
+    add_view_operand(&operands, &result_view);
+    add_view_operand(&operands, view);
+    add_scalar_operand(&operands, scalar);
+
+    run_strided_loop(&operands, loop, NULL);
+
+    return response;
+}
+
+
+//
+// Fused Expressions
+//
+
+/*
+
+    A `MatrixExpression` records element-wise operations as a small graph instead of
+    executing them. `evaluate_matrix_expression` walks the output once: for each block of
+    `EXPRESSION_BLOCK_SIZE` elements every node is computed into a block-sized buffer, which
+    stays in the L1-cache, and only the final block is written to the result-matrix. Chains like
+    `(A + B) * s + C` therefore read every input once and create no full-size temporaries.
+
+    Nodes are only created after their operands, so the node-index is a topological order.
+
+*/
+
+#define EXPRESSION_BLOCK_SIZE 256
+
+typedef struct ExpressionContext {
+    const MatrixExpression* expression;
+    size_t order[MAX_EXPRESSION_NODES];     // Nodes needed for the root, in evaluation order
+    size_t number_of_steps;
+    size_t root;
+    void* buffers;                          // `EXPRESSION_BLOCK_SIZE` elements per node
+} ExpressionContext;
+
+
+// Prepare an empty expression.
+void init_matrix_expression(MatrixExpression* expression) {
+    if (!expression) {
+        return;
+    }
+
+    expression->number_of_nodes = 0;
+    expression->number_of_inputs = 0;
+    expression->error_code = ERR_NONE;
+}
+
+// Append a node; returns its index or `INVALID_EXPRESSION_NODE`.
+static size_t append_expression_node(MatrixExpression* expression, MatrixExpressionNode node) {
+    if (expression->error_code != ERR_NONE) {
+        // An earlier recording-step already failed
+        return INVALID_EXPRESSION_NODE;
+    }
+
+    if (expression->number_of_nodes >= MAX_EXPRESSION_NODES) {
+        expression->error_code = ERR_INVALID_ARGS;
+        return INVALID_EXPRESSION_NODE;
+    }
+
+    expression->nodes[expression->number_of_nodes] = node;
+
+    return expression->number_of_nodes++;
+}
+
+// Record a view as an input of the expression.
+size_t expression_input_view(MatrixExpression* expression, const MatrixView* view) {
+    /*
+
+        Returns the index of the new node.
+        Returns `INVALID_EXPRESSION_NODE` if something went wrong; the error is stored in
+        `expression->error_code` and returned by `evaluate_matrix_expression`.
+
+    */
+
+    if (!expression) {
+        return INVALID_EXPRESSION_NODE;
+    }
+
+    if (!view || !view->parent) {
+        if (expression->error_code == ERR_NONE) {
+            expression->error_code = ERR_NULL_PTR;
+        }
+        return INVALID_EXPRESSION_NODE;
+    }
+
+    if (expression->number_of_inputs >= MAX_EXPRESSION_INPUTS) {
+        if (expression->error_code == ERR_NONE) {
+            expression->error_code = ERR_INVALID_ARGS;
+        }
+        return INVALID_EXPRESSION_NODE;
+    }
+
+    MatrixExpressionNode node = { EXPRESSION_INPUT, INVALID_EXPRESSION_NODE, INVALID_EXPRESSION_NODE, expression->number_of_inputs, 0.0 };
+    size_t index = append_expression_node(expression, node);
+
+    if (index != INVALID_EXPRESSION_NODE) {
+        expression->inputs[expression->number_of_inputs++] = *view;
+    }
+
+    return index;
+}
+
+// Record a matrix as an input of the expression.
+size_t expression_input(MatrixExpression* expression, const MultiDimensionalMatrix* matrix) {
+    /*
+
+        The matrix is not copied, it has to stay alive until the expression is evaluated.
+        Returns the index of the new node or `INVALID_EXPRESSION_NODE`.
+
+    */
+
+    if (!expression) {
+        return INVALID_EXPRESSION_NODE;
+    }
+
+    MatrixView view;
+    ErrorCode error = create_matrix_view(&view, matrix);
+
+    if (error != ERR_NONE) {
+        if (expression->error_code == ERR_NONE) {
+            expression->error_code = error;
+        }
+        return INVALID_EXPRESSION_NODE;
+    }
+
+    return expression_input_view(expression, &view);
+}
+
+// Record a constant, which is converted to the data-type of the expression.
+size_t expression_scalar(MatrixExpression* expression, double value) {
+    if (!expression) {
+        return INVALID_EXPRESSION_NODE;
+    }
+
+    MatrixExpressionNode node = { EXPRESSION_SCALAR, INVALID_EXPRESSION_NODE, INVALID_EXPRESSION_NODE, 0, value };
+
+    return append_expression_node(expression, node);
+}
+
+// Record a binary element-wise operation.
+static size_t expression_binary(MatrixExpression* expression, ExpressionOperation operation, size_t left, size_t right) {
+    if (!expression) {
+        return INVALID_EXPRESSION_NODE;
+    }
+
+    if (expression->error_code == ERR_NONE && (left >= expression->number_of_nodes || right >= expression->number_of_nodes)) {
+        // Operand does not exist
+        expression->error_code = ERR_INVALID_ARGS;
+    }
+
+    MatrixExpressionNode node = { operation, left, right, 0, 0.0 };
+
+    return append_expression_node(expression, node);
+}
+
+size_t expression_add(MatrixExpression* expression, size_t left, size_t right) {
+    return expression_binary(expression, EXPRESSION_ADD, left, right);
+}
+
+size_t expression_subtract(MatrixExpression* expression, size_t left, size_t right) {
+    return expression_binary(expression, EXPRESSION_SUBTRACT, left, right);
+}
+
+size_t expression_multiply(MatrixExpression* expression, size_t left, size_t right) {
+    return expression_binary(expression, EXPRESSION_MULTIPLY, left, right);
+}
+
+// Evaluates all nodes of one innermost row, block by block (in `COMPUTE`).
+#define DEFINE_EXPRESSION_LOOP(NAME, STORAGE, COMPUTE, LOAD, STORE)                                     \
+static void NAME(char** data, const size_t* strides, size_t count, const void* context) {              \
+    const ExpressionContext* state = (const ExpressionContext*)context;                                 \
+    const MatrixExpressionNode* nodes = state->expression->nodes;                                       \
+    COMPUTE* buffers = (COMPUTE*)state->buffers;                                                        \
+    const COMPUTE* values[MAX_EXPRESSION_NODES];                                                        \
+    /* Stored elements can only be used in place, if they already are compute-values */                 \
+    const int same_type = sizeof(STORAGE) == sizeof(COMPUTE);                                           \
+    int direct_output = same_type && strides[0] == sizeof(STORAGE);                                     \
+    for (size_t start = 0; start < count; start += EXPRESSION_BLOCK_SIZE) {                             \
+        size_t length = count - start < EXPRESSION_BLOCK_SIZE ? count - start : EXPRESSION_BLOCK_SIZE;  \
+        STORAGE* output = (STORAGE*)(data[0] + start * strides[0]);                                     \
+        for (size_t step = 0; step < state->number_of_steps; step++) {                                  \
+            size_t node = state->order[step];                                                           \
+            const MatrixExpressionNode* current = &nodes[node];                                         \
+            /* The root writes straight into a contiguous result */                                     \
+            COMPUTE* buffer = (node == state->root && direct_output) ? (COMPUTE*)output : buffers + node * EXPRESSION_BLOCK_SIZE; \
+            const COMPUTE* left = current->left < MAX_EXPRESSION_NODES ? values[current->left] : NULL;  \
+            const COMPUTE* right = current->right < MAX_EXPRESSION_NODES ? values[current->right] : NULL; \
+            switch (current->operation) {                                                               \
+                case EXPRESSION_INPUT: {                                                                \
+                    size_t stride = strides[1 + current->input];                                        \
+                    const char* source = data[1 + current->input] + start * stride;                     \
+                    if (same_type && stride == sizeof(STORAGE)) {                                       \
+                        /* Contiguous inputs are read in place */                                       \
+                        values[node] = (const COMPUTE*)source;                                          \
+                        continue;                                                                       \
+                    }                                                                                   \
+                    for (size_t i = 0; i < length; i++) {                                               \
+                        buffer[i] = LOAD(*(const STORAGE*)(source + i * stride));                       \
+                    }                                                                                   \
+                    break;                                                                              \
+                }                                                                                       \
+                case EXPRESSION_SCALAR:                                                                 \
+                    for (size_t i = 0; i < length; i++) {                                               \
+                        buffer[i] = (COMPUTE)current->scalar;                                           \
+                    }                                                                                   \
+                    break;                                                                              \
+                case EXPRESSION_ADD:                                                                    \
+                    for (size_t i = 0; i < length; i++) {                                               \
+                        buffer[i] = left[i] + right[i];                                                 \
+                    }                                                                                   \
+                    break;                                                                              \
+                case EXPRESSION_SUBTRACT:                                                               \
+                    for (size_t i = 0; i < length; i++) {                                               \
+                        buffer[i] = left[i] - right[i];                                                 \
+                    }                                                                                   \
+                    break;                                                                              \
+                case EXPRESSION_MULTIPLY:                                                               \
+                    for (size_t i = 0; i < length; i++) {                                               \
+                        buffer[i] = left[i] * right[i];                                                 \
+                    }                                                                                   \
+                    break;                                                                              \
+            }                                                                                           \
+            values[node] = buffer;                                                                      \
+        }                                                                                               \
+        const COMPUTE* result = values[state->root];                                                    \
+        if ((const void*)result == (const void*)output) {                                               \
+            continue;                                                                                   \
+        }                                                                                               \
+        for (size_t i = 0; i < length; i++) {                                                           \
+            *(STORAGE*)((char*)output + i * strides[0]) = STORE(STORAGE, result[i]);                    \
+        }                                                                                               \
+    }                                                                                                   \
+}
+
+#define DEFINE_TYPE_EXPRESSION_LOOP(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE)                          \
+    DEFINE_EXPRESSION_LOOP(expression_##NAME##_loop, STORAGE, COMPUTE, LOAD, STORE)
+
+FOR_EACH_DATA_TYPE(DEFINE_TYPE_EXPRESSION_LOOP)
+
+// Evaluate a recorded expression in a single pass over the data.
+ArithmeticOperationReturn evaluate_matrix_expression(const MatrixExpression* expression, size_t root) {
+    /*
+
+        All inputs have to share one data-type and their shapes are broadcasted
+        (see `broadcast_matrix_view`). The expression can be evaluated several times.
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The result of this operation.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                    = No error.
+        ERR_NULL_PTR                = Expression does not exist;
+        ERR_INVALID_ARGS            = Invalid root-node; Too many nodes/inputs; The root does not depend on any input;
+        ERR_DIMENSION_SIZE_MISMATCH = The shapes of the inputs are not broadcastable;
+        ERR_DATATYPE_MISMATCH       = The inputs have different data-types;
+        ERR_UNSUPPORTED_DATATYPE    = Unsupported data-type;
+
+        » Errors, which occured while recording, are returned here as well. «
+
+    */
+
+    ArithmeticOperationReturn response;
+    response.error_code = ERR_NONE;
+    response.result_matrix.head_ptr = NULL;
+
+    if (!expression) {
+        response.error_code = ERR_NULL_PTR;
+        return response;
+    }
+
+    if (expression->error_code != ERR_NONE) {
+        response.error_code = expression->error_code;
+        return response;
+    }
+
+    if (root >= expression->number_of_nodes) {
+        response.error_code = ERR_INVALID_ARGS;
+        return response;
+    }
+
+    // Mark every node the root depends on
+    int needed[MAX_EXPRESSION_NODES] = {0};
+    needed[root] = 1;
+
+    for (size_t node = root + 1; node-- > 0;) {
+        const MatrixExpressionNode* current = &expression->nodes[node];
+
+        if (!needed[node] || current->operation == EXPRESSION_INPUT || current->operation == EXPRESSION_SCALAR) {
+            continue;
+        }
+        needed[current->left] = 1;
+        needed[current->right] = 1;
+    }
+
+    ExpressionContext context;
+    context.expression = expression;
+    context.root = root;
+    context.number_of_steps = 0;
+
+    // Result-shape and data-type of all used inputs
+    size_t number_of_dimensions = 0;
+    size_t dimensions[MAX_VIEW_DIMENSIONS];
+    int has_input = 0;
+    DataType data_type = TYPE_INT;
+
+    for (size_t node = 0; node <= root; node++) {
+        if (!needed[node]) {
+            continue;
+        }
+        context.order[context.number_of_steps++] = node;
+
+        if (expression->nodes[node].operation != EXPRESSION_INPUT) {
+            continue;
+        }
+
+        const MatrixView* input = &expression->inputs[expression->nodes[node].input];
+
+        if (!input->parent->data) {
+            response.error_code = ERR_NULL_PTR;
+            return response;
+        }
+
+        if (has_input && input->data_type != data_type) {
+            response.error_code = ERR_DATATYPE_MISMATCH;
+            return response;
+        }
+        data_type = input->data_type;
+        has_input = 1;
+
+        response.error_code = broadcast_shape_with_view(&number_of_dimensions, dimensions, input);
+
+        if (response.error_code != ERR_NONE) {
+            return response;
+        }
+    }
+
+    if (!has_input) {
+        // Shape and data-type are unknown
+        response.error_code = ERR_INVALID_ARGS;
+        return response;
+    }
+
+    StridedInnerLoop loop;
+
+    #define EXPRESSION_LOOP_CASE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE) \
+        case ENUM: loop = expression_##NAME##_loop; break;
+
+    switch(data_type) {
+        FOR_EACH_DATA_TYPE(EXPRESSION_LOOP_CASE)
+
+        default:
+            // Unsupported Data-Type
+            response.error_code = ERR_UNSUPPORTED_DATATYPE;
+            return response;
+    }
+
+    #undef EXPRESSION_LOOP_CASE
+
+    response.error_code = create_matrix(&response.result_matrix, number_of_dimensions, dimensions, data_type);
+
+    if (response.error_code != ERR_NONE) {
+        return response;
+    }
+
+    // Large enough for every compute-type (`int`, `int64_t`, `float` or `double`)
+    context.buffers = malloc(MAX_EXPRESSION_NODES * EXPRESSION_BLOCK_SIZE * sizeof(double));
+
+    if (!context.buffers) {
+        clear_matrix(&response.result_matrix);
+        response.error_code = ERR_MALLOC_FAILED;
+        return response;
+    }
+
+    MatrixView result_view;
+    ErrorCode error = create_matrix_view(&result_view, &response.result_matrix);
+
+    if (error != ERR_NONE) {
+        free(context.buffers);
+        clear_matrix(&response.result_matrix);
+        response.error_code = error;
+        return response;
+    }
+
+    StridedOperands operands;
+    init_strided_operands(&operands, &result_view);
+    add_view_operand(&operands, &result_view);
+
+    // Every input is stretched to the result-shape; unused inputs keep their slot
+    for (size_t i = 0; i < expression->number_of_inputs; i++) {
+        MatrixView stretched;
+
+        if (broadcast_matrix_view(&stretched, &expression->inputs[i], number_of_dimensions, dimensions) == ERR_NONE) {
+            add_view_operand(&operands, &stretched);
+        } else {
+            add_scalar_operand(&operands, expression->inputs[i].parent->data);
+        }
+    }
+
+    run_strided_loop(&operands, loop, &context);
+
+    free(context.buffers);
+
+    return response;
+}
+
+
+//
+// Arithmetic Operations
+//
+
+
+// Evaluate `result = A <operation> B` element-wise with broadcasting for two matrices.
+static ArithmeticOperationReturn broadcast_binary_matrices(const MultiDimensionalMatrix* matrix_A, const MultiDimensionalMatrix* matrix_B, BinaryOperation operation) {
+    ArithmeticOperationReturn response;
+    response.error_code = ERR_NONE;
+    response.result_matrix.head_ptr = NULL;
+
+    MatrixView view_A, view_B;
+
+    response.error_code = create_matrix_view(&view_A, matrix_A);
+
+    if (response.error_code == ERR_NONE) {
+        response.error_code = create_matrix_view(&view_B, matrix_B);
+    }
+
+    if (response.error_code != ERR_NONE) {
+        return response;
+    }
+
+    return broadcast_binary_operation(&view_A, &view_B, operation);
+}
+
+// Addition of two multidimensional-matrices.
+ArithmeticOperationReturn add_matrices(const MultiDimensionalMatrix* matrix_A, const MultiDimensionalMatrix* matrix_B) {
+    /*
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The result of this operation.
+        - ErrorCode error_code                : Indicating the operation status.
+        
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                        = No error.
+        ERR_NULL_PTR                    = One or both matrices are NULL (head-pointer is invalid);
+        ERR_INVALID_ARGS                = Shapes differ and a matrix has more than `MAX_VIEW_DIMENSIONS` dimensions;
+        ERR_DIMENSION_SIZE_MISMATCH     = The shapes of both matrices are not broadcastable;
+        ERR_DATATYPE_MISMATCH           = The data types of both matrices do not match;
+        ERR_UNSUPPORTED_DATATYPE        = Unsupported data-type;
+
+        Matrices with different shapes are broadcasted (see `broadcast_matrix_view`),
+        e.g. a 4 x 3 matrix plus a 3-element row-vector adds the vector to every row.
+
+    */
+
+    ArithmeticOperationReturn response;
+    response.error_code = ERR_NONE;
+    response.result_matrix.head_ptr = NULL;
+
+    if (!matrix_A || !matrix_B || !matrix_A->head_ptr || !matrix_B->head_ptr) {
+        // Wether `matrix_A` or `matrix_B` (or both) is a NULL-Pointer
+        response.error_code = ERR_NULL_PTR;
+        return response;
+    }
+
+    // Check dimensions
+    int same_shape = matrix_A->head_ptr->number_of_dimensions == matrix_B->head_ptr->number_of_dimensions;
+
+    for (size_t i = 0; same_shape && i < matrix_A->head_ptr->number_of_dimensions; i++) {
+        if (matrix_A->head_ptr->dimensions[i] != matrix_B->head_ptr->dimensions[i]) {
+            same_shape = 0;
+        }
+    }
+
+    if (!same_shape) {
+        // Stretch size-1 and missing leading dimensions (broadcasting)
+        return broadcast_binary_matrices(matrix_A, matrix_B, BINARY_ADD);
+    }
+    
+    // Check data_type
+    if (matrix_A->head_ptr->data_type != matrix_B->head_ptr->data_type) {
         // Cannot add two matrices with different data-types
         response.error_code = ERR_DATATYPE_MISMATCH;
         return response;
@@ -577,48 +5358,65 @@ ArithmeticOperationReturn add_matrices(const MultiDimensionalMatrix* matrix_A, c
 
     // Calculate the sum of both matrices
     
-    size_t total_elements;
+    StridedInnerLoop loop = select_binary_loop(BINARY_ADD, matrix_A->head_ptr->data_type);
 
-    switch(matrix_A->head_ptr->data_type) {
-        case TYPE_INT:
-            total_elements = matrix_A->head_ptr->data_size / sizeof(int);
-            int* int_dataA = (int*)matrix_A->head_ptr->data;
-            int* int_dataB = (int*)matrix_B->head_ptr->data; 
-            for (size_t i = 0; i < total_elements; i++) {
-                ((int*)result_matrix.head_ptr->data)[i] = int_dataA[i] + int_dataB[i];
-            }
-            break;
-        
-        case TYPE_FLOAT:
-            total_elements = matrix_A->head_ptr->data_size / sizeof(float);
-            float* float_dataA = (float*)matrix_A->head_ptr->data;
-            float* float_dataB = (float*)matrix_B->head_ptr->data; 
-            for (size_t i = 0; i < total_elements; i++) {
-                ((float*)result_matrix.head_ptr->data)[i] = float_dataA[i] + float_dataB[i];
-            }
-            break;
+    if (!loop) {
+        // Unsupported Data_Type
+        response.error_code = ERR_UNSUPPORTED_DATATYPE;
+        clear_matrix(&result_matrix);
+        response.result_matrix.head_ptr = NULL;
+        return response;
+    }
 
-        case TYPE_DOUBLE:
-            total_elements = matrix_A->head_ptr->data_size / sizeof(double);
-            double* double_dataA = (double*)matrix_A->head_ptr->data;
-            double* double_dataB = (double*)matrix_B->head_ptr->data; 
-            for (size_t i = 0; i < total_elements; i++) {
-                ((double*)result_matrix.head_ptr->data)[i] = double_dataA[i] + double_dataB[i];
-            }
-            break;
+    // All three buffers are contiguous: a single run of the inner loop
+    size_t element_size = get_data_type_size(matrix_A->head_ptr->data_type);
+    char* data[] = {(char*)result_matrix.head_ptr->data, (char*)matrix_A->head_ptr->data, (char*)matrix_B->head_ptr->data};
+    size_t strides[] = {element_size, element_size, element_size};
 
-        default:
-            // Unsupported Data_Type
-            response.error_code = ERR_UNSUPPORTED_DATATYPE;
-            clear_matrix(&result_matrix);
-            return response;
-    }
+    loop(data, strides, matrix_A->head_ptr->data_size / element_size, NULL);
 
     // Successfully added two matrices
     return response;
 
 }
 
+// Element-wise (Hadamard) product of two multidimensional-matrices.
+ArithmeticOperationReturn multiply_matrices_elementwise(const MultiDimensionalMatrix* matrix_A, const MultiDimensionalMatrix* matrix_B) {
+    /*
+
+        Matrices with different shapes are broadcasted (see `broadcast_matrix_view`),
+        e.g. a C x H x W tensor times a C x 1 x 1 tensor scales every channel.
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The result of this operation.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                        = No error.
+        ERR_NULL_PTR                    = One or both matrices are NULL (head-pointer is invalid);
+        ERR_INVALID_ARGS                = A matrix has more than `MAX_VIEW_DIMENSIONS` dimensions;
+        ERR_DIMENSION_SIZE_MISMATCH     = The shapes of both matrices are not broadcastable;
+        ERR_DATATYPE_MISMATCH           = The data types of both matrices do not match;
+        ERR_UNSUPPORTED_DATATYPE        = Unsupported data-type;
+
+    */
+
+    ArithmeticOperationReturn response;
+    response.error_code = ERR_NONE;
+    response.result_matrix.head_ptr = NULL;
+
+    if (!matrix_A || !matrix_B || !matrix_A->head_ptr || !matrix_B->head_ptr) {
+        // Wether `matrix_A` or `matrix_B` (or both) is a NULL-Pointer
+        response.error_code = ERR_NULL_PTR;
+        return response;
+    }
+
+    return broadcast_binary_matrices(matrix_A, matrix_B, BINARY_MULTIPLY);
+}
+
 // Multiplication of two 2-Dimensional-matrices.
 ArithmeticOperationReturn multiply_2d_matrices(const MultiDimensionalMatrix* matrix_A, const MultiDimensionalMatrix* matrix_B) {
     /*
@@ -634,6 +5432,9 @@ ArithmeticOperationReturn multiply_2d_matrices(const MultiDimensionalMatrix* mat
         ERR_NONE                        = No error.
         ERR_NULL_PTR                    = One or both matrices are NULL (head-pointer is invalid);
         ERR_INVALID_ARGS                = The number of dimensions in both matrices do not match;
+        ERR_MALLOC_FAILED               = Allocating the Strassen-Winograd workspace failed;
+
+        Uses the algorithm selected by `set_multiplication_algorithm` (default: standard kernel).
 
         » For the other possible ErrorCodes, see what `create_matrix` returns. «
 
@@ -688,67 +5489,54 @@ ArithmeticOperationReturn multiply_2d_matrices(const MultiDimensionalMatrix* mat
 
     // Calculate the product of both matrices
 
+    ErrorCode multiplication_resp;
     size_t rows_A = matrix_A->head_ptr->dimensions[0], cols_A = matrix_A->head_ptr->dimensions[1];
     size_t cols_B = matrix_B->head_ptr->dimensions[1];
 
-    switch(matrix_A->head_ptr->data_type) {
-        case TYPE_INT:
-            int* int_dataA = (int*)matrix_A->head_ptr->data;
-            int* int_dataB = (int*)matrix_B->head_ptr->data; 
-            int* int_result = (int*)result_matrix.head_ptr->data;
-
-            for (size_t i = 0; i < rows_A; i++) {
-                for (size_t j = 0; j < cols_B; j++) {
-                    int_result[i * cols_B + j] = 0; // Initialize result element
-                    for (size_t k = 0; k < cols_A; k++) {
-                        int_result[i * cols_B + j] += int_dataA[i * cols_A + k] * int_dataB[k * cols_B + j];
-                    }
-                }
-            }
-            break;
-        
-        case TYPE_FLOAT:
-            float* float_dataA = (float*)matrix_A->head_ptr->data;
-            float* float_dataB = (float*)matrix_B->head_ptr->data; 
-            float* float_result = (float*)result_matrix.head_ptr->data;
-
-            for (size_t i = 0; i < rows_A; i++) {
-                for (size_t j = 0; j < cols_B; j++) {
-                    float_result[i * cols_B + j] = 0; // Initialize result element
-                    for (size_t k = 0; k < cols_A; k++) {
-                        float_result[i * cols_B + j] += float_dataA[i * cols_A + k] * float_dataB[k * cols_B + j];
-                    }
-                }
-            }
-            break;
+    if (multiplication_algorithm == MULTIPLICATION_STRASSEN && !is_half_data_type(matrix_A->head_ptr->data_type) &&
+        rows_A > strassen_cutoff && cols_A > strassen_cutoff && cols_B > strassen_cutoff) {
+        // Opt-in: Strassen-Winograd recursion (see `set_multiplication_algorithm`)
+        multiplication_resp = strassen_multiply(result_matrix.head_ptr->data, matrix_A->head_ptr->data, matrix_B->head_ptr->data,
+                                                rows_A, cols_A, cols_B, matrix_A->head_ptr->data_type);
+    } else {
+        MatrixView view_A, view_B;
+        create_matrix_view(&view_A, matrix_A);
+        create_matrix_view(&view_B, matrix_B);
 
-        case TYPE_DOUBLE:
-            double* double_dataA = (double*)matrix_A->head_ptr->data;
-            double* double_dataB = (double*)matrix_B->head_ptr->data; 
-            double* double_result = (double*)result_matrix.head_ptr->data;
-
-            for (size_t i = 0; i < rows_A; i++) {
-                for (size_t j = 0; j < cols_B; j++) {
-                    double_result[i * cols_B + j] = 0; // Initialize result element
-                    for (size_t k = 0; k < cols_A; k++) {
-                        double_result[i * cols_B + j] += double_dataA[i * cols_A + k] * double_dataB[k * cols_B + j];
-                    }
-                }
-            }
-            break;
+        multiplication_resp = multiply_2d_views_into(&result_matrix, &view_A, &view_B);
+    }
 
-        default:
-            // Unsupported Data_Type
-            // This section shouldn't be reached
-            response.error_code = ERR_UNKNOWN;
-            clear_matrix(&result_matrix);
-            return response;
+    if (multiplication_resp != ERR_NONE) {
+        // Unsupported Data_Type
+        response.error_code = multiplication_resp;
+        clear_matrix(&result_matrix);
+        response.result_matrix.head_ptr = NULL;
+        return response;
     }
 
     // Successfully multiplied two 2D-matrices
     return response;
 }
 
+// Mixed precision multiplication of two 2-Dimensional-matrices (see `multiply_2d_matrix_views_mixed`).
+ArithmeticOperationReturn multiply_2d_matrices_mixed(const MultiDimensionalMatrix* matrix_A, const MultiDimensionalMatrix* matrix_B, DataType output_type) {
+    ArithmeticOperationReturn response;
+    response.result_matrix.head_ptr = NULL;
+
+    MatrixView view_A, view_B;
+    response.error_code = create_matrix_view(&view_A, matrix_A);
+
+    if (response.error_code == ERR_NONE) {
+        response.error_code = create_matrix_view(&view_B, matrix_B);
+    }
+
+    if (response.error_code != ERR_NONE) {
+        return response;
+    }
+
+    return multiply_2d_matrix_views_mixed(&view_A, &view_B, output_type);
+}
+
 // Multiplication of a matrix and a scalar.
 ArithmeticOperationReturn scalar_multiply_matrix(const MultiDimensionalMatrix* matrix, void* scalar) {
     /*
@@ -791,33 +5579,22 @@ ArithmeticOperationReturn scalar_multiply_matrix(const MultiDimensionalMatrix* m
     response.result_matrix = result_matrix;
 
     // Iterate through matrix and multiply each element with the scalar
+    StridedInnerLoop loop = select_binary_loop(BINARY_MULTIPLY, matrix->head_ptr->data_type);
 
-    switch(matrix->head_ptr->data_type) {
-        case TYPE_INT:
-            for (size_t i = 0; i < (matrix->head_ptr->data_size/sizeof(int)); i++) {
-                ((int*)result_matrix.head_ptr->data)[i] = ((int*)matrix->head_ptr->data)[i] * *((int*)scalar);
-            }
-            break;
-        
-        case TYPE_FLOAT:
-            for (size_t i = 0; i < (matrix->head_ptr->data_size/sizeof(float)); i++) {
-                ((float*)result_matrix.head_ptr->data)[i] = ((float*)matrix->head_ptr->data)[i] * *((float*)scalar);
-            }
-            break;
-
-        case TYPE_DOUBLE:
-            for (size_t i = 0; i < (matrix->head_ptr->data_size/sizeof(double)); i++) {
-                ((double*)result_matrix.head_ptr->data)[i] = ((double*)matrix->head_ptr->data)[i] * *((double*)scalar);
-            }
-            break;
-
-        default:
-            // Unsupported Data_Type
-            response.error_code = ERR_UNSUPPORTED_DATATYPE;
-            clear_matrix(&result_matrix);
-            return response;
+    if (!loop) {
+        // Unsupported Data_Type
+        response.error_code = ERR_UNSUPPORTED_DATATYPE;
+        clear_matrix(&result_matrix);
+        response.result_matrix.head_ptr = NULL;
+        return response;
     }
 
+    // The scalar is repeated with a stride of `0`
+    size_t element_size = get_data_type_size(matrix->head_ptr->data_type);
+    char* data[] = {(char*)result_matrix.head_ptr->data, (char*)matrix->head_ptr->data, (char*)scalar};
+    size_t strides[] = {element_size, element_size, 0};
+
+    loop(data, strides, matrix->head_ptr->data_size / element_size, NULL);
 
     return response;
 }
@@ -0,0 +1,994 @@
+#include "custom_sparse_matrices.h"
+#include "matrix_data_types.h"
+#include "matrix_parallel.h"
+
+
+/*
+
+    CSR-matrices are the working format: products and additions are computed row by row, so
+    large row counts can be distributed over several threads without any synchronization.
+    Products with COO/CSC-matrices scatter their entries into the result on one thread.
+
+*/
+
+// Minimum number of multiply-adds processed by one thread
+#define PARALLEL_SPARSE_CHUNK 16384
+
+
+// Allocate the arrays of an empty sparse matrix.
+static ErrorCode allocate_sparse_matrix(SparseMatrix* matrix, SparseFormat format, size_t rows, size_t cols,
+                                        DataType data_type, size_t capacity) {
+    /*
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                 = No error.
+        ERR_MALLOC_FAILED        = Space allocation with `malloc` failed;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported data-type;
+        ERR_INVALID_ARGS         = Unknown format;
+
+    */
+
+    memset(matrix, 0, sizeof(SparseMatrix));
+
+    size_t element_size = get_data_type_size(data_type);
+
+    if (!element_size) {
+        // Unsupported Data-Type
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    if (format != SPARSE_COO && format != SPARSE_CSR && format != SPARSE_CSC) {
+        // Unknown format
+        return ERR_INVALID_ARGS;
+    }
+
+    matrix->format = format;
+    matrix->data_type = data_type;
+    matrix->rows = rows;
+    matrix->cols = cols;
+    matrix->capacity = capacity;
+
+    // Always allocate at least one entry, `malloc(0)` may return NULL
+    size_t slots = capacity > 0 ? capacity : 1;
+
+    matrix->values = malloc(slots * element_size);
+
+    if (format != SPARSE_CSR) {
+        matrix->row_indices = (size_t*) malloc(slots * sizeof(size_t));
+    }
+
+    if (format != SPARSE_CSC) {
+        matrix->col_indices = (size_t*) malloc(slots * sizeof(size_t));
+    }
+
+    if (format != SPARSE_COO) {
+        matrix->pointers = (size_t*) calloc((format == SPARSE_CSR ? rows : cols) + 1, sizeof(size_t));
+    }
+
+    if (!matrix->values || (format != SPARSE_CSR && !matrix->row_indices) ||
+        (format != SPARSE_CSC && !matrix->col_indices) || (format != SPARSE_COO && !matrix->pointers)) {
+        // Allocation-Error
+        clear_sparse_matrix(matrix);
+        return ERR_MALLOC_FAILED;
+    }
+
+    return ERR_NONE;
+}
+
+// Create an empty sparse matrix in the COO-format.
+ErrorCode create_sparse_matrix(SparseMatrix* matrix, size_t rows, size_t cols, DataType data_type, size_t capacity) {
+    /*
+
+        Entries are added with `append_sparse_entry`, `capacity` is the number of entries
+        which can be appended before the arrays have to grow.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                 = No error.
+        ERR_NULL_PTR             = Matrix does not exist;
+        ERR_INVALID_ARGS         = `rows` or `cols` is 0;
+        ERR_MALLOC_FAILED        = Space allocation with `malloc` failed;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported data-type;
+
+    */
+
+    if (!matrix) {
+        // Matrix does not exist
+        return ERR_NULL_PTR;
+    }
+
+    if (rows == 0 || cols == 0) {
+        return ERR_INVALID_ARGS;
+    }
+
+    return allocate_sparse_matrix(matrix, SPARSE_COO, rows, cols, data_type, capacity);
+}
+
+// Free all allocated space.
+void clear_sparse_matrix(SparseMatrix* matrix) {
+    if (!matrix) {
+        // Matrix does not exist
+        return;
+    }
+
+    free(matrix->values);
+    free(matrix->row_indices);
+    free(matrix->col_indices);
+    free(matrix->pointers);
+
+    matrix->values = NULL;
+    matrix->row_indices = NULL;
+    matrix->col_indices = NULL;
+    matrix->pointers = NULL;
+    matrix->number_of_nonzeros = 0;
+    matrix->capacity = 0;
+}
+
+// Append an entry to a COO-matrix.
+ErrorCode append_sparse_entry(SparseMatrix* matrix, size_t row, size_t col, void* value) {
+    /*
+
+        The capacity is doubled whenever the arrays are full. Entries with the same position
+        are summed up when the matrix is converted or used.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                 = No error.
+        ERR_NULL_PTR             = Matrix/Value does not exist;
+        ERR_INVALID_ARGS         = The matrix is not in the COO-format;
+        ERR_INVALID_INDEX        = The position is outside of the matrix;
+        ERR_REALLOC_FAILED       = Growing the arrays failed;
+
+    */
+
+    if (!matrix || !value || !matrix->values) {
+        // Matrix/Value does not exist
+        return ERR_NULL_PTR;
+    }
+
+    if (matrix->format != SPARSE_COO) {
+        // Only COO-matrices are unordered
+        return ERR_INVALID_ARGS;
+    }
+
+    if (row >= matrix->rows || col >= matrix->cols) {
+        return ERR_INVALID_INDEX;
+    }
+
+    size_t element_size = get_data_type_size(matrix->data_type);
+
+    if (matrix->number_of_nonzeros == matrix->capacity) {
+        size_t new_capacity = matrix->capacity > 0 ? 2 * matrix->capacity : 8;
+
+        void* values = realloc(matrix->values, new_capacity * element_size);
+        if (!values) {
+            return ERR_REALLOC_FAILED;
+        }
+        matrix->values = values;
+
+        size_t* row_indices = (size_t*) realloc(matrix->row_indices, new_capacity * sizeof(size_t));
+        if (!row_indices) {
+            return ERR_REALLOC_FAILED;
+        }
+        matrix->row_indices = row_indices;
+
+        size_t* col_indices = (size_t*) realloc(matrix->col_indices, new_capacity * sizeof(size_t));
+        if (!col_indices) {
+            return ERR_REALLOC_FAILED;
+        }
+        matrix->col_indices = col_indices;
+
+        matrix->capacity = new_capacity;
+    }
+
+    size_t entry = matrix->number_of_nonzeros;
+
+    memcpy((char*)matrix->values + entry * element_size, value, element_size);
+    matrix->row_indices[entry] = row;
+    matrix->col_indices[entry] = col;
+    matrix->number_of_nonzeros++;
+
+    return ERR_NONE;
+}
+
+// `destination += source` for one element.
+static void add_element(char* destination, const char* source, DataType data_type) {
+    #define ADD_ELEMENT_CASE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE)                                 \
+        case ENUM:                                                                                      \
+            *(STORAGE*)destination = STORE(STORAGE, LOAD(*(STORAGE*)destination) + LOAD(*(const STORAGE*)source)); \
+            break;
+
+    switch(data_type) {
+        FOR_EACH_DATA_TYPE(ADD_ELEMENT_CASE)
+
+        default:
+            // Unsupported Data-Type
+            break;
+    }
+
+    #undef ADD_ELEMENT_CASE
+}
+
+static int is_zero_element(const char* element, DataType data_type) {
+    #define ZERO_ELEMENT_CASE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE) \
+        case ENUM: return LOAD(*(const STORAGE*)element) == 0;
+
+    switch(data_type) {
+        FOR_EACH_DATA_TYPE(ZERO_ELEMENT_CASE)
+
+        default:
+            // Unsupported Data-Type
+            return 1;
+    }
+
+    #undef ZERO_ELEMENT_CASE
+}
+
+// Row- (or column-) index of every entry of a compressed matrix.
+static size_t* expand_pointers(const size_t* pointers, size_t count, size_t number_of_nonzeros) {
+    size_t* indices = (size_t*) malloc((number_of_nonzeros > 0 ? number_of_nonzeros : 1) * sizeof(size_t));
+
+    if (!indices) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        for (size_t entry = pointers[i]; entry < pointers[i + 1]; entry++) {
+            indices[entry] = i;
+        }
+    }
+
+    return indices;
+}
+
+// Stable counting-sort of the entries `order` by `keys[entry]` (keys are in [0, key_count)).
+static ErrorCode counting_sort(size_t* sorted, const size_t* order, const size_t* keys, size_t count, size_t key_count) {
+    size_t* offsets = (size_t*) calloc(key_count + 1, sizeof(size_t));
+
+    if (!offsets) {
+        return ERR_MALLOC_FAILED;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        offsets[keys[order ? order[i] : i] + 1]++;
+    }
+
+    for (size_t key = 0; key < key_count; key++) {
+        offsets[key + 1] += offsets[key];
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        size_t entry = order ? order[i] : i;
+        sorted[offsets[keys[entry]]++] = entry;
+    }
+
+    free(offsets);
+
+    return ERR_NONE;
+}
+
+// Build a CSR/CSC-matrix from the (row, col, value) triplets of `count` entries.
+static ErrorCode compress_entries(SparseMatrix* result, SparseFormat format, size_t rows, size_t cols, DataType data_type,
+                                  const size_t* row_indices, const size_t* col_indices, const char* values, size_t count) {
+    /*
+
+        The entries are sorted by their major index and then by their minor index with two
+        stable counting-sorts (O(count + rows + cols)). Entries with the same position are summed.
+
+    */
+
+    const size_t* major = format == SPARSE_CSR ? row_indices : col_indices;
+    const size_t* minor = format == SPARSE_CSR ? col_indices : row_indices;
+    size_t major_count = format == SPARSE_CSR ? rows : cols;
+    size_t minor_count = format == SPARSE_CSR ? cols : rows;
+    size_t element_size = get_data_type_size(data_type);
+
+    size_t slots = count > 0 ? count : 1;
+    size_t* by_minor = (size_t*) malloc(slots * sizeof(size_t));
+    size_t* order = (size_t*) malloc(slots * sizeof(size_t));
+
+    if (!by_minor || !order) {
+        free(by_minor);
+        free(order);
+        return ERR_MALLOC_FAILED;
+    }
+
+    ErrorCode error = counting_sort(by_minor, NULL, minor, count, minor_count);
+
+    if (error == ERR_NONE) {
+        error = counting_sort(order, by_minor, major, count, major_count);
+    }
+
+    free(by_minor);
+
+    if (error != ERR_NONE) {
+        free(order);
+        return error;
+    }
+
+    // Number of unique positions
+    size_t unique = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (i == 0 || major[order[i]] != major[order[i - 1]] || minor[order[i]] != minor[order[i - 1]]) {
+            unique++;
+        }
+    }
+
+    error = allocate_sparse_matrix(result, format, rows, cols, data_type, unique);
+
+    if (error != ERR_NONE) {
+        free(order);
+        return error;
+    }
+
+    size_t* result_minor = format == SPARSE_CSR ? result->col_indices : result->row_indices;
+    char* result_values = (char*)result->values;
+    size_t position = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        size_t entry = order[i];
+
+        if (i > 0 && major[entry] == major[order[i - 1]] && minor[entry] == minor[order[i - 1]]) {
+            // Same position as the previous entry
+            add_element(result_values + (position - 1) * element_size, values + entry * element_size, data_type);
+            continue;
+        }
+
+        result_minor[position] = minor[entry];
+        memcpy(result_values + position * element_size, values + entry * element_size, element_size);
+        result->pointers[major[entry] + 1]++;
+        position++;
+    }
+
+    for (size_t i = 0; i < major_count; i++) {
+        result->pointers[i + 1] += result->pointers[i];
+    }
+
+    result->number_of_nonzeros = unique;
+    free(order);
+
+    return ERR_NONE;
+}
+
+// Convert a sparse matrix into another format.
+ErrorCode convert_sparse_matrix(SparseMatrix* result, const SparseMatrix* matrix, SparseFormat format) {
+    /*
+
+        `result` is a new matrix, which has to be cleared with `clear_sparse_matrix`.
+        Converting to CSR/CSC sorts the entries and sums up entries with the same position.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                 = No error.
+        ERR_NULL_PTR             = Result/Matrix does not exist;
+        ERR_INVALID_ARGS         = Unknown format;
+        ERR_MALLOC_FAILED        = Space allocation with `malloc` failed;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported data-type;
+
+    */
+
+    if (!result || !matrix || !matrix->values) {
+        // Result/Matrix does not exist
+        return ERR_NULL_PTR;
+    }
+
+    size_t count = matrix->number_of_nonzeros;
+    size_t* row_indices = matrix->row_indices;
+    size_t* col_indices = matrix->col_indices;
+
+    // Compressed matrices only store one index per entry
+    if (matrix->format == SPARSE_CSR) {
+        row_indices = expand_pointers(matrix->pointers, matrix->rows, count);
+    } else if (matrix->format == SPARSE_CSC) {
+        col_indices = expand_pointers(matrix->pointers, matrix->cols, count);
+    }
+
+    if (!row_indices || !col_indices) {
+        if (row_indices != matrix->row_indices) free(row_indices);
+        if (col_indices != matrix->col_indices) free(col_indices);
+        return ERR_MALLOC_FAILED;
+    }
+
+    ErrorCode error;
+
+    if (format == SPARSE_COO) {
+        error = allocate_sparse_matrix(result, SPARSE_COO, matrix->rows, matrix->cols, matrix->data_type, count);
+
+        if (error == ERR_NONE) {
+            memcpy(result->values, matrix->values, count * get_data_type_size(matrix->data_type));
+            memcpy(result->row_indices, row_indices, count * sizeof(size_t));
+            memcpy(result->col_indices, col_indices, count * sizeof(size_t));
+            result->number_of_nonzeros = count;
+        }
+    } else if (format == SPARSE_CSR || format == SPARSE_CSC) {
+        error = compress_entries(result, format, matrix->rows, matrix->cols, matrix->data_type,
+                                 row_indices, col_indices, (const char*)matrix->values, count);
+    } else {
+        // Unknown format
+        error = ERR_INVALID_ARGS;
+    }
+
+    if (row_indices != matrix->row_indices) free(row_indices);
+    if (col_indices != matrix->col_indices) free(col_indices);
+
+    return error;
+}
+
+// Create a sparse matrix from the non-zero elements of a dense 2-D matrix.
+ErrorCode dense_to_sparse_matrix(SparseMatrix* result, const MultiDimensionalMatrix* matrix, SparseFormat format) {
+    /*
+
+        `result` is a new matrix, which has to be cleared with `clear_sparse_matrix`.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                 = No error.
+        ERR_NULL_PTR             = Result/Matrix does not exist;
+        ERR_INVALID_ARGS         = The matrix is not 2-dimensional; Unknown format;
+        ERR_MALLOC_FAILED        = Space allocation with `malloc` failed;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported data-type;
+
+    */
+
+    if (!result || !matrix || !matrix->head_ptr || !matrix->head_ptr->data) {
+        // Result/Matrix does not exist
+        return ERR_NULL_PTR;
+    }
+
+    if (matrix->head_ptr->number_of_dimensions != 2) {
+        // Only 2-D matrices can be sparse
+        return ERR_INVALID_ARGS;
+    }
+
+    if (format != SPARSE_COO && format != SPARSE_CSR && format != SPARSE_CSC) {
+        // Unknown format
+        return ERR_INVALID_ARGS;
+    }
+
+    DataType data_type = matrix->head_ptr->data_type;
+    size_t element_size = get_data_type_size(data_type);
+
+    if (!element_size) {
+        // Unsupported Data-Type
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    size_t rows = matrix->head_ptr->dimensions[0], cols = matrix->head_ptr->dimensions[1];
+    const char* data = (const char*)matrix->head_ptr->data;
+    size_t count = 0;
+
+    for (size_t i = 0; i < rows * cols; i++) {
+        count += !is_zero_element(data + i * element_size, data_type);
+    }
+
+    // Row-major scan: the entries are already sorted for CSR
+    SparseMatrix entries;
+    ErrorCode error = allocate_sparse_matrix(&entries, SPARSE_COO, rows, cols, data_type, count);
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    for (size_t i = 0; i < rows * cols; i++) {
+        if (is_zero_element(data + i * element_size, data_type)) {
+            continue;
+        }
+
+        size_t entry = entries.number_of_nonzeros++;
+        entries.row_indices[entry] = i / cols;
+        entries.col_indices[entry] = i % cols;
+        memcpy((char*)entries.values + entry * element_size, data + i * element_size, element_size);
+    }
+
+    if (format == SPARSE_COO) {
+        *result = entries;
+        return ERR_NONE;
+    }
+
+    error = compress_entries(result, format, rows, cols, data_type,
+                             entries.row_indices, entries.col_indices, (const char*)entries.values, count);
+    clear_sparse_matrix(&entries);
+
+    return error;
+}
+
+// Create a dense 2-D matrix from a sparse matrix.
+ArithmeticOperationReturn sparse_to_dense_matrix(const SparseMatrix* matrix) {
+    /*
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The dense (rows x cols) matrix.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                        = No error.
+        ERR_NULL_PTR                    = Matrix does not exist;
+
+        » For the other possible ErrorCodes, see what `create_matrix` returns. «
+
+    */
+
+    ArithmeticOperationReturn response;
+    response.error_code = ERR_NONE;
+    response.result_matrix.head_ptr = NULL;
+
+    if (!matrix || !matrix->values) {
+        // Matrix does not exist
+        response.error_code = ERR_NULL_PTR;
+        return response;
+    }
+
+    size_t dimensions[] = {matrix->rows, matrix->cols};
+    response.error_code = create_matrix(&response.result_matrix, 2, dimensions, matrix->data_type);
+
+    if (response.error_code != ERR_NONE) {
+        response.result_matrix.head_ptr = NULL;
+        return response;
+    }
+
+    char* data = (char*)response.result_matrix.head_ptr->data;
+    const char* values = (const char*)matrix->values;
+    size_t element_size = get_data_type_size(matrix->data_type);
+
+    memset(data, 0, response.result_matrix.head_ptr->data_size);
+
+    size_t row = 0, col = 0;
+
+    for (size_t entry = 0; entry < matrix->number_of_nonzeros; entry++) {
+        // Compressed entries are visited in order, so the row/column only moves forward
+        if (matrix->format == SPARSE_CSR) {
+            while (matrix->pointers[row + 1] <= entry) row++;
+        } else {
+            row = matrix->row_indices[entry];
+        }
+
+        if (matrix->format == SPARSE_CSC) {
+            while (matrix->pointers[col + 1] <= entry) col++;
+        } else {
+            col = matrix->col_indices[entry];
+        }
+
+        add_element(data + (row * matrix->cols + col) * element_size, values + entry * element_size, matrix->data_type);
+    }
+
+    return response;
+}
+
+
+//
+// Products
+//
+
+
+// Sparse times dense kernels: `C (rows x n) = A (rows x cols) * B (cols x n)`
+#define DEFINE_SPARSE_PRODUCT_KERNELS(NAME, STORAGE, COMPUTE, LOAD, STORE)                              \
+/* Rows [begin, end) of the product with a CSR-matrix */                                                \
+static void NAME##_csr_rows(const SparseMatrix* matrix, const void* dense, void* result, size_t n,      \
+                            size_t begin, size_t end) {                                                 \
+    const STORAGE* values = (const STORAGE*)matrix->values;                                             \
+    const STORAGE* B = (const STORAGE*)dense;                                                           \
+    STORAGE* C = (STORAGE*)result;                                                                      \
+    /* Types, which are computed in another type, are always summed in registers */                     \
+    int in_registers = n == 1 || sizeof(STORAGE) != sizeof(COMPUTE);                                    \
+    for (size_t i = begin; i < end; i++) {                                                              \
+        STORAGE* c_row = C + i * n;                                                                     \
+        if (in_registers) {                                                                             \
+            /* Dot-products of the row and every column (of a vector: a single one) */                  \
+            for (size_t j = 0; j < n; j++) {                                                            \
+                COMPUTE sum = 0;                                                                        \
+                for (size_t p = matrix->pointers[i]; p < matrix->pointers[i + 1]; p++) {                \
+                    sum += LOAD(values[p]) * LOAD(B[matrix->col_indices[p] * n + j]);                   \
+                }                                                                                       \
+                c_row[j] = STORE(STORAGE, sum);                                                         \
+            }                                                                                           \
+            continue;                                                                                   \
+        }                                                                                               \
+        memset(c_row, 0, n * sizeof(STORAGE));                                                          \
+        for (size_t p = matrix->pointers[i]; p < matrix->pointers[i + 1]; p++) {                        \
+            const COMPUTE a = LOAD(values[p]);                                                          \
+            const STORAGE* b_row = B + matrix->col_indices[p] * n;                                      \
+            for (size_t j = 0; j < n; j++) {                                                            \
+                c_row[j] += a * b_row[j];                                                               \
+            }                                                                                           \
+        }                                                                                               \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+/* Product with a COO/CSC-matrix: every entry is scattered into its result row */                       \
+static void NAME##_scatter(const SparseMatrix* matrix, const void* dense, void* result, size_t n) {     \
+    const STORAGE* values = (const STORAGE*)matrix->values;                                             \
+    const STORAGE* B = (const STORAGE*)dense;                                                           \
+    STORAGE* C = (STORAGE*)result;                                                                      \
+    memset(C, 0, matrix->rows * n * sizeof(STORAGE));                                                   \
+    size_t col = 0;                                                                                     \
+    for (size_t p = 0; p < matrix->number_of_nonzeros; p++) {                                           \
+        if (matrix->format == SPARSE_CSC) {                                                             \
+            while (matrix->pointers[col + 1] <= p) col++;                                               \
+        } else {                                                                                        \
+            col = matrix->col_indices[p];                                                               \
+        }                                                                                               \
+        const COMPUTE a = LOAD(values[p]);                                                              \
+        const STORAGE* b_row = B + col * n;                                                             \
+        STORAGE* c_row = C + matrix->row_indices[p] * n;                                                \
+        for (size_t j = 0; j < n; j++) {                                                                \
+            c_row[j] = STORE(STORAGE, LOAD(c_row[j]) + a * LOAD(b_row[j]));                             \
+        }                                                                                               \
+    }                                                                                                   \
+}
+
+#define DEFINE_TYPE_SPARSE_PRODUCT_KERNELS(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE)                   \
+    DEFINE_SPARSE_PRODUCT_KERNELS(sparse_##NAME, STORAGE, COMPUTE, LOAD, STORE)
+
+FOR_EACH_DATA_TYPE(DEFINE_TYPE_SPARSE_PRODUCT_KERNELS)
+
+typedef void (*SparseRowKernel)(const SparseMatrix* matrix, const void* dense, void* result, size_t n, size_t begin, size_t end);
+typedef void (*SparseScatterKernel)(const SparseMatrix* matrix, const void* dense, void* result, size_t n);
+
+static SparseRowKernel select_sparse_row_kernel(DataType data_type) {
+    #define SPARSE_ROW_KERNEL_CASE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE) case ENUM: return sparse_##NAME##_csr_rows;
+
+    switch(data_type) {
+        FOR_EACH_DATA_TYPE(SPARSE_ROW_KERNEL_CASE)
+
+        default:
+            // Unsupported Data-Type
+            return NULL;
+    }
+
+    #undef SPARSE_ROW_KERNEL_CASE
+}
+
+static SparseScatterKernel select_sparse_scatter_kernel(DataType data_type) {
+    #define SPARSE_SCATTER_KERNEL_CASE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE) case ENUM: return sparse_##NAME##_scatter;
+
+    switch(data_type) {
+        FOR_EACH_DATA_TYPE(SPARSE_SCATTER_KERNEL_CASE)
+
+        default:
+            // Unsupported Data-Type
+            return NULL;
+    }
+
+    #undef SPARSE_SCATTER_KERNEL_CASE
+}
+
+typedef struct SparseProductTask {
+    const SparseMatrix* matrix;
+    const void* dense;
+    void* result;
+    size_t n;
+    SparseRowKernel kernel;
+} SparseProductTask;
+
+// Parallel task: compute the result rows [begin, end).
+static void multiply_sparse_row_range(void* context, size_t begin, size_t end) {
+    const SparseProductTask* task = (const SparseProductTask*)context;
+    task->kernel(task->matrix, task->dense, task->result, task->n, begin, end);
+}
+
+// Minimum number of rows per thread, so every thread gets `PARALLEL_SPARSE_CHUNK` multiply-adds.
+static size_t minimum_sparse_rows(size_t rows, size_t work) {
+    size_t work_per_row = rows > 0 ? work / rows : 0;
+
+    return work_per_row > 0 ? PARALLEL_SPARSE_CHUNK / work_per_row + 1 : PARALLEL_SPARSE_CHUNK;
+}
+
+// `result = matrix * dense` for a dense operand with `cols` rows and `n` columns.
+static ArithmeticOperationReturn multiply_sparse_dense(const SparseMatrix* matrix, const MultiDimensionalMatrix* dense, size_t n) {
+    ArithmeticOperationReturn response;
+    response.error_code = ERR_NONE;
+    response.result_matrix.head_ptr = NULL;
+
+    if (matrix->data_type != dense->head_ptr->data_type) {
+        // Cannot multiply two matrices with different data-types
+        response.error_code = ERR_DATATYPE_MISMATCH;
+        return response;
+    }
+
+    SparseRowKernel row_kernel = select_sparse_row_kernel(matrix->data_type);
+    SparseScatterKernel scatter_kernel = select_sparse_scatter_kernel(matrix->data_type);
+
+    if (!row_kernel || !scatter_kernel) {
+        // Unsupported Data-Type
+        response.error_code = ERR_UNSUPPORTED_DATATYPE;
+        return response;
+    }
+
+    // A vector gives a vector, a matrix gives a (rows x n) matrix
+    size_t dimensions[] = {matrix->rows, n};
+    response.error_code = create_matrix(&response.result_matrix, dense->head_ptr->number_of_dimensions, dimensions, matrix->data_type);
+
+    if (response.error_code != ERR_NONE) {
+        response.result_matrix.head_ptr = NULL;
+        return response;
+    }
+
+    if (matrix->format == SPARSE_CSR) {
+        SparseProductTask task = {matrix, dense->head_ptr->data, response.result_matrix.head_ptr->data, n, row_kernel};
+        parallel_for(matrix->rows, minimum_sparse_rows(matrix->rows, matrix->number_of_nonzeros * n),
+                     multiply_sparse_row_range, &task);
+    } else {
+        scatter_kernel(matrix, dense->head_ptr->data, response.result_matrix.head_ptr->data, n);
+    }
+
+    return response;
+}
+
+// Multiplication of a sparse matrix and a dense vector.
+ArithmeticOperationReturn sparse_multiply_dense_vector(const SparseMatrix* matrix, const MultiDimensionalMatrix* vector) {
+    /*
+
+        `vector` is a 1-D matrix with `cols` elements, the result is a 1-D matrix with `rows` elements.
+        CSR-matrices with many rows are processed by several threads.
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The result of this operation.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                        = No error.
+        ERR_NULL_PTR                    = Matrix/Vector does not exist;
+        ERR_INVALID_ARGS                = The vector is not 1-dimensional;
+        ERR_DIMENSION_SIZE_MISMATCH     = The length of the vector is not equal to `cols`;
+        ERR_DATATYPE_MISMATCH           = The data types of both operands do not match;
+        ERR_UNSUPPORTED_DATATYPE        = Unsupported data-type;
+
+        » For the other possible ErrorCodes, see what `create_matrix` returns. «
+
+    */
+
+    ArithmeticOperationReturn response;
+    response.result_matrix.head_ptr = NULL;
+
+    if (!matrix || !matrix->values || !vector || !vector->head_ptr || !vector->head_ptr->data) {
+        // Matrix/Vector does not exist
+        response.error_code = ERR_NULL_PTR;
+        return response;
+    }
+
+    if (vector->head_ptr->number_of_dimensions != 1) {
+        response.error_code = ERR_INVALID_ARGS;
+        return response;
+    }
+
+    if (vector->head_ptr->dimensions[0] != matrix->cols) {
+        response.error_code = ERR_DIMENSION_SIZE_MISMATCH;
+        return response;
+    }
+
+    return multiply_sparse_dense(matrix, vector, 1);
+}
+
+// Multiplication of a sparse matrix and a dense 2-D matrix.
+ArithmeticOperationReturn sparse_multiply_dense_matrix(const SparseMatrix* matrix, const MultiDimensionalMatrix* dense_matrix) {
+    /*
+
+        `dense_matrix` has `cols` rows, the result is a dense (rows x dense-cols) matrix.
+        CSR-matrices with many rows are processed by several threads.
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The result of this operation.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                        = No error.
+        ERR_NULL_PTR                    = One or both matrices do not exist;
+        ERR_INVALID_ARGS                = The dense matrix is not 2-dimensional;
+        ERR_DIMENSION_SIZE_MISMATCH     = The rows of the dense matrix are not equal to `cols`;
+        ERR_DATATYPE_MISMATCH           = The data types of both matrices do not match;
+        ERR_UNSUPPORTED_DATATYPE        = Unsupported data-type;
+
+        » For the other possible ErrorCodes, see what `create_matrix` returns. «
+
+    */
+
+    ArithmeticOperationReturn response;
+    response.result_matrix.head_ptr = NULL;
+
+    if (!matrix || !matrix->values || !dense_matrix || !dense_matrix->head_ptr || !dense_matrix->head_ptr->data) {
+        // One or both matrices do not exist
+        response.error_code = ERR_NULL_PTR;
+        return response;
+    }
+
+    if (dense_matrix->head_ptr->number_of_dimensions != 2) {
+        response.error_code = ERR_INVALID_ARGS;
+        return response;
+    }
+
+    if (dense_matrix->head_ptr->dimensions[0] != matrix->cols) {
+        response.error_code = ERR_DIMENSION_SIZE_MISMATCH;
+        return response;
+    }
+
+    return multiply_sparse_dense(matrix, dense_matrix, dense_matrix->head_ptr->dimensions[1]);
+}
+
+
+//
+// Addition
+//
+
+
+// Merge the sorted rows [begin, end) of two CSR-matrices into the prepared result-rows.
+#define DEFINE_SPARSE_ADD_KERNEL(NAME, STORAGE, COMPUTE, LOAD, STORE)                                   \
+static void NAME(const SparseMatrix* A, const SparseMatrix* B, SparseMatrix* C, size_t begin, size_t end) { \
+    const STORAGE* values_A = (const STORAGE*)A->values;                                                \
+    const STORAGE* values_B = (const STORAGE*)B->values;                                                \
+    STORAGE* values_C = (STORAGE*)C->values;                                                            \
+    for (size_t i = begin; i < end; i++) {                                                              \
+        size_t p = A->pointers[i], q = B->pointers[i], out = C->pointers[i];                            \
+        while (p < A->pointers[i + 1] || q < B->pointers[i + 1]) {                                      \
+            size_t col_A = p < A->pointers[i + 1] ? A->col_indices[p] : C->cols;                        \
+            size_t col_B = q < B->pointers[i + 1] ? B->col_indices[q] : C->cols;                        \
+            if (col_A == col_B) {                                                                       \
+                values_C[out] = STORE(STORAGE, LOAD(values_A[p]) + LOAD(values_B[q]));                  \
+                p++;                                                                                    \
+                q++;                                                                                    \
+            } else if (col_A < col_B) {                                                                 \
+                values_C[out] = values_A[p++];                                                          \
+            } else {                                                                                    \
+                values_C[out] = values_B[q++];                                                          \
+            }                                                                                           \
+            C->col_indices[out++] = col_A < col_B ? col_A : col_B;                                      \
+        }                                                                                               \
+    }                                                                                                   \
+}
+
+#define DEFINE_TYPE_SPARSE_ADD_KERNEL(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE)                       \
+    DEFINE_SPARSE_ADD_KERNEL(add_sparse_##NAME##_rows, STORAGE, COMPUTE, LOAD, STORE)
+
+FOR_EACH_DATA_TYPE(DEFINE_TYPE_SPARSE_ADD_KERNEL)
+
+typedef void (*SparseAddKernel)(const SparseMatrix* A, const SparseMatrix* B, SparseMatrix* C, size_t begin, size_t end);
+
+typedef struct SparseAddTask {
+    const SparseMatrix* A;
+    const SparseMatrix* B;
+    SparseMatrix* C;
+    size_t* row_sizes;
+    SparseAddKernel kernel;
+} SparseAddTask;
+
+// Parallel task: number of entries of the result rows [begin, end).
+static void count_sparse_sum_rows(void* context, size_t begin, size_t end) {
+    const SparseAddTask* task = (const SparseAddTask*)context;
+    const SparseMatrix* A = task->A;
+    const SparseMatrix* B = task->B;
+
+    for (size_t i = begin; i < end; i++) {
+        size_t p = A->pointers[i], q = B->pointers[i], count = 0;
+
+        while (p < A->pointers[i + 1] && q < B->pointers[i + 1]) {
+            size_t col_A = A->col_indices[p], col_B = B->col_indices[q];
+            p += col_A <= col_B;
+            q += col_B <= col_A;
+            count++;
+        }
+
+        task->row_sizes[i + 1] = count + (A->pointers[i + 1] - p) + (B->pointers[i + 1] - q);
+    }
+}
+
+// Parallel task: fill the result rows [begin, end).
+static void add_sparse_row_range(void* context, size_t begin, size_t end) {
+    const SparseAddTask* task = (const SparseAddTask*)context;
+    task->kernel(task->A, task->B, task->C, begin, end);
+}
+
+// Addition of two sparse matrices.
+ErrorCode add_sparse_matrices(SparseMatrix* result, const SparseMatrix* matrix_A, const SparseMatrix* matrix_B) {
+    /*
+
+        `result` is a new CSR-matrix, which has to be cleared with `clear_sparse_matrix`.
+        Operands in another format are converted to CSR first. The rows are merged in two
+        passes (count, then fill), both of them are distributed over several threads.
+        Positions, which are stored in both operands, stay in the result even if their sum is 0.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                        = No error.
+        ERR_NULL_PTR                    = Result or one of the matrices does not exist;
+        ERR_DIMENSION_SIZE_MISMATCH     = The shapes of both matrices do not match;
+        ERR_DATATYPE_MISMATCH           = The data types of both matrices do not match;
+        ERR_MALLOC_FAILED               = Space allocation with `malloc` failed;
+        ERR_UNSUPPORTED_DATATYPE        = Unsupported data-type;
+
+    */
+
+    if (!result || !matrix_A || !matrix_B || !matrix_A->values || !matrix_B->values) {
+        // Result or one of the matrices does not exist
+        return ERR_NULL_PTR;
+    }
+
+    if (matrix_A->rows != matrix_B->rows || matrix_A->cols != matrix_B->cols) {
+        return ERR_DIMENSION_SIZE_MISMATCH;
+    }
+
+    if (matrix_A->data_type != matrix_B->data_type) {
+        return ERR_DATATYPE_MISMATCH;
+    }
+
+    SparseAddTask task;
+
+    #define SPARSE_ADD_KERNEL_CASE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE) \
+        case ENUM: task.kernel = add_sparse_##NAME##_rows; break;
+
+    switch(matrix_A->data_type) {
+        FOR_EACH_DATA_TYPE(SPARSE_ADD_KERNEL_CASE)
+
+        default:
+            // Unsupported Data-Type
+            return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    #undef SPARSE_ADD_KERNEL_CASE
+
+    // CSR-copies of operands in other formats
+    SparseMatrix converted_A, converted_B;
+    ErrorCode error = ERR_NONE;
+
+    converted_A.values = NULL;
+    converted_B.values = NULL;
+
+    if (matrix_A->format != SPARSE_CSR) {
+        error = convert_sparse_matrix(&converted_A, matrix_A, SPARSE_CSR);
+        matrix_A = &converted_A;
+    }
+
+    if (error == ERR_NONE && matrix_B->format != SPARSE_CSR) {
+        error = convert_sparse_matrix(&converted_B, matrix_B, SPARSE_CSR);
+        matrix_B = &converted_B;
+    }
+
+    size_t rows = matrix_A->rows;
+    size_t* row_sizes = NULL;
+
+    if (error == ERR_NONE) {
+        row_sizes = (size_t*) calloc(rows + 1, sizeof(size_t));
+        error = row_sizes ? ERR_NONE : ERR_MALLOC_FAILED;
+    }
+
+    if (error == ERR_NONE) {
+        size_t minimum_rows = minimum_sparse_rows(rows, matrix_A->number_of_nonzeros + matrix_B->number_of_nonzeros);
+
+        task.A = matrix_A;
+        task.B = matrix_B;
+        task.C = result;
+        task.row_sizes = row_sizes;
+
+        // First pass: size of every result row
+        parallel_for(rows, minimum_rows, count_sparse_sum_rows, &task);
+
+        for (size_t i = 0; i < rows; i++) {
+            row_sizes[i + 1] += row_sizes[i];
+        }
+
+        error = allocate_sparse_matrix(result, SPARSE_CSR, rows, matrix_A->cols, matrix_A->data_type, row_sizes[rows]);
+
+        if (error == ERR_NONE) {
+            // Second pass: merge the rows
+            memcpy(result->pointers, row_sizes, (rows + 1) * sizeof(size_t));
+            result->number_of_nonzeros = row_sizes[rows];
+            parallel_for(rows, minimum_rows, add_sparse_row_range, &task);
+        }
+    }
+
+    free(row_sizes);
+
+    if (converted_A.values) clear_sparse_matrix(&converted_A);
+    if (converted_B.values) clear_sparse_matrix(&converted_B);
+
+    return error;
+}
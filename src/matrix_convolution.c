@@ -0,0 +1,623 @@
+#include "custom_dynamic_matrices.h"
+#include "matrix_data_types.h"
+#include "matrix_kernels.h"
+#include "matrix_parallel.h"
+
+#include <stdatomic.h> // For `atomic_int`
+#include <stddef.h> // For `ptrdiff_t`
+
+
+/*
+
+    Correlations and convolutions of multi-channel inputs with a bank of filters:
+
+    - input:   [batch, in_channels, spatial...]            (1 to 3 spatial dimensions)
+    - filters: [out_channels, in_channels, kernel...]
+    - result:  [batch, out_channels, output...]
+
+    with `output = (spatial + 2 * padding - dilation * (kernel - 1) - 1) / stride + 1` per
+    spatial dimension. Internally every tensor has 3 spatial dimensions (missing leading ones
+    have the size 1), so one set of loops covers 1-D, 2-D and 3-D.
+
+    There are two algorithms:
+
+    - im2col: the input of a batch-item is unfolded into a matrix with one row per filter-tap
+      (in_channels * kernel rows) and one column per output-position. The filters, read as a
+      [out_channels, in_channels * kernel] matrix, are multiplied with it by the matmul kernels
+      of `multiply_matrix_tiles`. The output-positions are processed in tiles, whose unfolded
+      matrix fits into the cache; the tiles are split over threads.
+    - direct: for each output row, every filter-tap adds `weight * input` to a block of
+      accumulators along the last dimension (an axpy over contiguous inputs for stride 1,
+      which vectorizes). The output rows are split over threads. It avoids the unfolded copy,
+      which costs more than the matmul saves when the filters are small and have few channels.
+
+    A convolution is a correlation with the filters flipped along all spatial dimensions.
+
+*/
+
+// Filters with at most this many taps per channel (5x5) use the direct kernel by default...
+#define DIRECT_CONVOLUTION_KERNEL_LIMIT 25
+// ...if a result also sums at most this many products (in_channels * taps)
+#define DIRECT_CONVOLUTION_REDUCTION_LIMIT 64
+
+// Accumulators of the direct kernel along the last dimension
+#define DIRECT_CONVOLUTION_BLOCK 256
+
+// Filter rows up to this length are accumulated in one pass over the accumulators
+#define DIRECT_CONVOLUTION_FUSED_TAPS 8
+
+// Bytes of the unfolded input of one im2col-tile and the granularity of its columns
+#define IM2COL_TILE_BYTES (128 * 1024)
+#define IM2COL_COLUMN_ALIGNMENT 16
+
+// Minimum number of multiply-adds processed by one thread
+#define PARALLEL_CONVOLUTION_CHUNK 65536
+
+// Geometry of a convolution with 3 spatial dimensions
+typedef struct ConvolutionGeometry {
+    size_t batch;
+    size_t in_channels;
+    size_t out_channels;
+    size_t input[MAX_CONVOLUTION_DIMENSIONS];
+    size_t kernel[MAX_CONVOLUTION_DIMENSIONS];
+    size_t output[MAX_CONVOLUTION_DIMENSIONS];
+    size_t stride[MAX_CONVOLUTION_DIMENSIONS];
+    size_t dilation[MAX_CONVOLUTION_DIMENSIONS];
+    ptrdiff_t padding[MAX_CONVOLUTION_DIMENSIONS];
+    size_t input_size;              // Elements of one input channel
+    size_t kernel_size;             // Taps of one filter channel
+    size_t output_size;             // Elements of one output channel
+} ConvolutionGeometry;
+
+// Input-position of an output-position and a filter-tap along one dimension
+static inline ptrdiff_t input_position(const ConvolutionGeometry* geometry, size_t dimension, size_t output, size_t tap) {
+    return (ptrdiff_t)(output * geometry->stride[dimension] + tap * geometry->dilation[dimension]) - geometry->padding[dimension];
+}
+
+// Outputs [first, last) along the last dimension, whose input-position for `tap` lies inside the input
+static void valid_output_range(const ConvolutionGeometry* geometry, size_t tap, size_t* first, size_t* last) {
+    ptrdiff_t offset = (ptrdiff_t)(tap * geometry->dilation[2]) - geometry->padding[2];
+    ptrdiff_t stride = (ptrdiff_t)geometry->stride[2];
+    ptrdiff_t size = (ptrdiff_t)geometry->input[2];
+
+    size_t lower = offset >= 0 ? 0 : (size_t)((-offset + stride - 1) / stride);
+    size_t upper = offset >= size ? 0 : (size_t)((size - 1 - offset) / stride) + 1;
+
+    *last = upper < geometry->output[2] ? upper : geometry->output[2];
+    *first = lower < *last ? lower : *last;
+}
+
+
+//
+// Direct
+//
+
+// Work of a convolution, shared by all threads.
+typedef struct ConvolutionTask {
+    const ConvolutionGeometry* geometry;
+    const char* input;
+    const char* filters;
+    char* result;
+} ConvolutionTask;
+
+// Kernels of the direct convolution
+#define DEFINE_DIRECT_CONVOLUTION_KERNEL(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE)                     \
+/* `sums[i] += weight * values[i * stride]` */                                                       \
+static inline void accumulate_tap_##NAME(COMPUTE* sums, const STORAGE* values, COMPUTE weight,          \
+                                         size_t count, size_t stride) {                                 \
+    if (stride == 1) {                                                                                  \
+        for (size_t i = 0; i < count; i++) {                                                            \
+            sums[i] += weight * LOAD(values[i]);                                                        \
+        }                                                                                               \
+    } else {                                                                                            \
+        for (size_t i = 0; i < count; i++) {                                                            \
+            sums[i] += weight * LOAD(values[i * stride]);                                               \
+        }                                                                                               \
+    }                                                                                                   \
+}                                                                                                       \
+/* `sums[i] += sum_k weights[k] * values[i + k * dilation]`: one pass over the sums for all taps */     \
+static inline void accumulate_taps_##NAME(COMPUTE* sums, const STORAGE* values, const COMPUTE* weights, \
+                                          size_t count, size_t taps, size_t dilation) {                 \
+    for (size_t i = 0; i < count; i++) {                                                                \
+        COMPUTE sum = sums[i];                                                                          \
+        for (size_t k = 0; k < taps; k++) {                                                             \
+            sum += weights[k] * LOAD(values[i + k * dilation]);                                         \
+        }                                                                                               \
+        sums[i] = sum;                                                                                  \
+    }                                                                                                   \
+}                                                                                                       \
+/* Add the taps of one filter row to the outputs [block, block + length) */                             \
+static void accumulate_row_##NAME(const ConvolutionGeometry* g, COMPUTE* sums, const STORAGE* source,   \
+                                  const STORAGE* taps, size_t block, size_t length) {                   \
+    size_t fused_first = 0, fused_last = 0;                                                             \
+    COMPUTE weights[DIRECT_CONVOLUTION_FUSED_TAPS];                                                     \
+    if (g->stride[2] == 1 && g->kernel[2] <= DIRECT_CONVOLUTION_FUSED_TAPS) {                           \
+        /* Outputs, for which all taps lie inside the input */                                          \
+        size_t first, last;                                                                             \
+        valid_output_range(g, 0, &fused_first, &last);                                                  \
+        valid_output_range(g, g->kernel[2] - 1, &first, &fused_last);                                   \
+        fused_first = fused_first > block ? fused_first : block;                                        \
+        fused_last = fused_last < block + length ? fused_last : block + length;                         \
+        fused_last = fused_last > fused_first ? fused_last : fused_first;                               \
+        for (size_t k2 = 0; k2 < g->kernel[2]; k2++) {                                                  \
+            weights[k2] = LOAD(taps[k2]);                                                               \
+        }                                                                                               \
+        const STORAGE* values = source + (fused_last > fused_first ? input_position(g, 2, fused_first, 0) : 0);\
+        size_t count = fused_last - fused_first;                                                        \
+        /* Constant tap-counts are unrolled */                                                          \
+        switch(g->kernel[2]) {                                                                          \
+            case 3:                                                                                     \
+                accumulate_taps_##NAME(sums + (fused_first - block), values, weights, count, 3, g->dilation[2]);\
+                break;                                                                                  \
+            case 5:                                                                                     \
+                accumulate_taps_##NAME(sums + (fused_first - block), values, weights, count, 5, g->dilation[2]);\
+                break;                                                                                  \
+            default:                                                                                    \
+                accumulate_taps_##NAME(sums + (fused_first - block), values, weights, count, g->kernel[2], g->dilation[2]);\
+                break;                                                                                  \
+        }                                                                                               \
+    }                                                                                                   \
+    /* Remaining outputs tap by tap (all of them, if the taps are not fused) */                         \
+    for (size_t k2 = 0; k2 < g->kernel[2]; k2++) {                                                      \
+        size_t first, last;                                                                             \
+        valid_output_range(g, k2, &first, &last);                                                       \
+        first = first > block ? first : block;                                                          \
+        last = last < block + length ? last : block + length;                                           \
+        COMPUTE weight = LOAD(taps[k2]);                                                                \
+        size_t before = last < fused_first ? last : fused_first;                                        \
+        size_t after = first > fused_last ? first : fused_last;                                         \
+        if (fused_first == fused_last) {                                                                \
+            before = last;                                                                              \
+            after = last;                                                                               \
+        }                                                                                               \
+        if (first < before) {                                                                           \
+            accumulate_tap_##NAME(sums + (first - block), source + input_position(g, 2, first, k2), weight,\
+                                  before - first, g->stride[2]);                                        \
+        }                                                                                               \
+        if (after < last) {                                                                             \
+            accumulate_tap_##NAME(sums + (after - block), source + input_position(g, 2, after, k2), weight,\
+                                  last - after, g->stride[2]);                                          \
+        }                                                                                               \
+    }                                                                                                   \
+}                                                                                                       \
+/* Parallel task: compute the output rows [begin, end), a row being (batch, out_channel, output[0], output[1]) */\
+static void direct_convolution_##NAME(void* context, size_t begin, size_t end) {                        \
+    const ConvolutionTask* task = (const ConvolutionTask*)context;                                      \
+    const ConvolutionGeometry* g = task->geometry;                                                      \
+    const STORAGE* input = (const STORAGE*)task->input;                                                 \
+    const STORAGE* filters = (const STORAGE*)task->filters;                                             \
+    COMPUTE sums[DIRECT_CONVOLUTION_BLOCK];                                                             \
+    for (size_t row = begin; row < end; row++) {                                                        \
+        size_t o1 = row % g->output[1];                                                                 \
+        size_t o0 = row / g->output[1] % g->output[0];                                                  \
+        size_t channel = row / (g->output[1] * g->output[0]) % g->out_channels;                         \
+        size_t item = row / (g->output[1] * g->output[0] * g->out_channels);                            \
+        STORAGE* out = (STORAGE*)task->result + row * g->output[2];                                     \
+        for (size_t block = 0; block < g->output[2]; block += DIRECT_CONVOLUTION_BLOCK) {               \
+            size_t length = g->output[2] - block;                                                       \
+            length = length < DIRECT_CONVOLUTION_BLOCK ? length : DIRECT_CONVOLUTION_BLOCK;             \
+            for (size_t i = 0; i < length; i++) {                                                       \
+                sums[i] = 0;                                                                            \
+            }                                                                                           \
+            for (size_t c = 0; c < g->in_channels; c++) {                                               \
+                const STORAGE* plane = input + (item * g->in_channels + c) * g->input_size;             \
+                const STORAGE* weights = filters + (channel * g->in_channels + c) * g->kernel_size;     \
+                for (size_t k0 = 0; k0 < g->kernel[0]; k0++) {                                          \
+                    ptrdiff_t i0 = input_position(g, 0, o0, k0);                                        \
+                    if (i0 < 0 || i0 >= (ptrdiff_t)g->input[0]) {                                       \
+                        continue;                                                                       \
+                    }                                                                                   \
+                    for (size_t k1 = 0; k1 < g->kernel[1]; k1++) {                                      \
+                        ptrdiff_t i1 = input_position(g, 1, o1, k1);                                    \
+                        if (i1 < 0 || i1 >= (ptrdiff_t)g->input[1]) {                                   \
+                            continue;                                                                   \
+                        }                                                                               \
+                        accumulate_row_##NAME(g, sums, plane + ((size_t)i0 * g->input[1] + (size_t)i1) * g->input[2],\
+                                              weights + (k0 * g->kernel[1] + k1) * g->kernel[2], block, length);\
+                    }                                                                                   \
+                }                                                                                       \
+            }                                                                                           \
+            for (size_t i = 0; i < length; i++) {                                                       \
+                out[block + i] = STORE(STORAGE, sums[i]);                                               \
+            }                                                                                           \
+        }                                                                                               \
+    }                                                                                                   \
+}
+
+FOR_EACH_DATA_TYPE(DEFINE_DIRECT_CONVOLUTION_KERNEL)
+
+static ParallelTask select_direct_convolution_kernel(DataType data_type) {
+    /*
+
+        Returns NULL if the data-type is not supported.
+
+    */
+
+    #define DIRECT_CONVOLUTION_CASE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE) \
+        case ENUM: return direct_convolution_##NAME;
+
+    switch(data_type) {
+        FOR_EACH_DATA_TYPE(DIRECT_CONVOLUTION_CASE)
+
+        default:
+            // Unsupported Data-Type
+            return NULL;
+    }
+
+    #undef DIRECT_CONVOLUTION_CASE
+}
+
+
+//
+// im2col
+//
+
+// Work of an im2col-convolution, shared by all threads (a tile being a batch-item and a block of output-positions)
+typedef struct Im2colTask {
+    const ConvolutionGeometry* geometry;
+    const char* input;
+    const char* filters;
+    char* result;
+    DataType data_type;
+    size_t element_size;
+    size_t tile_columns;            // Output-positions per tile
+    size_t tiles_per_item;
+    atomic_int error;               // First error of any thread (an `ErrorCode`)
+} Im2colTask;
+
+// Keep `error`, unless another thread has failed before.
+static void set_im2col_error(Im2colTask* task, ErrorCode error) {
+    int expected = ERR_NONE;
+    atomic_compare_exchange_strong(&task->error, &expected, (int)error);
+}
+
+// Unfold the output-positions [first_position, first_position + count) of one batch-item,
+// a row of `columns` being (in_channel, tap)
+static void unfold_convolution_tile(const Im2colTask* task, const char* input, char* columns,
+                                    size_t first_position, size_t count) {
+    const ConvolutionGeometry* g = task->geometry;
+    size_t element_size = task->element_size;
+    size_t rows = g->in_channels * g->kernel_size;
+
+    // Positions in the padding stay zero
+    memset(columns, 0, rows * count * element_size);
+
+    for (size_t row = 0; row < rows; row++) {
+        size_t tap = row % g->kernel_size;
+        size_t k2 = tap % g->kernel[2];
+        size_t k1 = tap / g->kernel[2] % g->kernel[1];
+        size_t k0 = tap / (g->kernel[2] * g->kernel[1]);
+
+        const char* plane = input + row / g->kernel_size * g->input_size * element_size;
+        char* target_row = columns + row * count * element_size;
+
+        size_t first_valid, last_valid;
+        valid_output_range(g, k2, &first_valid, &last_valid);
+
+        // Runs of positions along the last dimension
+        for (size_t position = first_position; position < first_position + count;) {
+            size_t o2 = position % g->output[2];
+            size_t o1 = position / g->output[2] % g->output[1];
+            size_t o0 = position / (g->output[2] * g->output[1]);
+            size_t run = g->output[2] - o2;
+            run = run < first_position + count - position ? run : first_position + count - position;
+
+            ptrdiff_t i0 = input_position(g, 0, o0, k0);
+            ptrdiff_t i1 = input_position(g, 1, o1, k1);
+            size_t first = o2 > first_valid ? o2 : first_valid;
+            size_t last = o2 + run < last_valid ? o2 + run : last_valid;
+
+            if (i0 >= 0 && i0 < (ptrdiff_t)g->input[0] && i1 >= 0 && i1 < (ptrdiff_t)g->input[1] && first < last) {
+                const char* source = plane + (((size_t)i0 * g->input[1] + (size_t)i1) * g->input[2] +
+                                              (size_t)input_position(g, 2, first, k2)) * element_size;
+                char* target = target_row + (position - first_position + first - o2) * element_size;
+
+                if (g->stride[2] == 1) {
+                    memcpy(target, source, (last - first) * element_size);
+                } else {
+                    for (size_t i = 0; i < last - first; i++) {
+                        memcpy(target + i * element_size, source + i * g->stride[2] * element_size, element_size);
+                    }
+                }
+            }
+
+            position += run;
+        }
+    }
+}
+
+// Parallel task: compute the tiles [begin, end)
+static void correlate_im2col_tiles(void* context, size_t begin, size_t end) {
+    Im2colTask* task = (Im2colTask*)context;
+    const ConvolutionGeometry* g = task->geometry;
+    size_t element_size = task->element_size;
+    size_t rows = g->in_channels * g->kernel_size;
+
+    // Unfolded input and product of one tile, reused for all tiles of this thread
+    char* columns = (char*)malloc((rows + g->out_channels) * task->tile_columns * element_size);
+
+    if (!columns) {
+        set_im2col_error(task, ERR_MALLOC_FAILED);
+        return;
+    }
+
+    char* product = columns + rows * task->tile_columns * element_size;
+
+    for (size_t tile = begin; tile < end; tile++) {
+        size_t item = tile / task->tiles_per_item;
+        size_t first_position = tile % task->tiles_per_item * task->tile_columns;
+        size_t count = g->output_size - first_position;
+        count = count < task->tile_columns ? count : task->tile_columns;
+
+        unfold_convolution_tile(task, task->input + item * g->in_channels * g->input_size * element_size,
+                                columns, first_position, count);
+
+        ErrorCode error = multiply_matrix_tiles(product, task->filters, columns, g->out_channels, rows, count,
+                                                task->data_type, NULL);
+
+        if (error != ERR_NONE) {
+            set_im2col_error(task, error);
+            break;
+        }
+
+        // Rows of the product are blocks of the output-channels
+        for (size_t channel = 0; channel < g->out_channels; channel++) {
+            memcpy(task->result + ((item * g->out_channels + channel) * g->output_size + first_position) * element_size,
+                   product + channel * count * element_size, count * element_size);
+        }
+    }
+
+    free(columns);
+}
+
+// `result = filters * im2col(input)` for every batch-item, tile by tile
+static ErrorCode correlate_by_im2col(char* result, const char* input, const char* filters,
+                                     const ConvolutionGeometry* geometry, DataType data_type) {
+    Im2colTask task;
+    task.geometry = geometry;
+    task.input = input;
+    task.filters = filters;
+    task.result = result;
+    task.data_type = data_type;
+    task.element_size = get_data_type_size(data_type);
+    atomic_init(&task.error, ERR_NONE);
+
+    // The unfolded tile stays in the cache, while the matmul streams it once per output-channel
+    size_t rows = geometry->in_channels * geometry->kernel_size;
+
+    if (rows == 0 || geometry->output_size == 0) {
+        // Empty sums (zero-sized channels or filters), like the direct algorithm
+        memset(result, 0, geometry->batch * geometry->out_channels * geometry->output_size * task.element_size);
+        return ERR_NONE;
+    }
+    size_t tile_columns = IM2COL_TILE_BYTES / (rows * task.element_size) / IM2COL_COLUMN_ALIGNMENT * IM2COL_COLUMN_ALIGNMENT;
+
+    tile_columns = tile_columns > IM2COL_COLUMN_ALIGNMENT ? tile_columns : IM2COL_COLUMN_ALIGNMENT;
+    task.tile_columns = tile_columns < geometry->output_size ? tile_columns : geometry->output_size;
+    task.tiles_per_item = (geometry->output_size + task.tile_columns - 1) / task.tile_columns;
+
+    size_t work_per_tile = geometry->out_channels * rows * task.tile_columns;
+
+    parallel_for(geometry->batch * task.tiles_per_item, PARALLEL_CONVOLUTION_CHUNK / (work_per_tile + 1) + 1,
+                 correlate_im2col_tiles, &task);
+
+    return (ErrorCode)atomic_load(&task.error);
+}
+
+
+//
+// Correlation & Convolution
+//
+
+// Check the operands and describe the convolution with 3 spatial dimensions.
+static ErrorCode init_convolution_geometry(ConvolutionGeometry* geometry, const MultiDimensionalMatrix* input,
+                                           const MultiDimensionalMatrix* filters, const ConvolutionParameters* parameters) {
+    if (!input || !filters || !input->head_ptr || !filters->head_ptr || !input->head_ptr->data || !filters->head_ptr->data) {
+        // Input/Filters do not exist
+        return ERR_NULL_PTR;
+    }
+
+    const MultiDimensionalMatrixNode* source = input->head_ptr;
+    const MultiDimensionalMatrixNode* bank = filters->head_ptr;
+    size_t spatial = source->number_of_dimensions - 2;
+
+    if (source->number_of_dimensions < 3 || spatial > MAX_CONVOLUTION_DIMENSIONS) {
+        // Not [batch, channels, spatial...]
+        return ERR_INVALID_ARGS;
+    }
+
+    if (bank->number_of_dimensions != source->number_of_dimensions) {
+        return ERR_DIMENSION_COUNT_MISMATCH;
+    }
+
+    if (bank->dimensions[1] != source->dimensions[1]) {
+        // Filters have another number of input-channels
+        return ERR_DIMENSION_SIZE_MISMATCH;
+    }
+
+    if (bank->data_type != source->data_type) {
+        return ERR_DATATYPE_MISMATCH;
+    }
+
+    geometry->batch = source->dimensions[0];
+    geometry->in_channels = source->dimensions[1];
+    geometry->out_channels = bank->dimensions[0];
+    geometry->input_size = 1;
+    geometry->kernel_size = 1;
+    geometry->output_size = 1;
+
+    for (size_t i = 0; i < MAX_CONVOLUTION_DIMENSIONS; i++) {
+        // Missing leading spatial dimensions have the size 1
+        size_t offset = MAX_CONVOLUTION_DIMENSIONS - spatial;
+        int present = i >= offset;
+
+        size_t stride = present && parameters ? parameters->stride[i - offset] : 0;
+        size_t dilation = present && parameters ? parameters->dilation[i - offset] : 0;
+
+        geometry->input[i] = present ? source->dimensions[2 + i - offset] : 1;
+        geometry->kernel[i] = present ? bank->dimensions[2 + i - offset] : 1;
+        geometry->stride[i] = stride > 0 ? stride : 1;
+        geometry->dilation[i] = dilation > 0 ? dilation : 1;
+        geometry->padding[i] = present && parameters ? (ptrdiff_t)parameters->padding[i - offset] : 0;
+
+        size_t padded = geometry->input[i] + 2 * (size_t)geometry->padding[i];
+        size_t extent = geometry->dilation[i] * (geometry->kernel[i] - 1) + 1;
+
+        if (geometry->kernel[i] == 0 || padded < extent) {
+            // Filter does not fit into the padded input
+            return ERR_DIMENSION_SIZE_MISMATCH;
+        }
+
+        geometry->output[i] = (padded - extent) / geometry->stride[i] + 1;
+        geometry->input_size *= geometry->input[i];
+        geometry->kernel_size *= geometry->kernel[i];
+        geometry->output_size *= geometry->output[i];
+    }
+
+    return ERR_NONE;
+}
+
+// Correlation (or convolution with flipped filters) of an input with a bank of filters
+static ArithmeticOperationReturn run_convolution(const MultiDimensionalMatrix* input, const MultiDimensionalMatrix* filters,
+                                                 const ConvolutionParameters* parameters, int flipped) {
+    ArithmeticOperationReturn response;
+    response.result_matrix.head_ptr = NULL;
+
+    ConvolutionGeometry geometry;
+    response.error_code = init_convolution_geometry(&geometry, input, filters, parameters);
+
+    if (response.error_code != ERR_NONE) {
+        return response;
+    }
+
+    DataType data_type = input->head_ptr->data_type;
+    ParallelTask direct_kernel = select_direct_convolution_kernel(data_type);
+
+    if (!direct_kernel) {
+        // Unsupported Data-Type
+        response.error_code = ERR_UNSUPPORTED_DATATYPE;
+        return response;
+    }
+
+    size_t number_of_dimensions = input->head_ptr->number_of_dimensions;
+    size_t dimensions[MAX_CONVOLUTION_DIMENSIONS + 2] = { geometry.batch, geometry.out_channels };
+
+    for (size_t i = 2; i < number_of_dimensions; i++) {
+        dimensions[i] = geometry.output[i - number_of_dimensions + MAX_CONVOLUTION_DIMENSIONS];
+    }
+
+    response.error_code = create_matrix(&response.result_matrix, number_of_dimensions, dimensions, data_type);
+
+    if (response.error_code != ERR_NONE) {
+        response.result_matrix.head_ptr = NULL;
+        return response;
+    }
+
+    size_t element_size = get_data_type_size(data_type);
+    const char* bank = (const char*)filters->head_ptr->data;
+    char* flipped_bank = NULL;
+
+    if (flipped) {
+        // Reversing the taps of a channel flips all of its spatial dimensions
+        size_t channels = geometry.out_channels * geometry.in_channels;
+        flipped_bank = (char*)malloc(channels * geometry.kernel_size * element_size);
+
+        if (!flipped_bank) {
+            clear_matrix(&response.result_matrix);
+            response.result_matrix.head_ptr = NULL;
+            response.error_code = ERR_MALLOC_FAILED;
+            return response;
+        }
+
+        for (size_t channel = 0; channel < channels; channel++) {
+            for (size_t tap = 0; tap < geometry.kernel_size; tap++) {
+                memcpy(flipped_bank + (channel * geometry.kernel_size + tap) * element_size,
+                       bank + (channel * geometry.kernel_size + geometry.kernel_size - 1 - tap) * element_size, element_size);
+            }
+        }
+
+        bank = flipped_bank;
+    }
+
+    ConvolutionAlgorithm algorithm = parameters ? parameters->algorithm : CONVOLUTION_AUTO;
+
+    if (algorithm == CONVOLUTION_AUTO) {
+        int small = geometry.kernel_size <= DIRECT_CONVOLUTION_KERNEL_LIMIT &&
+                    geometry.in_channels * geometry.kernel_size <= DIRECT_CONVOLUTION_REDUCTION_LIMIT;
+        algorithm = small ? CONVOLUTION_DIRECT : CONVOLUTION_IM2COL;
+    }
+
+    if (algorithm == CONVOLUTION_IM2COL) {
+        response.error_code = correlate_by_im2col((char*)response.result_matrix.head_ptr->data, (const char*)input->head_ptr->data,
+                                                  bank, &geometry, data_type);
+    } else {
+        ConvolutionTask task;
+        task.geometry = &geometry;
+        task.input = (const char*)input->head_ptr->data;
+        task.filters = bank;
+        task.result = (char*)response.result_matrix.head_ptr->data;
+
+        size_t rows = geometry.batch * geometry.out_channels * geometry.output[0] * geometry.output[1];
+        size_t work_per_row = geometry.output[2] * geometry.in_channels * geometry.kernel_size;
+
+        parallel_for(rows, PARALLEL_CONVOLUTION_CHUNK / (work_per_row + 1) + 1, direct_kernel, &task);
+    }
+
+    free(flipped_bank);
+
+    if (response.error_code != ERR_NONE) {
+        clear_matrix(&response.result_matrix);
+        response.result_matrix.head_ptr = NULL;
+    }
+
+    return response;
+}
+
+// Cross-correlation of a multi-channel input with a bank of filters.
+ArithmeticOperationReturn correlate_matrices(const MultiDimensionalMatrix* input, const MultiDimensionalMatrix* filters, const ConvolutionParameters* parameters) {
+    /*
+
+        `input` is [batch, in_channels, spatial...] with 1 to 3 spatial dimensions, `filters`
+        is [out_channels, in_channels, kernel...] and the result is [batch, out_channels, output...]:
+
+            result[n, o, x] = sum_c sum_k input[n, c, x * stride + k * dilation - padding] * filters[o, c, k]
+
+        Inputs outside of the matrix (in the padding) are zero. `parameters` may be NULL
+        (stride 1, no padding, dilation 1, automatic choice of the algorithm). The work is
+        split over several threads.
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The result of this operation.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                        = No error.
+        ERR_NULL_PTR                    = Input/Filters do not exist;
+        ERR_INVALID_ARGS                = The input does not have 1 to 3 spatial dimensions;
+        ERR_DIMENSION_COUNT_MISMATCH    = The filters have another number of dimensions than the input;
+        ERR_DIMENSION_SIZE_MISMATCH     = The filters have another number of input-channels; A filter is larger than the padded input;
+        ERR_DATATYPE_MISMATCH           = The data types of input and filters do not match;
+        ERR_UNSUPPORTED_DATATYPE        = Unsupported data-type;
+        ERR_MALLOC_FAILED               = Couldn't allocate the unfolded input;
+
+        » For the other possible ErrorCodes, see what `create_matrix` returns. «
+
+    */
+
+    return run_convolution(input, filters, parameters, 0);
+}
+
+// Convolution of a multi-channel input with a bank of filters.
+ArithmeticOperationReturn convolve_matrices(const MultiDimensionalMatrix* input, const MultiDimensionalMatrix* filters, const ConvolutionParameters* parameters) {
+    /*
+
+        Same as `correlate_matrices` with the filters flipped along all spatial dimensions
+        (the filters themselves are not modified).
+
+    */
+
+    return run_convolution(input, filters, parameters, 1);
+}
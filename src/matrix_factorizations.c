@@ -0,0 +1,754 @@
+#include "custom_dynamic_matrices.h"
+#include "matrix_parallel.h"
+
+#include <math.h>   // For `sqrt` & `fabs`
+
+
+/*
+
+    LU- and Cholesky-factorizations of square `TYPE_FLOAT`/`TYPE_DOUBLE` matrices (in place,
+    row-major) and the triangular solves built on them.
+
+    Both factorizations are blocked and right-looking: a panel of `FACTORIZATION_BLOCK`
+    columns is factorized, then the rest of the matrix (the trailing matrix) is updated with
+    the panel in one rank-`FACTORIZATION_BLOCK` update. The update does almost all of the
+    arithmetic; like the matmul-kernels it streams rows (i-k-j order over blocks of
+    `FACTORIZATION_COLUMN_BLOCK` columns, which stay in the cache). Four rows of the panel
+    are applied per pass over a row, so each element of the updated row is loaded and stored
+    once per four multiply-adds. The rows are split over several threads.
+
+    - LU with partial pivoting: P * A = L * U. L (unit diagonal, not stored) and U overwrite
+      A, the row-interchanges are returned like LAPACK's `getrf`: row `i` was swapped with
+      row `pivots[i]` (in this order).
+    - Cholesky: A = L * L^T for symmetric positive definite A. Only the lower triangle of A is
+      read, L overwrites it and the upper triangle is set to zero. For the trailing update
+      the panel is transposed into a buffer, so the update is an axpy as well; the rows of
+      the triangle are paired (short with long), so every thread gets the same work.
+
+    Right-hand sides are n-element vectors or [n, k] matrices; their columns are solved
+    independently and split over threads.
+
+*/
+
+// Columns of a panel
+#define FACTORIZATION_BLOCK 64
+
+// Columns of the trailing matrix, which are updated together
+#define FACTORIZATION_COLUMN_BLOCK 256
+
+// Minimum number of multiply-adds processed by one thread
+#define PARALLEL_FACTORIZATION_CHUNK 65536
+
+// Triangles of the triangular solves
+typedef enum Triangle {
+    TRIANGLE_LOWER,                 // L * X = B
+    TRIANGLE_UNIT_LOWER,            // L * X = B with ones on the diagonal of L (not read)
+    TRIANGLE_UPPER,                 // U * X = B
+    TRIANGLE_LOWER_TRANSPOSED       // L^T * X = B
+} Triangle;
+
+// Work of a factorization-step or a triangular solve, shared by all threads.
+typedef struct FactorizationTask {
+    void* matrix;
+    size_t n;
+    size_t panel_begin;             // Columns of the current panel
+    size_t panel_end;
+    void* packed;                   // Transposed panel (Cholesky)
+    const void* triangle;
+    void* rhs;
+    size_t rhs_columns;
+    Triangle kind;
+} FactorizationTask;
+
+// Floating point types of the factorizations: X(ENUM, NAME, TYPE, SQRT, ABS)
+#define FOR_EACH_FACTORIZATION_TYPE(X)                                                                  \
+    X(TYPE_FLOAT,  float,  float,  sqrtf, fabsf)                                                        \
+    X(TYPE_DOUBLE, double, double, sqrt,  fabs)
+
+// LU, Cholesky & triangular solves of one data-type
+#define DEFINE_FACTORIZATION_KERNELS(ENUM, NAME, TYPE, SQRT, ABS)                                       \
+/* `target[c] -= sum_r weights[r] * sources[r * source_stride + c]`, four rows of sources per pass over the target */ \
+static inline void subtract_products_##NAME(TYPE* restrict target, const TYPE* restrict weights, const TYPE* restrict sources, \
+                                            size_t source_stride, size_t terms, size_t count) {         \
+    size_t r = 0;                                                                                       \
+    for (; r + 4 <= terms; r += 4) {                                                                    \
+        const TYPE w0 = weights[r], w1 = weights[r + 1], w2 = weights[r + 2], w3 = weights[r + 3];      \
+        const TYPE* s0 = sources + r * source_stride;                                                   \
+        const TYPE* s1 = s0 + source_stride;                                                            \
+        const TYPE* s2 = s1 + source_stride;                                                            \
+        const TYPE* s3 = s2 + source_stride;                                                            \
+        for (size_t c = 0; c < count; c++) {                                                            \
+            target[c] -= w0 * s0[c] + w1 * s1[c] + w2 * s2[c] + w3 * s3[c];                             \
+        }                                                                                               \
+    }                                                                                                   \
+    for (; r < terms; r++) {                                                                            \
+        const TYPE w = weights[r];                                                                      \
+        const TYPE* s = sources + r * source_stride;                                                    \
+        for (size_t c = 0; c < count; c++) {                                                            \
+            target[c] -= w * s[c];                                                                      \
+        }                                                                                               \
+    }                                                                                                   \
+}                                                                                                       \
+/* Parallel task: U12 = L11^-1 * A12 for the columns [panel_end + begin, panel_end + end) */            \
+static void lu_panel_rows_##NAME(void* context, size_t begin, size_t end) {                             \
+    const FactorizationTask* task = (const FactorizationTask*)context;                                  \
+    TYPE* a = (TYPE*)task->matrix;                                                                      \
+    size_t n = task->n;                                                                                 \
+    TYPE weights[FACTORIZATION_BLOCK];                                                                  \
+    for (size_t i = task->panel_begin + 1; i < task->panel_end; i++) {                                  \
+        TYPE* row = a + i * n;                                                                          \
+        for (size_t r = task->panel_begin; r < i; r++) {                                                \
+            weights[r - task->panel_begin] = row[r];                                                    \
+        }                                                                                               \
+        subtract_products_##NAME(row + task->panel_end + begin, weights, a + task->panel_begin * n + task->panel_end + begin, \
+                                 n, i - task->panel_begin, end - begin);                                \
+    }                                                                                                   \
+}                                                                                                       \
+/* Parallel task: A22 -= L21 * U12 for the rows [panel_end + begin, panel_end + end) */                 \
+static void lu_update_##NAME(void* context, size_t begin, size_t end) {                                 \
+    const FactorizationTask* task = (const FactorizationTask*)context;                                  \
+    TYPE* a = (TYPE*)task->matrix;                                                                      \
+    size_t n = task->n;                                                                                 \
+    size_t panel_width = task->panel_end - task->panel_begin;                                           \
+    TYPE weights[FACTORIZATION_BLOCK];                                                                  \
+    for (size_t block = task->panel_end; block < n; block += FACTORIZATION_COLUMN_BLOCK) {              \
+        size_t block_end = n - block < FACTORIZATION_COLUMN_BLOCK ? n : block + FACTORIZATION_COLUMN_BLOCK; \
+        for (size_t i = task->panel_end + begin; i < task->panel_end + end; i++) {                      \
+            TYPE* row = a + i * n;                                                                      \
+            memcpy(weights, row + task->panel_begin, panel_width * sizeof(TYPE));                       \
+            subtract_products_##NAME(row + block, weights, a + task->panel_begin * n + block, n, panel_width, block_end - block); \
+        }                                                                                               \
+    }                                                                                                   \
+}                                                                                                       \
+static ErrorCode lu_##NAME(void* matrix, size_t n, size_t* pivots) {                                    \
+    TYPE* a = (TYPE*)matrix;                                                                            \
+    FactorizationTask task;                                                                             \
+    task.matrix = matrix;                                                                               \
+    task.n = n;                                                                                         \
+    for (size_t panel = 0; panel < n; panel += FACTORIZATION_BLOCK) {                                   \
+        size_t panel_end = n - panel < FACTORIZATION_BLOCK ? n : panel + FACTORIZATION_BLOCK;           \
+        /* Unblocked LU of the panel [panel, n) x [panel, panel_end) */                                 \
+        for (size_t j = panel; j < panel_end; j++) {                                                    \
+            size_t pivot = j;                                                                           \
+            TYPE largest = ABS(a[j * n + j]);                                                           \
+            for (size_t i = j + 1; i < n; i++) {                                                        \
+                if (ABS(a[i * n + j]) > largest) {                                                      \
+                    largest = ABS(a[i * n + j]);                                                        \
+                    pivot = i;                                                                          \
+                }                                                                                       \
+            }                                                                                           \
+            pivots[j] = pivot;                                                                          \
+            if (!(largest > 0)) {                                                                       \
+                /* Zero (or NaN) column */                                                              \
+                return ERR_SINGULAR_MATRIX;                                                             \
+            }                                                                                           \
+            if (pivot != j) {                                                                           \
+                TYPE* row_j = a + j * n;                                                                \
+                TYPE* row_pivot = a + pivot * n;                                                        \
+                for (size_t c = 0; c < n; c++) {                                                        \
+                    TYPE swap = row_j[c];                                                               \
+                    row_j[c] = row_pivot[c];                                                            \
+                    row_pivot[c] = swap;                                                                \
+                }                                                                                       \
+            }                                                                                           \
+            const TYPE* row_j = a + j * n;                                                              \
+            const TYPE inverse = 1 / row_j[j];                                                          \
+            for (size_t i = j + 1; i < n; i++) {                                                        \
+                TYPE* row = a + i * n;                                                                  \
+                const TYPE l = row[j] *= inverse;                                                       \
+                for (size_t c = j + 1; c < panel_end; c++) {                                            \
+                    row[c] -= l * row_j[c];                                                             \
+                }                                                                                       \
+            }                                                                                           \
+        }                                                                                               \
+        if (panel_end < n) {                                                                            \
+            task.panel_begin = panel;                                                                   \
+            task.panel_end = panel_end;                                                                 \
+            size_t panel_width = panel_end - panel;                                                     \
+            parallel_for(n - panel_end, PARALLEL_FACTORIZATION_CHUNK / (panel_width * panel_width) + 1, \
+                         lu_panel_rows_##NAME, &task);                                                  \
+            parallel_for(n - panel_end, PARALLEL_FACTORIZATION_CHUNK / (panel_width * (n - panel_end)) + 1, \
+                         lu_update_##NAME, &task);                                                      \
+        }                                                                                               \
+    }                                                                                                   \
+    return ERR_NONE;                                                                                    \
+}                                                                                                       \
+/* Parallel task: L21 = A21 * L11^-T for the rows [panel_end + begin, panel_end + end) */               \
+static void cholesky_panel_rows_##NAME(void* context, size_t begin, size_t end) {                       \
+    const FactorizationTask* task = (const FactorizationTask*)context;                                  \
+    TYPE* a = (TYPE*)task->matrix;                                                                      \
+    size_t n = task->n;                                                                                 \
+    for (size_t i = task->panel_end + begin; i < task->panel_end + end; i++) {                          \
+        TYPE* row = a + i * n;                                                                          \
+        for (size_t j = task->panel_begin; j < task->panel_end; j++) {                                  \
+            const TYPE* row_j = a + j * n;                                                              \
+            TYPE sum = row[j];                                                                          \
+            for (size_t r = task->panel_begin; r < j; r++) {                                            \
+                sum -= row[r] * row_j[r];                                                               \
+            }                                                                                           \
+            row[j] = sum / row_j[j];                                                                    \
+        }                                                                                               \
+    }                                                                                                   \
+}                                                                                                       \
+/* Lower triangle of row `i` of A22 -= L21 * L21^T, with the transposed panel in `packed` */            \
+static void cholesky_update_row_##NAME(const FactorizationTask* task, size_t i) {                       \
+    TYPE* a = (TYPE*)task->matrix;                                                                      \
+    const TYPE* packed = (const TYPE*)task->packed;                                                     \
+    size_t n = task->n;                                                                                 \
+    size_t width = n - task->panel_end;                                                                 \
+    size_t panel_width = task->panel_end - task->panel_begin;                                           \
+    TYPE* row = a + i * n;                                                                              \
+    TYPE weights[FACTORIZATION_BLOCK];                                                                  \
+    memcpy(weights, row + task->panel_begin, panel_width * sizeof(TYPE));                               \
+    for (size_t block = task->panel_end; block <= i; block += FACTORIZATION_COLUMN_BLOCK) {             \
+        size_t block_end = i + 1 - block < FACTORIZATION_COLUMN_BLOCK ? i + 1 : block + FACTORIZATION_COLUMN_BLOCK; \
+        subtract_products_##NAME(row + block, weights, packed + (block - task->panel_end), width, panel_width, block_end - block); \
+    }                                                                                                   \
+}                                                                                                       \
+/* Parallel task: update the row-pairs [begin, end) of A22 (a short row with a long one) */             \
+static void cholesky_update_##NAME(void* context, size_t begin, size_t end) {                           \
+    const FactorizationTask* task = (const FactorizationTask*)context;                                  \
+    size_t rows = task->n - task->panel_end;                                                            \
+    for (size_t pair = begin; pair < end; pair++) {                                                     \
+        cholesky_update_row_##NAME(task, task->panel_end + pair);                                       \
+        if (rows - 1 - pair != pair) {                                                                  \
+            cholesky_update_row_##NAME(task, task->n - 1 - pair);                                       \
+        }                                                                                               \
+    }                                                                                                   \
+}                                                                                                       \
+static ErrorCode cholesky_##NAME(void* matrix, size_t n) {                                              \
+    TYPE* a = (TYPE*)matrix;                                                                            \
+    TYPE* packed = (TYPE*)malloc(FACTORIZATION_BLOCK * n * sizeof(TYPE));                               \
+    if (!packed) {                                                                                      \
+        return ERR_MALLOC_FAILED;                                                                       \
+    }                                                                                                   \
+    FactorizationTask task;                                                                             \
+    task.matrix = matrix;                                                                               \
+    task.n = n;                                                                                         \
+    task.packed = packed;                                                                               \
+    ErrorCode error = ERR_NONE;                                                                         \
+    for (size_t panel = 0; panel < n && error == ERR_NONE; panel += FACTORIZATION_BLOCK) {              \
+        size_t panel_end = n - panel < FACTORIZATION_BLOCK ? n : panel + FACTORIZATION_BLOCK;           \
+        /* Unblocked Cholesky of the diagonal block */                                                  \
+        for (size_t j = panel; j < panel_end && error == ERR_NONE; j++) {                               \
+            TYPE* row_j = a + j * n;                                                                    \
+            TYPE diagonal = row_j[j];                                                                   \
+            for (size_t r = panel; r < j; r++) {                                                        \
+                diagonal -= row_j[r] * row_j[r];                                                        \
+            }                                                                                           \
+            if (!(diagonal > 0)) {                                                                      \
+                error = ERR_NOT_POSITIVE_DEFINITE;                                                      \
+                break;                                                                                  \
+            }                                                                                           \
+            row_j[j] = SQRT(diagonal);                                                                  \
+            for (size_t i = j + 1; i < panel_end; i++) {                                                \
+                TYPE* row = a + i * n;                                                                  \
+                TYPE sum = row[j];                                                                      \
+                for (size_t r = panel; r < j; r++) {                                                    \
+                    sum -= row[r] * row_j[r];                                                           \
+                }                                                                                       \
+                row[j] = sum / row_j[j];                                                                \
+            }                                                                                           \
+        }                                                                                               \
+        if (error == ERR_NONE && panel_end < n) {                                                       \
+            task.panel_begin = panel;                                                                   \
+            task.panel_end = panel_end;                                                                 \
+            size_t width = n - panel_end;                                                               \
+            size_t panel_width = panel_end - panel;                                                     \
+            parallel_for(width, PARALLEL_FACTORIZATION_CHUNK / (panel_width * panel_width) + 1,         \
+                         cholesky_panel_rows_##NAME, &task);                                            \
+            for (size_t i = panel_end; i < n; i++) {                                                    \
+                for (size_t r = panel; r < panel_end; r++) {                                            \
+                    packed[(r - panel) * width + (i - panel_end)] = a[i * n + r];                       \
+                }                                                                                       \
+            }                                                                                           \
+            parallel_for((width + 1) / 2, PARALLEL_FACTORIZATION_CHUNK / (panel_width * width) + 1,     \
+                         cholesky_update_##NAME, &task);                                                \
+        }                                                                                               \
+    }                                                                                                   \
+    free(packed);                                                                                       \
+    if (error == ERR_NONE) {                                                                            \
+        for (size_t i = 0; i < n; i++) {                                                                \
+            for (size_t c = i + 1; c < n; c++) {                                                        \
+                a[i * n + c] = 0;                                                                       \
+            }                                                                                           \
+        }                                                                                               \
+    }                                                                                                   \
+    return error;                                                                                       \
+}                                                                                                       \
+/* Parallel task: solve the right-hand side columns [begin, end) */                                     \
+static void solve_triangular_columns_##NAME(void* context, size_t begin, size_t end) {                  \
+    const FactorizationTask* task = (const FactorizationTask*)context;                                  \
+    const TYPE* t = (const TYPE*)task->triangle;                                                        \
+    TYPE* b = (TYPE*)task->rhs;                                                                         \
+    size_t n = task->n;                                                                                 \
+    size_t k = task->rhs_columns;                                                                       \
+    switch(task->kind) {                                                                                \
+        case TRIANGLE_LOWER:                                                                            \
+        case TRIANGLE_UNIT_LOWER:                                                                       \
+            /* Forward substitution */                                                                  \
+            for (size_t i = 0; i < n; i++) {                                                            \
+                TYPE* row = b + i * k;                                                                  \
+                subtract_products_##NAME(row + begin, t + i * n, b + begin, k, i, end - begin);         \
+                if (task->kind == TRIANGLE_LOWER) {                                                     \
+                    for (size_t c = begin; c < end; c++) {                                              \
+                        row[c] /= t[i * n + i];                                                         \
+                    }                                                                                   \
+                }                                                                                       \
+            }                                                                                           \
+            break;                                                                                      \
+        case TRIANGLE_UPPER:                                                                            \
+            /* Back substitution */                                                                     \
+            for (size_t i = n; i-- > 0;) {                                                              \
+                TYPE* row = b + i * k;                                                                  \
+                subtract_products_##NAME(row + begin, t + i * n + i + 1, b + (i + 1) * k + begin, k, n - 1 - i, end - begin); \
+                for (size_t c = begin; c < end; c++) {                                                  \
+                    row[c] /= t[i * n + i];                                                             \
+                }                                                                                       \
+            }                                                                                           \
+            break;                                                                                      \
+        case TRIANGLE_LOWER_TRANSPOSED:                                                                 \
+            /* Back substitution with the columns of L^T (the rows of L) */                             \
+            for (size_t i = n; i-- > 0;) {                                                              \
+                TYPE* solved = b + i * k;                                                               \
+                for (size_t c = begin; c < end; c++) {                                                  \
+                    solved[c] /= t[i * n + i];                                                          \
+                }                                                                                       \
+                for (size_t r = 0; r < i; r++) {                                                        \
+                    const TYPE l = t[i * n + r];                                                        \
+                    TYPE* row = b + r * k;                                                              \
+                    for (size_t c = begin; c < end; c++) {                                              \
+                        row[c] -= l * solved[c];                                                        \
+                    }                                                                                   \
+                }                                                                                       \
+            }                                                                                           \
+            break;                                                                                      \
+    }                                                                                                   \
+}
+
+FOR_EACH_FACTORIZATION_TYPE(DEFINE_FACTORIZATION_KERNELS)
+
+// Kernels of one data-type
+typedef struct FactorizationKernels {
+    ErrorCode (*lu)(void* matrix, size_t n, size_t* pivots);
+    ErrorCode (*cholesky)(void* matrix, size_t n);
+    ParallelTask solve_columns;
+} FactorizationKernels;
+
+static int select_factorization_kernels(DataType data_type, FactorizationKernels* kernels) {
+    /*
+
+        Returns 0 if the data-type is not supported.
+
+    */
+
+    #define FACTORIZATION_CASE(ENUM, NAME, TYPE, SQRT, ABS)                                             \
+        case ENUM:                                                                                      \
+            kernels->lu = lu_##NAME;                                                                    \
+            kernels->cholesky = cholesky_##NAME;                                                        \
+            kernels->solve_columns = solve_triangular_columns_##NAME;                                   \
+            return 1;
+
+    switch(data_type) {
+        FOR_EACH_FACTORIZATION_TYPE(FACTORIZATION_CASE)
+
+        default:
+            // Unsupported Data-Type
+            return 0;
+    }
+
+    #undef FACTORIZATION_CASE
+}
+
+// Check a square 2-D matrix of a supported data-type.
+static ErrorCode check_square_matrix(const MultiDimensionalMatrix* matrix, FactorizationKernels* kernels) {
+    if (!matrix || !matrix->head_ptr || !matrix->head_ptr->data) {
+        // Matrix does not exist
+        return ERR_NULL_PTR;
+    }
+
+    if (matrix->head_ptr->number_of_dimensions != 2) {
+        return ERR_INVALID_ARGS;
+    }
+
+    if (matrix->head_ptr->dimensions[0] != matrix->head_ptr->dimensions[1]) {
+        // Not square
+        return ERR_DIMENSION_SIZE_MISMATCH;
+    }
+
+    if (!select_factorization_kernels(matrix->head_ptr->data_type, kernels)) {
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    return ERR_NONE;
+}
+
+// Check the right-hand side(s) of a square matrix: a vector of `n` elements or a [n, k] matrix.
+static ErrorCode check_right_hand_side(const MultiDimensionalMatrix* matrix, const MultiDimensionalMatrix* rhs) {
+    if (!rhs || !rhs->head_ptr || !rhs->head_ptr->data) {
+        // Right-hand side does not exist
+        return ERR_NULL_PTR;
+    }
+
+    if (rhs->head_ptr->number_of_dimensions != 1 && rhs->head_ptr->number_of_dimensions != 2) {
+        return ERR_INVALID_ARGS;
+    }
+
+    if (rhs->head_ptr->dimensions[0] != matrix->head_ptr->dimensions[0]) {
+        return ERR_DIMENSION_SIZE_MISMATCH;
+    }
+
+    if (rhs->head_ptr->data_type != matrix->head_ptr->data_type) {
+        return ERR_DATATYPE_MISMATCH;
+    }
+
+    return ERR_NONE;
+}
+
+// Solve `T * X = B` (or `L^T * X = B`) in place for contiguous buffers, the columns of B are split over threads.
+static ErrorCode solve_triangle(const FactorizationKernels* kernels, const void* triangle, size_t n, void* rhs,
+                                size_t rhs_columns, Triangle kind, DataType data_type) {
+    if (kind != TRIANGLE_UNIT_LOWER) {
+        for (size_t i = 0; i < n; i++) {
+            double diagonal = data_type == TYPE_FLOAT ? (double)((const float*)triangle)[i * n + i] : ((const double*)triangle)[i * n + i];
+
+            if (diagonal == 0.0) {
+                return ERR_SINGULAR_MATRIX;
+            }
+        }
+    }
+
+    FactorizationTask task;
+    task.triangle = triangle;
+    task.rhs = rhs;
+    task.n = n;
+    task.rhs_columns = rhs_columns;
+    task.kind = kind;
+
+    parallel_for(rhs_columns, PARALLEL_FACTORIZATION_CHUNK / (n * n / 2 + 1) + 1, kernels->solve_columns, &task);
+
+    return ERR_NONE;
+}
+
+// `X = A^-1 * B` in place with the LU-factors of A
+static ErrorCode solve_with_lu_factors(const FactorizationKernels* kernels, const void* factors, const size_t* pivots, size_t n,
+                                       void* rhs, size_t rhs_columns, DataType data_type) {
+    size_t row_size = rhs_columns * (data_type == TYPE_FLOAT ? sizeof(float) : sizeof(double));
+    char* rows = (char*)rhs;
+
+    for (size_t i = 0; i < n; i++) {
+        if (pivots[i] >= n) {
+            // Not the pivots of an n x n matrix
+            return ERR_INVALID_ARGS;
+        }
+    }
+
+    // Apply the row-interchanges P to B
+    for (size_t i = 0; i < n; i++) {
+        if (pivots[i] != i) {
+            char* row_i = rows + i * row_size;
+            char* row_pivot = rows + pivots[i] * row_size;
+
+            for (size_t byte = 0; byte < row_size; byte++) {
+                char swap = row_i[byte];
+                row_i[byte] = row_pivot[byte];
+                row_pivot[byte] = swap;
+            }
+        }
+    }
+
+    ErrorCode error = solve_triangle(kernels, factors, n, rhs, rhs_columns, TRIANGLE_UNIT_LOWER, data_type);
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    return solve_triangle(kernels, factors, n, rhs, rhs_columns, TRIANGLE_UPPER, data_type);
+}
+
+// Solve with a triangular matrix after checking both operands
+static ErrorCode solve_checked_triangle(const MultiDimensionalMatrix* triangle, MultiDimensionalMatrix* rhs, Triangle kind) {
+    FactorizationKernels kernels;
+    ErrorCode error = check_square_matrix(triangle, &kernels);
+
+    if (error == ERR_NONE) {
+        error = check_right_hand_side(triangle, rhs);
+    }
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    if (rhs->head_ptr->storage == STORAGE_MAPPED_READ_ONLY) {
+        // Writing would fault
+        return ERR_READ_ONLY;
+    }
+
+    size_t rhs_columns = rhs->head_ptr->number_of_dimensions == 2 ? rhs->head_ptr->dimensions[1] : 1;
+
+    return solve_triangle(&kernels, triangle->head_ptr->data, triangle->head_ptr->dimensions[0], rhs->head_ptr->data,
+                          rhs_columns, kind, triangle->head_ptr->data_type);
+}
+
+
+//
+// Factorizations
+//
+
+// LU-factorization with partial pivoting in place.
+ErrorCode lu_decompose(MultiDimensionalMatrix* matrix, size_t* pivots) {
+    /*
+
+        Factorizes a square `TYPE_FLOAT`/`TYPE_DOUBLE` matrix A into P * A = L * U. Afterwards
+        the matrix holds U on and above the diagonal and L (without its unit diagonal) below.
+        `pivots` needs space for `n` indices: row `i` was swapped with row `pivots[i]`, for
+        i = 0, 1, ..., n - 1 in this order. The trailing updates are split over several threads.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                        = No error.
+        ERR_NULL_PTR                    = Matrix/Pivots do not exist;
+        ERR_INVALID_ARGS                = The matrix is not 2-dimensional;
+        ERR_DIMENSION_SIZE_MISMATCH     = The matrix is not square;
+        ERR_UNSUPPORTED_DATATYPE        = Data-type isn't `TYPE_FLOAT`/`TYPE_DOUBLE`;
+        ERR_READ_ONLY                   = The matrix is a read-only mapping of a file;
+        ERR_SINGULAR_MATRIX             = The matrix is singular (the matrix is partially factorized);
+
+    */
+
+    FactorizationKernels kernels;
+    ErrorCode error = check_square_matrix(matrix, &kernels);
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    if (!pivots) {
+        // Pivots do not exist
+        return ERR_NULL_PTR;
+    }
+
+    if (matrix->head_ptr->storage == STORAGE_MAPPED_READ_ONLY) {
+        // Writing would fault
+        return ERR_READ_ONLY;
+    }
+
+    return kernels.lu(matrix->head_ptr->data, matrix->head_ptr->dimensions[0], pivots);
+}
+
+// Cholesky-factorization in place.
+ErrorCode cholesky_decompose(MultiDimensionalMatrix* matrix) {
+    /*
+
+        Factorizes a symmetric positive definite `TYPE_FLOAT`/`TYPE_DOUBLE` matrix A into
+        A = L * L^T. Only the lower triangle of A is read; afterwards the matrix holds L (the
+        upper triangle is zero). The trailing updates are split over several threads.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                        = No error.
+        ERR_NOT_POSITIVE_DEFINITE       = The matrix is not positive definite (the matrix is partially factorized);
+        ERR_MALLOC_FAILED               = Couldn't allocate the buffer for the transposed panels;
+
+        » For the other possible ErrorCodes, see what `lu_decompose` returns. «
+
+    */
+
+    FactorizationKernels kernels;
+    ErrorCode error = check_square_matrix(matrix, &kernels);
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    if (matrix->head_ptr->storage == STORAGE_MAPPED_READ_ONLY) {
+        // Writing would fault
+        return ERR_READ_ONLY;
+    }
+
+    return kernels.cholesky(matrix->head_ptr->data, matrix->head_ptr->dimensions[0]);
+}
+
+
+//
+// Solves
+//
+
+// Forward substitution: solve `L * X = B` in place.
+ErrorCode forward_substitution(const MultiDimensionalMatrix* lower, MultiDimensionalMatrix* rhs, int unit_diagonal) {
+    /*
+
+        `lower` is a square lower triangular matrix (its upper triangle is not read); with
+        `unit_diagonal` its diagonal is taken as ones and not read either, e.g. for the
+        L of `lu_decompose`. `rhs` is a vector with `n` elements or a [n, k] matrix of the same
+        data-type, which is overwritten with X. The columns of X are split over several threads.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                        = No error.
+        ERR_NULL_PTR                    = Triangle/Right-hand side does not exist;
+        ERR_INVALID_ARGS                = The triangle is not 2-dimensional; The right-hand side isn't 1- or 2-dimensional;
+        ERR_DIMENSION_SIZE_MISMATCH     = The triangle is not square; The right-hand side doesn't have `n` rows;
+        ERR_DATATYPE_MISMATCH           = The data types of the operands do not match;
+        ERR_UNSUPPORTED_DATATYPE        = Data-type isn't `TYPE_FLOAT`/`TYPE_DOUBLE`;
+        ERR_READ_ONLY                   = The right-hand side is a read-only mapping of a file;
+        ERR_SINGULAR_MATRIX             = A diagonal element is zero;
+
+    */
+
+    return solve_checked_triangle(lower, rhs, unit_diagonal ? TRIANGLE_UNIT_LOWER : TRIANGLE_LOWER);
+}
+
+// Back substitution: solve `U * X = B` in place.
+ErrorCode back_substitution(const MultiDimensionalMatrix* upper, MultiDimensionalMatrix* rhs) {
+    /*
+
+        `upper` is a square upper triangular matrix (its lower triangle is not read).
+
+        » For the possible ErrorCodes, see what `forward_substitution` returns. «
+
+    */
+
+    return solve_checked_triangle(upper, rhs, TRIANGLE_UPPER);
+}
+
+// Solve `A * X = B` in place with the factors of `lu_decompose`.
+ErrorCode lu_solve(const MultiDimensionalMatrix* factors, const size_t* pivots, MultiDimensionalMatrix* rhs) {
+    /*
+
+        Applies the row-interchanges to B, then solves with L (forward substitution) and U
+        (back substitution).
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                        = No error.
+        ERR_NULL_PTR                    = Pivots do not exist;
+        ERR_INVALID_ARGS                = A pivot is not smaller than `n`;
+
+        » For the other possible ErrorCodes, see what `forward_substitution` returns. «
+
+    */
+
+    FactorizationKernels kernels;
+    ErrorCode error = check_square_matrix(factors, &kernels);
+
+    if (error == ERR_NONE) {
+        error = check_right_hand_side(factors, rhs);
+    }
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    if (!pivots) {
+        // Pivots do not exist
+        return ERR_NULL_PTR;
+    }
+
+    if (rhs->head_ptr->storage == STORAGE_MAPPED_READ_ONLY) {
+        // Writing would fault
+        return ERR_READ_ONLY;
+    }
+
+    size_t rhs_columns = rhs->head_ptr->number_of_dimensions == 2 ? rhs->head_ptr->dimensions[1] : 1;
+
+    return solve_with_lu_factors(&kernels, factors->head_ptr->data, pivots, factors->head_ptr->dimensions[0],
+                                 rhs->head_ptr->data, rhs_columns, factors->head_ptr->data_type);
+}
+
+// Solve `A * X = B` in place with the factor of `cholesky_decompose`.
+ErrorCode cholesky_solve(const MultiDimensionalMatrix* factor, MultiDimensionalMatrix* rhs) {
+    /*
+
+        Solves with L (forward substitution) and L^T (back substitution).
+
+        » For the possible ErrorCodes, see what `forward_substitution` returns. «
+
+    */
+
+    ErrorCode error = solve_checked_triangle(factor, rhs, TRIANGLE_LOWER);
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    return solve_checked_triangle(factor, rhs, TRIANGLE_LOWER_TRANSPOSED);
+}
+
+// Solve the linear system `A * X = B`.
+ArithmeticOperationReturn solve_linear_system(const MultiDimensionalMatrix* matrix_A, const MultiDimensionalMatrix* matrix_B) {
+    /*
+
+        `A` is a square `TYPE_FLOAT`/`TYPE_DOUBLE` matrix, `B` a vector with `n` elements or a
+        [n, k] matrix of the same data-type; X has the shape of B. A copy of A is factorized
+        with `lu_decompose` and X is computed with `lu_solve`, neither operand is modified.
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The result of this operation.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                        = No error.
+        ERR_MALLOC_FAILED               = Couldn't allocate the copy of A or the pivots;
+
+        » For the other possible ErrorCodes, see what `lu_decompose`, `lu_solve` & `create_matrix` return. «
+
+    */
+
+    ArithmeticOperationReturn response;
+    response.result_matrix.head_ptr = NULL;
+
+    FactorizationKernels kernels;
+    response.error_code = check_square_matrix(matrix_A, &kernels);
+
+    if (response.error_code == ERR_NONE) {
+        response.error_code = check_right_hand_side(matrix_A, matrix_B);
+    }
+
+    if (response.error_code != ERR_NONE) {
+        return response;
+    }
+
+    const MultiDimensionalMatrixNode* node_B = matrix_B->head_ptr;
+    size_t n = matrix_A->head_ptr->dimensions[0];
+    DataType data_type = matrix_A->head_ptr->data_type;
+
+    response.error_code = create_matrix(&response.result_matrix, node_B->number_of_dimensions, node_B->dimensions, data_type);
+
+    if (response.error_code != ERR_NONE) {
+        response.result_matrix.head_ptr = NULL;
+        return response;
+    }
+
+    memcpy(response.result_matrix.head_ptr->data, node_B->data, node_B->data_size);
+
+    void* factors = malloc(matrix_A->head_ptr->data_size);
+    size_t* pivots = (size_t*)malloc(n * sizeof(size_t));
+
+    if (!factors || !pivots) {
+        response.error_code = ERR_MALLOC_FAILED;
+    } else {
+        memcpy(factors, matrix_A->head_ptr->data, matrix_A->head_ptr->data_size);
+        response.error_code = kernels.lu(factors, n, pivots);
+    }
+
+    if (response.error_code == ERR_NONE) {
+        size_t rhs_columns = node_B->number_of_dimensions == 2 ? node_B->dimensions[1] : 1;
+
+        response.error_code = solve_with_lu_factors(&kernels, factors, pivots, n, response.result_matrix.head_ptr->data,
+                                                    rhs_columns, data_type);
+    }
+
+    free(factors);
+    free(pivots);
+
+    if (response.error_code != ERR_NONE) {
+        clear_matrix(&response.result_matrix);
+        response.result_matrix.head_ptr = NULL;
+    }
+
+    return response;
+}
@@ -0,0 +1,828 @@
+#include "custom_dynamic_matrices.h"
+#include "matrix_data_types.h"
+#include "matrix_kernels.h"
+#include "matrix_workspace.h"
+
+#include <fcntl.h>    // For `open`
+#include <math.h>     // For `sqrt`
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/mman.h> // For `mmap`
+#include <sys/stat.h> // For `fstat`
+#include <unistd.h>   // For `close`
+
+
+/*
+
+    Matrix-file layout (all values in the byte-order of the writer):
+
+        offset 0                : `MatrixFileHeader`
+        offset 56               : `number_of_dimensions` dimensions (`uint64_t`)
+        offset `data_offset`    : `data_size` bytes of row-major elements
+
+    `data_offset` is a multiple of `alignment` (`MATRIX_FILE_ALIGNMENT` for files written by
+    `save_matrix`), so a mapping of the file can be used as the data-buffer of a matrix
+    without copying anything. `byte_order` is written as 0x01020304: `load_matrix` swaps
+    the bytes of files from machines with another byte-order, `open_matrix_mmap` rejects them.
+
+*/
+
+#define MATRIX_FILE_MAGIC "DYNMATRX"
+#define MATRIX_FILE_VERSION 1
+#define MATRIX_FILE_BYTE_ORDER 0x01020304u
+
+typedef struct MatrixFileHeader {
+    char magic[8];
+    uint32_t byte_order;
+    uint32_t version;
+    uint32_t data_type;
+    uint32_t element_size;
+    uint64_t number_of_dimensions;
+    uint64_t alignment;
+    uint64_t data_offset;
+    uint64_t data_size;
+} MatrixFileHeader;
+
+// The fields have no padding in between, the dimensions follow at offset 56
+_Static_assert(sizeof(MatrixFileHeader) == 56, "unexpected layout of `MatrixFileHeader`");
+
+
+// Reverse the bytes of `count` values with `size` bytes each.
+static void swap_byte_order(void* values, size_t count, size_t size) {
+    unsigned char* bytes = (unsigned char*)values;
+
+    for (size_t i = 0; i < count; i++, bytes += size) {
+        for (size_t low = 0, high = size - 1; low < high; low++, high--) {
+            unsigned char byte = bytes[low];
+            bytes[low] = bytes[high];
+            bytes[high] = byte;
+        }
+    }
+}
+
+// Validate a header (and bring it into the own byte-order).
+static ErrorCode check_matrix_file_header(MatrixFileHeader* header, int* swapped, uint64_t file_size) {
+    /*
+
+        Returns ERR_INVALID_FILE_FORMAT if the header is damaged or doesn't fit into the file.
+
+    */
+
+    if (memcmp(header->magic, MATRIX_FILE_MAGIC, sizeof(header->magic)) != 0) {
+        return ERR_INVALID_FILE_FORMAT;
+    }
+
+    *swapped = header->byte_order != MATRIX_FILE_BYTE_ORDER;
+
+    if (*swapped) {
+        swap_byte_order(&header->byte_order, 1, sizeof(uint32_t));
+        swap_byte_order(&header->version, 1, sizeof(uint32_t));
+        swap_byte_order(&header->data_type, 1, sizeof(uint32_t));
+        swap_byte_order(&header->element_size, 1, sizeof(uint32_t));
+        swap_byte_order(&header->number_of_dimensions, 1, sizeof(uint64_t));
+        swap_byte_order(&header->alignment, 1, sizeof(uint64_t));
+        swap_byte_order(&header->data_offset, 1, sizeof(uint64_t));
+        swap_byte_order(&header->data_size, 1, sizeof(uint64_t));
+
+        if (header->byte_order != MATRIX_FILE_BYTE_ORDER) {
+            return ERR_INVALID_FILE_FORMAT;
+        }
+    }
+
+    if (header->version != MATRIX_FILE_VERSION || header->data_type >= NUMBER_OF_DATA_TYPES ||
+        header->element_size != get_data_type_size((DataType)header->data_type)) {
+        return ERR_INVALID_FILE_FORMAT;
+    }
+
+    uint64_t dimensions_end = sizeof(MatrixFileHeader) + header->number_of_dimensions * sizeof(uint64_t);
+
+    if (header->number_of_dimensions == 0 || header->number_of_dimensions > (file_size - sizeof(MatrixFileHeader)) / sizeof(uint64_t) ||
+        header->alignment == 0 || (header->alignment & (header->alignment - 1)) != 0 ||
+        header->data_offset % header->alignment != 0 || header->data_offset % header->element_size != 0 ||
+        header->data_offset < dimensions_end || header->data_offset > file_size ||
+        header->data_size > file_size - header->data_offset) {
+        return ERR_INVALID_FILE_FORMAT;
+    }
+
+    return ERR_NONE;
+}
+
+// Create a matrix-node for the validated header and dimensions, without a data-buffer.
+static ErrorCode create_matrix_node_for_file(MultiDimensionalMatrix* matrix, const MatrixFileHeader* header, const uint64_t* dimensions) {
+    uint64_t total_size = 1;
+
+    for (uint64_t i = 0; i < header->number_of_dimensions; i++) {
+        if (dimensions[i] != 0 && total_size > UINT64_MAX / dimensions[i]) {
+            return ERR_INVALID_FILE_FORMAT;
+        }
+        total_size *= dimensions[i];
+    }
+
+    if (total_size > SIZE_MAX / header->element_size || total_size * header->element_size != header->data_size) {
+        return ERR_INVALID_FILE_FORMAT;
+    }
+
+    MultiDimensionalMatrixNode* node = (MultiDimensionalMatrixNode*) malloc(sizeof(MultiDimensionalMatrixNode));
+
+    if (!node) {
+        return ERR_MALLOC_FAILED;
+    }
+
+    node->dimensions = (size_t*) malloc(2 * header->number_of_dimensions * sizeof(size_t));
+
+    if (!node->dimensions) {
+        free(node);
+        return ERR_MALLOC_FAILED;
+    }
+
+    for (uint64_t i = 0; i < header->number_of_dimensions; i++) {
+        node->dimensions[i] = (size_t)dimensions[i];
+    }
+
+    node->strides = node->dimensions + header->number_of_dimensions;
+    set_matrix_strides(node->strides, node->dimensions, (size_t)header->number_of_dimensions);
+
+    node->data = NULL;
+    node->number_of_dimensions = (size_t)header->number_of_dimensions;
+    node->data_type = (DataType)header->data_type;
+    node->data_size = (size_t)header->data_size;
+    node->capacity = (size_t)header->data_size;
+    node->storage = STORAGE_HEAP;
+    node->mapping = NULL;
+    node->mapping_size = 0;
+
+    matrix->head_ptr = node;
+    track_workspace_matrix(node);
+
+    return ERR_NONE;
+}
+
+// Header of a new file, the data starts at the next multiple of `MATRIX_FILE_ALIGNMENT`.
+static void init_matrix_file_header(MatrixFileHeader* header, DataType data_type, size_t number_of_dimensions, size_t data_size) {
+    memcpy(header->magic, MATRIX_FILE_MAGIC, sizeof(header->magic));
+    header->byte_order = MATRIX_FILE_BYTE_ORDER;
+    header->version = MATRIX_FILE_VERSION;
+    header->data_type = (uint32_t)data_type;
+    header->element_size = (uint32_t)get_data_type_size(data_type);
+    header->number_of_dimensions = number_of_dimensions;
+    header->alignment = MATRIX_FILE_ALIGNMENT;
+    header->data_size = data_size;
+
+    uint64_t dimensions_end = sizeof(MatrixFileHeader) + number_of_dimensions * sizeof(uint64_t);
+    header->data_offset = (dimensions_end + MATRIX_FILE_ALIGNMENT - 1) / MATRIX_FILE_ALIGNMENT * MATRIX_FILE_ALIGNMENT;
+}
+
+// Write a matrix into a binary file.
+ErrorCode save_matrix(const MultiDimensionalMatrix* matrix, const char* path) {
+    /*
+
+        The file can be read with `load_matrix` or mapped with `open_matrix_mmap`, an existing
+        file is overwritten.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                 = No error.
+        ERR_NULL_PTR             = Matrix/Path does not exist;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported data-type;
+        ERR_FILE_IO              = The file couldn't be created or written;
+
+    */
+
+    if (!matrix || !matrix->head_ptr || !matrix->head_ptr->data || !path) {
+        return ERR_NULL_PTR;
+    }
+
+    const MultiDimensionalMatrixNode* node = matrix->head_ptr;
+    size_t element_size = get_data_type_size(node->data_type);
+
+    if (!element_size) {
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    MatrixFileHeader header;
+    init_matrix_file_header(&header, node->data_type, node->number_of_dimensions, node->data_size);
+
+    uint64_t dimensions_end = sizeof(header) + node->number_of_dimensions * sizeof(uint64_t);
+
+    FILE* file = fopen(path, "wb");
+
+    if (!file) {
+        return ERR_FILE_IO;
+    }
+
+    int written = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    for (size_t i = 0; written && i < node->number_of_dimensions; i++) {
+        uint64_t dimension = node->dimensions[i];
+        written = fwrite(&dimension, sizeof(dimension), 1, file) == 1;
+    }
+
+    // Zero-padding up to the aligned data
+    static const char padding[MATRIX_FILE_ALIGNMENT];
+    size_t padding_size = (size_t)(header.data_offset - dimensions_end);
+
+    written = written && fwrite(padding, 1, padding_size, file) == padding_size;
+    written = written && fwrite(node->data, 1, node->data_size, file) == node->data_size;
+
+    if (fclose(file) != 0 || !written) {
+        return ERR_FILE_IO;
+    }
+
+    return ERR_NONE;
+}
+
+// Read a matrix from a file written by `save_matrix` into memory.
+ErrorCode load_matrix(MultiDimensionalMatrix* matrix, const char* path) {
+    /*
+
+        The data is read in one piece into the buffer of the new matrix. Files from machines
+        with another byte-order are converted.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                = No error.
+        ERR_NULL_PTR            = Matrix/Path does not exist;
+        ERR_FILE_IO             = The file couldn't be opened or read;
+        ERR_INVALID_FILE_FORMAT = The file is no (valid) matrix-file;
+        ERR_MALLOC_FAILED       = Space allocation with `malloc` failed;
+
+    */
+
+    if (!matrix || !path) {
+        return ERR_NULL_PTR;
+    }
+
+    matrix->head_ptr = NULL;
+
+    FILE* file = fopen(path, "rb");
+
+    if (!file) {
+        return ERR_FILE_IO;
+    }
+
+    MatrixFileHeader header;
+    uint64_t* dimensions = NULL;
+    int swapped;
+    ErrorCode error = ERR_NONE;
+
+    struct stat file_status;
+
+    if (fstat(fileno(file), &file_status) != 0) {
+        error = ERR_FILE_IO;
+    } else if ((uint64_t)file_status.st_size < sizeof(header) || fread(&header, sizeof(header), 1, file) != 1) {
+        error = ERR_INVALID_FILE_FORMAT;
+    } else {
+        error = check_matrix_file_header(&header, &swapped, (uint64_t)file_status.st_size);
+    }
+
+    if (error == ERR_NONE) {
+        dimensions = (uint64_t*) malloc(header.number_of_dimensions * sizeof(uint64_t));
+
+        if (!dimensions) {
+            error = ERR_MALLOC_FAILED;
+        } else if (fread(dimensions, sizeof(uint64_t), header.number_of_dimensions, file) != header.number_of_dimensions) {
+            error = ERR_FILE_IO;
+        } else {
+            if (swapped) {
+                swap_byte_order(dimensions, header.number_of_dimensions, sizeof(uint64_t));
+            }
+            error = create_matrix_node_for_file(matrix, &header, dimensions);
+        }
+    }
+
+    if (error == ERR_NONE) {
+        MultiDimensionalMatrixNode* node = matrix->head_ptr;
+        node->data = malloc(node->data_size > 0 ? node->data_size : 1);
+
+        if (!node->data) {
+            error = ERR_MALLOC_FAILED;
+        } else if (fseek(file, (long)header.data_offset, SEEK_SET) != 0 ||
+                   fread(node->data, 1, node->data_size, file) != node->data_size) {
+            error = ERR_FILE_IO;
+        } else if (swapped) {
+            swap_byte_order(node->data, node->data_size / header.element_size, header.element_size);
+        }
+
+        if (error != ERR_NONE) {
+            clear_matrix(matrix);
+        }
+    }
+
+    free(dimensions);
+    fclose(file);
+
+    return error;
+}
+
+// Map a file written by `save_matrix` into memory and use it as the data-buffer of a matrix.
+ErrorCode open_matrix_mmap(MultiDimensionalMatrix* matrix, const char* path, MatrixStorage storage) {
+    /*
+
+        Opening takes constant time: the elements are read by the operating system when they
+        are accessed for the first time, and pages, which aren't needed anymore, can be
+        dropped from memory again. `storage` selects:
+
+        - STORAGE_MAPPED_READ_ONLY: setting elements returns ERR_READ_ONLY.
+        - STORAGE_MAPPED_PRIVATE  : elements can be changed (copy-on-write), the file stays
+                                    unchanged.
+
+        The file mustn't be truncated while the matrix exists. Operations, which reallocate the
+        data-buffer (`resize_matrix`, `reserve_matrix_capacity`, `convert_matrix_data_type`),
+        copy the elements into memory first. `clear_matrix` unmaps the file.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                = No error.
+        ERR_NULL_PTR            = Matrix/Path does not exist;
+        ERR_INVALID_ARGS        = `storage` is not a mapped storage;
+        ERR_FILE_IO             = The file couldn't be opened or mapped;
+        ERR_INVALID_FILE_FORMAT = The file is no (valid) matrix-file; The file has another byte-order;
+        ERR_MALLOC_FAILED       = Space allocation with `malloc` failed;
+
+    */
+
+    if (!matrix || !path) {
+        return ERR_NULL_PTR;
+    }
+
+    matrix->head_ptr = NULL;
+
+    if (storage != STORAGE_MAPPED_READ_ONLY && storage != STORAGE_MAPPED_PRIVATE) {
+        return ERR_INVALID_ARGS;
+    }
+
+    int descriptor = open(path, O_RDONLY);
+
+    if (descriptor < 0) {
+        return ERR_FILE_IO;
+    }
+
+    struct stat file_status;
+
+    if (fstat(descriptor, &file_status) != 0) {
+        close(descriptor);
+        return ERR_FILE_IO;
+    }
+
+    size_t file_size = (size_t)file_status.st_size;
+
+    if (file_size < sizeof(MatrixFileHeader)) {
+        close(descriptor);
+        return ERR_INVALID_FILE_FORMAT;
+    }
+
+    int protection = storage == STORAGE_MAPPED_READ_ONLY ? PROT_READ : PROT_READ | PROT_WRITE;
+    char* mapping = (char*) mmap(NULL, file_size, protection, MAP_PRIVATE, descriptor, 0);
+
+    // The mapping keeps its own reference to the file
+    close(descriptor);
+
+    if (mapping == MAP_FAILED) {
+        return ERR_FILE_IO;
+    }
+
+    MatrixFileHeader header;
+    int swapped;
+    memcpy(&header, mapping, sizeof(header));
+
+    ErrorCode error = check_matrix_file_header(&header, &swapped, file_size);
+
+    if (error == ERR_NONE && swapped) {
+        // The elements cannot be used without converting them
+        error = ERR_INVALID_FILE_FORMAT;
+    }
+
+    if (error == ERR_NONE) {
+        // The dimensions directly follow the header (8-byte aligned)
+        error = create_matrix_node_for_file(matrix, &header, (const uint64_t*)(mapping + sizeof(header)));
+    }
+
+    if (error != ERR_NONE) {
+        munmap(mapping, file_size);
+        return error;
+    }
+
+    MultiDimensionalMatrixNode* node = matrix->head_ptr;
+    node->data = mapping + header.data_offset;
+    node->storage = storage;
+    node->mapping = mapping;
+    node->mapping_size = file_size;
+
+    return ERR_NONE;
+}
+
+
+//
+// Out-of-core multiplication
+//
+
+/*
+
+    `multiply_matrix_files` never holds more than one tile of each operand (and two tiles of
+    the result) in memory. The result is computed tile by tile; each result tile sums up the
+    products of the panels of the inner dimension:
+
+        for every result tile (i, j):
+            C(i, j) = A(i, 0) * B(0, j) + A(i, 1) * B(1, j) + ...
+
+    Every step (one product) is computed while a background thread writes the previously
+    finished result tile and reads the operand tiles of the next step into a second set of
+    buffers, so disk and CPU are busy at the same time.
+
+*/
+
+// Buffers of the tile multiplication: 2 x A, 2 x B, 2 x C and one product
+#define OUT_OF_CORE_TILE_BUFFERS 7
+
+// Open 2-D matrix-file
+typedef struct MatrixFile {
+    int descriptor;
+    MatrixFileHeader header;
+    size_t rows;
+    size_t cols;
+} MatrixFile;
+
+// Position of a tile in a matrix-file
+typedef struct FileTile {
+    size_t row;
+    size_t col;
+    size_t rows;
+    size_t cols;
+} FileTile;
+
+// Work of the background thread: write one result tile, then read the operand tiles of a step.
+typedef struct TileIoJob {
+    const MatrixFile* file_A;
+    const MatrixFile* file_B;
+    const MatrixFile* file_C;
+    void* buffer_A;
+    void* buffer_B;
+    const void* buffer_C;
+    FileTile tile_A;            // `rows == 0`: nothing to read
+    FileTile tile_B;
+    FileTile tile_C;            // `rows == 0`: nothing to write
+    ErrorCode error_code;
+} TileIoJob;
+
+// Read/write `size` bytes at `offset`, `pread`/`pwrite` can transfer less than requested.
+static int transfer_file_bytes(int descriptor, void* buffer, size_t size, uint64_t offset, int write_bytes) {
+    char* bytes = (char*)buffer;
+
+    while (size > 0) {
+        ssize_t count = write_bytes ? pwrite(descriptor, bytes, size, (off_t)offset) : pread(descriptor, bytes, size, (off_t)offset);
+
+        if (count <= 0) {
+            return 0;
+        }
+
+        bytes += count;
+        size -= (size_t)count;
+        offset += (uint64_t)count;
+    }
+
+    return 1;
+}
+
+// Copy a tile between a matrix-file and a contiguous buffer (one transfer per row).
+static ErrorCode transfer_file_tile(const MatrixFile* file, void* buffer, const FileTile* tile, int write_tile) {
+    size_t element_size = file->header.element_size;
+    size_t row_size = tile->cols * element_size;
+
+    if (tile->cols == file->cols) {
+        // Whole rows are contiguous in the file
+        row_size *= tile->rows;
+    }
+
+    size_t transfers = tile->cols == file->cols ? 1 : tile->rows;
+
+    for (size_t i = 0; i < transfers; i++) {
+        uint64_t offset = file->header.data_offset + ((uint64_t)(tile->row + i) * file->cols + tile->col) * element_size;
+
+        if (!transfer_file_bytes(file->descriptor, (char*)buffer + i * row_size, row_size, offset, write_tile)) {
+            return ERR_FILE_IO;
+        }
+    }
+
+    return ERR_NONE;
+}
+
+static void run_tile_io_job(TileIoJob* job) {
+    job->error_code = ERR_NONE;
+
+    if (job->tile_C.rows > 0) {
+        job->error_code = transfer_file_tile(job->file_C, (void*)job->buffer_C, &job->tile_C, 1);
+    }
+
+    if (job->error_code == ERR_NONE && job->tile_A.rows > 0) {
+        job->error_code = transfer_file_tile(job->file_A, job->buffer_A, &job->tile_A, 0);
+    }
+
+    if (job->error_code == ERR_NONE && job->tile_B.rows > 0) {
+        job->error_code = transfer_file_tile(job->file_B, job->buffer_B, &job->tile_B, 0);
+    }
+}
+
+static void* tile_io_thread(void* argument) {
+    run_tile_io_job((TileIoJob*)argument);
+    return NULL;
+}
+
+// Open a 2-D matrix-file for reading.
+static ErrorCode open_2d_matrix_file(MatrixFile* file, const char* path) {
+    file->descriptor = open(path, O_RDONLY);
+
+    if (file->descriptor < 0) {
+        return ERR_FILE_IO;
+    }
+
+    struct stat file_status;
+    uint64_t dimensions[2];
+    int swapped;
+    ErrorCode error = ERR_NONE;
+
+    if (fstat(file->descriptor, &file_status) != 0) {
+        error = ERR_FILE_IO;
+    } else if ((uint64_t)file_status.st_size < sizeof(MatrixFileHeader) ||
+               !transfer_file_bytes(file->descriptor, &file->header, sizeof(MatrixFileHeader), 0, 0)) {
+        error = ERR_INVALID_FILE_FORMAT;
+    } else {
+        error = check_matrix_file_header(&file->header, &swapped, (uint64_t)file_status.st_size);
+
+        if (error == ERR_NONE && swapped) {
+            // The tiles are used without converting them
+            error = ERR_INVALID_FILE_FORMAT;
+        }
+    }
+
+    if (error == ERR_NONE && file->header.number_of_dimensions != 2) {
+        error = ERR_INVALID_ARGS;
+    }
+
+    if (error == ERR_NONE && !transfer_file_bytes(file->descriptor, dimensions, sizeof(dimensions), sizeof(MatrixFileHeader), 0)) {
+        error = ERR_FILE_IO;
+    }
+
+    if (error == ERR_NONE && (dimensions[0] > SIZE_MAX || dimensions[1] > SIZE_MAX ||
+        (dimensions[1] != 0 && dimensions[0] > UINT64_MAX / dimensions[1] / file->header.element_size) ||
+        dimensions[0] * dimensions[1] * file->header.element_size != file->header.data_size)) {
+        error = ERR_INVALID_FILE_FORMAT;
+    }
+
+    if (error != ERR_NONE) {
+        close(file->descriptor);
+        return error;
+    }
+
+    file->rows = (size_t)dimensions[0];
+    file->cols = (size_t)dimensions[1];
+
+    return ERR_NONE;
+}
+
+// Create the result-file with its header, the data is filled with zeros.
+static ErrorCode create_2d_matrix_file(MatrixFile* file, const char* path, DataType data_type, size_t rows, size_t cols) {
+    file->descriptor = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    if (file->descriptor < 0) {
+        return ERR_FILE_IO;
+    }
+
+    file->rows = rows;
+    file->cols = cols;
+    init_matrix_file_header(&file->header, data_type, 2, rows * cols * get_data_type_size(data_type));
+
+    uint64_t dimensions[2] = { rows, cols };
+
+    if (!transfer_file_bytes(file->descriptor, &file->header, sizeof(MatrixFileHeader), 0, 1) ||
+        !transfer_file_bytes(file->descriptor, dimensions, sizeof(dimensions), sizeof(MatrixFileHeader), 1) ||
+        ftruncate(file->descriptor, (off_t)(file->header.data_offset + file->header.data_size)) != 0) {
+        close(file->descriptor);
+        return ERR_FILE_IO;
+    }
+
+    return ERR_NONE;
+}
+
+// Operand tiles of the step `step` (the inner dimension changes fastest).
+static void get_step_tiles(size_t step, size_t tile_rows, size_t tile_inner, size_t tile_cols,
+                           size_t rows, size_t inner, size_t cols, FileTile* tile_A, FileTile* tile_B) {
+    size_t inner_tiles = (inner + tile_inner - 1) / tile_inner;
+    size_t col_tiles = (cols + tile_cols - 1) / tile_cols;
+
+    size_t k = step % inner_tiles * tile_inner;
+    size_t j = step / inner_tiles % col_tiles * tile_cols;
+    size_t i = step / inner_tiles / col_tiles * tile_rows;
+
+    tile_A->row = i;
+    tile_A->col = k;
+    tile_A->rows = rows - i < tile_rows ? rows - i : tile_rows;
+    tile_A->cols = inner - k < tile_inner ? inner - k : tile_inner;
+
+    tile_B->row = k;
+    tile_B->col = j;
+    tile_B->rows = tile_A->cols;
+    tile_B->cols = cols - j < tile_cols ? cols - j : tile_cols;
+}
+
+// Whether `path` names the open file `descriptor` (same device and inode).
+static int is_same_file(const char* path, int descriptor) {
+    struct stat path_status, file_status;
+
+    if (stat(path, &path_status) != 0 || fstat(descriptor, &file_status) != 0) {
+        return 0;
+    }
+
+    return path_status.st_dev == file_status.st_dev && path_status.st_ino == file_status.st_ino;
+}
+
+
+// Multiply two matrices, which are stored in files, without loading them completely.
+ErrorCode multiply_matrix_files(const char* path_A, const char* path_B, const char* result_path, size_t memory_budget) {
+    /*
+
+        Computes `C = A * B` for two 2-D matrix-files (see `save_matrix`) with the same
+        data-type and writes C into `result_path` (an existing file is overwritten). The
+        operands and the result can be larger than the main memory: they are processed in
+        square tiles, which fit 7 times into `memory_budget` bytes (`0` selects
+        `DEFAULT_OUT_OF_CORE_MEMORY_BUDGET`). Larger budgets mean fewer reads, because every
+        tile of A is read once per column of result tiles and every tile of B once per row.
+
+        Integer results are the same as with `multiply_2d_matrices`, floating point results
+        are summed up in another order (per tile of the inner dimension); fp16/bf16-results are
+        rounded once per tile of the inner dimension.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                    = No error.
+        ERR_NULL_PTR                = A path does not exist;
+        ERR_INVALID_ARGS            = The matrices are not 2-Dimensional; The budget doesn't fit 7 elements;
+                                      `result_path` is the file of an operand (also via links);
+        ERR_DIMENSION_SIZE_MISMATCH = Columns of A don't match rows of B;
+        ERR_DATATYPE_MISMATCH       = Data-types don't match;
+        ERR_FILE_IO                 = A file couldn't be opened, read or written;
+        ERR_INVALID_FILE_FORMAT     = An operand is no (valid) matrix-file or has another byte-order;
+        ERR_MALLOC_FAILED           = Space allocation with `malloc` failed;
+
+    */
+
+    if (!path_A || !path_B || !result_path) {
+        return ERR_NULL_PTR;
+    }
+
+    if (memory_budget == 0) {
+        memory_budget = DEFAULT_OUT_OF_CORE_MEMORY_BUDGET;
+    }
+
+    MatrixFile file_A, file_B, file_C;
+    ErrorCode error = open_2d_matrix_file(&file_A, path_A);
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    error = open_2d_matrix_file(&file_B, path_B);
+
+    if (error != ERR_NONE) {
+        close(file_A.descriptor);
+        return error;
+    }
+
+    DataType data_type = (DataType)file_A.header.data_type;
+    size_t element_size = file_A.header.element_size;
+    size_t rows = file_A.rows, inner = file_A.cols, cols = file_B.cols;
+
+    if (file_B.header.data_type != file_A.header.data_type) {
+        error = ERR_DATATYPE_MISMATCH;
+    } else if (file_B.rows != inner) {
+        error = ERR_DIMENSION_SIZE_MISMATCH;
+    } else if (memory_budget / element_size < OUT_OF_CORE_TILE_BUFFERS) {
+        error = ERR_INVALID_ARGS;
+    } else if (is_same_file(result_path, file_A.descriptor) || is_same_file(result_path, file_B.descriptor)) {
+        // Truncating the result would destroy an operand before it is read
+        error = ERR_INVALID_ARGS;
+    } else {
+        error = create_2d_matrix_file(&file_C, result_path, data_type, rows, cols);
+    }
+
+    if (error != ERR_NONE) {
+        close(file_A.descriptor);
+        close(file_B.descriptor);
+        return error;
+    }
+
+    // Largest square tiles, which fit into the budget (smaller along short dimensions)
+    size_t tile_size = (size_t)sqrt((double)(memory_budget / element_size / OUT_OF_CORE_TILE_BUFFERS));
+
+    while (tile_size > 1 && tile_size * tile_size > memory_budget / element_size / OUT_OF_CORE_TILE_BUFFERS) {
+        tile_size--;
+    }
+
+    size_t tile_rows = rows < tile_size ? rows : tile_size;
+    size_t tile_inner = inner < tile_size ? inner : tile_size;
+    size_t tile_cols = cols < tile_size ? cols : tile_size;
+    size_t tile_elements = tile_size * tile_size;
+
+    size_t steps = 0;
+
+    if (rows > 0 && inner > 0 && cols > 0) {
+        steps = ((rows + tile_rows - 1) / tile_rows) * ((inner + tile_inner - 1) / tile_inner) * ((cols + tile_cols - 1) / tile_cols);
+    }
+
+    char* buffers = steps > 0 ? (char*) malloc(OUT_OF_CORE_TILE_BUFFERS * tile_elements * element_size) : NULL;
+
+    if (steps > 0 && !buffers) {
+        error = ERR_MALLOC_FAILED;
+    }
+
+    char* buffers_A[2], * buffers_B[2], * buffers_C[2], * product = NULL;
+
+    if (buffers) {
+        for (size_t i = 0; i < 2; i++) {
+            buffers_A[i] = buffers + (0 + i) * tile_elements * element_size;
+            buffers_B[i] = buffers + (2 + i) * tile_elements * element_size;
+            buffers_C[i] = buffers + (4 + i) * tile_elements * element_size;
+        }
+        product = buffers + 6 * tile_elements * element_size;
+    }
+
+    // Operand tiles of the first step
+    TileIoJob job;
+    memset(&job, 0, sizeof(job));
+    job.file_A = &file_A;
+    job.file_B = &file_B;
+    job.file_C = &file_C;
+
+    if (error == ERR_NONE && steps > 0) {
+        job.buffer_A = buffers_A[0];
+        job.buffer_B = buffers_B[0];
+        get_step_tiles(0, tile_rows, tile_inner, tile_cols, rows, inner, cols, &job.tile_A, &job.tile_B);
+        run_tile_io_job(&job);
+        error = job.error_code;
+    }
+
+    FileTile finished_tile;         // Result tile, which is written during the next step
+    finished_tile.rows = 0;
+    size_t current_C = 0;
+
+    for (size_t step = 0; step < steps && error == ERR_NONE; step++) {
+        size_t current = step % 2;
+        FileTile tile_A, tile_B;
+        get_step_tiles(step, tile_rows, tile_inner, tile_cols, rows, inner, cols, &tile_A, &tile_B);
+
+        // Background: write the finished result tile, read the operands of the next step
+        job.buffer_A = buffers_A[1 - current];
+        job.buffer_B = buffers_B[1 - current];
+        job.buffer_C = buffers_C[1 - current_C];
+        job.tile_C = finished_tile;
+        job.tile_A.rows = 0;
+        job.tile_B.rows = 0;
+
+        if (step + 1 < steps) {
+            get_step_tiles(step + 1, tile_rows, tile_inner, tile_cols, rows, inner, cols, &job.tile_A, &job.tile_B);
+        }
+
+        pthread_t io_thread;
+        int background = pthread_create(&io_thread, NULL, tile_io_thread, &job) == 0;
+
+        // First panel of the inner dimension overwrites the result tile, the others are added
+        error = multiply_matrix_tiles(buffers_C[current_C], buffers_A[current], buffers_B[current],
+                                      tile_A.rows, tile_A.cols, tile_B.cols, data_type, tile_A.col == 0 ? NULL : product);
+
+        if (background) {
+            pthread_join(io_thread, NULL);
+        } else {
+            // No thread available: transfer synchronously
+            run_tile_io_job(&job);
+        }
+
+        if (error == ERR_NONE) {
+            error = job.error_code;
+        }
+
+        finished_tile.rows = 0;
+
+        if (tile_A.col + tile_A.cols == inner) {
+            // Result tile complete
+            finished_tile.row = tile_A.row;
+            finished_tile.col = tile_B.col;
+            finished_tile.rows = tile_A.rows;
+            finished_tile.cols = tile_B.cols;
+            current_C = 1 - current_C;
+        }
+    }
+
+    if (error == ERR_NONE && finished_tile.rows > 0) {
+        error = transfer_file_tile(&file_C, buffers_C[1 - current_C], &finished_tile, 1);
+    }
+
+    free(buffers);
+    close(file_A.descriptor);
+    close(file_B.descriptor);
+
+    if (close(file_C.descriptor) != 0 && error == ERR_NONE) {
+        error = ERR_FILE_IO;
+    }
+
+    return error;
+}
@@ -0,0 +1,333 @@
+#define _GNU_SOURCE // For `pthread_attr_setaffinity_np` & `CPU_SET`
+
+#include "matrix_parallel.h"
+
+#include <dirent.h>      // For `opendir`
+#include <pthread.h>
+#include <sched.h>       // For `sched_getaffinity`
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h> // For `SYS_mbind`
+#include <unistd.h>      // For `sysconf`
+
+
+// Largest NUMA-node, which the placement supports
+#define MAX_NUMA_NODES 1024
+
+// `MPOL_INTERLEAVE` of <numaif.h>, without depending on libnuma
+#define NUMA_POLICY_INTERLEAVE 3
+
+// Default size (in bytes) from which `set_matrix_memory_policy` applies
+#define DEFAULT_NUMA_MINIMUM_BYTES ((size_t)4 << 20)
+
+
+// `0` means: use one thread per online CPU
+static size_t configured_thread_count = 0;
+
+// Set inside worker-threads, so nested parallel loops run sequentially
+static __thread int inside_parallel_region = 0;
+
+static MatrixMemoryPolicy memory_policy = MEMORY_POLICY_DEFAULT;
+static size_t memory_policy_minimum_bytes = DEFAULT_NUMA_MINIMUM_BYTES;
+static int pin_worker_threads = 0;
+
+// CPUs of the process sorted by their NUMA-node, so neighbouring chunks share a node
+static pthread_once_t topology_once = PTHREAD_ONCE_INIT;
+static int cpu_order[CPU_SETSIZE];
+static size_t cpu_count = 0;
+static unsigned long online_nodes[MAX_NUMA_NODES / (8 * sizeof(unsigned long))];
+static size_t node_count = 1;
+
+typedef struct ParallelChunk {
+    ParallelTask task;
+    void* context;
+    size_t begin;
+    size_t end;
+} ParallelChunk;
+
+typedef struct FirstTouchTask {
+    char* data;
+    size_t size;
+    size_t page_size;
+} FirstTouchTask;
+
+
+// NUMA-node of a CPU (the `nodeN`-link in its sysfs-directory), `0` if unknown.
+static int read_cpu_node(int cpu) {
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d", cpu);
+
+    DIR* directory = opendir(path);
+    int node = 0;
+
+    if (!directory) {
+        return 0;
+    }
+
+    struct dirent* entry;
+
+    while ((entry = readdir(directory))) {
+        if (!strncmp(entry->d_name, "node", 4) && entry->d_name[4] >= '0' && entry->d_name[4] <= '9') {
+            node = atoi(entry->d_name + 4);
+            break;
+        }
+    }
+
+    closedir(directory);
+
+    return node < MAX_NUMA_NODES ? node : 0;
+}
+
+static void detect_topology(void) {
+    cpu_set_t allowed;
+    int nodes[CPU_SETSIZE];
+
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        CPU_ZERO(&allowed);
+        CPU_SET(0, &allowed);
+    }
+
+    // Insertion-sort by node, CPUs of the same node stay in ascending order
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed)) {
+            continue;
+        }
+
+        int node = read_cpu_node(cpu);
+        size_t position = cpu_count++;
+
+        while (position > 0 && nodes[position - 1] > node) {
+            cpu_order[position] = cpu_order[position - 1];
+            nodes[position] = nodes[position - 1];
+            position--;
+        }
+
+        cpu_order[position] = cpu;
+        nodes[position] = node;
+        online_nodes[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+    }
+
+    node_count = 0;
+
+    for (size_t i = 0; i < cpu_count; i++) {
+        if (i == 0 || nodes[i] != nodes[i - 1]) {
+            node_count++;
+        }
+    }
+}
+
+// CPU of chunk `index` out of `chunks`: the chunks are spread evenly over the sorted CPUs.
+static int chunk_cpu(size_t index, size_t chunks) {
+    return cpu_order[index * cpu_count / chunks];
+}
+
+
+// Set the maximum number of threads used by the matrix-kernels.
+void set_matrix_thread_count(size_t thread_count) {
+    /*
+
+        `0` restores the default (one thread per online CPU).
+
+    */
+
+    configured_thread_count = thread_count;
+}
+
+// Get the maximum number of threads used by the matrix-kernels.
+size_t get_matrix_thread_count(void) {
+    if (configured_thread_count != 0) {
+        return configured_thread_count;
+    }
+
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return online > 0 ? (size_t)online : 1;
+}
+
+// Choose where the pages of large data-buffers are placed.
+void set_matrix_memory_policy(MatrixMemoryPolicy policy, size_t minimum_bytes) {
+    /*
+
+        Only buffers of at least `minimum_bytes` (`0` restores the default of 4 MiB) are
+        placed, which `create_matrix` takes from the system allocator.
+
+        MEMORY_POLICY_FIRST_TOUCH  = The buffer is zeroed by the threads of `parallel_for`, so
+                                     each page lands on the node of the thread, which processes
+                                     the same part of the matrix in the parallel kernels (most
+                                     effective with `set_matrix_thread_affinity`).
+        MEMORY_POLICY_INTERLEAVED  = The pages are spread round-robin over all NUMA-nodes, for
+                                     matrices, which are accessed by all threads alike.
+
+    */
+
+    memory_policy = policy;
+    memory_policy_minimum_bytes = minimum_bytes ? minimum_bytes : DEFAULT_NUMA_MINIMUM_BYTES;
+}
+
+MatrixMemoryPolicy get_matrix_memory_policy(void) {
+    return memory_policy;
+}
+
+// Pin the threads of `parallel_for` to fixed CPUs.
+void set_matrix_thread_affinity(int pin_threads) {
+    /*
+
+        Chunk `i` of `n` always runs on the same CPU (the CPUs of the process are sorted by
+        their NUMA-node and split evenly between the chunks), so loops with the same number of
+        chunks work on the memory, which was first touched by the same CPU. The calling thread
+        is pinned while it processes the first chunk and gets its old affinity back afterwards.
+
+    */
+
+    pin_worker_threads = pin_threads != 0;
+}
+
+int get_matrix_thread_affinity(void) {
+    return pin_worker_threads;
+}
+
+// Number of NUMA-nodes with CPUs of the process.
+size_t get_numa_node_count(void) {
+    pthread_once(&topology_once, detect_topology);
+
+    return node_count;
+}
+
+static void first_touch_pages(void* context, size_t begin, size_t end) {
+    FirstTouchTask* task = (FirstTouchTask*)context;
+    size_t first_byte = begin * task->page_size;
+    size_t last_byte = end * task->page_size < task->size ? end * task->page_size : task->size;
+
+    memset(task->data + first_byte, 0, last_byte - first_byte);
+}
+
+void place_matrix_data(void* data, size_t size) {
+    if (memory_policy == MEMORY_POLICY_DEFAULT || !data || size < memory_policy_minimum_bytes) {
+        return;
+    }
+
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+    if (memory_policy == MEMORY_POLICY_FIRST_TOUCH) {
+        FirstTouchTask task = {(char*)data, size, page_size};
+        parallel_for((size + page_size - 1) / page_size, 1, first_touch_pages, &task);
+        return;
+    }
+
+#ifdef SYS_mbind
+    if (get_numa_node_count() > 1) {
+        // Only the whole pages inside of the buffer; they are still untouched, if `malloc` mapped them freshly
+        uintptr_t begin = ((uintptr_t)data + page_size - 1) / page_size * page_size;
+        uintptr_t end = ((uintptr_t)data + size) / page_size * page_size;
+
+        if (end > begin) {
+            syscall(SYS_mbind, (void*)begin, (unsigned long)(end - begin), NUMA_POLICY_INTERLEAVE,
+                    online_nodes, (unsigned long)MAX_NUMA_NODES + 1, 0UL);
+        }
+    }
+#endif
+}
+
+static void* run_parallel_chunk(void* argument) {
+    ParallelChunk* chunk = (ParallelChunk*)argument;
+
+    inside_parallel_region = 1;
+    chunk->task(chunk->context, chunk->begin, chunk->end);
+
+    return NULL;
+}
+
+// Split [0, count) into chunks and process them on several threads.
+void parallel_for(size_t count, size_t minimum_chunk_size, ParallelTask task, void* context) {
+    /*
+
+        Every chunk has at least `minimum_chunk_size` items, so small loops stay on the calling
+        thread. The calling thread processes the first chunk itself and waits for all others.
+        The chunks are disjoint and cover [0, count) in ascending order.
+
+    */
+
+    if (!task || count == 0) {
+        return;
+    }
+
+    if (minimum_chunk_size == 0) {
+        minimum_chunk_size = 1;
+    }
+
+    size_t chunks = get_matrix_thread_count();
+
+    if (chunks > count / minimum_chunk_size) {
+        chunks = count / minimum_chunk_size;
+    }
+
+    if (chunks <= 1 || inside_parallel_region) {
+        task(context, 0, count);
+        return;
+    }
+
+    ParallelChunk work[chunks];
+    pthread_t threads[chunks];
+    int started[chunks];
+
+    for (size_t i = 0; i < chunks; i++) {
+        work[i].task = task;
+        work[i].context = context;
+        work[i].begin = count / chunks * i + (i < count % chunks ? i : count % chunks);
+        work[i].end = work[i].begin + count / chunks + (i < count % chunks ? 1 : 0);
+        started[i] = 0;
+    }
+
+    int pin = pin_worker_threads;
+    cpu_set_t caller_affinity;
+
+    if (pin) {
+        pthread_once(&topology_once, detect_topology);
+        pin = pthread_getaffinity_np(pthread_self(), sizeof(caller_affinity), &caller_affinity) == 0;
+    }
+
+    for (size_t i = 1; i < chunks; i++) {
+        pthread_attr_t attributes;
+        pthread_attr_init(&attributes);
+
+        if (pin) {
+            cpu_set_t cpu;
+            CPU_ZERO(&cpu);
+            CPU_SET(chunk_cpu(i, chunks), &cpu);
+            pthread_attr_setaffinity_np(&attributes, sizeof(cpu), &cpu);
+        }
+
+        started[i] = pthread_create(&threads[i], &attributes, run_parallel_chunk, &work[i]) == 0;
+        pthread_attr_destroy(&attributes);
+
+        if (!started[i]) {
+            // Couldn't start a thread, process this chunk on the calling thread (without nested threads)
+            inside_parallel_region = 1;
+            task(context, work[i].begin, work[i].end);
+            inside_parallel_region = 0;
+        }
+    }
+
+    if (pin) {
+        cpu_set_t cpu;
+        CPU_ZERO(&cpu);
+        CPU_SET(chunk_cpu(0, chunks), &cpu);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu), &cpu);
+    }
+
+    inside_parallel_region = 1;
+    task(context, work[0].begin, work[0].end);
+    inside_parallel_region = 0;
+
+    if (pin) {
+        pthread_setaffinity_np(pthread_self(), sizeof(caller_affinity), &caller_affinity);
+    }
+
+    for (size_t i = 1; i < chunks; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+}
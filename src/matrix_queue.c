@@ -0,0 +1,528 @@
+#include "custom_dynamic_matrices.h"
+
+#include <pthread.h>
+
+
+struct MatrixOperation {
+    MatrixQueue* queue;
+    MatrixOperationFunction function;
+    void* context;
+    BinaryMatrixFunction binary_function;
+    const MultiDimensionalMatrix* operands[2];
+    ArithmeticOperationReturn result;
+    int finished;
+    size_t references;                       // Caller, queue (until finished) and every dependent (until it has finished)
+    size_t unfinished_dependencies;
+    ErrorCode dependency_error;              // First error of a dependency; the operation is skipped
+    MatrixOperation** dependencies;          // Referenced until the operation has finished
+    size_t number_of_dependencies;
+    MatrixOperation** dependents;            // Operations, which wait for this one
+    size_t number_of_dependents;
+    size_t dependents_capacity;
+    MatrixOperationCallback callback;
+    void* user_data;
+    MatrixOperation* next_ready;
+    MatrixOperation* previous_live;          // All operations of the queue, which aren't freed yet
+    MatrixOperation* next_live;
+};
+
+struct MatrixQueue {
+    pthread_mutex_t lock;                    // Protects the queue and all of its operations
+    pthread_cond_t work_available;
+    pthread_cond_t operation_finished;
+    MatrixOperation* first_ready;            // FIFO of operations without unfinished dependencies
+    MatrixOperation* last_ready;
+    MatrixOperation* live_operations;
+    size_t unfinished_operations;
+    int shutting_down;
+    pthread_t* workers;
+    size_t number_of_workers;
+};
+
+
+// Append an operation to the ready-FIFO and wake a worker (lock held).
+static void push_ready_operation(MatrixQueue* queue, MatrixOperation* operation) {
+    operation->next_ready = NULL;
+
+    if (queue->last_ready) {
+        queue->last_ready->next_ready = operation;
+    } else {
+        queue->first_ready = operation;
+    }
+
+    queue->last_ready = operation;
+    pthread_cond_signal(&queue->work_available);
+}
+
+static void free_operation(MatrixOperation* operation) {
+    MatrixQueue* queue = operation->queue;
+
+    if (operation->previous_live) {
+        operation->previous_live->next_live = operation->next_live;
+    } else {
+        queue->live_operations = operation->next_live;
+    }
+
+    if (operation->next_live) {
+        operation->next_live->previous_live = operation->previous_live;
+    }
+
+    free(operation->dependencies);
+    free(operation->dependents);
+    free(operation);
+}
+
+// Drop one reference and free the operation with the last one (lock held).
+static void drop_operation_reference(MatrixOperation* operation) {
+    if (--operation->references == 0) {
+        free_operation(operation);
+    }
+}
+
+// Store the result, release the dependents and the dependencies (lock held).
+static void finish_operation(MatrixQueue* queue, MatrixOperation* operation, ArithmeticOperationReturn result) {
+    operation->result = result;
+    operation->finished = 1;
+
+    for (size_t i = 0; i < operation->number_of_dependents; i++) {
+        MatrixOperation* dependent = operation->dependents[i];
+
+        if (result.error_code != ERR_NONE && dependent->dependency_error == ERR_NONE) {
+            dependent->dependency_error = result.error_code;
+        }
+
+        if (--dependent->unfinished_dependencies == 0) {
+            push_ready_operation(queue, dependent);
+        }
+    }
+
+    for (size_t i = 0; i < operation->number_of_dependencies; i++) {
+        drop_operation_reference(operation->dependencies[i]);
+    }
+
+    operation->number_of_dependencies = 0;
+    queue->unfinished_operations--;
+    pthread_cond_broadcast(&queue->operation_finished);
+}
+
+static void* run_queue_worker(void* argument) {
+    MatrixQueue* queue = (MatrixQueue*)argument;
+
+    pthread_mutex_lock(&queue->lock);
+
+    for (;;) {
+        while (!queue->first_ready && !queue->shutting_down) {
+            pthread_cond_wait(&queue->work_available, &queue->lock);
+        }
+
+        if (!queue->first_ready) {
+            // Shutting down and nothing left
+            break;
+        }
+
+        MatrixOperation* operation = queue->first_ready;
+        queue->first_ready = operation->next_ready;
+
+        if (!queue->first_ready) {
+            queue->last_ready = NULL;
+        }
+
+        pthread_mutex_unlock(&queue->lock);
+
+        ArithmeticOperationReturn result;
+
+        if (operation->dependency_error != ERR_NONE) {
+            // Skipped, the inputs are missing
+            result.result_matrix.head_ptr = NULL;
+            result.error_code = operation->dependency_error;
+        } else if (operation->binary_function) {
+            result = operation->binary_function(operation->operands[0], operation->operands[1]);
+        } else {
+            result = operation->function(operation->context);
+        }
+
+        if (result.error_code != ERR_NONE) {
+            // Failed operations don't always set their result
+            result.result_matrix.head_ptr = NULL;
+        }
+
+        pthread_mutex_lock(&queue->lock);
+        finish_operation(queue, operation, result);
+
+        MatrixOperationCallback callback = operation->callback;
+        void* user_data = operation->user_data;
+
+        if (callback) {
+            pthread_mutex_unlock(&queue->lock);
+            callback(operation, user_data);
+            pthread_mutex_lock(&queue->lock);
+        }
+
+        drop_operation_reference(operation);
+    }
+
+    pthread_mutex_unlock(&queue->lock);
+
+    return NULL;
+}
+
+// Create a queue with its own worker-threads.
+ErrorCode create_matrix_queue(MatrixQueue** queue, size_t number_of_workers) {
+    /*
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE          = No error.
+        ERR_NULL_PTR      = `queue` is NULL;
+        ERR_INVALID_ARGS  = `number_of_workers` is 0;
+        ERR_MALLOC_FAILED = Space allocation with `malloc` failed;
+        ERR_UNKNOWN       = No worker-thread could be started;
+
+        Up to `number_of_workers` independent operations run at the same time. Each of them
+        still splits its work over the threads of `set_matrix_thread_count`.
+
+    */
+
+    if (!queue) {
+        return ERR_NULL_PTR;
+    }
+
+    if (number_of_workers == 0) {
+        return ERR_INVALID_ARGS;
+    }
+
+    MatrixQueue* new_queue = (MatrixQueue*) calloc(1, sizeof(MatrixQueue));
+    pthread_t* workers = (pthread_t*) malloc(number_of_workers * sizeof(pthread_t));
+
+    if (!new_queue || !workers) {
+        // Allocation-Error
+        free(new_queue);
+        free(workers);
+        return ERR_MALLOC_FAILED;
+    }
+
+    pthread_mutex_init(&new_queue->lock, NULL);
+    pthread_cond_init(&new_queue->work_available, NULL);
+    pthread_cond_init(&new_queue->operation_finished, NULL);
+    new_queue->workers = workers;
+
+    for (size_t i = 0; i < number_of_workers; i++) {
+        if (pthread_create(&workers[new_queue->number_of_workers], NULL, run_queue_worker, new_queue) == 0) {
+            new_queue->number_of_workers++;
+        }
+    }
+
+    if (new_queue->number_of_workers == 0) {
+        clear_matrix_queue(new_queue);
+        return ERR_UNKNOWN;
+    }
+
+    *queue = new_queue;
+
+    return ERR_NONE;
+}
+
+// Wait for all submitted operations, stop the workers and free the queue.
+void clear_matrix_queue(MatrixQueue* queue) {
+    /*
+
+        Operation-handles, which weren't released yet, are freed as well. The result-matrices
+        belong to the caller and stay untouched.
+
+    */
+
+    if (!queue) {
+        return;
+    }
+
+    pthread_mutex_lock(&queue->lock);
+
+    while (queue->unfinished_operations > 0) {
+        pthread_cond_wait(&queue->operation_finished, &queue->lock);
+    }
+
+    queue->shutting_down = 1;
+    pthread_cond_broadcast(&queue->work_available);
+    pthread_mutex_unlock(&queue->lock);
+
+    for (size_t i = 0; i < queue->number_of_workers; i++) {
+        pthread_join(queue->workers[i], NULL);
+    }
+
+    while (queue->live_operations) {
+        free_operation(queue->live_operations);
+    }
+
+    pthread_cond_destroy(&queue->operation_finished);
+    pthread_cond_destroy(&queue->work_available);
+    pthread_mutex_destroy(&queue->lock);
+    free(queue->workers);
+    free(queue);
+}
+
+// Create the handle of a new operation and link it to its dependencies.
+static ErrorCode enqueue_operation(MatrixQueue* queue, MatrixOperation* operation,
+                                   MatrixOperation* const* dependencies, size_t number_of_dependencies, MatrixOperation** handle) {
+    if (number_of_dependencies > 0) {
+        operation->dependencies = (MatrixOperation**) malloc(number_of_dependencies * sizeof(MatrixOperation*));
+
+        if (!operation->dependencies) {
+            // Allocation-Error
+            free(operation);
+            return ERR_MALLOC_FAILED;
+        }
+    }
+
+    pthread_mutex_lock(&queue->lock);
+
+    // Reserve the dependent-slots first, so nothing has to be undone afterwards
+    for (size_t i = 0; i < number_of_dependencies; i++) {
+        MatrixOperation* dependency = dependencies[i];
+
+        if (!dependency->finished && dependency->number_of_dependents == dependency->dependents_capacity) {
+            size_t capacity = dependency->dependents_capacity ? 2 * dependency->dependents_capacity : 4;
+            MatrixOperation** dependents = (MatrixOperation**) realloc(dependency->dependents, capacity * sizeof(MatrixOperation*));
+
+            if (!dependents) {
+                // Reallocation-Error
+                pthread_mutex_unlock(&queue->lock);
+                free(operation->dependencies);
+                free(operation);
+                return ERR_REALLOC_FAILED;
+            }
+
+            dependency->dependents = dependents;
+            dependency->dependents_capacity = capacity;
+        }
+    }
+
+    operation->queue = queue;
+    operation->references = 2;
+    operation->next_live = queue->live_operations;
+
+    if (queue->live_operations) {
+        queue->live_operations->previous_live = operation;
+    }
+
+    queue->live_operations = operation;
+    queue->unfinished_operations++;
+
+    for (size_t i = 0; i < number_of_dependencies; i++) {
+        MatrixOperation* dependency = dependencies[i];
+
+        // Keeps the result of the dependency alive until this operation has read it
+        dependency->references++;
+        operation->dependencies[operation->number_of_dependencies++] = dependency;
+
+        if (dependency->finished) {
+            if (dependency->result.error_code != ERR_NONE && operation->dependency_error == ERR_NONE) {
+                operation->dependency_error = dependency->result.error_code;
+            }
+        } else {
+            dependency->dependents[dependency->number_of_dependents++] = operation;
+            operation->unfinished_dependencies++;
+        }
+    }
+
+    if (operation->unfinished_dependencies == 0) {
+        push_ready_operation(queue, operation);
+    }
+
+    *handle = operation;
+    pthread_mutex_unlock(&queue->lock);
+
+    return ERR_NONE;
+}
+
+// Check the arguments of a submission.
+static ErrorCode check_submission(MatrixQueue* queue, MatrixOperation* const* dependencies, size_t number_of_dependencies,
+                                  MatrixOperation** operation) {
+    if (!queue || !operation || (number_of_dependencies > 0 && !dependencies)) {
+        return ERR_NULL_PTR;
+    }
+
+    for (size_t i = 0; i < number_of_dependencies; i++) {
+        if (!dependencies[i]) {
+            return ERR_NULL_PTR;
+        }
+
+        if (dependencies[i]->queue != queue) {
+            // Dependencies are only tracked within one queue
+            return ERR_INVALID_ARGS;
+        }
+    }
+
+    return ERR_NONE;
+}
+
+// Run `function(context)` on a worker, once all dependencies have finished.
+ErrorCode submit_matrix_operation(MatrixQueue* queue, MatrixOperationFunction function, void* context,
+                                  MatrixOperation* const* dependencies, size_t number_of_dependencies, MatrixOperation** operation) {
+    /*
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE           = No error.
+        ERR_NULL_PTR       = Queue, function, handle or a dependency is NULL;
+        ERR_INVALID_ARGS   = A dependency belongs to another queue;
+        ERR_MALLOC_FAILED  = Space allocation with `malloc` failed;
+        ERR_REALLOC_FAILED = Growing the dependent-list of a dependency failed;
+
+        `*operation` receives the handle, which has to be released with
+        `release_matrix_operation`. If a dependency fails, the operation doesn't run and
+        finishes with the ErrorCode of that dependency. The results of the dependencies can be
+        read with `get_matrix_operation_result` inside of `function`.
+
+    */
+
+    ErrorCode error = check_submission(queue, dependencies, number_of_dependencies, operation);
+
+    if (error != ERR_NONE || !function) {
+        return error != ERR_NONE ? error : ERR_NULL_PTR;
+    }
+
+    MatrixOperation* new_operation = (MatrixOperation*) calloc(1, sizeof(MatrixOperation));
+
+    if (!new_operation) {
+        // Allocation-Error
+        return ERR_MALLOC_FAILED;
+    }
+
+    new_operation->function = function;
+    new_operation->context = context;
+
+    return enqueue_operation(queue, new_operation, dependencies, number_of_dependencies, operation);
+}
+
+// Run `function(matrix_A, matrix_B)` (e.g. `multiply_2d_matrices`) on a worker, once all dependencies have finished.
+ErrorCode submit_binary_matrix_operation(MatrixQueue* queue, BinaryMatrixFunction function,
+                                         const MultiDimensionalMatrix* matrix_A, const MultiDimensionalMatrix* matrix_B,
+                                         MatrixOperation* const* dependencies, size_t number_of_dependencies, MatrixOperation** operation) {
+    /*
+
+        Returns a custom `ErrorCode`.
+
+        The operands are read when the operation runs, so they can be the results of its
+        dependencies (see `get_matrix_operation_result`), which don't exist yet.
+
+        » For the possible ErrorCodes, see what `submit_matrix_operation` returns. «
+
+    */
+
+    ErrorCode error = check_submission(queue, dependencies, number_of_dependencies, operation);
+
+    if (error != ERR_NONE || !function) {
+        return error != ERR_NONE ? error : ERR_NULL_PTR;
+    }
+
+    MatrixOperation* new_operation = (MatrixOperation*) calloc(1, sizeof(MatrixOperation));
+
+    if (!new_operation) {
+        // Allocation-Error
+        return ERR_MALLOC_FAILED;
+    }
+
+    new_operation->binary_function = function;
+    new_operation->operands[0] = matrix_A;
+    new_operation->operands[1] = matrix_B;
+
+    return enqueue_operation(queue, new_operation, dependencies, number_of_dependencies, operation);
+}
+
+// `1` if the operation has finished, otherwise `0`.
+int poll_matrix_operation(MatrixOperation* operation) {
+    if (!operation) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&operation->queue->lock);
+    int finished = operation->finished;
+    pthread_mutex_unlock(&operation->queue->lock);
+
+    return finished;
+}
+
+// Block until the operation has finished and return its result.
+ArithmeticOperationReturn wait_matrix_operation(MatrixOperation* operation) {
+    /*
+
+        The result-matrix belongs to the caller (also if this function is never called) and
+        has to be cleared with `clear_matrix`, after all operations which use it have finished.
+        Calling this function from inside of an operation can deadlock the queue.
+
+    */
+
+    ArithmeticOperationReturn response;
+
+    if (!operation) {
+        response.result_matrix.head_ptr = NULL;
+        response.error_code = ERR_NULL_PTR;
+        return response;
+    }
+
+    MatrixQueue* queue = operation->queue;
+
+    pthread_mutex_lock(&queue->lock);
+
+    while (!operation->finished) {
+        pthread_cond_wait(&queue->operation_finished, &queue->lock);
+    }
+
+    response = operation->result;
+    pthread_mutex_unlock(&queue->lock);
+
+    return response;
+}
+
+// Call `callback(operation, user_data)` once the operation has finished.
+ErrorCode set_matrix_operation_callback(MatrixOperation* operation, MatrixOperationCallback callback, void* user_data) {
+    /*
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE     = No error.
+        ERR_NULL_PTR = Operation is NULL;
+
+        The callback runs on the worker-thread before it takes the next operation. If the
+        operation has already finished, it runs immediately on the calling thread.
+
+    */
+
+    if (!operation) {
+        return ERR_NULL_PTR;
+    }
+
+    pthread_mutex_lock(&operation->queue->lock);
+    int finished = operation->finished;
+
+    if (!finished) {
+        operation->callback = callback;
+        operation->user_data = user_data;
+    }
+
+    pthread_mutex_unlock(&operation->queue->lock);
+
+    if (finished && callback) {
+        callback(operation, user_data);
+    }
+
+    return ERR_NONE;
+}
+
+// Matrix, which receives the result of the operation (empty until it has finished).
+const MultiDimensionalMatrix* get_matrix_operation_result(const MatrixOperation* operation) {
+    return operation ? &operation->result.result_matrix : NULL;
+}
+
+// Release the handle of an operation (it still runs, if it hasn't finished yet).
+void release_matrix_operation(MatrixOperation* operation) {
+    if (!operation) {
+        return;
+    }
+
+    MatrixQueue* queue = operation->queue;
+
+    pthread_mutex_lock(&queue->lock);
+    drop_operation_reference(operation);
+    pthread_mutex_unlock(&queue->lock);
+}
@@ -0,0 +1,705 @@
+#include "custom_dynamic_matrices.h"
+#include "matrix_data_types.h"
+#include "matrix_parallel.h"
+
+#include <limits.h> // For `LLONG_MIN` & `LLONG_MAX`
+#include <math.h>   // For `sqrt` & `INFINITY`
+
+
+/*
+
+    Reductions are planned as two groups of dimensions: the kept dimensions, which form the
+    output, and the reduced dimensions. Both groups are coalesced separately, afterwards the
+    work is done by a per data-type/operation kernel on 2-D blocks (kept x reduced):
+
+    - If the reduced elements are contiguous, each output-element reduces one run with
+      several independent accumulators (SIMD-lanes) and pairwise summation.
+    - If the output-elements are contiguous instead (e.g. the sum over the rows), whole rows
+      are accumulated into the output, which vectorizes over the kept dimension.
+
+    Floating point sums use Kahan-compensation when partial results are combined.
+    Large reductions are split over several threads, either over the output-elements or,
+    for a single output-element, over the reduced elements with per-thread partial results.
+
+*/
+
+#define PAIRWISE_BLOCK_SIZE 128
+#define REDUCTION_LANES 8
+
+// Minimum number of input-elements processed by one thread
+#define PARALLEL_REDUCTION_CHUNK 32768
+
+typedef void (*ReduceBlockKernel)(void* accumulators, void* compensations, const char* data,
+                                  size_t kept_count, size_t kept_stride, size_t reduced_count, size_t reduced_stride);
+typedef void (*MergeKernel)(void* accumulator, void* compensation, const void* partial_accumulator, const void* partial_compensation);
+
+typedef union ReductionValue {
+    long long int_value;
+    float float_value;
+    double double_value;
+} ReductionValue;
+
+typedef struct ReductionPlan {
+    ReduceBlockKernel kernel;
+    MergeKernel merge;
+    ReductionValue identity;
+    size_t accumulator_size;
+    const char* data;
+
+    size_t number_of_kept;
+    size_t kept_dimensions[MAX_VIEW_DIMENSIONS];
+    size_t kept_strides[MAX_VIEW_DIMENSIONS];       // Bytes
+    size_t total_kept;
+
+    size_t number_of_reduced;
+    size_t reduced_dimensions[MAX_VIEW_DIMENSIONS];
+    size_t reduced_strides[MAX_VIEW_DIMENSIONS];    // Bytes
+    size_t total_reduced;
+
+    char* accumulators;                             // One accumulator per output-element
+    char* compensations;
+    size_t number_of_partials;                      // Per-thread results of a single output-element
+} ReductionPlan;
+
+
+#define TRANSFORM_IDENTITY(x) (x)
+#define TRANSFORM_ABS(x) ((x) < 0 ? -(x) : (x))
+#define TRANSFORM_SQUARE(x) ((x) * (x))
+
+#define COMBINE_SUM(a, b) ((a) + (b))
+#define COMBINE_MIN(a, b) ((b) < (a) ? (b) : (a))
+#define COMBINE_MAX(a, b) ((b) > (a) ? (b) : (a))
+
+// Kernels of one reduction: `TYPE` elements are loaded with `LOAD` and reduced in `ACC` accumulators.
+#define DEFINE_REDUCTION_KERNELS(NAME, TYPE, ACC, LOAD, TRANSFORM, COMBINE, IS_SUM, COMPENSATED)        \
+static ACC NAME##_run(const char* data, size_t stride, size_t count, ACC identity) {                    \
+    if (IS_SUM && count > PAIRWISE_BLOCK_SIZE) {                                                        \
+        /* Pairwise summation: the rounding error grows with log(count) */                              \
+        size_t half = count / 2 / REDUCTION_LANES * REDUCTION_LANES;                                    \
+        return NAME##_run(data, stride, half, identity)                                                 \
+             + NAME##_run(data + half * stride, stride, count - half, identity);                        \
+    }                                                                                                   \
+    ACC lanes[REDUCTION_LANES];                                                                         \
+    for (size_t lane = 0; lane < REDUCTION_LANES; lane++) {                                             \
+        lanes[lane] = identity;                                                                         \
+    }                                                                                                   \
+    size_t i = 0;                                                                                       \
+    if (stride == sizeof(TYPE)) {                                                                       \
+        const TYPE* values = (const TYPE*)data;                                                         \
+        for (; i + REDUCTION_LANES <= count; i += REDUCTION_LANES) {                                    \
+            for (size_t lane = 0; lane < REDUCTION_LANES; lane++) {                                     \
+                ACC value = (ACC)LOAD(values[i + lane]);                                                \
+                lanes[lane] = COMBINE(lanes[lane], TRANSFORM(value));                                   \
+            }                                                                                           \
+        }                                                                                               \
+    }                                                                                                   \
+    ACC total = COMBINE(COMBINE(COMBINE(lanes[0], lanes[1]), COMBINE(lanes[2], lanes[3])),              \
+                        COMBINE(COMBINE(lanes[4], lanes[5]), COMBINE(lanes[6], lanes[7])));             \
+    for (; i < count; i++) {                                                                            \
+        ACC value = (ACC)LOAD(*(const TYPE*)(data + i * stride));                                      \
+        total = COMBINE(total, TRANSFORM(value));                                                       \
+    }                                                                                                   \
+    return total;                                                                                       \
+}                                                                                                       \
+                                                                                                        \
+static inline void NAME##_combine(ACC* accumulator, ACC* compensation, ACC value) {                    \
+    if (COMPENSATED) {                                                                                  \
+        /* Kahan-summation */                                                                           \
+        ACC corrected = value - *compensation;                                                          \
+        ACC sum = *accumulator + corrected;                                                             \
+        if (sum - sum == (ACC)0) {                                                                      \
+            *compensation = (sum - *accumulator) - corrected;                                           \
+            *accumulator = sum;                                                                         \
+        } else {                                                                                        \
+            /* Infinite or NaN: plain addition (the compensation would be inf - inf) */                 \
+            *compensation = (ACC)0;                                                                     \
+            *accumulator += value;                                                                      \
+        }                                                                                               \
+    } else {                                                                                            \
+        *accumulator = COMBINE(*accumulator, value);                                                    \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+static void NAME##_block(void* accumulators, void* compensations, const char* data,                    \
+                         size_t kept_count, size_t kept_stride, size_t reduced_count, size_t reduced_stride) { \
+    ACC* accumulator = (ACC*)accumulators;                                                              \
+    ACC* compensation = (ACC*)compensations;                                                            \
+    if (reduced_stride == sizeof(TYPE) || kept_stride != sizeof(TYPE) || kept_count == 1) {             \
+        /* Every output-element reduces one run */                                                      \
+        for (size_t k = 0; k < kept_count; k++) {                                                       \
+            ACC start = IS_SUM ? (ACC)0 : accumulator[k];                                               \
+            ACC value = NAME##_run(data + k * kept_stride, reduced_stride, reduced_count, start);       \
+            NAME##_combine(&accumulator[k], &compensation[k], value);                                   \
+        }                                                                                               \
+        return;                                                                                         \
+    }                                                                                                   \
+    /* Contiguous output-elements: accumulate whole rows */                                             \
+    for (size_t r = 0; r < reduced_count; r++) {                                                        \
+        const TYPE* row = (const TYPE*)(data + r * reduced_stride);                                     \
+        for (size_t k = 0; k < kept_count; k++) {                                                       \
+            ACC value = (ACC)LOAD(row[k]);                                                              \
+            NAME##_combine(&accumulator[k], &compensation[k], TRANSFORM(value));                        \
+        }                                                                                               \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+static void NAME##_merge(void* accumulator, void* compensation, const void* partial_accumulator, const void* partial_compensation) { \
+    ACC value = *(const ACC*)partial_accumulator;                                                       \
+    if (COMPENSATED) {                                                                                  \
+        value -= *(const ACC*)partial_compensation;                                                     \
+    }                                                                                                   \
+    NAME##_combine((ACC*)accumulator, (ACC*)compensation, value);                                       \
+}
+
+// All reductions of one data-type; floating point sums are compensated, norms are reduced in `NORM_ACC`
+#define DEFINE_TYPE_REDUCTION_KERNELS(NAME, TYPE, ACC, NORM_ACC, LOAD, COMPENSATED)                     \
+    DEFINE_REDUCTION_KERNELS(sum_##NAME, TYPE, ACC, LOAD, TRANSFORM_IDENTITY, COMBINE_SUM, 1, COMPENSATED) \
+    DEFINE_REDUCTION_KERNELS(abs_sum_##NAME, TYPE, NORM_ACC, LOAD, TRANSFORM_ABS, COMBINE_SUM, 1, 1)    \
+    DEFINE_REDUCTION_KERNELS(square_sum_##NAME, TYPE, NORM_ACC, LOAD, TRANSFORM_SQUARE, COMBINE_SUM, 1, 1) \
+    DEFINE_REDUCTION_KERNELS(min_##NAME, TYPE, ACC, LOAD, TRANSFORM_IDENTITY, COMBINE_MIN, 0, 0)        \
+    DEFINE_REDUCTION_KERNELS(max_##NAME, TYPE, ACC, LOAD, TRANSFORM_IDENTITY, COMBINE_MAX, 0, 0)        \
+    DEFINE_REDUCTION_KERNELS(abs_max_##NAME, TYPE, NORM_ACC, LOAD, TRANSFORM_ABS, COMBINE_MAX, 0, 0)
+
+// Integers are reduced in 64 bit, their norms in `double` (|MIN| and squares would overflow),
+// 16-bit floating point types in `float`
+DEFINE_TYPE_REDUCTION_KERNELS(int, int, long long, double, LOAD_VALUE, 0)
+DEFINE_TYPE_REDUCTION_KERNELS(int8, int8_t, long long, double, LOAD_VALUE, 0)
+DEFINE_TYPE_REDUCTION_KERNELS(int16, int16_t, long long, double, LOAD_VALUE, 0)
+DEFINE_TYPE_REDUCTION_KERNELS(int64, int64_t, long long, double, LOAD_VALUE, 0)
+DEFINE_TYPE_REDUCTION_KERNELS(uint8, uint8_t, long long, double, LOAD_VALUE, 0)
+DEFINE_TYPE_REDUCTION_KERNELS(float, float, float, float, LOAD_VALUE, 1)
+DEFINE_TYPE_REDUCTION_KERNELS(double, double, double, double, LOAD_VALUE, 1)
+DEFINE_TYPE_REDUCTION_KERNELS(fp16, fp16_t, float, float, LOAD_FP16, 1)
+DEFINE_TYPE_REDUCTION_KERNELS(bf16, bf16_t, float, float, LOAD_BF16, 1)
+
+
+// Pick kernels and identity-element of a reduction.
+static ErrorCode select_reduction_kernels(ReductionPlan* plan, ReductionOperation operation, DataType data_type) {
+    /*
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                 = No error.
+        ERR_INVALID_ARGS         = Unknown reduction-operation;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported data-type;
+
+    */
+
+    // Transform and combination of every operation: 0 = sum, 1 = |x|-sum, 2 = x²-sum, 3 = min, 4 = max, 5 = |x|-max
+    int kind;
+
+    switch(operation) {
+        case REDUCE_SUM:
+        case REDUCE_MEAN:
+            kind = 0;
+            break;
+
+        case REDUCE_NORM_L1:
+            kind = 1;
+            break;
+
+        case REDUCE_NORM_L2:
+            kind = 2;
+            break;
+
+        case REDUCE_MIN:
+            kind = 3;
+            break;
+
+        case REDUCE_MAX:
+            kind = 4;
+            break;
+
+        case REDUCE_NORM_MAX:
+            kind = 5;
+            break;
+
+        default:
+            return ERR_INVALID_ARGS;
+    }
+
+    #define REDUCTION_KERNEL_ROW(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE) \
+        [ENUM] = { sum_##NAME##_block, abs_sum_##NAME##_block, square_sum_##NAME##_block, min_##NAME##_block, max_##NAME##_block, abs_max_##NAME##_block },
+    #define REDUCTION_MERGE_ROW(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE) \
+        [ENUM] = { sum_##NAME##_merge, abs_sum_##NAME##_merge, square_sum_##NAME##_merge, min_##NAME##_merge, max_##NAME##_merge, abs_max_##NAME##_merge },
+
+    static const ReduceBlockKernel kernels[NUMBER_OF_DATA_TYPES][6] = { FOR_EACH_DATA_TYPE(REDUCTION_KERNEL_ROW) };
+    static const MergeKernel merges[NUMBER_OF_DATA_TYPES][6] = { FOR_EACH_DATA_TYPE(REDUCTION_MERGE_ROW) };
+
+    #undef REDUCTION_KERNEL_ROW
+    #undef REDUCTION_MERGE_ROW
+
+    if ((unsigned)data_type >= NUMBER_OF_DATA_TYPES) {
+        // Unsupported Data-Type
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    plan->kernel = kernels[data_type][kind];
+    plan->merge = merges[data_type][kind];
+
+    if (is_integer_data_type(data_type) && (kind == 1 || kind == 2 || kind == 5)) {
+        // Norms of integers are reduced in `double`
+        plan->accumulator_size = sizeof(double);
+        plan->identity.double_value = 0.0;
+    } else if (is_integer_data_type(data_type)) {
+        plan->accumulator_size = sizeof(long long);
+        plan->identity.int_value = kind == 3 ? LLONG_MAX : (kind == 4 ? LLONG_MIN : 0);
+    } else if (data_type == TYPE_DOUBLE) {
+        plan->accumulator_size = sizeof(double);
+        plan->identity.double_value = kind == 3 ? INFINITY : (kind == 4 ? -INFINITY : 0.0);
+    } else {
+        // `TYPE_FLOAT`, `TYPE_FP16` & `TYPE_BF16`
+        plan->accumulator_size = sizeof(float);
+        plan->identity.float_value = kind == 3 ? INFINITY : (kind == 4 ? -INFINITY : 0.0f);
+    }
+
+    return ERR_NONE;
+}
+
+// Drop size-1 dimensions of a group and merge neighbours, which are contiguous among themselves.
+static void coalesce_dimension_group(size_t* number_of_dimensions, size_t* dimensions, size_t* strides) {
+    size_t count = 0;
+
+    for (size_t i = 0; i < *number_of_dimensions; i++) {
+        if (dimensions[i] == 1) {
+            continue;
+        }
+
+        if (count > 0 && strides[count - 1] == strides[i] * dimensions[i]) {
+            dimensions[count - 1] *= dimensions[i];
+            strides[count - 1] = strides[i];
+            continue;
+        }
+
+        dimensions[count] = dimensions[i];
+        strides[count] = strides[i];
+        count++;
+    }
+
+    if (count == 0) {
+        // Single element
+        dimensions[0] = 1;
+        strides[0] = 0;
+        count = 1;
+    }
+
+    *number_of_dimensions = count;
+}
+
+// Fill accumulators with the identity-element.
+static void init_accumulators(char* accumulators, size_t count, const ReductionPlan* plan) {
+    for (size_t i = 0; i < count; i++) {
+        memcpy(accumulators + i * plan->accumulator_size, &plan->identity, plan->accumulator_size);
+    }
+}
+
+// Reduce all reduced elements of `kept_count` output-elements, which start at `data`.
+static void reduce_block(const ReductionPlan* plan, char* accumulators, char* compensations, const char* data, size_t kept_count, size_t kept_stride) {
+    size_t inner = plan->number_of_reduced - 1;
+    size_t counters[MAX_VIEW_DIMENSIONS] = {0};
+    size_t offset = 0;
+
+    for (;;) {
+        plan->kernel(accumulators, compensations, data + offset, kept_count, kept_stride,
+                     plan->reduced_dimensions[inner], plan->reduced_strides[inner]);
+
+        // Advance the outer reduced dimensions
+        size_t dimension = inner;
+
+        for (;;) {
+            if (dimension == 0) {
+                return;
+            }
+            dimension--;
+
+            counters[dimension]++;
+            offset += plan->reduced_strides[dimension];
+
+            if (counters[dimension] < plan->reduced_dimensions[dimension]) {
+                break;
+            }
+
+            offset -= plan->reduced_strides[dimension] * plan->reduced_dimensions[dimension];
+            counters[dimension] = 0;
+        }
+    }
+}
+
+// Parallel task: reduce the output-elements [begin, end).
+static void reduce_kept_range(void* context, size_t begin, size_t end) {
+    const ReductionPlan* plan = (const ReductionPlan*)context;
+    size_t inner = plan->number_of_kept - 1;
+    size_t counters[MAX_VIEW_DIMENSIONS];
+    size_t offset = 0, remainder = begin;
+
+    // Position of `begin` in the kept dimensions
+    for (size_t i = plan->number_of_kept; i-- > 0;) {
+        counters[i] = remainder % plan->kept_dimensions[i];
+        remainder /= plan->kept_dimensions[i];
+        offset += counters[i] * plan->kept_strides[i];
+    }
+
+    size_t position = begin;
+
+    while (position < end) {
+        size_t run = plan->kept_dimensions[inner] - counters[inner];
+
+        if (run > end - position) {
+            run = end - position;
+        }
+
+        reduce_block(plan, plan->accumulators + position * plan->accumulator_size,
+                     plan->compensations + position * plan->accumulator_size,
+                     plan->data + offset, run, plan->kept_strides[inner]);
+
+        position += run;
+        counters[inner] += run;
+        offset += run * plan->kept_strides[inner];
+
+        // Carry into the outer kept dimensions
+        for (size_t dimension = inner; dimension > 0 && counters[dimension] == plan->kept_dimensions[dimension]; dimension--) {
+            offset -= plan->kept_strides[dimension] * plan->kept_dimensions[dimension];
+            counters[dimension] = 0;
+            counters[dimension - 1]++;
+            offset += plan->kept_strides[dimension - 1];
+        }
+    }
+}
+
+// Parallel task: reduce the share [begin, end) of partial results for a single output-element.
+static void reduce_partial_range(void* context, size_t begin, size_t end) {
+    const ReductionPlan* plan = (const ReductionPlan*)context;
+    size_t inner = plan->number_of_reduced - 1;
+
+    for (size_t partial = begin; partial < end; partial++) {
+        char* accumulator = plan->accumulators + (partial + 1) * plan->accumulator_size;
+        char* compensation = plan->compensations + (partial + 1) * plan->accumulator_size;
+
+        // Flat range of reduced elements of this partial result
+        size_t first = plan->total_reduced / plan->number_of_partials * partial;
+        size_t last = partial + 1 == plan->number_of_partials ? plan->total_reduced : first + plan->total_reduced / plan->number_of_partials;
+
+        size_t counters[MAX_VIEW_DIMENSIONS];
+        size_t offset = 0, remainder = first;
+
+        for (size_t i = plan->number_of_reduced; i-- > 0;) {
+            counters[i] = remainder % plan->reduced_dimensions[i];
+            remainder /= plan->reduced_dimensions[i];
+            offset += counters[i] * plan->reduced_strides[i];
+        }
+
+        size_t position = first;
+
+        while (position < last) {
+            size_t run = plan->reduced_dimensions[inner] - counters[inner];
+
+            if (run > last - position) {
+                run = last - position;
+            }
+
+            plan->kernel(accumulator, compensation, plan->data + offset, 1, 0, run, plan->reduced_strides[inner]);
+
+            position += run;
+            counters[inner] += run;
+            offset += run * plan->reduced_strides[inner];
+
+            for (size_t dimension = inner; dimension > 0 && counters[dimension] == plan->reduced_dimensions[dimension]; dimension--) {
+                offset -= plan->reduced_strides[dimension] * plan->reduced_dimensions[dimension];
+                counters[dimension] = 0;
+                counters[dimension - 1]++;
+                offset += plan->reduced_strides[dimension - 1];
+            }
+        }
+    }
+}
+
+// Convert an accumulator into the output-value of the operation.
+static void finalize_reduction(void* output, DataType output_type, const char* accumulator, DataType input_type, ReductionOperation operation, size_t count) {
+    double value;
+
+    if (is_integer_data_type(input_type) &&
+        (operation == REDUCE_NORM_L1 || operation == REDUCE_NORM_L2 || operation == REDUCE_NORM_MAX)) {
+        value = *(const double*)accumulator;
+    } else if (is_integer_data_type(input_type)) {
+        long long integer = *(const long long*)accumulator;
+
+        // Sum, minimum & maximum stay integers
+        #define INTEGER_OUTPUT_CASE(ENUM, NAME, STORAGE, MINIMUM, MAXIMUM) \
+            case ENUM: *(STORAGE*)output = (STORAGE)integer; return;
+
+        switch(output_type) {
+            FOR_EACH_INTEGER_DATA_TYPE(INTEGER_OUTPUT_CASE)
+
+            default:
+                break;
+        }
+
+        #undef INTEGER_OUTPUT_CASE
+
+        value = (double)integer;
+    } else if (input_type == TYPE_DOUBLE) {
+        value = *(const double*)accumulator;
+    } else {
+        value = *(const float*)accumulator;
+    }
+
+    if (operation == REDUCE_MEAN) {
+        value /= (double)count;
+    } else if (operation == REDUCE_NORM_L2) {
+        value = sqrt(value);
+    }
+
+    switch(output_type) {
+        case TYPE_FLOAT:
+            *(float*)output = (float)value;
+            break;
+
+        case TYPE_FP16:
+            *(fp16_t*)output = float_to_fp16_bits((float)value);
+            break;
+
+        case TYPE_BF16:
+            *(bf16_t*)output = float_to_bf16_bits((float)value);
+            break;
+
+        default:
+            *(double*)output = value;
+            break;
+    }
+}
+
+// Reduce the given axes of a view.
+ArithmeticOperationReturn reduce_matrix_view_axes(const MatrixView* view, ReductionOperation operation, size_t number_of_axes, const size_t* axes, int keep_dimensions) {
+    /*
+
+        The result contains the kept dimensions in their original order. With `keep_dimensions`
+        the reduced dimensions stay in the result with size `1` (useful for broadcasting the
+        result against the input), otherwise they are removed. If every dimension is reduced
+        and removed, the result is a 1-D matrix with a single element.
+
+        Result data-type: `TYPE_INT`-matrices keep their type for `REDUCE_SUM`, `REDUCE_MIN` and
+        `REDUCE_MAX` (summed in 64 bit, truncated at the end) and give `TYPE_DOUBLE` for the mean and
+        the norms. The other integer types are summed into `TYPE_INT64`, keep their type for
+        `REDUCE_MIN`/`REDUCE_MAX` and give `TYPE_DOUBLE` as well. `TYPE_FP16`/`TYPE_BF16` are
+        reduced in `float` and give `TYPE_FLOAT`, except for `REDUCE_MIN`/`REDUCE_MAX`.
+        `TYPE_FLOAT`/`TYPE_DOUBLE`-matrices keep their data-type.
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The result of this operation.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                 = No error.
+        ERR_NULL_PTR             = View does not exist; Axes-array does not exist;
+        ERR_INVALID_ARGS         = Invalid or repeated axis; Unknown operation; Minimum/Maximum/Mean of zero elements;
+        ERR_MALLOC_FAILED        = Allocation of the accumulators failed;
+        ERR_UNSUPPORTED_DATATYPE = Unsupported data-type;
+
+        » For the other possible ErrorCodes, see what `create_matrix` returns. «
+
+    */
+
+    ArithmeticOperationReturn response;
+    response.error_code = ERR_NONE;
+    response.result_matrix.head_ptr = NULL;
+
+    if (!view || !view->parent || !view->parent->data || (number_of_axes > 0 && !axes)) {
+        response.error_code = ERR_NULL_PTR;
+        return response;
+    }
+
+    ReductionPlan plan;
+    response.error_code = select_reduction_kernels(&plan, operation, view->data_type);
+
+    if (response.error_code != ERR_NONE) {
+        return response;
+    }
+
+    int reduced[MAX_VIEW_DIMENSIONS] = {0};
+
+    for (size_t i = 0; i < number_of_axes; i++) {
+        if (axes[i] >= view->number_of_dimensions || reduced[axes[i]]) {
+            // Invalid or repeated axis
+            response.error_code = ERR_INVALID_ARGS;
+            return response;
+        }
+        reduced[axes[i]] = 1;
+    }
+
+    // Split the dimensions into both groups and build the output-shape
+    size_t element_size = get_data_type_size(view->data_type);
+    size_t output_dimensions[MAX_VIEW_DIMENSIONS];
+    size_t number_of_output_dimensions = 0;
+
+    plan.number_of_kept = 0;
+    plan.number_of_reduced = 0;
+    plan.total_kept = 1;
+    plan.total_reduced = 1;
+    plan.data = (const char*)view->parent->data + view->offset * element_size;
+
+    for (size_t i = 0; i < view->number_of_dimensions; i++) {
+        if (reduced[i]) {
+            plan.reduced_dimensions[plan.number_of_reduced] = view->dimensions[i];
+            plan.reduced_strides[plan.number_of_reduced] = view->strides[i] * element_size;
+            plan.number_of_reduced++;
+            plan.total_reduced *= view->dimensions[i];
+
+            if (keep_dimensions) {
+                output_dimensions[number_of_output_dimensions++] = 1;
+            }
+        } else {
+            plan.kept_dimensions[plan.number_of_kept] = view->dimensions[i];
+            plan.kept_strides[plan.number_of_kept] = view->strides[i] * element_size;
+            plan.number_of_kept++;
+            plan.total_kept *= view->dimensions[i];
+
+            output_dimensions[number_of_output_dimensions++] = view->dimensions[i];
+        }
+    }
+
+    if (number_of_output_dimensions == 0) {
+        output_dimensions[number_of_output_dimensions++] = 1;
+    }
+
+    if (plan.total_reduced == 0 && operation != REDUCE_SUM && operation != REDUCE_NORM_L1 && operation != REDUCE_NORM_L2) {
+        // Minimum/Maximum/Mean of nothing
+        response.error_code = ERR_INVALID_ARGS;
+        return response;
+    }
+
+    DataType output_type = view->data_type;
+
+    if (operation != REDUCE_MIN && operation != REDUCE_MAX) {
+        if (view->data_type == TYPE_INT) {
+            output_type = operation == REDUCE_SUM ? TYPE_INT : TYPE_DOUBLE;
+        } else if (is_integer_data_type(view->data_type)) {
+            output_type = operation == REDUCE_SUM ? TYPE_INT64 : TYPE_DOUBLE;
+        } else if (is_half_data_type(view->data_type)) {
+            output_type = TYPE_FLOAT;
+        }
+    }
+
+    response.error_code = create_matrix(&response.result_matrix, number_of_output_dimensions, output_dimensions, output_type);
+
+    if (response.error_code != ERR_NONE) {
+        return response;
+    }
+
+    coalesce_dimension_group(&plan.number_of_kept, plan.kept_dimensions, plan.kept_strides);
+    coalesce_dimension_group(&plan.number_of_reduced, plan.reduced_dimensions, plan.reduced_strides);
+
+    // A single output-element is split over the reduced elements instead
+    plan.number_of_partials = 1;
+
+    if (plan.total_kept == 1) {
+        size_t threads = get_matrix_thread_count();
+        plan.number_of_partials = plan.total_reduced / PARALLEL_REDUCTION_CHUNK;
+
+        if (plan.number_of_partials > threads) {
+            plan.number_of_partials = threads;
+        }
+        if (plan.number_of_partials == 0) {
+            plan.number_of_partials = 1;
+        }
+    }
+
+    size_t number_of_accumulators = plan.total_kept + (plan.number_of_partials > 1 ? plan.number_of_partials : 0);
+
+    if (number_of_accumulators == 0) {
+        // Empty result
+        number_of_accumulators = 1;
+    }
+
+    plan.accumulators = (char*)malloc(number_of_accumulators * plan.accumulator_size);
+    plan.compensations = (char*)calloc(number_of_accumulators, plan.accumulator_size);
+
+    if (!plan.accumulators || !plan.compensations) {
+        free(plan.accumulators);
+        free(plan.compensations);
+        clear_matrix(&response.result_matrix);
+        response.error_code = ERR_MALLOC_FAILED;
+        return response;
+    }
+
+    init_accumulators(plan.accumulators, number_of_accumulators, &plan);
+
+    if (plan.total_reduced > 0 && plan.total_kept > 0) {
+        if (plan.number_of_partials > 1) {
+            parallel_for(plan.number_of_partials, 1, reduce_partial_range, &plan);
+
+            // Combine the partial results in a fixed order
+            for (size_t partial = 1; partial <= plan.number_of_partials; partial++) {
+                plan.merge(plan.accumulators, plan.compensations,
+                           plan.accumulators + partial * plan.accumulator_size,
+                           plan.compensations + partial * plan.accumulator_size);
+            }
+        } else {
+            size_t minimum_chunk = PARALLEL_REDUCTION_CHUNK / plan.total_reduced;
+            parallel_for(plan.total_kept, minimum_chunk > 0 ? minimum_chunk : 1, reduce_kept_range, &plan);
+        }
+    }
+
+    size_t output_size = get_data_type_size(output_type);
+
+    for (size_t i = 0; i < plan.total_kept; i++) {
+        finalize_reduction((char*)response.result_matrix.head_ptr->data + i * output_size, output_type,
+                           plan.accumulators + i * plan.accumulator_size, view->data_type, operation, plan.total_reduced);
+    }
+
+    free(plan.accumulators);
+    free(plan.compensations);
+
+    return response;
+}
+
+// Reduce the given axes of a matrix.
+ArithmeticOperationReturn reduce_matrix_axes(const MultiDimensionalMatrix* matrix, ReductionOperation operation, size_t number_of_axes, const size_t* axes, int keep_dimensions) {
+    /*
+
+        See `reduce_matrix_view_axes`.
+
+    */
+
+    ArithmeticOperationReturn response;
+    response.result_matrix.head_ptr = NULL;
+
+    MatrixView view;
+    response.error_code = create_matrix_view(&view, matrix);
+
+    if (response.error_code != ERR_NONE) {
+        return response;
+    }
+
+    return reduce_matrix_view_axes(&view, operation, number_of_axes, axes, keep_dimensions);
+}
+
+// Reduce all elements of a matrix into a single value.
+ArithmeticOperationReturn reduce_matrix(const MultiDimensionalMatrix* matrix, ReductionOperation operation) {
+    /*
+
+        The result is a 1-D matrix with one element.
+        See `reduce_matrix_view_axes` for the result data-type and the possible ErrorCodes.
+
+    */
+
+    ArithmeticOperationReturn response;
+    response.result_matrix.head_ptr = NULL;
+
+    MatrixView view;
+    response.error_code = create_matrix_view(&view, matrix);
+
+    if (response.error_code != ERR_NONE) {
+        return response;
+    }
+
+    size_t axes[MAX_VIEW_DIMENSIONS];
+
+    for (size_t i = 0; i < view.number_of_dimensions; i++) {
+        axes[i] = i;
+    }
+
+    return reduce_matrix_view_axes(&view, operation, view.number_of_dimensions, axes, 0);
+}
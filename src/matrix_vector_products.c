@@ -0,0 +1,370 @@
+#include "custom_dynamic_matrices.h"
+#include "matrix_data_types.h"
+#include "matrix_kernels.h"
+#include "matrix_parallel.h"
+
+
+/*
+
+    Products with one vector-operand touch every element of the matrix exactly once, so
+    they are limited by the memory-bandwidth. Each kernel streams the matrix row by row
+    (contiguous) and keeps its accumulators in registers:
+
+    - `A * x`: every result-element is the dot-product of a row with `x`, which is summed in
+      `GEMV_LANES` independent accumulators (SIMD-lanes). The rows are split over threads.
+    - `A^T * x`: rows of A are scaled by `x[i]` and added to a block of `GEMV_COLUMN_BLOCK`
+      results (an axpy, which vectorizes over the columns). The column-blocks are split over
+      threads, so every thread streams its own columns of all rows.
+    - `A += alpha * x * y^T`: row `i` gets `alpha * x[i] * y` added. The rows are split over
+      threads.
+
+    Like the matmul-kernels, all kernels compute in the compute-type of the data-type
+    (`float` for fp16/bf16) and round once, when a result is stored.
+
+*/
+
+#define GEMV_LANES 8
+#define GEMV_COLUMN_BLOCK 256
+
+// Minimum number of matrix-elements processed by one thread
+#define PARALLEL_GEMV_CHUNK 32768
+
+// `result[i] = sum_j A[i, j] * x[j]` for the rows [begin, end)
+// `result[j] = sum_i A[i, j] * x[i]` for the columns [begin, end) (transposed)
+// `A[i, :] += alpha * x[i] * y` for the rows [begin, end) (rank-1 update)
+#define DEFINE_MATRIX_VECTOR_KERNELS(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE)                         \
+static void gemv_##NAME##_rows(void* result, const void* matrix, const void* vector,                    \
+                               size_t begin, size_t end, size_t rows, size_t cols, size_t row_stride) { \
+    (void)rows;                                                                                         \
+    STORAGE* y = (STORAGE*)result;                                                                      \
+    const STORAGE* A = (const STORAGE*)matrix;                                                          \
+    const STORAGE* x = (const STORAGE*)vector;                                                          \
+    for (size_t i = begin; i < end; i++) {                                                              \
+        const STORAGE* row = A + i * row_stride;                                                        \
+        COMPUTE lanes[GEMV_LANES] = {0};                                                                \
+        size_t j = 0;                                                                                   \
+        for (; j + GEMV_LANES <= cols; j += GEMV_LANES) {                                               \
+            for (size_t lane = 0; lane < GEMV_LANES; lane++) {                                          \
+                lanes[lane] += LOAD(row[j + lane]) * LOAD(x[j + lane]);                                 \
+            }                                                                                           \
+        }                                                                                               \
+        COMPUTE sum = 0;                                                                                \
+        for (size_t lane = 0; lane < GEMV_LANES; lane++) {                                              \
+            sum += lanes[lane];                                                                         \
+        }                                                                                               \
+        for (; j < cols; j++) {                                                                         \
+            sum += LOAD(row[j]) * LOAD(x[j]);                                                           \
+        }                                                                                               \
+        y[i] = STORE(STORAGE, sum);                                                                     \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+static void gemv_transposed_##NAME##_columns(void* result, const void* matrix, const void* vector,      \
+                               size_t begin, size_t end, size_t rows, size_t cols, size_t row_stride) { \
+    (void)cols;                                                                                         \
+    STORAGE* y = (STORAGE*)result;                                                                      \
+    const STORAGE* A = (const STORAGE*)matrix;                                                          \
+    const STORAGE* x = (const STORAGE*)vector;                                                          \
+    COMPUTE sums[GEMV_COLUMN_BLOCK];                                                                    \
+    for (size_t start = begin; start < end; start += GEMV_COLUMN_BLOCK) {                               \
+        size_t length = end - start < GEMV_COLUMN_BLOCK ? end - start : GEMV_COLUMN_BLOCK;              \
+        for (size_t j = 0; j < length; j++) {                                                           \
+            sums[j] = 0;                                                                                \
+        }                                                                                               \
+        for (size_t i = 0; i < rows; i++) {                                                             \
+            const COMPUTE a = LOAD(x[i]);                                                               \
+            const STORAGE* row = A + i * row_stride + start;                                            \
+            for (size_t j = 0; j < length; j++) {                                                       \
+                sums[j] += a * LOAD(row[j]);                                                            \
+            }                                                                                           \
+        }                                                                                               \
+        for (size_t j = 0; j < length; j++) {                                                           \
+            y[start + j] = STORE(STORAGE, sums[j]);                                                     \
+        }                                                                                               \
+    }                                                                                                   \
+}                                                                                                       \
+                                                                                                        \
+static void rank_one_update_##NAME##_rows(void* matrix, const void* vector_x, const void* vector_y,     \
+                                          const void* scalar, size_t begin, size_t end, size_t cols) {  \
+    STORAGE* A = (STORAGE*)matrix;                                                                      \
+    const STORAGE* x = (const STORAGE*)vector_x;                                                        \
+    const STORAGE* y = (const STORAGE*)vector_y;                                                        \
+    const COMPUTE alpha = LOAD(*(const STORAGE*)scalar);                                                \
+    for (size_t i = begin; i < end; i++) {                                                              \
+        const COMPUTE a = alpha * LOAD(x[i]);                                                           \
+        STORAGE* row = A + i * cols;                                                                    \
+        for (size_t j = 0; j < cols; j++) {                                                             \
+            row[j] = STORE(STORAGE, LOAD(row[j]) + a * LOAD(y[j]));                                     \
+        }                                                                                               \
+    }                                                                                                   \
+}
+
+FOR_EACH_DATA_TYPE(DEFINE_MATRIX_VECTOR_KERNELS)
+
+typedef void (*GemvKernel)(void* result, const void* matrix, const void* vector,
+                           size_t begin, size_t end, size_t rows, size_t cols, size_t row_stride);
+typedef void (*RankOneUpdateKernel)(void* matrix, const void* vector_x, const void* vector_y,
+                                    const void* scalar, size_t begin, size_t end, size_t cols);
+
+static GemvKernel select_gemv_kernel(DataType data_type, int transposed) {
+    /*
+
+        Returns NULL if the data-type is not supported.
+
+    */
+
+    #define GEMV_KERNEL_CASE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE) \
+        case ENUM: return transposed ? gemv_transposed_##NAME##_columns : gemv_##NAME##_rows;
+
+    switch(data_type) {
+        FOR_EACH_DATA_TYPE(GEMV_KERNEL_CASE)
+
+        default:
+            // Unsupported Data-Type
+            return NULL;
+    }
+
+    #undef GEMV_KERNEL_CASE
+}
+
+static RankOneUpdateKernel select_rank_one_update_kernel(DataType data_type) {
+    #define RANK_ONE_UPDATE_KERNEL_CASE(ENUM, NAME, STORAGE, COMPUTE, LOAD, STORE) case ENUM: return rank_one_update_##NAME##_rows;
+
+    switch(data_type) {
+        FOR_EACH_DATA_TYPE(RANK_ONE_UPDATE_KERNEL_CASE)
+
+        default:
+            // Unsupported Data-Type
+            return NULL;
+    }
+
+    #undef RANK_ONE_UPDATE_KERNEL_CASE
+}
+
+// Work of a matrix-vector product or rank-1 update, shared by all threads.
+typedef struct MatrixVectorTask {
+    GemvKernel gemv_kernel;
+    RankOneUpdateKernel update_kernel;
+    void* result;                       // Result-vector, or the updated matrix
+    const void* matrix;
+    const void* vector_x;
+    const void* vector_y;
+    const void* scalar;
+    size_t rows, cols, row_stride;
+} MatrixVectorTask;
+
+// Parallel task: rows (or columns, if transposed) [begin, end) of a product.
+static void multiply_matrix_vector_range(void* context, size_t begin, size_t end) {
+    const MatrixVectorTask* task = (const MatrixVectorTask*)context;
+    task->gemv_kernel(task->result, task->matrix, task->vector_x, begin, end, task->rows, task->cols, task->row_stride);
+}
+
+// Parallel task: rows [begin, end) of a rank-1 update.
+static void rank_one_update_range(void* context, size_t begin, size_t end) {
+    const MatrixVectorTask* task = (const MatrixVectorTask*)context;
+    task->update_kernel(task->result, task->vector_x, task->vector_y, task->scalar, begin, end, task->cols);
+}
+
+// `result = A * x` (or `A^T * x`) for a row-major matrix with `row_stride` elements per row.
+ErrorCode multiply_matrix_vector_buffers(void* result, const void* matrix, const void* vector,
+                                         size_t rows, size_t cols, size_t row_stride, DataType data_type, int transposed) {
+    /*
+
+        Returns ERR_UNSUPPORTED_DATATYPE for an unsupported data-type.
+
+    */
+
+    MatrixVectorTask task;
+    task.gemv_kernel = select_gemv_kernel(data_type, transposed);
+
+    if (!task.gemv_kernel) {
+        // Unsupported Data-Type
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    task.result = result;
+    task.matrix = matrix;
+    task.vector_x = vector;
+    task.rows = rows;
+    task.cols = cols;
+    task.row_stride = row_stride;
+
+    // Work-items are rows of `cols` elements, or columns of `rows` elements
+    size_t count = transposed ? cols : rows;
+    size_t work_per_item = transposed ? rows : cols;
+    size_t minimum_chunk = PARALLEL_GEMV_CHUNK / (work_per_item + 1) + 1;
+
+    parallel_for(count, minimum_chunk, multiply_matrix_vector_range, &task);
+
+    return ERR_NONE;
+}
+
+// Check a 2-D matrix and a vector of the same data-type with `length` elements.
+static ErrorCode check_matrix_vector_operands(const MultiDimensionalMatrix* matrix, const MultiDimensionalMatrix* vector, size_t length_dimension) {
+    if (!matrix || !vector || !matrix->head_ptr || !vector->head_ptr || !matrix->head_ptr->data || !vector->head_ptr->data) {
+        // Matrix/Vector does not exist
+        return ERR_NULL_PTR;
+    }
+
+    if (matrix->head_ptr->number_of_dimensions != 2 || vector->head_ptr->number_of_dimensions != 1) {
+        // Not a matrix and a vector
+        return ERR_INVALID_ARGS;
+    }
+
+    if (vector->head_ptr->dimensions[0] != matrix->head_ptr->dimensions[length_dimension]) {
+        return ERR_DIMENSION_SIZE_MISMATCH;
+    }
+
+    if (matrix->head_ptr->data_type != vector->head_ptr->data_type) {
+        // Cannot multiply operands with different data-types
+        return ERR_DATATYPE_MISMATCH;
+    }
+
+    return ERR_NONE;
+}
+
+// `A * x` or `A^T * x`
+static ArithmeticOperationReturn multiply_matrix_vector(const MultiDimensionalMatrix* matrix, const MultiDimensionalMatrix* vector, int transposed) {
+    ArithmeticOperationReturn response;
+    response.result_matrix.head_ptr = NULL;
+    response.error_code = check_matrix_vector_operands(matrix, vector, transposed ? 0 : 1);
+
+    if (response.error_code != ERR_NONE) {
+        return response;
+    }
+
+    size_t rows = matrix->head_ptr->dimensions[0], cols = matrix->head_ptr->dimensions[1];
+    size_t length = transposed ? cols : rows;
+
+    response.error_code = create_matrix(&response.result_matrix, 1, &length, matrix->head_ptr->data_type);
+
+    if (response.error_code != ERR_NONE) {
+        response.result_matrix.head_ptr = NULL;
+        return response;
+    }
+
+    response.error_code = multiply_matrix_vector_buffers(response.result_matrix.head_ptr->data, matrix->head_ptr->data,
+                                                         vector->head_ptr->data, rows, cols, cols,
+                                                         matrix->head_ptr->data_type, transposed);
+
+    if (response.error_code != ERR_NONE) {
+        clear_matrix(&response.result_matrix);
+        response.result_matrix.head_ptr = NULL;
+    }
+
+    return response;
+}
+
+// Product of a 2-D matrix and a vector.
+ArithmeticOperationReturn matrix_vector_multiply(const MultiDimensionalMatrix* matrix, const MultiDimensionalMatrix* vector) {
+    /*
+
+        `vector` is a 1-D matrix with `cols` elements, the result is a 1-D matrix with `rows`
+        elements. The matrix is streamed once, its rows are split over several threads.
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The result of this operation.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                        = No error.
+        ERR_NULL_PTR                    = Matrix/Vector does not exist;
+        ERR_INVALID_ARGS                = The matrix is not 2-dimensional; The vector is not 1-dimensional;
+        ERR_DIMENSION_SIZE_MISMATCH     = The length of the vector is not equal to `cols`;
+        ERR_DATATYPE_MISMATCH           = The data types of both operands do not match;
+        ERR_UNSUPPORTED_DATATYPE        = Unsupported data-type;
+
+        » For the other possible ErrorCodes, see what `create_matrix` returns. «
+
+    */
+
+    return multiply_matrix_vector(matrix, vector, 0);
+}
+
+// Product of the transpose of a 2-D matrix and a vector.
+ArithmeticOperationReturn matrix_transposed_vector_multiply(const MultiDimensionalMatrix* matrix, const MultiDimensionalMatrix* vector) {
+    /*
+
+        Computes `A^T * x` without transposing A: `vector` is a 1-D matrix with `rows`
+        elements, the result is a 1-D matrix with `cols` elements. The matrix is streamed
+        once, its columns are split over several threads.
+
+        Returns a `ArithmeticOperationReturn` struct, which contains:
+
+        - MultiDimensionalMatrix result_matrix: The result of this operation.
+        - ErrorCode error_code                : Indicating the operation status.
+
+
+        Possible `ErrorCodes`:
+
+        ERR_NONE                        = No error.
+        ERR_DIMENSION_SIZE_MISMATCH     = The length of the vector is not equal to `rows`;
+
+        » For the other possible ErrorCodes, see what `matrix_vector_multiply` returns. «
+
+    */
+
+    return multiply_matrix_vector(matrix, vector, 1);
+}
+
+// Add the scaled outer product of two vectors to a 2-D matrix.
+ErrorCode rank_one_update(MultiDimensionalMatrix* matrix, const void* alpha, const MultiDimensionalMatrix* vector_x, const MultiDimensionalMatrix* vector_y) {
+    /*
+
+        `A += alpha * x * y^T`: `x` has `rows`, `y` has `cols` elements and `alpha` points to
+        a value of the data-type of the matrix. The rows are updated by several threads.
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE                        = No error.
+        ERR_NULL_PTR                    = Matrix/Vectors/Alpha do not exist;
+        ERR_INVALID_ARGS                = The matrix is not 2-dimensional; A vector is not 1-dimensional;
+        ERR_DIMENSION_SIZE_MISMATCH     = The lengths of the vectors don't match `rows` and `cols`;
+        ERR_DATATYPE_MISMATCH           = The data types of the operands do not match;
+        ERR_READ_ONLY                   = The matrix is a read-only mapping of a file;
+        ERR_UNSUPPORTED_DATATYPE        = Unsupported data-type;
+
+    */
+
+    if (!alpha) {
+        // Alpha does not exist
+        return ERR_NULL_PTR;
+    }
+
+    ErrorCode error = check_matrix_vector_operands(matrix, vector_x, 0);
+
+    if (error == ERR_NONE) {
+        error = check_matrix_vector_operands(matrix, vector_y, 1);
+    }
+
+    if (error != ERR_NONE) {
+        return error;
+    }
+
+    if (matrix->head_ptr->storage == STORAGE_MAPPED_READ_ONLY) {
+        // Writing would fault
+        return ERR_READ_ONLY;
+    }
+
+    MatrixVectorTask task;
+    task.update_kernel = select_rank_one_update_kernel(matrix->head_ptr->data_type);
+
+    if (!task.update_kernel) {
+        // Unsupported Data-Type
+        return ERR_UNSUPPORTED_DATATYPE;
+    }
+
+    task.result = matrix->head_ptr->data;
+    task.vector_x = vector_x->head_ptr->data;
+    task.vector_y = vector_y->head_ptr->data;
+    task.scalar = alpha;
+    task.rows = matrix->head_ptr->dimensions[0];
+    task.cols = matrix->head_ptr->dimensions[1];
+
+    parallel_for(task.rows, PARALLEL_GEMV_CHUNK / (task.cols + 1) + 1, rank_one_update_range, &task);
+
+    return ERR_NONE;
+}
@@ -0,0 +1,329 @@
+#include "custom_dynamic_matrices.h"
+#include "matrix_workspace.h"
+
+
+// Smallest pooled buffer (in bytes); larger ones are rounded up to a quarter of a power of two
+#define WORKSPACE_MINIMUM_BLOCK_SIZE 64
+
+// Enough size-classes for every `size_t`: one for the minimum, then four per power of two
+#define WORKSPACE_SIZE_CLASSES (4 * 8 * sizeof(size_t))
+
+
+// Header in front of every pooled buffer; 32 bytes, so the data keeps the alignment of `malloc`
+typedef struct WorkspaceBlock {
+    struct WorkspaceBlock* next_free;
+    MatrixWorkspace* workspace;
+    size_t size_class;
+    size_t size;                 // Usable bytes behind the header
+} WorkspaceBlock;
+
+struct MatrixWorkspace {
+    WorkspaceBlock* free_blocks[WORKSPACE_SIZE_CLASSES]; // One LIFO-list per size-class
+    MultiDimensionalMatrixNode* newest_matrix;           // Last matrix of the open scopes
+    size_t scope_depth;
+    size_t reserved_bytes;
+    MatrixWorkspace* enclosing_workspace;                // Workspace, which was open before this one
+};
+
+// Workspace of the innermost open scope of the calling thread
+static __thread MatrixWorkspace* current_workspace = NULL;
+
+
+// Size-class of a buffer with at least `size` bytes and the bytes of that class.
+static int find_size_class(size_t size, size_t* size_class, size_t* class_size) {
+    if (size <= WORKSPACE_MINIMUM_BLOCK_SIZE) {
+        *size_class = 0;
+        *class_size = WORKSPACE_MINIMUM_BLOCK_SIZE;
+        return 1;
+    }
+
+    if (size > SIZE_MAX / 2) {
+        // Rounding up would overflow
+        return 0;
+    }
+
+    // `size - 1` lies in [2^power, 2^(power + 1)), which is split into four classes
+    size_t last_byte = size - 1;
+    size_t power = 0;
+
+    while (last_byte >> (power + 1)) {
+        power++;
+    }
+
+    size_t step = (size_t)1 << (power - 2);
+    size_t quarter = last_byte >> (power - 2);          // 4 to 7
+
+    *size_class = (power - 6) * 4 + (quarter - 4) + 1;
+    *class_size = (quarter + 1) * step;
+
+    return 1;
+}
+
+// Create an empty workspace.
+ErrorCode create_workspace(MatrixWorkspace** workspace) {
+    /*
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE          = No error.
+        ERR_NULL_PTR      = `workspace` is NULL;
+        ERR_MALLOC_FAILED = Space allocation with `malloc` failed;
+
+        Buffers are only reserved while matrices are created inside of its scopes
+        (see `begin_workspace_scope`) and kept until `clear_workspace`.
+
+    */
+
+    if (!workspace) {
+        return ERR_NULL_PTR;
+    }
+
+    *workspace = (MatrixWorkspace*) calloc(1, sizeof(MatrixWorkspace));
+
+    if (!*workspace) {
+        // Allocation-Error
+        return ERR_MALLOC_FAILED;
+    }
+
+    return ERR_NONE;
+}
+
+// Close all scopes of a workspace and free all of its buffers.
+void clear_workspace(MatrixWorkspace* workspace) {
+    if (!workspace) {
+        return;
+    }
+
+    // Clear the matrices of all open scopes
+    while (workspace->newest_matrix) {
+        MultiDimensionalMatrix matrix = {workspace->newest_matrix};
+        clear_matrix(&matrix);
+    }
+
+    if (current_workspace == workspace) {
+        current_workspace = workspace->enclosing_workspace;
+    } else {
+        // Unlink it from the scopes, which are nested in it (they end in its enclosing workspace)
+        for (MatrixWorkspace* inner = current_workspace; inner; inner = inner->enclosing_workspace) {
+            if (inner->enclosing_workspace == workspace) {
+                inner->enclosing_workspace = workspace->enclosing_workspace;
+                break;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < WORKSPACE_SIZE_CLASSES; i++) {
+        while (workspace->free_blocks[i]) {
+            WorkspaceBlock* block = workspace->free_blocks[i];
+            workspace->free_blocks[i] = block->next_free;
+            free(block);
+        }
+    }
+
+    free(workspace);
+}
+
+// Open a (nested) scope of a workspace on the calling thread.
+ErrorCode begin_workspace_scope(MatrixWorkspace* workspace) {
+    /*
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE         = No error.
+        ERR_NULL_PTR     = `workspace` is NULL;
+        ERR_INVALID_ARGS = `workspace` already has open scopes below the scope of another workspace;
+
+        Every matrix, which the calling thread creates until the matching `end_workspace_scope`
+        (directly with `create_matrix` or as the result of an operation), takes its data-buffer
+        from the pool of `workspace` and is cleared when the scope ends. Scopes of different
+        workspaces can be nested, but have to end in reverse order.
+
+    */
+
+    if (!workspace) {
+        return ERR_NULL_PTR;
+    }
+
+    if (current_workspace != workspace) {
+        if (workspace->scope_depth > 0) {
+            // The workspace is open, but not innermost
+            return ERR_INVALID_ARGS;
+        }
+
+        workspace->enclosing_workspace = current_workspace;
+        current_workspace = workspace;
+    }
+
+    workspace->scope_depth++;
+
+    return ERR_NONE;
+}
+
+// Clear all matrices of the innermost scope and return their buffers to the pool.
+ErrorCode end_workspace_scope(MatrixWorkspace* workspace) {
+    /*
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE         = No error.
+        ERR_NULL_PTR     = `workspace` is NULL;
+        ERR_INVALID_ARGS = The innermost scope of the calling thread does not belong to `workspace`;
+
+        The matrices of the scope must not be used afterwards (unless they were detached with
+        `detach_matrix_from_workspace`). The buffers stay reserved for the next matrices.
+
+    */
+
+    if (!workspace) {
+        return ERR_NULL_PTR;
+    }
+
+    if (current_workspace != workspace || workspace->scope_depth == 0) {
+        // Not the innermost scope
+        return ERR_INVALID_ARGS;
+    }
+
+    while (workspace->newest_matrix && workspace->newest_matrix->workspace_scope == workspace->scope_depth) {
+        MultiDimensionalMatrix matrix = {workspace->newest_matrix};
+        clear_matrix(&matrix);
+    }
+
+    if (--workspace->scope_depth == 0) {
+        current_workspace = workspace->enclosing_workspace;
+        workspace->enclosing_workspace = NULL;
+    }
+
+    return ERR_NONE;
+}
+
+// Keep a matrix beyond the end of its scope.
+ErrorCode detach_matrix_from_workspace(MultiDimensionalMatrix* matrix) {
+    /*
+
+        Returns a custom `ErrorCode`.
+
+        ERR_NONE          = No error.
+        ERR_NULL_PTR      = Matrix does not exist;
+        ERR_MALLOC_FAILED = Space allocation with `malloc` failed;
+
+        A pooled data-buffer is copied into an own buffer, afterwards the matrix has to be
+        cleared with `clear_matrix` like any other one.
+
+    */
+
+    if (!matrix || !matrix->head_ptr) {
+        return ERR_NULL_PTR;
+    }
+
+    MultiDimensionalMatrixNode* node = matrix->head_ptr;
+
+    if (node->storage == STORAGE_WORKSPACE) {
+        void* data = malloc(node->data_size > 0 ? node->data_size : 1);
+
+        if (!data) {
+            // Allocation-Error
+            return ERR_MALLOC_FAILED;
+        }
+
+        memcpy(data, node->data, node->data_size);
+        release_workspace_data(node->data);
+
+        node->data = data;
+        node->capacity = node->data_size;
+        node->storage = STORAGE_HEAP;
+    }
+
+    untrack_workspace_matrix(node);
+
+    return ERR_NONE;
+}
+
+// Bytes of all buffers, which the workspace holds (in use or free).
+size_t get_workspace_reserved_bytes(const MatrixWorkspace* workspace) {
+    return workspace ? workspace->reserved_bytes : 0;
+}
+
+void track_workspace_matrix(MultiDimensionalMatrixNode* node) {
+    MatrixWorkspace* workspace = current_workspace;
+
+    node->workspace = workspace;
+    node->workspace_next = NULL;
+    node->workspace_previous = NULL;
+    node->workspace_scope = 0;
+
+    if (!workspace) {
+        return;
+    }
+
+    node->workspace_scope = workspace->scope_depth;
+    node->workspace_previous = workspace->newest_matrix;
+
+    if (workspace->newest_matrix) {
+        workspace->newest_matrix->workspace_next = node;
+    }
+
+    workspace->newest_matrix = node;
+}
+
+void untrack_workspace_matrix(MultiDimensionalMatrixNode* node) {
+    MatrixWorkspace* workspace = node->workspace;
+
+    if (!workspace) {
+        return;
+    }
+
+    if (node->workspace_previous) {
+        node->workspace_previous->workspace_next = node->workspace_next;
+    }
+
+    if (node->workspace_next) {
+        node->workspace_next->workspace_previous = node->workspace_previous;
+    } else {
+        workspace->newest_matrix = node->workspace_previous;
+    }
+
+    node->workspace = NULL;
+    node->workspace_next = NULL;
+    node->workspace_previous = NULL;
+}
+
+void* allocate_workspace_data(MultiDimensionalMatrixNode* node, size_t size) {
+    MatrixWorkspace* workspace = current_workspace;
+    size_t size_class, class_size;
+
+    if (!workspace || !find_size_class(size, &size_class, &class_size)) {
+        return NULL;
+    }
+
+    WorkspaceBlock* block = workspace->free_blocks[size_class];
+
+    if (block) {
+        // Reuse the most recently released buffer of this class
+        workspace->free_blocks[size_class] = block->next_free;
+    } else {
+        block = (WorkspaceBlock*) malloc(sizeof(WorkspaceBlock) + class_size);
+
+        if (!block) {
+            // Allocation-Error
+            return NULL;
+        }
+
+        block->workspace = workspace;
+        block->size_class = size_class;
+        block->size = class_size;
+        workspace->reserved_bytes += class_size;
+    }
+
+    block->next_free = NULL;
+    node->storage = STORAGE_WORKSPACE;
+
+    return block + 1;
+}
+
+void release_workspace_data(void* data) {
+    WorkspaceBlock* block = (WorkspaceBlock*)data - 1;
+    MatrixWorkspace* workspace = block->workspace;
+
+    block->next_free = workspace->free_blocks[block->size_class];
+    workspace->free_blocks[block->size_class] = block;
+}
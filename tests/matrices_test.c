@@ -63,9 +63,9 @@ void test_add_matrices() {
     int* result_value = (int*)get_element_by_indices(&result.result_matrix, (size_t[]){0, 0});
     assert(*result_value == 3);
 
-    // Add matrices with different dimension-sizes
+    // Add matrices with incompatible dimension-sizes
     MultiDimensionalMatrix third_matrix;
-    dimensions[0] = 1;
+    dimensions[0] = 3;
     create_matrix(&third_matrix, 2, dimensions, TYPE_INT);
     set_element_by_indices(&third_matrix, (size_t[]){0, 0}, (void*)&val2);
     result = add_matrices(&matrix_A, &third_matrix);
@@ -205,24 +205,85 @@ void test_resize_matrix() {
     int B_static_array[2][2] = { {1, 2}, {3, 4}  };
     assert(fill_matrix_from_static_array(&matrix_B, B_static_array) == ERR_NONE);
 
+    // The (2) matrix is aligned as (1 x 2): the first row keeps the old elements
+    assert(err == ERR_NONE);
+    assert(matrix_A.head_ptr->number_of_dimensions == 2);
+
     // Add both matrices
     ArithmeticOperationReturn result = add_matrices(&matrix_A, &matrix_B);
     assert(result.error_code == ERR_NONE);
     assert(result.result_matrix.head_ptr != NULL);
 
-    // DEBUG
-    printf("result_matrix[0][0] = %d\n", *(int*)get_element_by_indices(&result.result_matrix, (size_t[]){0, 0}));
-    printf("result_matrix[0][1] = %d\n", *(int*)get_element_by_indices(&result.result_matrix, (size_t[]){0, 1}));
-    //
-
     assert(*(int*)get_element_by_indices(&result.result_matrix, (size_t[]){0, 0}) == 2);
     assert(*(int*)get_element_by_indices(&result.result_matrix, (size_t[]){0, 1}) == 4);
-    assert(*(int*)get_element_by_indices(&result.result_matrix, (size_t[]){1, 0}) == 6);
-    assert(*(int*)get_element_by_indices(&result.result_matrix, (size_t[]){1, 1}) == 8);
+    assert(*(int*)get_element_by_indices(&result.result_matrix, (size_t[]){1, 0}) == 3);
+    assert(*(int*)get_element_by_indices(&result.result_matrix, (size_t[]){1, 1}) == 4);
+    clear_matrix(&result.result_matrix);
+
+    // Same number of elements: reshape without touching the data
+    void* data = matrix_B.head_ptr->data;
+    assert(resize_matrix(&matrix_B, 1, (size_t[]){4}) == ERR_NONE);
+    assert(matrix_B.head_ptr->data == data);
+    assert(*(int*)get_element_by_indices(&matrix_B, (size_t[]){3}) == 4);
+
+    // Growing and shrinking inner dimensions keeps the coordinates
+    MultiDimensionalMatrix matrix_C;
+    create_matrix(&matrix_C, 3, (size_t[]){2, 2, 3}, TYPE_DOUBLE);
+    for (size_t i = 0; i < 12; i++) {
+        ((double*)matrix_C.head_ptr->data)[i] = (double)i;
+    }
+    assert(resize_matrix(&matrix_C, 3, (size_t[]){3, 1, 5}) == ERR_NONE);
+    assert(matrix_C.head_ptr->data_size == 15 * sizeof(double));
+    assert(*(double*)get_element_by_indices(&matrix_C, (size_t[]){1, 0, 2}) == 8.0);
+    assert(*(double*)get_element_by_indices(&matrix_C, (size_t[]){1, 0, 3}) == 0.0);
+    assert(*(double*)get_element_by_indices(&matrix_C, (size_t[]){2, 0, 0}) == 0.0);
+
+    // Fewer dimensions: only the index 0 of the removed dimension stays
+    assert(resize_matrix(&matrix_C, 2, (size_t[]){1, 2}) == ERR_NONE);
+    assert(*(double*)get_element_by_indices(&matrix_C, (size_t[]){0, 1}) == 1.0);
 
-    // Deallocate both matrices.
+    // Growing row by row into reserved capacity does not move the data
+    MultiDimensionalMatrix series;
+    create_matrix(&series, 2, (size_t[]){1, 3}, TYPE_FLOAT);
+    ((float*)series.head_ptr->data)[0] = 1.0f;
+    assert(reserve_matrix_capacity(&series, 100) == ERR_NONE);
+    assert(series.head_ptr->capacity == 100 * 3 * sizeof(float));
+    assert(reserve_matrix_capacity(&series, SIZE_MAX / 4) == ERR_INVALID_ARGS);
+    data = series.head_ptr->data;
+
+    for (size_t rows = 2; rows <= 100; rows++) {
+        assert(resize_matrix(&series, 2, (size_t[]){rows, 3}) == ERR_NONE);
+        float value = (float)rows;
+        set_element_by_indices(&series, (size_t[]){rows - 1, 0}, &value);
+    }
+    assert(series.head_ptr->data == data);
+    assert(*(float*)get_element_by_indices(&series, (size_t[]){0, 0}) == 1.0f);
+    assert(*(float*)get_element_by_indices(&series, (size_t[]){99, 0}) == 100.0f);
+    assert(*(float*)get_element_by_indices(&series, (size_t[]){99, 2}) == 0.0f);
+
+    // Beyond the reserved capacity the buffer grows geometrically
+    assert(resize_matrix(&series, 2, (size_t[]){101, 3}) == ERR_NONE);
+    assert(series.head_ptr->capacity == 200 * 3 * sizeof(float));
+    assert(*(float*)get_element_by_indices(&series, (size_t[]){50, 0}) == 51.0f);
+
+    // Errors
+    assert(resize_matrix(&series, 0, (size_t[]){1}) == ERR_INVALID_ARGS);
+    assert(resize_matrix(&series, 2, (size_t[]){0, 3}) == ERR_INVALID_ARGS);
+    assert(resize_matrix(&series, 2, NULL) == ERR_NULL_PTR);
+    assert(resize_matrix(&series, 2, (size_t[]){SIZE_MAX / 2, 3}) == ERR_INVALID_ARGS);
+    assert(resize_matrix(&series, 2, (size_t[]){SIZE_MAX / 2, 1}) == ERR_INVALID_ARGS);
+    assert(series.head_ptr->dimensions[0] == 101);
+
+    MultiDimensionalMatrix empty;
+    create_matrix(&empty, 2, (size_t[]){0, 3}, TYPE_FLOAT);
+    assert(reserve_matrix_capacity(&empty, 10) == ERR_INVALID_ARGS);
+    clear_matrix(&empty);
+
+    // Deallocate all matrices.
     clear_matrix(&matrix_A);
     clear_matrix(&matrix_B);
+    clear_matrix(&matrix_C);
+    clear_matrix(&series);
 }
 
 void test_change_data_type() {
@@ -237,10 +298,10 @@ void test_change_data_type() {
     assert(error == ERR_NONE);
 
     // Check values before changing the data-type.
-    assert(*(int*)get_element_by_indices(&matrix, (size_t[]){0, 0} == 1));
-    assert(*(int*)get_element_by_indices(&matrix, (size_t[]){0, 1} == 2));
-    assert(*(int*)get_element_by_indices(&matrix, (size_t[]){1, 0} == 3));
-    assert(*(int*)get_element_by_indices(&matrix, (size_t[]){1, 1} == 4));
+    assert(*(int*)get_element_by_indices(&matrix, (size_t[]){0, 0}) == 1);
+    assert(*(int*)get_element_by_indices(&matrix, (size_t[]){0, 1}) == 2);
+    assert(*(int*)get_element_by_indices(&matrix, (size_t[]){1, 0}) == 3);
+    assert(*(int*)get_element_by_indices(&matrix, (size_t[]){1, 1}) == 4);
 
     error = change_data_type(&matrix, TYPE_INT);
     assert(error == ERR_INVALID_ARGS);
@@ -248,12 +309,2359 @@ void test_change_data_type() {
     assert(error == ERR_NONE);
 
     // Check values after changing the data-type.
-    assert(*(int*)get_element_by_indices(&matrix, (size_t[]){0, 0} == 1));
-    assert(*(int*)get_element_by_indices(&matrix, (size_t[]){0, 1} == 2));
-    assert(*(int*)get_element_by_indices(&matrix, (size_t[]){1, 0} == 3));
-    assert(*(int*)get_element_by_indices(&matrix, (size_t[]){1, 1} == 4));
+    assert(matrix.head_ptr->data_type == TYPE_FLOAT);
+    assert(*(float*)get_element_by_indices(&matrix, (size_t[]){0, 0}) == 1.0f);
+    assert(*(float*)get_element_by_indices(&matrix, (size_t[]){0, 1}) == 2.0f);
+    assert(*(float*)get_element_by_indices(&matrix, (size_t[]){1, 0}) == 3.0f);
+    assert(*(float*)get_element_by_indices(&matrix, (size_t[]){1, 1}) == 4.0f);
+
+    // Wider elements: converted into a new buffer
+    assert(change_data_type(&matrix, TYPE_DOUBLE) == ERR_NONE);
+    assert(matrix.head_ptr->data_size == 4 * sizeof(double));
+    assert(*(double*)get_element_by_indices(&matrix, (size_t[]){1, 1}) == 4.0);
+
+    // Rounding and saturation
+    double special_values[2][2] = { {2.5, -2.5}, {1e10, -1e300} };
+    fill_matrix_from_static_array(&matrix, special_values);
+
+    MultiDimensionalMatrix copy;
+    create_matrix(&copy, 2, dimensions, TYPE_DOUBLE);
+    fill_matrix_from_static_array(&copy, special_values);
+
+    assert(change_data_type(&matrix, TYPE_INT) == ERR_NONE);
+    assert(matrix.head_ptr->data_size == 4 * sizeof(int));
+    assert(*(int*)get_element_by_indices(&matrix, (size_t[]){0, 0}) == 2);
+    assert(*(int*)get_element_by_indices(&matrix, (size_t[]){0, 1}) == -2);
+    assert(*(int*)get_element_by_indices(&matrix, (size_t[]){1, 0}) == INT_MAX);
+    assert(*(int*)get_element_by_indices(&matrix, (size_t[]){1, 1}) == INT_MIN);
+
+    MultiDimensionalMatrix nearest;
+    create_matrix(&nearest, 2, dimensions, TYPE_DOUBLE);
+    fill_matrix_from_static_array(&nearest, special_values);
+    assert(convert_matrix_data_type(&nearest, TYPE_INT, ROUND_TO_NEAREST, 1) == ERR_NONE);
+    assert(*(int*)get_element_by_indices(&nearest, (size_t[]){0, 0}) == 2);
+    assert(*(int*)get_element_by_indices(&nearest, (size_t[]){0, 1}) == -2);
+    assert(change_data_type(&nearest, TYPE_FLOAT) == ERR_NONE);
+    assert(change_data_type(&nearest, TYPE_DOUBLE) == ERR_NONE);
+    assert(convert_matrix_data_type(&nearest, TYPE_INT, ROUND_DOWN, 0) == ERR_NONE);
+    assert(*(int*)get_element_by_indices(&nearest, (size_t[]){0, 0}) == 2);
+    assert(convert_matrix_data_type(&nearest, TYPE_FLOAT, (RoundingMode)7, 0) == ERR_NONE);
+    assert(convert_matrix_data_type(&nearest, TYPE_INT, (RoundingMode)7, 0) == ERR_INVALID_ARGS);
+
+    assert(convert_matrix_data_type(&copy, TYPE_FLOAT, ROUND_TOWARD_ZERO, 1) == ERR_NONE);
+    assert(*(float*)get_element_by_indices(&copy, (size_t[]){0, 1}) == -2.5f);
+    assert(*(float*)get_element_by_indices(&copy, (size_t[]){1, 1}) == -FLT_MAX);
+    assert(convert_matrix_data_type(&copy, TYPE_INT, ROUND_UP, 0) == ERR_NONE);
+    assert(*(int*)get_element_by_indices(&copy, (size_t[]){0, 0}) == 3);
+    assert(*(int*)get_element_by_indices(&copy, (size_t[]){0, 1}) == -2);
+
+    // Larger than one conversion-block, in place
+    MultiDimensionalMatrix large;
+    create_matrix(&large, 1, (size_t[]){2000}, TYPE_DOUBLE);
+    for (size_t i = 0; i < 2000; i++) {
+        ((double*)large.head_ptr->data)[i] = (double)i + 0.75;
+    }
+    assert(convert_matrix_data_type(&large, TYPE_INT, ROUND_TO_NEAREST, 0) == ERR_NONE);
+    for (size_t i = 0; i < 2000; i++) {
+        assert(((int*)large.head_ptr->data)[i] == (int)i + 1);
+    }
 
     // Clear matrix
     clear_matrix(&matrix);
+    clear_matrix(&copy);
+    clear_matrix(&nearest);
+    clear_matrix(&large);
+
+}
+
+void test_matrix_views() {
+    MultiDimensionalMatrix matrix;
+    size_t dimensions[2] = { 3, 4 };
+    create_matrix(&matrix, 2, dimensions, TYPE_INT);
+
+    int static_array[3][4] = { {0, 1, 2, 3}, {4, 5, 6, 7}, {8, 9, 10, 11} };
+    assert(fill_matrix_from_static_array(&matrix, static_array) == ERR_NONE);
+
+    MatrixView view;
+    assert(create_matrix_view(&view, &matrix) == ERR_NONE);
+    assert(is_matrix_view_contiguous(&view));
+
+    // Rows 1..2, every second column
+    MatrixView sliced;
+    assert(slice_matrix_view(&sliced, &view, 0, 1, 3, 1) == ERR_NONE);
+    assert(slice_matrix_view(&sliced, &sliced, 1, 0, 4, 2) == ERR_NONE);
+    assert(sliced.dimensions[0] == 2 && sliced.dimensions[1] == 2);
+    assert(*(int*)get_view_element_by_indices(&sliced, (size_t[]){0, 1}) == 6);
+    assert(*(int*)get_view_element_by_indices(&sliced, (size_t[]){1, 0}) == 8);
+    assert(get_view_element_by_indices(&sliced, (size_t[]){2, 0}) == NULL);
+    assert(!is_matrix_view_contiguous(&sliced));
+
+    // Writing through a view modifies the parent
+    int value = 42;
+    assert(set_view_element_by_indices(&sliced, (size_t[]){0, 0}, &value) == ERR_NONE);
+    assert(*(int*)get_element_by_indices(&matrix, (size_t[]){1, 0}) == 42);
+    value = 4;
+    set_view_element_by_indices(&sliced, (size_t[]){0, 0}, &value);
+
+    // Select a single row
+    MatrixView row;
+    assert(select_matrix_view_index(&row, &view, 0, 2) == ERR_NONE);
+    assert(row.number_of_dimensions == 1 && row.dimensions[0] == 4);
+    assert(*(int*)get_view_element_by_indices(&row, (size_t[]){3}) == 11);
+
+    // Transposition
+    MatrixView transposed;
+    assert(transpose_matrix_view(&transposed, &view) == ERR_NONE);
+    assert(transposed.dimensions[0] == 4 && transposed.dimensions[1] == 3);
+    assert(*(int*)get_view_element_by_indices(&transposed, (size_t[]){3, 1}) == 7);
+
+    MatrixView permuted;
+    assert(permute_matrix_view_axes(&permuted, &view, (size_t[]){1, 0}) == ERR_NONE);
+    assert(*(int*)get_view_element_by_indices(&permuted, (size_t[]){3, 1}) == 7);
+    assert(permute_matrix_view_axes(&permuted, &view, (size_t[]){0, 0}) == ERR_INVALID_ARGS);
+
+    // Reshape
+    MatrixView reshaped;
+    assert(reshape_matrix_view(&reshaped, &view, 3, (size_t[]){2, 3, 2}) == ERR_NONE);
+    assert(*(int*)get_view_element_by_indices(&reshaped, (size_t[]){1, 2, 1}) == 11);
+    assert(reshape_matrix_view(&reshaped, &view, 2, (size_t[]){5, 2}) == ERR_DIMENSION_SIZE_MISMATCH);
+    assert(reshape_matrix_view(&reshaped, &transposed, 1, (size_t[]){12}) == ERR_NON_CONTIGUOUS_VIEW);
+
+    // Splitting the rows of a column-slice only needs strides
+    MatrixView columns;
+    assert(slice_matrix_view(&columns, &view, 1, 1, 3, 1) == ERR_NONE);
+    assert(reshape_matrix_view(&reshaped, &columns, 3, (size_t[]){3, 2, 1}) == ERR_NONE);
+    assert(*(int*)get_view_element_by_indices(&reshaped, (size_t[]){2, 1, 0}) == 10);
+
+    // Arithmetic on views
+    ArithmeticOperationReturn copy = copy_matrix_view(&transposed);
+    assert(copy.error_code == ERR_NONE);
+    assert(*(int*)get_element_by_indices(&copy.result_matrix, (size_t[]){3, 1}) == 7);
+
+    ArithmeticOperationReturn sum = add_matrix_views(&transposed, &transposed);
+    assert(sum.error_code == ERR_NONE);
+    assert(*(int*)get_element_by_indices(&sum.result_matrix, (size_t[]){2, 2}) == 20);
+    assert(add_matrix_views(&transposed, &view).error_code == ERR_DIMENSION_SIZE_MISMATCH);
+
+    int scalar = 3;
+    ArithmeticOperationReturn scaled = scalar_multiply_matrix_view(&sliced, &scalar);
+    assert(scaled.error_code == ERR_NONE);
+    assert(*(int*)get_element_by_indices(&scaled.result_matrix, (size_t[]){1, 1}) == 30);
+
+    // A * A^T
+    ArithmeticOperationReturn product = multiply_2d_matrix_views(&view, &transposed);
+    assert(product.error_code == ERR_NONE);
+    assert(product.result_matrix.head_ptr->dimensions[0] == 3);
+    assert(product.result_matrix.head_ptr->dimensions[1] == 3);
+    assert(*(int*)get_element_by_indices(&product.result_matrix, (size_t[]){0, 0}) == 14);
+    assert(*(int*)get_element_by_indices(&product.result_matrix, (size_t[]){1, 2}) == 4 * 8 + 5 * 9 + 6 * 10 + 7 * 11);
+
+    clear_matrix(&copy.result_matrix);
+    clear_matrix(&sum.result_matrix);
+    clear_matrix(&scaled.result_matrix);
+    clear_matrix(&product.result_matrix);
+    clear_matrix(&matrix);
+}
+
+void test_broadcasting() {
+    MultiDimensionalMatrix matrix, row, column, scalar;
+    create_matrix(&matrix, 2, (size_t[]){2, 3}, TYPE_DOUBLE);
+    create_matrix(&row, 1, (size_t[]){3}, TYPE_DOUBLE);
+    create_matrix(&column, 2, (size_t[]){2, 1}, TYPE_DOUBLE);
+    create_matrix(&scalar, 1, (size_t[]){1}, TYPE_DOUBLE);
+
+    double matrix_array[2][3] = { {1, 2, 3}, {4, 5, 6} };
+    double row_array[3] = { 10, 20, 30 };
+    double column_array[2] = { 2, 3 };
+    double scalar_array[1] = { 0.5 };
+    fill_matrix_from_static_array(&matrix, matrix_array);
+    fill_matrix_from_static_array(&row, row_array);
+    fill_matrix_from_static_array(&column, column_array);
+    fill_matrix_from_static_array(&scalar, scalar_array);
+
+    // Row-vector is added to every row
+    ArithmeticOperationReturn sum = add_matrices(&matrix, &row);
+    assert(sum.error_code == ERR_NONE);
+    assert(sum.result_matrix.head_ptr->number_of_dimensions == 2);
+    assert(*(double*)get_element_by_indices(&sum.result_matrix, (size_t[]){0, 0}) == 11);
+    assert(*(double*)get_element_by_indices(&sum.result_matrix, (size_t[]){1, 2}) == 36);
+
+    // Both operands are stretched: (2 x 1) + (3) = (2 x 3)
+    ArithmeticOperationReturn outer = add_matrices(&column, &row);
+    assert(outer.error_code == ERR_NONE);
+    assert(outer.result_matrix.head_ptr->dimensions[0] == 2);
+    assert(outer.result_matrix.head_ptr->dimensions[1] == 3);
+    assert(*(double*)get_element_by_indices(&outer.result_matrix, (size_t[]){1, 2}) == 33);
+
+    // Per-row scaling
+    ArithmeticOperationReturn scaled = multiply_matrices_elementwise(&matrix, &column);
+    assert(scaled.error_code == ERR_NONE);
+    assert(*(double*)get_element_by_indices(&scaled.result_matrix, (size_t[]){0, 2}) == 6);
+    assert(*(double*)get_element_by_indices(&scaled.result_matrix, (size_t[]){1, 0}) == 12);
+
+    // Scalar
+    ArithmeticOperationReturn halved = multiply_matrices_elementwise(&scalar, &matrix);
+    assert(halved.error_code == ERR_NONE);
+    assert(*(double*)get_element_by_indices(&halved.result_matrix, (size_t[]){1, 1}) == 2.5);
+
+    // Incompatible shapes
+    MultiDimensionalMatrix wrong;
+    create_matrix(&wrong, 1, (size_t[]){2}, TYPE_DOUBLE);
+    assert(add_matrices(&matrix, &wrong).error_code == ERR_DIMENSION_SIZE_MISMATCH);
+
+    // Broadcasted views
+    MatrixView row_view, stretched;
+    create_matrix_view(&row_view, &row);
+    assert(broadcast_matrix_view(&stretched, &row_view, 2, (size_t[]){4, 3}) == ERR_NONE);
+    assert(stretched.strides[0] == 0);
+    assert(*(double*)get_view_element_by_indices(&stretched, (size_t[]){3, 1}) == 20);
+    assert(broadcast_matrix_view(&stretched, &row_view, 2, (size_t[]){4, 2}) == ERR_DIMENSION_SIZE_MISMATCH);
+
+    clear_matrix(&sum.result_matrix);
+    clear_matrix(&outer.result_matrix);
+    clear_matrix(&scaled.result_matrix);
+    clear_matrix(&halved.result_matrix);
+    clear_matrix(&matrix);
+    clear_matrix(&row);
+    clear_matrix(&column);
+    clear_matrix(&scalar);
+    clear_matrix(&wrong);
+}
+
+void test_matrix_expression() {
+    MultiDimensionalMatrix A, B, C;
+    size_t dimensions[2] = { 3, 300 };
+    create_matrix(&A, 2, dimensions, TYPE_FLOAT);
+    create_matrix(&B, 2, dimensions, TYPE_FLOAT);
+    create_matrix(&C, 1, (size_t[]){300}, TYPE_FLOAT);
+
+    for (size_t i = 0; i < 3; i++) {
+        for (size_t j = 0; j < 300; j++) {
+            float a = (float)(i + j), b = (float)j * 0.5f, c = 1.0f;
+            set_element_by_indices(&A, (size_t[]){i, j}, &a);
+            set_element_by_indices(&B, (size_t[]){i, j}, &b);
+            set_element_by_indices(&C, (size_t[]){j}, &c);
+        }
+    }
+
+    // (A + B) * 2 + C, with C broadcasted over the rows
+    MatrixExpression expression;
+    init_matrix_expression(&expression);
+    size_t a = expression_input(&expression, &A);
+    size_t b = expression_input(&expression, &B);
+    size_t c = expression_input(&expression, &C);
+    size_t sum = expression_add(&expression, a, b);
+    size_t scaled = expression_multiply(&expression, sum, expression_scalar(&expression, 2.0));
+    size_t root = expression_add(&expression, scaled, c);
+
+    ArithmeticOperationReturn result = evaluate_matrix_expression(&expression, root);
+    assert(result.error_code == ERR_NONE);
+    assert(result.result_matrix.head_ptr->number_of_dimensions == 2);
+
+    for (size_t i = 0; i < 3; i++) {
+        for (size_t j = 0; j < 300; j++) {
+            float expected = ((float)(i + j) + (float)j * 0.5f) * 2.0f + 1.0f;
+            assert(*(float*)get_element_by_indices(&result.result_matrix, (size_t[]){i, j}) == expected);
+        }
+    }
+
+    // Sub-expressions can be evaluated on their own, transposed views are valid inputs
+    MatrixView transposed;
+    MultiDimensionalMatrix D;
+    create_matrix(&D, 2, (size_t[]){300, 3}, TYPE_FLOAT);
+    MatrixView view_D;
+    create_matrix_view(&view_D, &D);
+    transpose_matrix_view(&transposed, &view_D);
+    for (size_t j = 0; j < 300; j++) {
+        for (size_t i = 0; i < 3; i++) {
+            float d = (float)i;
+            set_element_by_indices(&D, (size_t[]){j, i}, &d);
+        }
+    }
+    size_t d = expression_input_view(&expression, &transposed);
+    size_t difference = expression_subtract(&expression, a, d);
+
+    ArithmeticOperationReturn partial = evaluate_matrix_expression(&expression, difference);
+    assert(partial.error_code == ERR_NONE);
+    assert(*(float*)get_element_by_indices(&partial.result_matrix, (size_t[]){2, 7}) == 7.0f);
+
+    // Errors
+    assert(evaluate_matrix_expression(&expression, 99).error_code == ERR_INVALID_ARGS);
+    MatrixExpression constant;
+    init_matrix_expression(&constant);
+    assert(evaluate_matrix_expression(&constant, expression_scalar(&constant, 1.0)).error_code == ERR_INVALID_ARGS);
+    MatrixExpression invalid;
+    init_matrix_expression(&invalid);
+    size_t root_invalid = expression_add(&invalid, expression_input(&invalid, &A), 5);
+    assert(root_invalid == INVALID_EXPRESSION_NODE);
+    assert(evaluate_matrix_expression(&invalid, root_invalid).error_code == ERR_INVALID_ARGS);
+
+    clear_matrix(&result.result_matrix);
+    clear_matrix(&partial.result_matrix);
+    clear_matrix(&A);
+    clear_matrix(&B);
+    clear_matrix(&C);
+    clear_matrix(&D);
+}
+
+void test_reductions() {
+    MultiDimensionalMatrix matrix;
+    create_matrix(&matrix, 2, (size_t[]){3, 4}, TYPE_DOUBLE);
+    double static_array[3][4] = { {1, -2, 3, 4}, {5, 6, -7, 8}, {9, 10, 11, -12} };
+    fill_matrix_from_static_array(&matrix, static_array);
+
+    // Whole matrix
+    ArithmeticOperationReturn result = reduce_matrix(&matrix, REDUCE_SUM);
+    assert(result.error_code == ERR_NONE);
+    assert(result.result_matrix.head_ptr->number_of_dimensions == 1);
+    assert(*(double*)get_element_by_indices(&result.result_matrix, (size_t[]){0}) == 36);
+    clear_matrix(&result.result_matrix);
+
+    result = reduce_matrix(&matrix, REDUCE_MIN);
+    assert(*(double*)get_element_by_indices(&result.result_matrix, (size_t[]){0}) == -12);
+    clear_matrix(&result.result_matrix);
+
+    result = reduce_matrix(&matrix, REDUCE_NORM_MAX);
+    assert(*(double*)get_element_by_indices(&result.result_matrix, (size_t[]){0}) == 12);
+    clear_matrix(&result.result_matrix);
+
+    result = reduce_matrix(&matrix, REDUCE_MEAN);
+    assert(*(double*)get_element_by_indices(&result.result_matrix, (size_t[]){0}) == 3);
+    clear_matrix(&result.result_matrix);
+
+    result = reduce_matrix(&matrix, REDUCE_NORM_L1);
+    assert(*(double*)get_element_by_indices(&result.result_matrix, (size_t[]){0}) == 78);
+    clear_matrix(&result.result_matrix);
+
+    // Sum over the rows (output-elements are contiguous)
+    result = reduce_matrix_axes(&matrix, REDUCE_SUM, 1, (size_t[]){0}, 0);
+    assert(result.error_code == ERR_NONE);
+    assert(result.result_matrix.head_ptr->number_of_dimensions == 1);
+    assert(result.result_matrix.head_ptr->dimensions[0] == 4);
+    assert(*(double*)get_element_by_indices(&result.result_matrix, (size_t[]){1}) == 14);
+    assert(*(double*)get_element_by_indices(&result.result_matrix, (size_t[]){3}) == 0);
+    clear_matrix(&result.result_matrix);
+
+    // Maximum of every row, dimensions kept
+    result = reduce_matrix_axes(&matrix, REDUCE_MAX, 1, (size_t[]){1}, 1);
+    assert(result.error_code == ERR_NONE);
+    assert(result.result_matrix.head_ptr->dimensions[0] == 3);
+    assert(result.result_matrix.head_ptr->dimensions[1] == 1);
+    assert(*(double*)get_element_by_indices(&result.result_matrix, (size_t[]){1, 0}) == 8);
+    clear_matrix(&result.result_matrix);
+
+    // Transposed view
+    MatrixView view, transposed;
+    create_matrix_view(&view, &matrix);
+    transpose_matrix_view(&transposed, &view);
+    result = reduce_matrix_view_axes(&transposed, REDUCE_NORM_L2, 1, (size_t[]){0}, 0);
+    assert(result.error_code == ERR_NONE);
+    assert(*(double*)get_element_by_indices(&result.result_matrix, (size_t[]){0}) == sqrt(1.0 + 4 + 9 + 16));
+    clear_matrix(&result.result_matrix);
+
+    assert(reduce_matrix_axes(&matrix, REDUCE_SUM, 2, (size_t[]){1, 1}, 0).error_code == ERR_INVALID_ARGS);
+    assert(reduce_matrix_axes(&matrix, REDUCE_SUM, 1, (size_t[]){2}, 0).error_code == ERR_INVALID_ARGS);
+    clear_matrix(&matrix);
+
+    // 3-D integer tensor, reduce the outer axes
+    MultiDimensionalMatrix tensor;
+    create_matrix(&tensor, 3, (size_t[]){2, 3, 2}, TYPE_INT);
+    for (int i = 0; i < 12; i++) {
+        set_element_by_indices(&tensor, (size_t[]){i / 6, (i / 2) % 3, i % 2}, &i);
+    }
+
+    result = reduce_matrix_axes(&tensor, REDUCE_SUM, 2, (size_t[]){0, 2}, 0);
+    assert(result.error_code == ERR_NONE);
+    assert(result.result_matrix.head_ptr->data_type == TYPE_INT);
+    assert(*(int*)get_element_by_indices(&result.result_matrix, (size_t[]){0}) == 0 + 1 + 6 + 7);
+    assert(*(int*)get_element_by_indices(&result.result_matrix, (size_t[]){2}) == 4 + 5 + 10 + 11);
+    clear_matrix(&result.result_matrix);
+
+    result = reduce_matrix(&tensor, REDUCE_MEAN);
+    assert(result.result_matrix.head_ptr->data_type == TYPE_DOUBLE);
+    assert(*(double*)get_element_by_indices(&result.result_matrix, (size_t[]){0}) == 5.5);
+    clear_matrix(&result.result_matrix);
+    clear_matrix(&tensor);
+
+    // Large float sum on several threads stays accurate
+    set_matrix_thread_count(4);
+    MultiDimensionalMatrix large;
+    size_t count = 1 << 20;
+    create_matrix(&large, 1, &count, TYPE_FLOAT);
+    for (size_t i = 0; i < count; i++) {
+        ((float*)large.head_ptr->data)[i] = 0.1f;
+    }
+
+    result = reduce_matrix(&large, REDUCE_SUM);
+    assert(result.error_code == ERR_NONE);
+    float sum = *(float*)get_element_by_indices(&result.result_matrix, (size_t[]){0});
+    assert(fabs(sum - 0.1 * count) < 1.0);
+    clear_matrix(&result.result_matrix);
+
+    // Infinite elements stay infinite in the compensated per-thread partial results
+    ((float*)large.head_ptr->data)[count / 3] = INFINITY;
+    result = reduce_matrix(&large, REDUCE_SUM);
+    assert(*(float*)get_element_by_indices(&result.result_matrix, (size_t[]){0}) == INFINITY);
+    clear_matrix(&result.result_matrix);
+    clear_matrix(&large);
+    set_matrix_thread_count(0);
+
+    // ... and in the compensated sums over an axis
+    MultiDimensionalMatrix infinite;
+    create_matrix(&infinite, 2, (size_t[]){2, 2}, TYPE_DOUBLE);
+    double infinite_array[2][2] = { {INFINITY, 1}, {1, 1} };
+    fill_matrix_from_static_array(&infinite, infinite_array);
+
+    result = reduce_matrix_axes(&infinite, REDUCE_SUM, 1, (size_t[]){0}, 0);
+    assert(*(double*)get_element_by_indices(&result.result_matrix, (size_t[]){0}) == INFINITY);
+    assert(*(double*)get_element_by_indices(&result.result_matrix, (size_t[]){1}) == 2);
+    clear_matrix(&result.result_matrix);
+    clear_matrix(&infinite);
+
+    // Squares of large integers don't overflow
+    MultiDimensionalMatrix integers;
+    create_matrix(&integers, 1, (size_t[]){2}, TYPE_INT64);
+    int64_t big = 4000000000;
+    set_element_by_indices(&integers, (size_t[]){0}, &big);
+    set_element_by_indices(&integers, (size_t[]){1}, &big);
+
+    result = reduce_matrix(&integers, REDUCE_NORM_L2);
+    assert(result.result_matrix.head_ptr->data_type == TYPE_DOUBLE);
+    assert(fabs(*(double*)get_element_by_indices(&result.result_matrix, (size_t[]){0}) - 4e9 * sqrt(2.0)) < 1.0);
+    clear_matrix(&result.result_matrix);
+
+    // ... and neither does the absolute value of the minimum
+    int64_t smallest = INT64_MIN;
+    set_element_by_indices(&integers, (size_t[]){1}, &smallest);
+
+    result = reduce_matrix(&integers, REDUCE_NORM_L1);
+    assert(*(double*)get_element_by_indices(&result.result_matrix, (size_t[]){0}) == 4e9 + 0x1p63);
+    clear_matrix(&result.result_matrix);
+
+    result = reduce_matrix(&integers, REDUCE_NORM_MAX);
+    assert(*(double*)get_element_by_indices(&result.result_matrix, (size_t[]){0}) == 0x1p63);
+    clear_matrix(&result.result_matrix);
+    clear_matrix(&integers);
+}
+
+void test_multiply_batched_matrices() {
+    // Batch of 2 x 3 (2 x 2) matrices times a single 2 x 2 matrix
+    MultiDimensionalMatrix batch, single;
+    create_matrix(&batch, 4, (size_t[]){2, 3, 2, 2}, TYPE_INT);
+    create_matrix(&single, 2, (size_t[]){2, 2}, TYPE_INT);
+
+    for (int i = 0; i < 24; i++) {
+        ((int*)batch.head_ptr->data)[i] = i;
+    }
+    int single_array[2][2] = { {1, 2}, {3, 4} };
+    fill_matrix_from_static_array(&single, single_array);
+
+    ArithmeticOperationReturn result = multiply_batched_matrices(&batch, &single);
+    assert(result.error_code == ERR_NONE);
+    assert(result.result_matrix.head_ptr->number_of_dimensions == 4);
+    assert(result.result_matrix.head_ptr->dimensions[0] == 2);
+    assert(result.result_matrix.head_ptr->dimensions[1] == 3);
+
+    // Every batch equals the 2-D product
+    for (size_t b0 = 0; b0 < 2; b0++) {
+        for (size_t b1 = 0; b1 < 3; b1++) {
+            MatrixView view, matrix_view, single_view;
+            create_matrix_view(&view, &batch);
+            select_matrix_view_index(&matrix_view, &view, 0, b0);
+            select_matrix_view_index(&matrix_view, &matrix_view, 0, b1);
+            create_matrix_view(&single_view, &single);
+
+            ArithmeticOperationReturn expected = multiply_2d_matrix_views(&matrix_view, &single_view);
+            assert(expected.error_code == ERR_NONE);
+
+            for (size_t i = 0; i < 2; i++) {
+                for (size_t j = 0; j < 2; j++) {
+                    assert(*(int*)get_element_by_indices(&result.result_matrix, (size_t[]){b0, b1, i, j}) ==
+                           *(int*)get_element_by_indices(&expected.result_matrix, (size_t[]){i, j}));
+                }
+            }
+            clear_matrix(&expected.result_matrix);
+        }
+    }
+    clear_matrix(&result.result_matrix);
+
+    // Broadcasted batch-dimensions: (3 x 1 x 2 x 2) * (2 x 2 x 2) -> (3 x 2 x 2 x 2), transposed operand
+    MultiDimensionalMatrix left, right;
+    create_matrix(&left, 4, (size_t[]){3, 1, 2, 2}, TYPE_DOUBLE);
+    create_matrix(&right, 3, (size_t[]){2, 2, 2}, TYPE_DOUBLE);
+    for (size_t i = 0; i < 12; i++) {
+        ((double*)left.head_ptr->data)[i] = (double)i;
+    }
+    for (size_t i = 0; i < 8; i++) {
+        ((double*)right.head_ptr->data)[i] = (double)(i % 3);
+    }
+
+    MatrixView left_view, right_view;
+    create_matrix_view(&left_view, &left);
+    create_matrix_view(&right_view, &right);
+    transpose_matrix_view(&right_view, &right_view);
+
+    set_matrix_thread_count(3);
+    result = multiply_batched_matrix_views(&left_view, &right_view);
+    set_matrix_thread_count(0);
+    assert(result.error_code == ERR_NONE);
+    assert(result.result_matrix.head_ptr->dimensions[0] == 3);
+    assert(result.result_matrix.head_ptr->dimensions[1] == 2);
+
+    for (size_t b0 = 0; b0 < 3; b0++) {
+        for (size_t b1 = 0; b1 < 2; b1++) {
+            for (size_t i = 0; i < 2; i++) {
+                for (size_t j = 0; j < 2; j++) {
+                    double expected = 0;
+                    for (size_t k = 0; k < 2; k++) {
+                        expected += *(double*)get_element_by_indices(&left, (size_t[]){b0, 0, i, k}) *
+                                    *(double*)get_element_by_indices(&right, (size_t[]){b1, j, k});
+                    }
+                    assert(*(double*)get_element_by_indices(&result.result_matrix, (size_t[]){b0, b1, i, j}) == expected);
+                }
+            }
+        }
+    }
+    clear_matrix(&result.result_matrix);
+
+    // Errors
+    assert(multiply_batched_matrices(&batch, &left).error_code == ERR_DATATYPE_MISMATCH);
+    MultiDimensionalMatrix vector;
+    create_matrix(&vector, 1, (size_t[]){2}, TYPE_INT);
+    assert(multiply_batched_matrices(&batch, &vector).error_code == ERR_INVALID_ARGS);
+    MultiDimensionalMatrix wrong;
+    create_matrix(&wrong, 3, (size_t[]){2, 2, 2}, TYPE_INT);
+    assert(multiply_batched_matrices(&batch, &wrong).error_code == ERR_DIMENSION_SIZE_MISMATCH);
+
+    clear_matrix(&batch);
+    clear_matrix(&single);
+    clear_matrix(&left);
+    clear_matrix(&right);
+    clear_matrix(&vector);
+    clear_matrix(&wrong);
+}
+
+void test_strassen_multiplication() {
+    // Odd dimensions exercise the peeling of the last row / column on every level
+    size_t rows = 37, inner = 29, cols = 41;
+    MultiDimensionalMatrix int_A, int_B, double_A, double_B;
+    create_matrix(&int_A, 2, (size_t[]){rows, inner}, TYPE_INT);
+    create_matrix(&int_B, 2, (size_t[]){inner, cols}, TYPE_INT);
+    create_matrix(&double_A, 2, (size_t[]){rows, inner}, TYPE_DOUBLE);
+    create_matrix(&double_B, 2, (size_t[]){inner, cols}, TYPE_DOUBLE);
+
+    for (size_t i = 0; i < rows * inner; i++) {
+        ((int*)int_A.head_ptr->data)[i] = (int)(i % 7) - 3;
+        ((double*)double_A.head_ptr->data)[i] = (double)(i % 11) / 7.0 - 0.5;
+    }
+    for (size_t i = 0; i < inner * cols; i++) {
+        ((int*)int_B.head_ptr->data)[i] = (int)(i % 5) - 2;
+        ((double*)double_B.head_ptr->data)[i] = (double)(i % 13) / 3.0 - 2.0;
+    }
+
+    assert(get_multiplication_algorithm() == MULTIPLICATION_STANDARD);
+    ArithmeticOperationReturn int_expected = multiply_2d_matrices(&int_A, &int_B);
+    ArithmeticOperationReturn double_expected = multiply_2d_matrices(&double_A, &double_B);
+
+    set_multiplication_algorithm(MULTIPLICATION_STRASSEN, 4);
+    assert(get_multiplication_algorithm() == MULTIPLICATION_STRASSEN);
+    assert(get_strassen_cutoff() == 4);
+
+    ArithmeticOperationReturn int_result = multiply_2d_matrices(&int_A, &int_B);
+    ArithmeticOperationReturn double_result = multiply_2d_matrices(&double_A, &double_B);
+    assert(int_result.error_code == ERR_NONE);
+    assert(double_result.error_code == ERR_NONE);
+
+    for (size_t i = 0; i < rows * cols; i++) {
+        // Integer-results are exact
+        assert(((int*)int_result.result_matrix.head_ptr->data)[i] == ((int*)int_expected.result_matrix.head_ptr->data)[i]);
+        assert(fabs(((double*)double_result.result_matrix.head_ptr->data)[i] -
+                    ((double*)double_expected.result_matrix.head_ptr->data)[i]) < 1e-9);
+    }
+
+    // A cutoff of 0 selects the default
+    set_multiplication_algorithm(MULTIPLICATION_STANDARD, 0);
+    assert(get_strassen_cutoff() == DEFAULT_STRASSEN_CUTOFF);
+
+    clear_matrix(&int_result.result_matrix);
+    clear_matrix(&double_result.result_matrix);
+    clear_matrix(&int_expected.result_matrix);
+    clear_matrix(&double_expected.result_matrix);
+    clear_matrix(&int_A);
+    clear_matrix(&int_B);
+    clear_matrix(&double_A);
+    clear_matrix(&double_B);
+}
+
+void test_compact_data_types() {
+    assert(get_data_type_size(TYPE_INT8) == 1 && get_data_type_size(TYPE_UINT8) == 1);
+    assert(get_data_type_size(TYPE_INT16) == 2 && get_data_type_size(TYPE_INT64) == 8);
+    assert(get_data_type_size(TYPE_FP16) == 2 && get_data_type_size(TYPE_BF16) == 2);
+
+    // 16-bit floating point bit-patterns
+    assert(float_to_fp16(1.0f) == 0x3C00 && fp16_to_float(0x3C00) == 1.0f);
+    assert(float_to_fp16(-2.5f) == 0xC100);
+    assert(float_to_fp16(65504.0f) == 0x7BFF && float_to_fp16(65520.0f) == 0x7C00);
+    assert(fp16_to_float(0x0001) == 0x1.0p-24f);                // Smallest subnormal
+    assert(float_to_fp16(1.0f + 0x1.0p-11f) == 0x3C00);          // Tie rounds to even
+    assert(fp16_to_float(float_to_fp16(NAN)) != fp16_to_float(float_to_fp16(NAN)));
+    assert(float_to_bf16(1.0f) == 0x3F80 && bf16_to_float(0xC0A0) == -5.0f);
+    assert(float_to_bf16(1.0f + 0x1.0p-8f) == 0x3F80 && float_to_bf16(1.0f + 0x1.8p-7f) == 0x3F82);
+
+    // Narrow integers wrap around
+    MultiDimensionalMatrix int8_A, int8_B;
+    create_matrix(&int8_A, 2, (size_t[]){2, 2}, TYPE_INT8);
+    create_matrix(&int8_B, 2, (size_t[]){2, 2}, TYPE_INT8);
+    int8_t int8_values[2][2] = { {100, -3}, {7, 1} };
+    assert(fill_matrix_from_static_array(&int8_A, int8_values) == ERR_NONE);
+    assert(fill_matrix_from_static_array(&int8_B, int8_values) == ERR_NONE);
+    assert(*(int8_t*)get_element_by_indices(&int8_A, (size_t[]){0, 1}) == -3);
+
+    ArithmeticOperationReturn result = add_matrices(&int8_A, &int8_B);
+    assert(result.error_code == ERR_NONE);
+    assert(result.result_matrix.head_ptr->data_type == TYPE_INT8);
+    assert(*(int8_t*)get_element_by_indices(&result.result_matrix, (size_t[]){0, 0}) == -56);
+    assert(*(int8_t*)get_element_by_indices(&result.result_matrix, (size_t[]){0, 1}) == -6);
+    clear_matrix(&result.result_matrix);
+
+    // [[100, -3], [7, 1]]^2 = [[9979, -303], [707, -20]]
+    result = multiply_2d_matrices(&int8_A, &int8_B);
+    assert(result.error_code == ERR_NONE);
+    assert(*(int8_t*)get_element_by_indices(&result.result_matrix, (size_t[]){0, 0}) == (int8_t)9979);
+    assert(*(int8_t*)get_element_by_indices(&result.result_matrix, (size_t[]){1, 1}) == -20);
+    clear_matrix(&result.result_matrix);
+
+    uint8_t uint8_scalar = 2;
+    MultiDimensionalMatrix uint8_matrix;
+    create_matrix(&uint8_matrix, 1, (size_t[]){3}, TYPE_UINT8);
+    fill_matrix_from_static_array(&uint8_matrix, (uint8_t[]){200, 3, 255});
+    result = scalar_multiply_matrix(&uint8_matrix, &uint8_scalar);
+    assert(result.error_code == ERR_NONE);
+    assert(((uint8_t*)result.result_matrix.head_ptr->data)[0] == 144);
+    assert(((uint8_t*)result.result_matrix.head_ptr->data)[2] == 254);
+    clear_matrix(&result.result_matrix);
+
+    // Reductions: integer sums are 64 bit, minimum/maximum keep the type
+    result = reduce_matrix(&uint8_matrix, REDUCE_SUM);
+    assert(result.result_matrix.head_ptr->data_type == TYPE_INT64);
+    assert(*(int64_t*)result.result_matrix.head_ptr->data == 458);
+    clear_matrix(&result.result_matrix);
+    result = reduce_matrix(&uint8_matrix, REDUCE_MAX);
+    assert(result.result_matrix.head_ptr->data_type == TYPE_UINT8);
+    assert(*(uint8_t*)result.result_matrix.head_ptr->data == 255);
+    clear_matrix(&result.result_matrix);
+
+    // 64-bit integers
+    MultiDimensionalMatrix int64_matrix;
+    create_matrix(&int64_matrix, 1, (size_t[]){2}, TYPE_INT64);
+    int64_t big = (int64_t)1 << 40;
+    set_element_by_indices(&int64_matrix, (size_t[]){0}, &big);
+    set_element_by_indices(&int64_matrix, (size_t[]){1}, &big);
+    result = add_matrices(&int64_matrix, &int64_matrix);
+    assert(((int64_t*)result.result_matrix.head_ptr->data)[1] == (int64_t)1 << 41);
+    clear_matrix(&result.result_matrix);
+
+    // Conversions between integer types wrap, or saturate on request
+    MultiDimensionalMatrix wrapped, saturated;
+    create_matrix(&wrapped, 1, (size_t[]){2}, TYPE_INT64);
+    create_matrix(&saturated, 1, (size_t[]){2}, TYPE_INT64);
+    fill_matrix_from_static_array(&wrapped, (int64_t[]){300, -40000});
+    fill_matrix_from_static_array(&saturated, (int64_t[]){300, -40000});
+    assert(change_data_type(&wrapped, TYPE_INT8) == ERR_NONE);
+    assert(convert_matrix_data_type(&saturated, TYPE_INT16, ROUND_TOWARD_ZERO, 1) == ERR_NONE);
+    assert(((int8_t*)wrapped.head_ptr->data)[0] == 44);
+    assert(((int16_t*)saturated.head_ptr->data)[0] == 300 && ((int16_t*)saturated.head_ptr->data)[1] == INT16_MIN);
+    assert(change_data_type(&saturated, TYPE_DOUBLE) == ERR_NONE);
+    assert(((double*)saturated.head_ptr->data)[1] == INT16_MIN);
+
+    // Floating point to integer types always saturate
+    MultiDimensionalMatrix rounded;
+    create_matrix(&rounded, 1, (size_t[]){4}, TYPE_DOUBLE);
+    fill_matrix_from_static_array(&rounded, (double[]){300.7, -5.0, 2.5, NAN});
+    assert(convert_matrix_data_type(&rounded, TYPE_UINT8, ROUND_TO_NEAREST, 0) == ERR_NONE);
+    assert(memcmp(rounded.head_ptr->data, (uint8_t[]){255, 0, 2, 0}, 4) == 0);
+    assert(rounded.head_ptr->data_size == 4);
+
+    // Half precision: larger than one conversion-block, with and without saturation
+    size_t count = 1500;
+    MultiDimensionalMatrix half, half_saturated;
+    create_matrix(&half, 1, (size_t[]){count}, TYPE_FLOAT);
+    create_matrix(&half_saturated, 1, (size_t[]){count}, TYPE_FLOAT);
+    for (size_t i = 0; i < count; i++) {
+        float value = i == 0 ? 1e6f : (float)i * 0.25f - 100.0f;
+        ((float*)half.head_ptr->data)[i] = value;
+        ((float*)half_saturated.head_ptr->data)[i] = value;
+    }
+    assert(change_data_type(&half, TYPE_FP16) == ERR_NONE);
+    assert(convert_matrix_data_type(&half_saturated, TYPE_FP16, ROUND_TOWARD_ZERO, 1) == ERR_NONE);
+    assert(((fp16_t*)half.head_ptr->data)[0] == 0x7C00);
+    assert(((fp16_t*)half_saturated.head_ptr->data)[0] == 0x7BFF);
+    for (size_t i = 1; i < count; i++) {
+        assert(fp16_to_float(((fp16_t*)half.head_ptr->data)[i]) == (float)i * 0.25f - 100.0f);
+    }
+    assert(change_data_type(&half_saturated, TYPE_BF16) == ERR_NONE);
+    assert(bf16_to_float(((bf16_t*)half_saturated.head_ptr->data)[2]) == -99.5f);
+    assert(convert_matrix_data_type(&half_saturated, TYPE_INT16, ROUND_DOWN, 0) == ERR_NONE);
+    assert(((int16_t*)half_saturated.head_ptr->data)[0] == INT16_MAX);     // 65504 became 65536 in bfloat16
+    assert(((int16_t*)half_saturated.head_ptr->data)[2] == -100);
+
+    // Half precision arithmetic is computed in `float`
+    size_t n = 20;
+    MultiDimensionalMatrix fp16_A, float_A;
+    create_matrix(&fp16_A, 2, (size_t[]){n, n}, TYPE_FP16);
+    create_matrix(&float_A, 2, (size_t[]){n, n}, TYPE_FLOAT);
+    for (size_t i = 0; i < n * n; i++) {
+        float value = (float)(i % 9) * 0.125f - 0.5f;
+        ((fp16_t*)fp16_A.head_ptr->data)[i] = float_to_fp16(value);
+        ((float*)float_A.head_ptr->data)[i] = value;
+    }
+
+    ArithmeticOperationReturn fp16_product = multiply_2d_matrices(&fp16_A, &fp16_A);
+    ArithmeticOperationReturn float_product = multiply_2d_matrices(&float_A, &float_A);
+    assert(fp16_product.error_code == ERR_NONE);
+    assert(fp16_product.result_matrix.head_ptr->data_type == TYPE_FP16);
+    for (size_t i = 0; i < n * n; i++) {
+        float expected = ((float*)float_product.result_matrix.head_ptr->data)[i];
+        assert(fabs(fp16_to_float(((fp16_t*)fp16_product.result_matrix.head_ptr->data)[i]) - expected) <= fabs(expected) * 0x1.0p-11 + 1e-6);
+    }
+    clear_matrix(&fp16_product.result_matrix);
+    clear_matrix(&float_product.result_matrix);
+
+    result = reduce_matrix(&fp16_A, REDUCE_MEAN);
+    assert(result.result_matrix.head_ptr->data_type == TYPE_FLOAT);
+    clear_matrix(&result.result_matrix);
+
+    // bfloat16 in a fused expression: (A + A) * 0.5
+    assert(change_data_type(&fp16_A, TYPE_BF16) == ERR_NONE);
+    MatrixExpression expression;
+    init_matrix_expression(&expression);
+    size_t a = expression_input(&expression, &fp16_A);
+    size_t root = expression_multiply(&expression, expression_add(&expression, a, a), expression_scalar(&expression, 0.5));
+    result = evaluate_matrix_expression(&expression, root);
+    assert(result.error_code == ERR_NONE);
+    assert(memcmp(result.result_matrix.head_ptr->data, fp16_A.head_ptr->data, fp16_A.head_ptr->data_size) == 0);
+    clear_matrix(&result.result_matrix);
+
+    // Strassen-Winograd over wrapping integers gives the same result as the standard kernel
+    MultiDimensionalMatrix int16_matrix;
+    create_matrix(&int16_matrix, 2, (size_t[]){n, n}, TYPE_INT16);
+    for (size_t i = 0; i < n * n; i++) {
+        ((int16_t*)int16_matrix.head_ptr->data)[i] = (int16_t)(i * 2654435761u);
+    }
+    ArithmeticOperationReturn expected = multiply_2d_matrices(&int16_matrix, &int16_matrix);
+    set_multiplication_algorithm(MULTIPLICATION_STRASSEN, 4);
+    result = multiply_2d_matrices(&int16_matrix, &int16_matrix);
+    set_multiplication_algorithm(MULTIPLICATION_STANDARD, 0);
+    assert(result.error_code == ERR_NONE);
+    assert(memcmp(result.result_matrix.head_ptr->data, expected.result_matrix.head_ptr->data, n * n * sizeof(int16_t)) == 0);
+    clear_matrix(&result.result_matrix);
+    clear_matrix(&expected.result_matrix);
+
+    clear_matrix(&int8_A);
+    clear_matrix(&int8_B);
+    clear_matrix(&uint8_matrix);
+    clear_matrix(&int64_matrix);
+    clear_matrix(&wrapped);
+    clear_matrix(&saturated);
+    clear_matrix(&rounded);
+    clear_matrix(&half);
+    clear_matrix(&half_saturated);
+    clear_matrix(&fp16_A);
+    clear_matrix(&float_A);
+    clear_matrix(&int16_matrix);
+}
+
+void test_mixed_precision_multiplication() {
+    // int8 x int8 -> TYPE_INT: the products do not wrap around
+    size_t n = 20;
+    MultiDimensionalMatrix int8_A, int8_B, int_A, int_B;
+    create_matrix(&int8_A, 2, (size_t[]){n, n}, TYPE_INT8);
+    create_matrix(&int8_B, 2, (size_t[]){n, n}, TYPE_INT8);
+    create_matrix(&int_A, 2, (size_t[]){n, n}, TYPE_INT);
+    create_matrix(&int_B, 2, (size_t[]){n, n}, TYPE_INT);
+    for (size_t i = 0; i < n * n; i++) {
+        int8_t a = (int8_t)(i * 37 + 100), b = (int8_t)(i * 91 - 128);
+        ((int8_t*)int8_A.head_ptr->data)[i] = a;
+        ((int8_t*)int8_B.head_ptr->data)[i] = b;
+        ((int*)int_A.head_ptr->data)[i] = a;
+        ((int*)int_B.head_ptr->data)[i] = b;
+    }
+
+    ArithmeticOperationReturn result = multiply_2d_matrices_mixed(&int8_A, &int8_B, TYPE_INT);
+    ArithmeticOperationReturn expected = multiply_2d_matrices(&int_A, &int_B);
+    assert(result.error_code == ERR_NONE);
+    assert(result.result_matrix.head_ptr->data_type == TYPE_INT);
+    assert(memcmp(result.result_matrix.head_ptr->data, expected.result_matrix.head_ptr->data, n * n * sizeof(int)) == 0);
+    clear_matrix(&result.result_matrix);
+    clear_matrix(&expected.result_matrix);
+
+    // Strided operand: A * B^T
+    MatrixView view_A, view_B, transposed;
+    create_matrix_view(&view_A, &int8_A);
+    create_matrix_view(&view_B, &int8_B);
+    transpose_matrix_view(&transposed, &view_B);
+    result = multiply_2d_matrix_views_mixed(&view_A, &transposed, TYPE_INT64);
+    assert(result.error_code == ERR_NONE);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            int64_t sum = 0;
+            for (size_t k = 0; k < n; k++) {
+                sum += ((int*)int_A.head_ptr->data)[i * n + k] * ((int*)int_B.head_ptr->data)[j * n + k];
+            }
+            assert(((int64_t*)result.result_matrix.head_ptr->data)[i * n + j] == sum);
+        }
+    }
+    clear_matrix(&result.result_matrix);
+
+    // Long uint8 dot-product: beyond the range of `int32_t`, exact in TYPE_INT64, saturated in TYPE_INT
+    size_t length = 40000;
+    MultiDimensionalMatrix row, column;
+    create_matrix(&row, 2, (size_t[]){1, length}, TYPE_UINT8);
+    create_matrix(&column, 2, (size_t[]){length, 1}, TYPE_UINT8);
+    memset(row.head_ptr->data, 255, length);
+    memset(column.head_ptr->data, 255, length);
+    result = multiply_2d_matrices_mixed(&row, &column, TYPE_INT64);
+    assert(result.error_code == ERR_NONE);
+    assert(*(int64_t*)result.result_matrix.head_ptr->data == (int64_t)length * 255 * 255);
+    clear_matrix(&result.result_matrix);
+    result = multiply_2d_matrices_mixed(&row, &column, TYPE_INT);
+    assert(*(int*)result.result_matrix.head_ptr->data == INT_MAX);
+    clear_matrix(&result.result_matrix);
+
+    // float x float -> TYPE_FLOAT, accumulated in double: 1e8 + 1 - 1e8 keeps the 1
+    MultiDimensionalMatrix float_A, float_B;
+    create_matrix(&float_A, 2, (size_t[]){1, 3}, TYPE_FLOAT);
+    create_matrix(&float_B, 2, (size_t[]){3, 1}, TYPE_FLOAT);
+    fill_matrix_from_static_array(&float_A, (float[]){1e8f, 1.0f, -1e8f});
+    fill_matrix_from_static_array(&float_B, (float[]){1.0f, 1.0f, 1.0f});
+    result = multiply_2d_matrices_mixed(&float_A, &float_B, TYPE_FLOAT);
+    assert(result.error_code == ERR_NONE);
+    assert(*(float*)result.result_matrix.head_ptr->data == 1.0f);
+    clear_matrix(&result.result_matrix);
+
+    // fp16 x fp16 -> TYPE_FLOAT
+    MultiDimensionalMatrix fp16_A;
+    create_matrix(&fp16_A, 2, (size_t[]){n, n}, TYPE_FP16);
+    for (size_t i = 0; i < n * n; i++) {
+        ((fp16_t*)fp16_A.head_ptr->data)[i] = float_to_fp16((float)(i % 13) * 0.25f - 1.5f);
+    }
+    result = multiply_2d_matrices_mixed(&fp16_A, &fp16_A, TYPE_FLOAT);
+    assert(result.error_code == ERR_NONE);
+    assert(result.result_matrix.head_ptr->data_type == TYPE_FLOAT);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            float sum = 0;
+            for (size_t k = 0; k < n; k++) {
+                sum += fp16_to_float(((fp16_t*)fp16_A.head_ptr->data)[i * n + k]) * fp16_to_float(((fp16_t*)fp16_A.head_ptr->data)[k * n + j]);
+            }
+            // Multiples of 1/16 are summed exactly
+            assert(((float*)result.result_matrix.head_ptr->data)[i * n + j] == sum);
+        }
+    }
+    clear_matrix(&result.result_matrix);
+
+    // Different input data-types
+    result = multiply_2d_matrices_mixed(&int8_A, &int_B, TYPE_INT);
+    assert(result.error_code == ERR_INVALID_ARGS);
+
+    clear_matrix(&int8_A);
+    clear_matrix(&int8_B);
+    clear_matrix(&int_A);
+    clear_matrix(&int_B);
+    clear_matrix(&row);
+    clear_matrix(&column);
+    clear_matrix(&float_A);
+    clear_matrix(&float_B);
+    clear_matrix(&fp16_A);
+}
+
+// Reverse the bytes of `count` values with `size` bytes each.
+static void reverse_value_bytes(unsigned char* bytes, size_t count, size_t size) {
+    for (size_t i = 0; i < count; i++, bytes += size) {
+        for (size_t low = 0, high = size - 1; low < high; low++, high--) {
+            unsigned char byte = bytes[low];
+            bytes[low] = bytes[high];
+            bytes[high] = byte;
+        }
+    }
+}
+
+void test_matrix_files() {
+    const char* path = "test_matrix_file.bin";
+    MultiDimensionalMatrix matrix, loaded, mapped;
+    float values[3][4] = {
+        {1.5f, -2.0f, 3.25f, 4.0f},
+        {5.0f, 6.5f, -7.0f, 8.0f},
+        {9.0f, 10.0f, 11.0f, -12.75f}
+    };
+    create_matrix(&matrix, 2, (size_t[]){3, 4}, TYPE_FLOAT);
+    fill_matrix_from_static_array(&matrix, values);
+
+    assert(save_matrix(&matrix, path) == ERR_NONE);
+
+    // Read into memory
+    assert(load_matrix(&loaded, path) == ERR_NONE);
+    assert(loaded.head_ptr->storage == STORAGE_HEAP);
+    assert(loaded.head_ptr->data_type == TYPE_FLOAT);
+    assert(loaded.head_ptr->number_of_dimensions == 2);
+    assert(loaded.head_ptr->dimensions[0] == 3 && loaded.head_ptr->dimensions[1] == 4);
+    assert(memcmp(loaded.head_ptr->data, values, sizeof(values)) == 0);
+    clear_matrix(&loaded);
+
+    // Read-only mapping: the data is used in place
+    assert(open_matrix_mmap(&mapped, path, STORAGE_MAPPED_READ_ONLY) == ERR_NONE);
+    assert(mapped.head_ptr->storage == STORAGE_MAPPED_READ_ONLY);
+    assert((size_t)((char*)mapped.head_ptr->data - (char*)mapped.head_ptr->mapping) == MATRIX_FILE_ALIGNMENT);
+    assert(memcmp(mapped.head_ptr->data, values, sizeof(values)) == 0);
+    float value = 100.0f;
+    assert(set_element_by_indices(&mapped, (size_t[]){0, 0}, &value) == ERR_READ_ONLY);
+
+    ArithmeticOperationReturn result = add_matrices(&mapped, &matrix);
+    assert(result.error_code == ERR_NONE);
+    assert(((float*)result.result_matrix.head_ptr->data)[11] == -25.5f);
+    clear_matrix(&result.result_matrix);
+
+    // Growing copies the elements into memory
+    assert(resize_matrix(&mapped, 2, (size_t[]){4, 4}) == ERR_NONE);
+    assert(mapped.head_ptr->storage == STORAGE_HEAP);
+    assert(memcmp(mapped.head_ptr->data, values, sizeof(values)) == 0);
+    assert(set_element_by_indices(&mapped, (size_t[]){3, 3}, &value) == ERR_NONE);
+    clear_matrix(&mapped);
+
+    // Copy-on-write mapping: changes don't reach the file
+    assert(open_matrix_mmap(&mapped, path, STORAGE_MAPPED_PRIVATE) == ERR_NONE);
+    assert(set_element_by_indices(&mapped, (size_t[]){0, 0}, &value) == ERR_NONE);
+    assert(*(float*)get_element_by_indices(&mapped, (size_t[]){0, 0}) == 100.0f);
+    assert(convert_matrix_data_type(&mapped, TYPE_INT, ROUND_TO_NEAREST, 0) == ERR_NONE);
+    assert(mapped.head_ptr->storage == STORAGE_HEAP);
+    assert(((int*)mapped.head_ptr->data)[0] == 100 && ((int*)mapped.head_ptr->data)[2] == 3);
+    clear_matrix(&mapped);
+
+    assert(load_matrix(&loaded, path) == ERR_NONE);
+    assert(memcmp(loaded.head_ptr->data, values, sizeof(values)) == 0);
+    clear_matrix(&loaded);
+
+    // File of a machine with the other byte-order
+    FILE* file = fopen(path, "rb");
+    unsigned char bytes[MATRIX_FILE_ALIGNMENT + sizeof(values)];
+    assert(fread(bytes, 1, sizeof(bytes), file) == sizeof(bytes));
+    fclose(file);
+
+    reverse_value_bytes(bytes + 8, 4, sizeof(uint32_t));
+    reverse_value_bytes(bytes + 24, 4 + 2, sizeof(uint64_t));
+    reverse_value_bytes(bytes + MATRIX_FILE_ALIGNMENT, 12, sizeof(float));
+
+    file = fopen(path, "wb");
+    assert(fwrite(bytes, 1, sizeof(bytes), file) == sizeof(bytes));
+    fclose(file);
+
+    assert(load_matrix(&loaded, path) == ERR_NONE);
+    assert(loaded.head_ptr->dimensions[0] == 3 && loaded.head_ptr->dimensions[1] == 4);
+    assert(memcmp(loaded.head_ptr->data, values, sizeof(values)) == 0);
+    clear_matrix(&loaded);
+    assert(open_matrix_mmap(&mapped, path, STORAGE_MAPPED_READ_ONLY) == ERR_INVALID_FILE_FORMAT);
+
+    // Damaged and missing files
+    bytes[0] = 'X';
+    file = fopen(path, "wb");
+    assert(fwrite(bytes, 1, 100, file) == 100);
+    fclose(file);
+    assert(load_matrix(&loaded, path) == ERR_INVALID_FILE_FORMAT);
+    assert(open_matrix_mmap(&mapped, path, STORAGE_MAPPED_READ_ONLY) == ERR_INVALID_FILE_FORMAT);
+
+    remove(path);
+    assert(load_matrix(&loaded, path) == ERR_FILE_IO);
+    assert(open_matrix_mmap(&mapped, path, STORAGE_MAPPED_READ_ONLY) == ERR_FILE_IO);
+
+    clear_matrix(&matrix);
+}
+
+void test_out_of_core_multiplication() {
+    const char* path_A = "test_matrix_A.bin";
+    const char* path_B = "test_matrix_B.bin";
+    const char* path_C = "test_matrix_C.bin";
+
+    // Tiles of 10 x 10 elements: uneven tiles at the borders of every dimension
+    size_t rows = 37, inner = 53, cols = 29;
+    size_t budget = 7 * 10 * 10 * sizeof(int);
+    MultiDimensionalMatrix matrix_A, matrix_B, loaded;
+    create_matrix(&matrix_A, 2, (size_t[]){rows, inner}, TYPE_INT);
+    create_matrix(&matrix_B, 2, (size_t[]){inner, cols}, TYPE_INT);
+    for (size_t i = 0; i < rows * inner; i++) {
+        ((int*)matrix_A.head_ptr->data)[i] = (int)(i * 7 % 23) - 11;
+    }
+    for (size_t i = 0; i < inner * cols; i++) {
+        ((int*)matrix_B.head_ptr->data)[i] = (int)(i * 5 % 17) - 8;
+    }
+    assert(save_matrix(&matrix_A, path_A) == ERR_NONE);
+    assert(save_matrix(&matrix_B, path_B) == ERR_NONE);
+
+    assert(multiply_matrix_files(path_A, path_B, path_C, budget) == ERR_NONE);
+    ArithmeticOperationReturn expected = multiply_2d_matrices(&matrix_A, &matrix_B);
+    assert(load_matrix(&loaded, path_C) == ERR_NONE);
+    assert(loaded.head_ptr->dimensions[0] == rows && loaded.head_ptr->dimensions[1] == cols);
+    assert(memcmp(loaded.head_ptr->data, expected.result_matrix.head_ptr->data, rows * cols * sizeof(int)) == 0);
+    clear_matrix(&loaded);
+    clear_matrix(&expected.result_matrix);
+
+    // Floating point: the same up to the order of the summation
+    assert(change_data_type(&matrix_A, TYPE_DOUBLE) == ERR_NONE);
+    assert(change_data_type(&matrix_B, TYPE_DOUBLE) == ERR_NONE);
+    for (size_t i = 0; i < rows * inner; i++) {
+        ((double*)matrix_A.head_ptr->data)[i] *= 0.1;
+    }
+    assert(save_matrix(&matrix_A, path_A) == ERR_NONE);
+    assert(save_matrix(&matrix_B, path_B) == ERR_NONE);
+
+    assert(multiply_matrix_files(path_A, path_B, path_C, budget) == ERR_NONE);
+    expected = multiply_2d_matrices(&matrix_A, &matrix_B);
+    assert(load_matrix(&loaded, path_C) == ERR_NONE);
+    for (size_t i = 0; i < rows * cols; i++) {
+        assert(fabs(((double*)loaded.head_ptr->data)[i] - ((double*)expected.result_matrix.head_ptr->data)[i]) < 1e-9);
+    }
+    clear_matrix(&loaded);
+    clear_matrix(&expected.result_matrix);
+
+    // Whole matrices in one tile (default budget)
+    assert(multiply_matrix_files(path_A, path_B, path_C, 0) == ERR_NONE);
+    assert(load_matrix(&loaded, path_C) == ERR_NONE);
+    clear_matrix(&loaded);
+
+    // Errors
+    assert(multiply_matrix_files(path_A, path_A, path_C, budget) == ERR_DIMENSION_SIZE_MISMATCH);
+    assert(multiply_matrix_files(path_A, path_B, path_C, 6 * sizeof(double)) == ERR_INVALID_ARGS);
+
+    // The result must not overwrite an operand
+    assert(multiply_matrix_files(path_A, path_B, path_A, budget) == ERR_INVALID_ARGS);
+    assert(multiply_matrix_files(path_A, path_B, path_B, budget) == ERR_INVALID_ARGS);
+    assert(multiply_matrix_files(path_A, path_B, "./test_matrix_A.bin", budget) == ERR_INVALID_ARGS);
+    assert(load_matrix(&loaded, path_A) == ERR_NONE);
+    assert(memcmp(loaded.head_ptr->data, matrix_A.head_ptr->data, matrix_A.head_ptr->data_size) == 0);
+    clear_matrix(&loaded);
+
+    assert(change_data_type(&matrix_B, TYPE_FLOAT) == ERR_NONE);
+    assert(save_matrix(&matrix_B, path_B) == ERR_NONE);
+    assert(multiply_matrix_files(path_A, path_B, path_C, budget) == ERR_DATATYPE_MISMATCH);
+
+    remove(path_A);
+    remove(path_B);
+    remove(path_C);
+    assert(multiply_matrix_files(path_A, path_B, path_C, budget) == ERR_FILE_IO);
+
+    clear_matrix(&matrix_A);
+    clear_matrix(&matrix_B);
+}
+
+void test_element_batches() {
+    MultiDimensionalMatrix matrix;
+    create_matrix(&matrix, 3, (size_t[]){3, 4, 5}, TYPE_INT);
+    for (size_t i = 0; i < 60; i++) {
+        ((int*)matrix.head_ptr->data)[i] = (int)i;
+    }
+    assert(matrix.head_ptr->strides[0] == 20 && matrix.head_ptr->strides[1] == 5 && matrix.head_ptr->strides[2] == 1);
+
+    // Every index is checked against its own dimension
+    assert(*(int*)get_element_by_indices(&matrix, (size_t[]){2, 3, 4}) == 59);
+    assert(get_element_by_indices(&matrix, (size_t[]){0, 4, 0}) == NULL);
+    int value = -1;
+    assert(set_element_by_indices(&matrix, (size_t[]){0, 0, 5}, &value) == ERR_INVALID_INDEX);
+
+    // Coordinate-tuples, more than one block
+    size_t count = 600;
+    size_t* indices = malloc(count * 3 * sizeof(size_t));
+    size_t* linear_indices = malloc(count * sizeof(size_t));
+    int* values = malloc(count * sizeof(int));
+    for (size_t i = 0; i < count; i++) {
+        size_t linear = i * 37 % 60;
+        indices[3 * i] = linear / 20;
+        indices[3 * i + 1] = linear / 5 % 4;
+        indices[3 * i + 2] = linear % 5;
+        linear_indices[i] = linear;
+    }
+
+    assert(gather_elements_by_indices(&matrix, indices, count, values) == ERR_NONE);
+    for (size_t i = 0; i < count; i++) {
+        assert(values[i] == (int)linear_indices[i]);
+    }
+    memset(values, 0, count * sizeof(int));
+    assert(gather_elements_by_linear_indices(&matrix, linear_indices, count, values) == ERR_NONE);
+    for (size_t i = 0; i < count; i++) {
+        assert(values[i] == (int)linear_indices[i]);
+    }
+
+    // Scatter: negated values at the same positions (repeated positions get the same value)
+    for (size_t i = 0; i < count; i++) {
+        values[i] = -(int)linear_indices[i];
+    }
+    assert(scatter_elements_by_indices(&matrix, indices, count, values) == ERR_NONE);
+    for (size_t i = 0; i < 60; i++) {
+        assert(((int*)matrix.head_ptr->data)[i] == -(int)i);
+    }
+    assert(scatter_elements_by_linear_indices(&matrix, linear_indices, 2, (int[]){7, 8}) == ERR_NONE);
+    assert(((int*)matrix.head_ptr->data)[0] == 7 && ((int*)matrix.head_ptr->data)[37] == 8);
+
+    // One invalid index: nothing is written
+    indices[3 * 100 + 1] = 4;
+    assert(scatter_elements_by_indices(&matrix, indices, count, values) == ERR_INVALID_INDEX);
+    assert(((int*)matrix.head_ptr->data)[0] == 7);
+    linear_indices[5] = 60;
+    assert(gather_elements_by_linear_indices(&matrix, linear_indices, count, values) == ERR_INVALID_INDEX);
+
+    // Strides follow the shape
+    assert(resize_matrix(&matrix, 2, (size_t[]){6, 10}) == ERR_NONE);
+    assert(matrix.head_ptr->strides[0] == 10 && matrix.head_ptr->strides[1] == 1);
+    assert(gather_elements_by_indices(&matrix, (size_t[]){5, 9, 3, 7}, 2, values) == ERR_NONE);
+    assert(values[0] == -59 && values[1] == 8);
+
+    // 2-byte elements
+    MultiDimensionalMatrix half;
+    create_matrix(&half, 2, (size_t[]){2, 2}, TYPE_FP16);
+    fp16_t halves[] = { float_to_fp16(1.0f), float_to_fp16(-2.0f) };
+    assert(scatter_elements_by_indices(&half, (size_t[]){1, 1, 0, 1}, 2, halves) == ERR_NONE);
+    assert(fp16_to_float(*(fp16_t*)get_element_by_indices(&half, (size_t[]){1, 1})) == 1.0f);
+    assert(fp16_to_float(((fp16_t*)half.head_ptr->data)[1]) == -2.0f);
+
+    free(indices);
+    free(linear_indices);
+    free(values);
+    clear_matrix(&matrix);
+    clear_matrix(&half);
+}
+
+// Writes `1000 * i + 10 * j + k`, checks that runs stay within one row
+static void fill_coordinates(void* elements, size_t count, const size_t* indices, void* context) {
+    assert(indices[2] + count <= *(size_t*)context);
+    for (size_t k = 0; k < count; k++) {
+        ((int*)elements)[k] = (int)(1000 * indices[0] + 10 * indices[1] + indices[2] + k);
+    }
+}
+
+void test_bulk_fill() {
+    // Large enough to be split over several threads
+    size_t rows = 300, cols = 500;
+    MultiDimensionalMatrix matrix;
+    create_matrix(&matrix, 2, (size_t[]){rows, cols}, TYPE_INT);
+    int* data = (int*)matrix.head_ptr->data;
+
+    int value = 7;
+    assert(fill_matrix_with_value(&matrix, &value) == ERR_NONE);
+    for (size_t i = 0; i < rows * cols; i++) {
+        assert(data[i] == 7);
+    }
+    value = -1;
+    assert(fill_matrix_with_value(&matrix, &value) == ERR_NONE);
+    assert(data[0] == -1 && data[rows * cols - 1] == -1);
+    assert(fill_matrix_with_value(&matrix, NULL) == ERR_NULL_PTR);
+
+    // Transposed source: element (i, j) is `source[j * rows + i]`
+    int* source = malloc(rows * cols * sizeof(int));
+    for (size_t i = 0; i < rows * cols; i++) {
+        source[i] = (int)i;
+    }
+    assert(fill_matrix_from_array(&matrix, source, TYPE_INT, (size_t[]){1, rows}) == ERR_NONE);
+    for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols; j++) {
+            assert(data[i * cols + j] == (int)(j * rows + i));
+        }
+    }
+
+    // Contiguous, converted like a C-cast
+    double* values = malloc(rows * cols * sizeof(double));
+    for (size_t i = 0; i < rows * cols; i++) {
+        values[i] = (i % 2 ? -1.0 : 1.0) * ((double)i + 0.75);
+    }
+    assert(fill_matrix_from_array(&matrix, values, TYPE_DOUBLE, NULL) == ERR_NONE);
+    for (size_t i = 0; i < rows * cols; i++) {
+        assert(data[i] == (int)values[i]);
+    }
+    assert(fill_matrix_from_array(&matrix, NULL, TYPE_DOUBLE, NULL) == ERR_NULL_PTR);
+
+    // Strided and converted: every second column of the source
+    MultiDimensionalMatrix doubles;
+    create_matrix(&doubles, 2, (size_t[]){rows, cols / 2}, TYPE_DOUBLE);
+    assert(fill_matrix_from_array(&doubles, source, TYPE_INT, (size_t[]){cols, 2}) == ERR_NONE);
+    for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols / 2; j++) {
+            assert(((double*)doubles.head_ptr->data)[i * (cols / 2) + j] == (double)(i * cols + 2 * j));
+        }
+    }
+
+    // Broadcast a row (stride 0) of 16-bit floats
+    fp16_t row[250];
+    for (size_t j = 0; j < 250; j++) {
+        row[j] = float_to_fp16((float)j * 0.5f);
+    }
+    assert(fill_matrix_from_array(&doubles, row, TYPE_FP16, (size_t[]){0, 1}) == ERR_NONE);
+    assert(((double*)doubles.head_ptr->data)[299 * 250 + 249] == 124.5);
+
+    // Function of the coordinates
+    MultiDimensionalMatrix cube;
+    size_t last_dimension = 60;
+    create_matrix(&cube, 3, (size_t[]){40, 50, last_dimension}, TYPE_INT);
+    assert(fill_matrix_from_function(&cube, fill_coordinates, &last_dimension) == ERR_NONE);
+    for (size_t i = 0; i < 40; i++) {
+        for (size_t j = 0; j < 50; j++) {
+            for (size_t k = 0; k < 60; k++) {
+                assert(*(int*)get_element_by_indices(&cube, (size_t[]){i, j, k}) == (int)(1000 * i + 10 * j + k));
+            }
+        }
+    }
+    assert(fill_matrix_from_function(&cube, NULL, NULL) == ERR_NULL_PTR);
+
+    free(source);
+    free(values);
+    clear_matrix(&matrix);
+    clear_matrix(&doubles);
+    clear_matrix(&cube);
+}
+
+// Fills the matrix with its linear indices (as the data-type of the matrix)
+static void fill_with_linear_indices(MultiDimensionalMatrix* matrix) {
+    size_t count = 1;
+    for (size_t i = 0; i < matrix->head_ptr->number_of_dimensions; i++) {
+        count *= matrix->head_ptr->dimensions[i];
+    }
+    double* values = malloc(count * sizeof(double));
+    for (size_t i = 0; i < count; i++) {
+        values[i] = (double)(i % 251);
+    }
+    assert(fill_matrix_from_array(matrix, values, TYPE_DOUBLE, NULL) == ERR_NONE);
+    free(values);
+}
+
+void test_blocked_transpose() {
+    // Shapes, which aren't multiples of the tiles, in every element-size
+    DataType data_types[] = { TYPE_UINT8, TYPE_FP16, TYPE_FLOAT, TYPE_DOUBLE };
+    size_t shapes[][2] = { {37, 53}, {300, 500}, {1, 9}, {9, 8} };
+
+    for (size_t t = 0; t < 4; t++) {
+        for (size_t s = 0; s < 4; s++) {
+            size_t rows = shapes[s][0], cols = shapes[s][1];
+            MultiDimensionalMatrix matrix;
+            create_matrix(&matrix, 2, (size_t[]){rows, cols}, data_types[t]);
+            fill_with_linear_indices(&matrix);
+            size_t element_size = get_data_type_size(data_types[t]);
+
+            ArithmeticOperationReturn transposed = transpose_matrix(&matrix);
+            assert(transposed.error_code == ERR_NONE);
+            assert(transposed.result_matrix.head_ptr->dimensions[0] == cols);
+            for (size_t i = 0; i < rows; i++) {
+                for (size_t j = 0; j < cols; j++) {
+                    assert(memcmp(get_element_by_indices(&matrix, (size_t[]){i, j}),
+                                  get_element_by_indices(&transposed.result_matrix, (size_t[]){j, i}), element_size) == 0);
+                }
+            }
+            clear_matrix(&transposed.result_matrix);
+            clear_matrix(&matrix);
+        }
+    }
+
+    // N-D permutations
+    MultiDimensionalMatrix cube;
+    create_matrix(&cube, 3, (size_t[]){7, 20, 30}, TYPE_INT);
+    fill_with_linear_indices(&cube);
+    size_t permutations[][3] = { {2, 0, 1}, {1, 0, 2}, {2, 1, 0}, {0, 2, 1} };
+
+    for (size_t p = 0; p < 4; p++) {
+        ArithmeticOperationReturn permuted = permute_matrix_axes(&cube, permutations[p]);
+        assert(permuted.error_code == ERR_NONE);
+        size_t indices[3], permuted_indices[3];
+        for (indices[0] = 0; indices[0] < 7; indices[0]++) {
+            for (indices[1] = 0; indices[1] < 20; indices[1]++) {
+                for (indices[2] = 0; indices[2] < 30; indices[2]++) {
+                    for (size_t i = 0; i < 3; i++) {
+                        permuted_indices[i] = indices[permutations[p][i]];
+                    }
+                    assert(*(int*)get_element_by_indices(&cube, indices) ==
+                           *(int*)get_element_by_indices(&permuted.result_matrix, permuted_indices));
+                }
+            }
+        }
+        clear_matrix(&permuted.result_matrix);
+    }
+    assert(permute_matrix_axes(&cube, (size_t[]){0, 0, 1}).error_code == ERR_INVALID_ARGS);
+
+    // Source with a step (not contiguous along any dimension)
+    MatrixView view;
+    create_matrix_view(&view, &cube);
+    slice_matrix_view(&view, &view, 2, 0, 30, 2);
+    transpose_matrix_view(&view, &view);
+    ArithmeticOperationReturn copy = copy_matrix_view(&view);
+    assert(copy.error_code == ERR_NONE);
+    for (size_t i = 0; i < 7; i++) {
+        for (size_t j = 0; j < 15; j++) {
+            for (size_t k = 0; k < 20; k++) {
+                assert(*(int*)get_element_by_indices(&copy.result_matrix, (size_t[]){i, j, k}) ==
+                       *(int*)get_element_by_indices(&cube, (size_t[]){i, k, 2 * j}));
+            }
+        }
+    }
+    clear_matrix(&copy.result_matrix);
+
+    // In place
+    MultiDimensionalMatrix square, expected;
+    create_matrix(&square, 3, (size_t[]){2, 100, 100}, TYPE_DOUBLE);
+    fill_with_linear_indices(&square);
+    expected = transpose_matrix(&square).result_matrix;
+    assert(transpose_matrix_in_place(&square) == ERR_NONE);
+    assert(memcmp(square.head_ptr->data, expected.head_ptr->data, square.head_ptr->data_size) == 0);
+    assert(transpose_matrix_in_place(&cube) == ERR_DIMENSION_SIZE_MISMATCH);
+
+    clear_matrix(&square);
+    clear_matrix(&expected);
+    clear_matrix(&cube);
+}
+
+void test_matrix_vector_products() {
+    // Integer-valued floats, so every sum is exact; large enough for several threads
+    size_t rows = 300, cols = 517;
+    MultiDimensionalMatrix matrix, x, y;
+    create_matrix(&matrix, 2, (size_t[]){rows, cols}, TYPE_FLOAT);
+    create_matrix(&x, 1, (size_t[]){cols}, TYPE_FLOAT);
+    create_matrix(&y, 1, (size_t[]){rows}, TYPE_FLOAT);
+    float* A = (float*)matrix.head_ptr->data;
+    for (size_t i = 0; i < rows * cols; i++) {
+        A[i] = (float)((int)(i % 7) - 3);
+    }
+    for (size_t j = 0; j < cols; j++) {
+        ((float*)x.head_ptr->data)[j] = (float)(j % 5);
+    }
+    for (size_t i = 0; i < rows; i++) {
+        ((float*)y.head_ptr->data)[i] = (float)((int)(i % 3) - 1);
+    }
+
+    ArithmeticOperationReturn product = matrix_vector_multiply(&matrix, &x);
+    assert(product.error_code == ERR_NONE);
+    assert(product.result_matrix.head_ptr->number_of_dimensions == 1 && product.result_matrix.head_ptr->dimensions[0] == rows);
+    for (size_t i = 0; i < rows; i++) {
+        float expected = 0;
+        for (size_t j = 0; j < cols; j++) {
+            expected += A[i * cols + j] * ((float*)x.head_ptr->data)[j];
+        }
+        assert(((float*)product.result_matrix.head_ptr->data)[i] == expected);
+    }
+
+    // Same result through `multiply_2d_matrices` with a (cols x 1) matrix
+    MultiDimensionalMatrix column;
+    create_matrix(&column, 2, (size_t[]){cols, 1}, TYPE_FLOAT);
+    fill_matrix_from_static_array(&column, x.head_ptr->data);
+    ArithmeticOperationReturn general = multiply_2d_matrices(&matrix, &column);
+    assert(general.error_code == ERR_NONE);
+    assert(memcmp(general.result_matrix.head_ptr->data, product.result_matrix.head_ptr->data, rows * sizeof(float)) == 0);
+    clear_matrix(&general.result_matrix);
+    clear_matrix(&product.result_matrix);
+
+    // Transposed
+    product = matrix_transposed_vector_multiply(&matrix, &y);
+    assert(product.error_code == ERR_NONE && product.result_matrix.head_ptr->dimensions[0] == cols);
+    MultiDimensionalMatrix row;
+    create_matrix(&row, 2, (size_t[]){1, rows}, TYPE_FLOAT);
+    fill_matrix_from_static_array(&row, y.head_ptr->data);
+    general = multiply_2d_matrices(&row, &matrix);
+    assert(general.error_code == ERR_NONE);
+    for (size_t j = 0; j < cols; j++) {
+        float expected = 0;
+        for (size_t i = 0; i < rows; i++) {
+            expected += A[i * cols + j] * ((float*)y.head_ptr->data)[i];
+        }
+        assert(((float*)product.result_matrix.head_ptr->data)[j] == expected);
+        assert(((float*)general.result_matrix.head_ptr->data)[j] == expected);
+    }
+    clear_matrix(&general.result_matrix);
+    clear_matrix(&product.result_matrix);
+
+    // A += 2 * y * x^T
+    float alpha = 2.0f;
+    float* original = malloc(rows * cols * sizeof(float));
+    memcpy(original, A, rows * cols * sizeof(float));
+    assert(rank_one_update(&matrix, &alpha, &y, &x) == ERR_NONE);
+    for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols; j++) {
+            assert(A[i * cols + j] == original[i * cols + j] + 2.0f * ((float*)y.head_ptr->data)[i] * ((float*)x.head_ptr->data)[j]);
+        }
+    }
+
+    // Errors
+    assert(matrix_vector_multiply(&matrix, &y).error_code == ERR_DIMENSION_SIZE_MISMATCH);
+    assert(matrix_transposed_vector_multiply(&matrix, &x).error_code == ERR_DIMENSION_SIZE_MISMATCH);
+    assert(matrix_vector_multiply(&matrix, &column).error_code == ERR_INVALID_ARGS);
+    assert(rank_one_update(&matrix, &alpha, &x, &y) == ERR_DIMENSION_SIZE_MISMATCH);
+    assert(rank_one_update(&matrix, NULL, &y, &x) == ERR_NULL_PTR);
+    change_data_type(&x, TYPE_DOUBLE);
+    assert(matrix_vector_multiply(&matrix, &x).error_code == ERR_DATATYPE_MISMATCH);
+
+    // 16-bit floats are summed in `float`
+    MultiDimensionalMatrix half_matrix, half_vector;
+    create_matrix(&half_matrix, 2, (size_t[]){2, 20}, TYPE_FP16);
+    create_matrix(&half_vector, 1, (size_t[]){20}, TYPE_FP16);
+    for (size_t j = 0; j < 20; j++) {
+        ((fp16_t*)half_matrix.head_ptr->data)[j] = float_to_fp16(0.5f);
+        ((fp16_t*)half_matrix.head_ptr->data)[20 + j] = float_to_fp16((float)j);
+        ((fp16_t*)half_vector.head_ptr->data)[j] = float_to_fp16(1.0f);
+    }
+    product = matrix_vector_multiply(&half_matrix, &half_vector);
+    assert(product.error_code == ERR_NONE);
+    assert(fp16_to_float(((fp16_t*)product.result_matrix.head_ptr->data)[0]) == 10.0f);
+    assert(fp16_to_float(((fp16_t*)product.result_matrix.head_ptr->data)[1]) == 190.0f);
+    clear_matrix(&product.result_matrix);
+
+    free(original);
+    clear_matrix(&matrix);
+    clear_matrix(&x);
+    clear_matrix(&y);
+    clear_matrix(&column);
+    clear_matrix(&row);
+    clear_matrix(&half_matrix);
+    clear_matrix(&half_vector);
+}
+
+// out = 2 * in + 1
+static void affine_map(void* out, const void* in, size_t count, void* context) {
+    (void)context;
+    for (size_t i = 0; i < count; i++) {
+        ((double*)out)[i] = 2.0 * ((const double*)in)[i] + 1.0;
+    }
+}
+
+// out = a * b + offset, counts the elements
+static void fused_multiply_add(void* out, const void* a, const void* b, size_t count, void* context) {
+    for (size_t i = 0; i < count; i++) {
+        ((int*)out)[i] = ((const int*)a)[i] * ((const int*)b)[i] + 100;
+    }
+    *(size_t*)context += count;
+}
+
+void test_map_zip() {
+    MultiDimensionalMatrix a, b, column, out;
+    create_matrix(&a, 2, (size_t[]){2, 3}, TYPE_INT);
+    create_matrix(&b, 1, (size_t[]){3}, TYPE_INT);
+    create_matrix(&column, 2, (size_t[]){2, 1}, TYPE_INT);
+    create_matrix(&out, 2, (size_t[]){2, 3}, TYPE_INT);
+    fill_matrix_from_static_array(&a, (int[]){-3, 5, 0, 7, -1, 4});
+    fill_matrix_from_static_array(&b, (int[]){2, 0, -1});
+    fill_matrix_from_static_array(&column, (int[]){10, -2});
+    int* result = (int*)out.head_ptr->data;
+
+    // Built-in maps
+    assert(matrix_map(&out, &a, MAP_ABSOLUTE) == ERR_NONE);
+    assert(memcmp(result, (int[]){3, 5, 0, 7, 1, 4}, sizeof(int) * 6) == 0);
+    assert(matrix_map(&out, &a, MAP_SQUARE) == ERR_NONE);
+    assert(memcmp(result, (int[]){9, 25, 0, 49, 1, 16}, sizeof(int) * 6) == 0);
+    assert(matrix_map(&out, &out, MAP_NEGATE) == ERR_NONE);
+    assert(memcmp(result, (int[]){-9, -25, 0, -49, -1, -16}, sizeof(int) * 6) == 0);
+
+    int lower = -2, upper = 4;
+    assert(matrix_clamp(&out, &a, &lower, &upper) == ERR_NONE);
+    assert(memcmp(result, (int[]){-2, 4, 0, 4, -1, 4}, sizeof(int) * 6) == 0);
+
+    // Built-in zips with broadcasting
+    assert(matrix_zip(&out, &a, &b, ZIP_SUBTRACT) == ERR_NONE);
+    assert(memcmp(result, (int[]){-5, 5, 1, 5, -1, 5}, sizeof(int) * 6) == 0);
+    assert(matrix_zip(&out, &a, &b, ZIP_DIVIDE) == ERR_NONE);
+    assert(memcmp(result, (int[]){-1, 0, 0, 3, 0, -4}, sizeof(int) * 6) == 0);
+    assert(matrix_zip(&out, &a, &b, ZIP_MAXIMUM) == ERR_NONE);
+    assert(memcmp(result, (int[]){2, 5, 0, 7, 0, 4}, sizeof(int) * 6) == 0);
+    assert(matrix_zip(&out, &a, &column, ZIP_MINIMUM) == ERR_NONE);
+    assert(memcmp(result, (int[]){-3, 5, 0, -2, -2, -2}, sizeof(int) * 6) == 0);
+    assert(matrix_zip(&out, &a, &b, ZIP_LESS_EQUAL) == ERR_NONE);
+    assert(memcmp(result, (int[]){1, 0, 0, 0, 1, 0}, sizeof(int) * 6) == 0);
+    assert(matrix_zip(&out, &b, &a, ZIP_NOT_EQUAL) == ERR_NONE);
+    assert(memcmp(result, (int[]){1, 1, 1, 1, 1, 1}, sizeof(int) * 6) == 0);
+    assert(matrix_zip(&out, &a, &b, ZIP_ADD) == ERR_NONE);
+    assert(memcmp(result, (int[]){-1, 5, -1, 9, -1, 3}, sizeof(int) * 6) == 0);
+
+    // Callbacks: the broadcasted column has no contiguous rows and is gathered into blocks
+    size_t elements = 0;
+    assert(matrix_zip_function(&out, &a, &column, fused_multiply_add, &elements) == ERR_NONE);
+    assert(memcmp(result, (int[]){70, 150, 100, 86, 102, 92}, sizeof(int) * 6) == 0);
+    assert(elements == 6);
+
+    MultiDimensionalMatrix doubles;
+    create_matrix(&doubles, 3, (size_t[]){4, 50, 30}, TYPE_DOUBLE);
+    for (size_t i = 0; i < 6000; i++) {
+        ((double*)doubles.head_ptr->data)[i] = (double)i;
+    }
+    assert(matrix_map_function(&doubles, &doubles, affine_map, NULL) == ERR_NONE);
+    for (size_t i = 0; i < 6000; i++) {
+        assert(((double*)doubles.head_ptr->data)[i] == 2.0 * (double)i + 1.0);
+    }
+    assert(matrix_zip(&doubles, &doubles, &doubles, ZIP_DIVIDE) == ERR_NONE);
+    assert(((double*)doubles.head_ptr->data)[5999] == 1.0);
+
+    // Errors
+    assert(matrix_map(&doubles, &a, MAP_ABSOLUTE) == ERR_DIMENSION_COUNT_MISMATCH);
+    assert(matrix_map(&column, &a, MAP_ABSOLUTE) == ERR_DIMENSION_SIZE_MISMATCH);
+    assert(matrix_zip(&out, &a, &doubles, ZIP_ADD) == ERR_DIMENSION_SIZE_MISMATCH);
+    assert(matrix_map_function(&out, &a, NULL, NULL) == ERR_NULL_PTR);
+    assert(matrix_zip(&out, &a, &b, (ZipOperation)99) == ERR_UNSUPPORTED_DATATYPE);
+    change_data_type(&b, TYPE_DOUBLE);
+    assert(matrix_zip(&out, &a, &b, ZIP_ADD) == ERR_DATATYPE_MISMATCH);
+
+    clear_matrix(&a);
+    clear_matrix(&b);
+    clear_matrix(&column);
+    clear_matrix(&out);
+    clear_matrix(&doubles);
+
+    // The minimum divided by -1 wraps to the minimum instead of overflowing
+    MultiDimensionalMatrix minimum, negative_one, wide_minimum, wide_negative_one;
+    create_matrix(&minimum, 1, (size_t[]){3}, TYPE_INT);
+    create_matrix(&negative_one, 1, (size_t[]){1}, TYPE_INT);
+    create_matrix(&wide_minimum, 1, (size_t[]){3}, TYPE_INT64);
+    create_matrix(&wide_negative_one, 1, (size_t[]){1}, TYPE_INT64);
+    fill_matrix_from_static_array(&minimum, (int[]){INT_MIN, INT_MIN + 1, 6});
+    fill_matrix_from_static_array(&negative_one, (int[]){-1});
+    fill_matrix_from_static_array(&wide_minimum, (int64_t[]){INT64_MIN, INT64_MIN + 1, 6});
+    fill_matrix_from_static_array(&wide_negative_one, (int64_t[]){-1});
+
+    assert(matrix_zip(&minimum, &minimum, &negative_one, ZIP_DIVIDE) == ERR_NONE);
+    assert(memcmp(minimum.head_ptr->data, (int[]){INT_MIN, INT_MAX, -6}, sizeof(int) * 3) == 0);
+    assert(matrix_zip(&wide_minimum, &wide_minimum, &wide_negative_one, ZIP_DIVIDE) == ERR_NONE);
+    assert(memcmp(wide_minimum.head_ptr->data, (int64_t[]){INT64_MIN, INT64_MAX, -6}, sizeof(int64_t) * 3) == 0);
+
+    // Negating, taking the absolute value and squaring the minimum wraps as well
+    fill_matrix_from_static_array(&minimum, (int[]){INT_MIN, INT_MIN + 1, 65536});
+    fill_matrix_from_static_array(&wide_minimum, (int64_t[]){INT64_MIN, INT64_MIN + 1, 4294967296});
+    MultiDimensionalMatrix mapped, wide_mapped;
+    create_matrix(&mapped, 1, (size_t[]){3}, TYPE_INT);
+    create_matrix(&wide_mapped, 1, (size_t[]){3}, TYPE_INT64);
+
+    assert(matrix_map(&mapped, &minimum, MAP_NEGATE) == ERR_NONE);
+    assert(memcmp(mapped.head_ptr->data, (int[]){INT_MIN, INT_MAX, -65536}, sizeof(int) * 3) == 0);
+    assert(matrix_map(&mapped, &minimum, MAP_ABSOLUTE) == ERR_NONE);
+    assert(memcmp(mapped.head_ptr->data, (int[]){INT_MIN, INT_MAX, 65536}, sizeof(int) * 3) == 0);
+    assert(matrix_map(&mapped, &minimum, MAP_SQUARE) == ERR_NONE);
+    assert(memcmp(mapped.head_ptr->data, (int[]){0, 1, 0}, sizeof(int) * 3) == 0);
+
+    assert(matrix_map(&wide_mapped, &wide_minimum, MAP_NEGATE) == ERR_NONE);
+    assert(memcmp(wide_mapped.head_ptr->data, (int64_t[]){INT64_MIN, INT64_MAX, -4294967296}, sizeof(int64_t) * 3) == 0);
+    assert(matrix_map(&wide_mapped, &wide_minimum, MAP_ABSOLUTE) == ERR_NONE);
+    assert(memcmp(wide_mapped.head_ptr->data, (int64_t[]){INT64_MIN, INT64_MAX, 4294967296}, sizeof(int64_t) * 3) == 0);
+    assert(matrix_map(&wide_mapped, &wide_minimum, MAP_SQUARE) == ERR_NONE);
+    assert(memcmp(wide_mapped.head_ptr->data, (int64_t[]){0, 1, 0}, sizeof(int64_t) * 3) == 0);
+
+    clear_matrix(&minimum);
+    clear_matrix(&negative_one);
+    clear_matrix(&wide_minimum);
+    clear_matrix(&wide_negative_one);
+    clear_matrix(&mapped);
+    clear_matrix(&wide_mapped);
+}
+
+// Distance of `value` to `reference` in units in the last place of the data-type
+static double ulp_error(long double value, long double reference, DataType data_type) {
+    int mantissa_bits = data_type == TYPE_FLOAT ? 24 : 53;
+    int minimum_exponent = data_type == TYPE_FLOAT ? -149 : -1074;
+
+    // Overflowing references are infinity in the data-type
+    long double limit = data_type == TYPE_FLOAT ? (long double)FLT_MAX : (long double)DBL_MAX;
+    if (fabsl(reference) > limit) {
+        reference = reference > 0 ? INFINITY : -INFINITY;
+    }
+    if (value == reference) {
+        return 0.0;
+    }
+
+    int exponent;
+    frexpl(reference, &exponent);
+    exponent = exponent - mantissa_bits < minimum_exponent ? minimum_exponent : exponent - mantissa_bits;
+    return (double)(fabsl(value - reference) / ldexpl(1.0L, exponent));
+}
+
+static long double math_reference(MathFunction function, long double x) {
+    switch(function) {
+        case MATH_EXP:
+            return expl(x);
+        case MATH_LOG:
+            return logl(x);
+        case MATH_TANH:
+            return tanhl(x);
+        case MATH_SIGMOID:
+            return 1.0L / (1.0L + expl(-x));
+        default:
+            return sqrtl(x);
+    }
+}
+
+void test_math_functions() {
+    // Sweeps over the interesting ranges (the exponent of positive-only functions is sampled evenly)
+    const size_t count = 40000;
+    const double lower[] = {-746.0, 0x1p-1074, -25.0, -746.0, 0x1p-1074};
+    const double upper[] = {710.0, 0x1p1023, 25.0, 60.0, 0x1p1023};
+    const double maximum_ulp[] = {1.0, 1.0, 1.5, 2.5, 0.5};
+    DataType data_types[] = {TYPE_FLOAT, TYPE_DOUBLE};
+
+    for (size_t t = 0; t < 2; t++) {
+        DataType data_type = data_types[t];
+        MultiDimensionalMatrix in, out;
+        create_matrix(&in, 2, (size_t[]){200, count / 200}, data_type);
+        create_matrix(&out, 2, (size_t[]){200, count / 200}, data_type);
+
+        for (MathFunction function = MATH_EXP; function <= MATH_SQRT; function++) {
+            double low = lower[function];
+            double high = upper[function];
+            if (data_type == TYPE_FLOAT) {
+                // The tails of exp and sigmoid reach the subnormals of `float`
+                low = function == MATH_EXP || function == MATH_SIGMOID ? -104.0 : (low > 0 ? 0x1p-149 : low);
+                high = function == MATH_EXP ? 89.0 : (low > 0 ? 0x1p127 : high);
+            }
+
+            for (size_t i = 0; i < count; i++) {
+                double step = (double)i / (double)(count - 1);
+                double x = low > 0 ? exp2(log2(low) + (log2(high) - log2(low)) * step) : low + (high - low) * step;
+                if (data_type == TYPE_FLOAT) {
+                    ((float*)in.head_ptr->data)[i] = (float)x;
+                } else {
+                    ((double*)in.head_ptr->data)[i] = x;
+                }
+            }
+
+            assert(matrix_math(&out, &in, function) == ERR_NONE);
+
+            for (size_t i = 0; i < count; i++) {
+                long double x, y;
+                if (data_type == TYPE_FLOAT) {
+                    x = ((float*)in.head_ptr->data)[i];
+                    y = ((float*)out.head_ptr->data)[i];
+                } else {
+                    x = ((double*)in.head_ptr->data)[i];
+                    y = ((double*)out.head_ptr->data)[i];
+                }
+                assert(ulp_error(y, math_reference(function, x), data_type) <= maximum_ulp[function]);
+            }
+        }
+
+        clear_matrix(&in);
+        clear_matrix(&out);
+    }
+
+    // Special values, in place
+    MultiDimensionalMatrix specials;
+    create_matrix(&specials, 1, (size_t[]){6}, TYPE_FLOAT);
+    float* values = (float*)specials.head_ptr->data;
+
+    fill_matrix_from_static_array(&specials, (float[]){-INFINITY, INFINITY, NAN, 0.0f, -1.0f, 1e-40f});
+    assert(matrix_math_in_place(&specials, MATH_EXP) == ERR_NONE);
+    assert(values[0] == 0.0f && values[1] == INFINITY && isnan(values[2]) && values[3] == 1.0f);
+
+    fill_matrix_from_static_array(&specials, (float[]){-INFINITY, INFINITY, NAN, 0.0f, -1.0f, 1e-40f});
+    assert(matrix_math_in_place(&specials, MATH_LOG) == ERR_NONE);
+    assert(isnan(values[0]) && values[1] == INFINITY && isnan(values[2]) && values[3] == -INFINITY && isnan(values[4]));
+    assert(fabsf(values[5] - logf(1e-40f)) <= 1e-5f);
+
+    fill_matrix_from_static_array(&specials, (float[]){-INFINITY, INFINITY, NAN, 0.0f, -1.0f, 1e-40f});
+    assert(matrix_math_in_place(&specials, MATH_TANH) == ERR_NONE);
+    assert(values[0] == -1.0f && values[1] == 1.0f && isnan(values[2]) && values[3] == 0.0f);
+
+    fill_matrix_from_static_array(&specials, (float[]){-INFINITY, INFINITY, NAN, 0.0f, -1.0f, 1e-40f});
+    assert(matrix_math_in_place(&specials, MATH_SIGMOID) == ERR_NONE);
+    assert(values[0] == 0.0f && values[1] == 1.0f && isnan(values[2]) && values[3] == 0.5f);
+
+    // Errors
+    MultiDimensionalMatrix integers, doubles;
+    create_matrix(&integers, 1, (size_t[]){6}, TYPE_INT);
+    create_matrix(&doubles, 1, (size_t[]){6}, TYPE_DOUBLE);
+    assert(matrix_math_in_place(&integers, MATH_SQRT) == ERR_UNSUPPORTED_DATATYPE);
+    assert(matrix_math(&doubles, &specials, MATH_EXP) == ERR_DATATYPE_MISMATCH);
+    assert(matrix_math_in_place(&specials, (MathFunction)99) == ERR_UNSUPPORTED_DATATYPE);
+    assert(matrix_math(NULL, &specials, MATH_EXP) == ERR_NULL_PTR);
+
+    clear_matrix(&specials);
+    clear_matrix(&integers);
+    clear_matrix(&doubles);
+}
+
+// Correlation with plain loops over 3 spatial dimensions (missing leading ones have the size 1)
+static void reference_correlation(const double* input, const double* filters, double* result, const size_t* shape,
+                                  size_t out_channels, const size_t* kernel, const size_t* output,
+                                  const ConvolutionParameters* parameters, size_t spatial) {
+    size_t stride[3], padding[3], dilation[3];
+    for (size_t d = 0; d < 3; d++) {
+        size_t index = d + spatial - 3;
+        stride[d] = d + spatial < 3 ? 1 : parameters->stride[index];
+        padding[d] = d + spatial < 3 ? 0 : parameters->padding[index];
+        dilation[d] = d + spatial < 3 ? 1 : parameters->dilation[index];
+    }
+
+    for (size_t n = 0; n < shape[0]; n++)
+    for (size_t o = 0; o < out_channels; o++)
+    for (size_t x = 0; x < output[0]; x++)
+    for (size_t y = 0; y < output[1]; y++)
+    for (size_t z = 0; z < output[2]; z++) {
+        double sum = 0.0;
+        for (size_t c = 0; c < shape[1]; c++)
+        for (size_t i = 0; i < kernel[0]; i++)
+        for (size_t j = 0; j < kernel[1]; j++)
+        for (size_t k = 0; k < kernel[2]; k++) {
+            long a = (long)(x * stride[0] + i * dilation[0]) - (long)padding[0];
+            long b = (long)(y * stride[1] + j * dilation[1]) - (long)padding[1];
+            long e = (long)(z * stride[2] + k * dilation[2]) - (long)padding[2];
+            if (a < 0 || b < 0 || e < 0 || a >= (long)shape[2] || b >= (long)shape[3] || e >= (long)shape[4]) {
+                continue;
+            }
+            sum += input[(((n * shape[1] + c) * shape[2] + a) * shape[3] + b) * shape[4] + e] *
+                   filters[(((o * shape[1] + c) * kernel[0] + i) * kernel[1] + j) * kernel[2] + k];
+        }
+        result[(((n * out_channels + o) * output[0] + x) * output[1] + y) * output[2] + z] = sum;
+    }
+}
+
+void test_convolution() {
+    // 1-D, 2-D and 3-D cases with stride, padding and dilation; both algorithms against plain loops
+    struct {
+        size_t spatial;
+        size_t input[5];            // batch, channels, spatial...
+        size_t out_channels;
+        size_t kernel[3];
+        ConvolutionParameters parameters;
+    } cases[] = {
+        { 1, {2, 3, 40},         4, {5},       {{1}, {2}, {1}, CONVOLUTION_AUTO} },
+        { 2, {2, 3, 11, 300},    4, {3, 3},    {{1, 1}, {1, 1}, {1, 1}, CONVOLUTION_AUTO} },
+        { 2, {1, 2, 13, 17},     3, {3, 2},    {{2, 3}, {1, 2}, {2, 1}, CONVOLUTION_AUTO} },
+        { 2, {1, 2, 9, 20},      2, {5, 5},    {{1, 1}, {2, 2}, {1, 2}, CONVOLUTION_AUTO} },
+        { 3, {1, 2, 5, 6, 7},    2, {2, 3, 3}, {{1, 2, 1}, {0, 1, 1}, {2, 1, 1}, CONVOLUTION_AUTO} },
+    };
+
+    for (size_t t = 0; t < sizeof(cases) / sizeof(cases[0]); t++) {
+        size_t spatial = cases[t].spatial;
+        size_t shape[5] = {cases[t].input[0], cases[t].input[1], 1, 1, 1};
+        size_t kernel[3] = {1, 1, 1}, output[3] = {1, 1, 1};
+        size_t filter_dimensions[5] = {cases[t].out_channels, cases[t].input[1]};
+
+        for (size_t d = 0; d < spatial; d++) {
+            shape[5 - spatial + d] = cases[t].input[2 + d];
+            kernel[3 - spatial + d] = cases[t].kernel[d];
+            filter_dimensions[2 + d] = cases[t].kernel[d];
+            output[3 - spatial + d] = (cases[t].input[2 + d] + 2 * cases[t].parameters.padding[d] -
+                                       cases[t].parameters.dilation[d] * (cases[t].kernel[d] - 1) - 1) / cases[t].parameters.stride[d] + 1;
+        }
+
+        MultiDimensionalMatrix input, filters;
+        create_matrix(&input, 2 + spatial, cases[t].input, TYPE_DOUBLE);
+        create_matrix(&filters, 2 + spatial, filter_dimensions, TYPE_DOUBLE);
+        size_t input_count = input.head_ptr->data_size / sizeof(double);
+        size_t filter_count = filters.head_ptr->data_size / sizeof(double);
+        for (size_t i = 0; i < input_count; i++) {
+            ((double*)input.head_ptr->data)[i] = (double)((i * 7) % 11) - 5.0;
+        }
+        for (size_t i = 0; i < filter_count; i++) {
+            ((double*)filters.head_ptr->data)[i] = (double)((i * 5) % 7) - 3.0;
+        }
+
+        size_t output_count = shape[0] * cases[t].out_channels * output[0] * output[1] * output[2];
+        double* expected = (double*)malloc(output_count * sizeof(double));
+        reference_correlation((double*)input.head_ptr->data, (double*)filters.head_ptr->data, expected, shape,
+                              cases[t].out_channels, kernel, output, &cases[t].parameters, spatial);
+
+        for (ConvolutionAlgorithm algorithm = CONVOLUTION_AUTO; algorithm <= CONVOLUTION_DIRECT; algorithm++) {
+            cases[t].parameters.algorithm = algorithm;
+            ArithmeticOperationReturn response = correlate_matrices(&input, &filters, &cases[t].parameters);
+            assert(response.error_code == ERR_NONE);
+            assert(response.result_matrix.head_ptr->number_of_dimensions == 2 + spatial);
+            assert(response.result_matrix.head_ptr->dimensions[1] == cases[t].out_channels);
+            assert(response.result_matrix.head_ptr->dimensions[1 + spatial] == output[2]);
+            // Integer-valued products are exact
+            assert(memcmp(response.result_matrix.head_ptr->data, expected, output_count * sizeof(double)) == 0);
+            clear_matrix(&response.result_matrix);
+        }
+
+        free(expected);
+        clear_matrix(&input);
+        clear_matrix(&filters);
+    }
+
+    // Convolution flips the filter; without parameters: stride 1, no padding
+    MultiDimensionalMatrix signal, filter;
+    create_matrix(&signal, 3, (size_t[]){1, 1, 5}, TYPE_INT);
+    create_matrix(&filter, 3, (size_t[]){1, 1, 3}, TYPE_INT);
+    fill_matrix_from_static_array(&signal, (int[]){1, 2, 3, 4, 5});
+    fill_matrix_from_static_array(&filter, (int[]){1, 0, -1});
+
+    ArithmeticOperationReturn correlated = correlate_matrices(&signal, &filter, NULL);
+    ArithmeticOperationReturn convolved = convolve_matrices(&signal, &filter, NULL);
+    assert(correlated.error_code == ERR_NONE && convolved.error_code == ERR_NONE);
+    assert(memcmp(correlated.result_matrix.head_ptr->data, (int[]){-2, -2, -2}, sizeof(int) * 3) == 0);
+    assert(memcmp(convolved.result_matrix.head_ptr->data, (int[]){2, 2, 2}, sizeof(int) * 3) == 0);
+    assert(((int*)filter.head_ptr->data)[0] == 1);
+    clear_matrix(&correlated.result_matrix);
+    clear_matrix(&convolved.result_matrix);
+
+    // Zero input-channels: both algorithms give zeros
+    MultiDimensionalMatrix empty_input, empty_filters;
+    create_matrix(&empty_input, 3, (size_t[]){2, 0, 5}, TYPE_FLOAT);
+    create_matrix(&empty_filters, 3, (size_t[]){3, 0, 2}, TYPE_FLOAT);
+
+    ConvolutionAlgorithm algorithms[] = {CONVOLUTION_DIRECT, CONVOLUTION_IM2COL};
+
+    for (size_t a = 0; a < 2; a++) {
+        ConvolutionParameters parameters = { .algorithm = algorithms[a] };
+        ArithmeticOperationReturn empty = correlate_matrices(&empty_input, &empty_filters, &parameters);
+        assert(empty.error_code == ERR_NONE);
+        assert(empty.result_matrix.head_ptr->dimensions[1] == 3 && empty.result_matrix.head_ptr->dimensions[2] == 4);
+
+        for (size_t i = 0; i < 2 * 3 * 4; i++) {
+            assert(((float*)empty.result_matrix.head_ptr->data)[i] == 0.0f);
+        }
+
+        clear_matrix(&empty.result_matrix);
+    }
+
+    clear_matrix(&empty_input);
+    clear_matrix(&empty_filters);
+
+    // Errors
+    MultiDimensionalMatrix too_large, flat, doubles;
+    create_matrix(&too_large, 3, (size_t[]){1, 1, 6}, TYPE_INT);
+    create_matrix(&flat, 2, (size_t[]){1, 5}, TYPE_INT);
+    create_matrix(&doubles, 3, (size_t[]){1, 1, 3}, TYPE_DOUBLE);
+    assert(correlate_matrices(&signal, &too_large, NULL).error_code == ERR_DIMENSION_SIZE_MISMATCH);
+    assert(correlate_matrices(&flat, &flat, NULL).error_code == ERR_INVALID_ARGS);
+    assert(correlate_matrices(&signal, &flat, NULL).error_code == ERR_DIMENSION_COUNT_MISMATCH);
+    assert(correlate_matrices(&signal, &doubles, NULL).error_code == ERR_DATATYPE_MISMATCH);
+    assert(convolve_matrices(NULL, &filter, NULL).error_code == ERR_NULL_PTR);
+
+    clear_matrix(&signal);
+    clear_matrix(&filter);
+    clear_matrix(&too_large);
+    clear_matrix(&flat);
+    clear_matrix(&doubles);
+}
+
+// Largest entry of `A * X - B` (A is n x n, X and B are n x k)
+static double linear_system_residual(const double* A, const double* X, const double* B, size_t n, size_t k) {
+    double largest = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t c = 0; c < k; c++) {
+            double sum = -B[i * k + c];
+            for (size_t j = 0; j < n; j++) {
+                sum += A[i * n + j] * X[j * k + c];
+            }
+            largest = fabs(sum) > largest ? fabs(sum) : largest;
+        }
+    }
+    return largest;
+}
+
+void test_linear_systems() {
+    // Small system with pivoting: the first pivot is zero
+    MultiDimensionalMatrix A, b;
+    create_matrix(&A, 2, (size_t[]){3, 3}, TYPE_DOUBLE);
+    create_matrix(&b, 1, (size_t[]){3}, TYPE_DOUBLE);
+    fill_matrix_from_static_array(&A, (double[]){0, 2, 1, 1, 1, 1, 2, 1, 3});
+    fill_matrix_from_static_array(&b, (double[]){7, 6, 13});
+
+    ArithmeticOperationReturn response = solve_linear_system(&A, &b);
+    assert(response.error_code == ERR_NONE);
+    double* x = (double*)response.result_matrix.head_ptr->data;
+    assert(fabs(x[0] - 1.0) < 1e-12 && fabs(x[1] - 2.0) < 1e-12 && fabs(x[2] - 3.0) < 1e-12);
+    assert(((double*)A.head_ptr->data)[0] == 0.0);
+    clear_matrix(&response.result_matrix);
+
+    size_t pivots[150];
+    assert(lu_decompose(&A, pivots) == ERR_NONE);
+    assert(pivots[0] == 2);
+    assert(lu_solve(&A, pivots, &b) == ERR_NONE);
+    assert(fabs(((double*)b.head_ptr->data)[2] - 3.0) < 1e-12);
+
+    // Several panels, several right-hand sides, both data-types
+    const size_t n = 150, k = 3;
+    double* matrix = (double*)malloc(n * n * sizeof(double));
+    double* spd = (double*)malloc(n * n * sizeof(double));
+    double* rhs = (double*)malloc(n * k * sizeof(double));
+    for (size_t i = 0; i < n * n; i++) {
+        matrix[i] = sin((double)i * 0.7) + (i % (n + 1) == 0 ? 4.0 : 0.0);
+    }
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            double sum = i == j ? (double)n : 0.0;
+            for (size_t r = 0; r < n; r++) {
+                sum += matrix[i * n + r] * matrix[j * n + r];
+            }
+            spd[i * n + j] = sum;
+        }
+    }
+    for (size_t i = 0; i < n * k; i++) {
+        rhs[i] = cos((double)i);
+    }
+
+    DataType data_types[] = {TYPE_DOUBLE, TYPE_FLOAT};
+    double tolerances[] = {1e-10, 1e-2};
+    for (size_t t = 0; t < 2; t++) {
+        MultiDimensionalMatrix dense, positive, right, solution;
+        create_matrix(&dense, 2, (size_t[]){n, n}, TYPE_DOUBLE);
+        create_matrix(&positive, 2, (size_t[]){n, n}, TYPE_DOUBLE);
+        create_matrix(&right, 2, (size_t[]){n, k}, TYPE_DOUBLE);
+        memcpy(dense.head_ptr->data, matrix, n * n * sizeof(double));
+        memcpy(positive.head_ptr->data, spd, n * n * sizeof(double));
+        memcpy(right.head_ptr->data, rhs, n * k * sizeof(double));
+        change_data_type(&dense, data_types[t]);
+        change_data_type(&positive, data_types[t]);
+        change_data_type(&right, data_types[t]);
+
+        // LU through `solve_linear_system`
+        response = solve_linear_system(&dense, &right);
+        assert(response.error_code == ERR_NONE);
+        solution = response.result_matrix;
+        change_data_type(&solution, TYPE_DOUBLE);
+        assert(linear_system_residual(matrix, (double*)solution.head_ptr->data, rhs, n, k) < tolerances[t]);
+        clear_matrix(&solution);
+
+        // Cholesky: A = L * L^T with zeros above the diagonal
+        assert(cholesky_decompose(&positive) == ERR_NONE);
+        assert(cholesky_solve(&positive, &right) == ERR_NONE);
+        change_data_type(&right, TYPE_DOUBLE);
+        assert(linear_system_residual(spd, (double*)right.head_ptr->data, rhs, n, k) < tolerances[t] * 1e-2);
+        change_data_type(&positive, TYPE_DOUBLE);
+        double* factor = (double*)positive.head_ptr->data;
+        assert(factor[1] == 0.0 && factor[n - 1] == 0.0);
+        double product = 0.0;
+        for (size_t r = 0; r < n; r++) {
+            product += factor[(n - 1) * n + r] * factor[70 * n + r];
+        }
+        assert(fabs(product - spd[(n - 1) * n + 70]) < tolerances[t] * 1e3);
+
+        clear_matrix(&dense);
+        clear_matrix(&positive);
+        clear_matrix(&right);
+    }
+
+    // Triangular solves read only their triangle
+    MultiDimensionalMatrix triangle, vector;
+    create_matrix(&triangle, 2, (size_t[]){2, 2}, TYPE_FLOAT);
+    create_matrix(&vector, 1, (size_t[]){2}, TYPE_FLOAT);
+    fill_matrix_from_static_array(&triangle, (float[]){2, 9, 1, 4});
+    fill_matrix_from_static_array(&vector, (float[]){4, 10});
+    assert(forward_substitution(&triangle, &vector, 0) == ERR_NONE);
+    assert(memcmp(vector.head_ptr->data, (float[]){2, 2}, sizeof(float) * 2) == 0);
+    assert(forward_substitution(&triangle, &vector, 1) == ERR_NONE);
+    assert(memcmp(vector.head_ptr->data, (float[]){2, 0}, sizeof(float) * 2) == 0);
+    fill_matrix_from_static_array(&vector, (float[]){22, 8});
+    assert(back_substitution(&triangle, &vector) == ERR_NONE);
+    assert(memcmp(vector.head_ptr->data, (float[]){2, 2}, sizeof(float) * 2) == 0);
+
+    // Errors
+    MultiDimensionalMatrix singular, rectangle, integers, doubles, longer;
+    create_matrix(&singular, 2, (size_t[]){2, 2}, TYPE_FLOAT);
+    create_matrix(&rectangle, 2, (size_t[]){2, 3}, TYPE_FLOAT);
+    create_matrix(&integers, 2, (size_t[]){2, 2}, TYPE_INT);
+    create_matrix(&doubles, 1, (size_t[]){2}, TYPE_DOUBLE);
+    create_matrix(&longer, 1, (size_t[]){3}, TYPE_FLOAT);
+    fill_matrix_from_static_array(&singular, (float[]){1, 2, 2, 4});
+    assert(solve_linear_system(&singular, &vector).error_code == ERR_SINGULAR_MATRIX);
+    assert(cholesky_decompose(&singular) == ERR_NOT_POSITIVE_DEFINITE);
+    assert(lu_decompose(&rectangle, pivots) == ERR_DIMENSION_SIZE_MISMATCH);
+    assert(lu_decompose(&integers, pivots) == ERR_UNSUPPORTED_DATATYPE);
+    assert(lu_decompose(&triangle, NULL) == ERR_NULL_PTR);
+    assert(back_substitution(&triangle, &doubles) == ERR_DATATYPE_MISMATCH);
+    assert(forward_substitution(&triangle, &longer, 0) == ERR_DIMENSION_SIZE_MISMATCH);
+    fill_matrix_from_static_array(&triangle, (float[]){0, 0, 1, 4});
+    assert(forward_substitution(&triangle, &vector, 0) == ERR_SINGULAR_MATRIX);
+
+    free(matrix);
+    free(spd);
+    free(rhs);
+    clear_matrix(&A);
+    clear_matrix(&b);
+    clear_matrix(&triangle);
+    clear_matrix(&vector);
+    clear_matrix(&singular);
+    clear_matrix(&rectangle);
+    clear_matrix(&integers);
+    clear_matrix(&doubles);
+    clear_matrix(&longer);
+}
+
+void test_workspaces() {
+    MatrixWorkspace* workspace;
+    assert(create_workspace(&workspace) == ERR_NONE);
+    assert(end_workspace_scope(workspace) == ERR_INVALID_ARGS);
+
+    // Repeated shapes reuse the same buffers
+    void* first_buffers[3];
+    size_t reserved_bytes = 0;
+
+    for (int iteration = 0; iteration < 3; iteration++) {
+        assert(begin_workspace_scope(workspace) == ERR_NONE);
+
+        MultiDimensionalMatrix A, B;
+        assert(create_matrix(&A, 2, (size_t[]){20, 30}, TYPE_DOUBLE) == ERR_NONE);
+        assert(create_matrix(&B, 2, (size_t[]){30, 20}, TYPE_DOUBLE) == ERR_NONE);
+        assert(A.head_ptr->storage == STORAGE_WORKSPACE);
+        double two = 2.0;
+        fill_matrix_with_value(&A, &two);
+        fill_matrix_with_value(&B, &two);
+
+        ArithmeticOperationReturn sum = add_matrices(&A, &A);
+        ArithmeticOperationReturn product = multiply_2d_matrices(&A, &B);
+        assert(sum.error_code == ERR_NONE && product.error_code == ERR_NONE);
+        assert(((double*)product.result_matrix.head_ptr->data)[399] == 120.0);
+
+        void* buffers[3] = {A.head_ptr->data, sum.result_matrix.head_ptr->data, product.result_matrix.head_ptr->data};
+
+        if (iteration == 0) {
+            memcpy(first_buffers, buffers, sizeof(buffers));
+            reserved_bytes = get_workspace_reserved_bytes(workspace);
+            assert(reserved_bytes >= (2 * 600 + 600 + 400) * sizeof(double));
+        } else {
+            assert(memcmp(first_buffers, buffers, sizeof(buffers)) == 0);
+            assert(get_workspace_reserved_bytes(workspace) == reserved_bytes);
+        }
+
+        assert(end_workspace_scope(workspace) == ERR_NONE);
+    }
+
+    // Cleared matrices give their buffer back right away
+    assert(begin_workspace_scope(workspace) == ERR_NONE);
+    MultiDimensionalMatrix temporary, kept, grown;
+    create_matrix(&temporary, 1, (size_t[]){100}, TYPE_FLOAT);
+    void* buffer = temporary.head_ptr->data;
+    clear_matrix(&temporary);
+    create_matrix(&temporary, 1, (size_t[]){100}, TYPE_INT);
+    assert(temporary.head_ptr->data == buffer);
+
+    // Nested scopes, detached matrices and buffers, which leave the pool
+    assert(begin_workspace_scope(workspace) == ERR_NONE);
+    create_matrix(&kept, 1, (size_t[]){3}, TYPE_INT);
+    fill_matrix_from_static_array(&kept, (int[]){1, 2, 3});
+    create_matrix(&grown, 1, (size_t[]){1000}, TYPE_FLOAT);
+    assert(change_data_type(&grown, TYPE_DOUBLE) == ERR_NONE);
+    assert(grown.head_ptr->storage == STORAGE_HEAP);
+    assert(detach_matrix_from_workspace(&kept) == ERR_NONE);
+    assert(kept.head_ptr->storage == STORAGE_HEAP);
+    assert(end_workspace_scope(workspace) == ERR_NONE);
+
+    assert(temporary.head_ptr->data == buffer);
+    assert(end_workspace_scope(workspace) == ERR_NONE);
+    assert(end_workspace_scope(workspace) == ERR_INVALID_ARGS);
+
+    assert(memcmp(kept.head_ptr->data, (int[]){1, 2, 3}, sizeof(int) * 3) == 0);
+    clear_matrix(&kept);
+
+    // Outside of scopes nothing changes
+    MultiDimensionalMatrix plain;
+    create_matrix(&plain, 1, (size_t[]){4}, TYPE_INT);
+    assert(plain.head_ptr->storage == STORAGE_HEAP && plain.head_ptr->workspace == NULL);
+    clear_matrix(&plain);
+
+    // Scopes of different workspaces end in reverse order
+    MatrixWorkspace* inner;
+    assert(create_workspace(&inner) == ERR_NONE);
+    assert(begin_workspace_scope(workspace) == ERR_NONE);
+    assert(begin_workspace_scope(inner) == ERR_NONE);
+    assert(begin_workspace_scope(workspace) == ERR_INVALID_ARGS);
+    assert(end_workspace_scope(workspace) == ERR_INVALID_ARGS);
+    create_matrix(&temporary, 1, (size_t[]){8}, TYPE_INT);
+    assert(temporary.head_ptr->workspace == inner);
+    assert(end_workspace_scope(inner) == ERR_NONE);
+    create_matrix(&temporary, 1, (size_t[]){8}, TYPE_INT);
+    assert(temporary.head_ptr->workspace == workspace);
+
+    // Clearing a workspace closes its open scopes
+    clear_workspace(inner);
+    clear_workspace(workspace);
+    create_matrix(&plain, 1, (size_t[]){4}, TYPE_INT);
+    assert(plain.head_ptr->workspace == NULL);
+    clear_matrix(&plain);
+
+    // Clearing an enclosing workspace: the inner scope ends in the scope around the cleared one
+    MatrixWorkspace* outer;
+    assert(create_workspace(&outer) == ERR_NONE);
+    assert(create_workspace(&inner) == ERR_NONE);
+    assert(begin_workspace_scope(outer) == ERR_NONE);
+    assert(begin_workspace_scope(inner) == ERR_NONE);
+    clear_workspace(outer);
+    create_matrix(&temporary, 1, (size_t[]){8}, TYPE_INT);
+    assert(temporary.head_ptr->workspace == inner);
+    assert(end_workspace_scope(inner) == ERR_NONE);
+    create_matrix(&plain, 1, (size_t[]){4}, TYPE_INT);
+    assert(plain.head_ptr->workspace == NULL);
+    clear_matrix(&plain);
+    clear_workspace(inner);
+
+    assert(create_workspace(NULL) == ERR_NULL_PTR);
+    assert(begin_workspace_scope(NULL) == ERR_NULL_PTR);
+    assert(detach_matrix_from_workspace(NULL) == ERR_NULL_PTR);
+}
+
+void test_numa_placement() {
+    assert(get_numa_node_count() >= 1);
+    assert(get_matrix_memory_policy() == MEMORY_POLICY_DEFAULT && !get_matrix_thread_affinity());
+
+    set_matrix_thread_count(4);
+    set_matrix_thread_affinity(1);
+
+    MatrixMemoryPolicy policies[] = {MEMORY_POLICY_FIRST_TOUCH, MEMORY_POLICY_INTERLEAVED};
+
+    for (size_t p = 0; p < 2; p++) {
+        set_matrix_memory_policy(policies[p], 4096);
+        assert(get_matrix_memory_policy() == policies[p]);
+
+        MultiDimensionalMatrix matrix;
+        assert(create_matrix(&matrix, 2, (size_t[]){300, 500}, TYPE_DOUBLE) == ERR_NONE);
+        double* data = (double*)matrix.head_ptr->data;
+
+        if (policies[p] == MEMORY_POLICY_FIRST_TOUCH) {
+            // Zeroed by the (pinned) threads
+            for (size_t i = 0; i < 300 * 500; i++) {
+                assert(data[i] == 0.0);
+            }
+        }
+
+        double value = 1.5;
+        fill_matrix_with_value(&matrix, &value);
+
+        // Pinned threads compute the same results
+        ArithmeticOperationReturn reduction = reduce_matrix(&matrix, REDUCE_SUM);
+        assert(reduction.error_code == ERR_NONE);
+        assert(*(double*)reduction.result_matrix.head_ptr->data == 1.5 * 300 * 500);
+
+        clear_matrix(&reduction.result_matrix);
+        clear_matrix(&matrix);
+    }
+
+    set_matrix_memory_policy(MEMORY_POLICY_DEFAULT, 0);
+    set_matrix_thread_affinity(0);
+    set_matrix_thread_count(0);
+}
+
+typedef struct QueueTestContext {
+    atomic_int started;
+    atomic_int callbacks;
+} QueueTestContext;
+
+// Waits (at most 5 seconds) until a second operation runs at the same time
+static ArithmeticOperationReturn wait_for_second_operation(void* context) {
+    QueueTestContext* test = (QueueTestContext*)context;
+    ArithmeticOperationReturn response = {{NULL}, ERR_NONE};
+
+    atomic_fetch_add(&test->started, 1);
+
+    for (int i = 0; i < 5000 && atomic_load(&test->started) < 2; i++) {
+        usleep(1000);
+    }
+
+    response.error_code = atomic_load(&test->started) == 2 ? ERR_NONE : ERR_UNKNOWN;
+    return response;
+}
+
+static void count_callback(MatrixOperation* operation, void* user_data) {
+    assert(poll_matrix_operation(operation));
+    atomic_fetch_add(&((QueueTestContext*)user_data)->callbacks, 1);
+}
+
+void test_matrix_queue() {
+    MatrixQueue* queue;
+    QueueTestContext test;
+    atomic_init(&test.started, 0);
+    atomic_init(&test.callbacks, 0);
+
+    assert(create_matrix_queue(&queue, 0) == ERR_INVALID_ARGS);
+    assert(create_matrix_queue(&queue, 2) == ERR_NONE);
+
+    MultiDimensionalMatrix A, B, C;
+    create_matrix(&A, 2, (size_t[]){2, 3}, TYPE_INT);
+    create_matrix(&B, 2, (size_t[]){3, 2}, TYPE_INT);
+    create_matrix(&C, 2, (size_t[]){2, 2}, TYPE_INT);
+    fill_matrix_from_static_array(&A, (int[]){1, 2, 3, 4, 5, 6});
+    fill_matrix_from_static_array(&B, (int[]){7, 8, 9, 10, 11, 12});
+    fill_matrix_from_static_array(&C, (int[]){1, 1, 1, 1});
+
+    // Pipeline: (A * B + C) * C, submitted without waiting in between
+    MatrixOperation *product, *sum, *final;
+    assert(submit_binary_matrix_operation(queue, multiply_2d_matrices, &A, &B, NULL, 0, &product) == ERR_NONE);
+    assert(submit_binary_matrix_operation(queue, add_matrices, get_matrix_operation_result(product), &C, &product, 1, &sum) == ERR_NONE);
+    assert(submit_binary_matrix_operation(queue, multiply_2d_matrices, get_matrix_operation_result(sum), &C, &sum, 1, &final) == ERR_NONE);
+    assert(set_matrix_operation_callback(final, count_callback, &test) == ERR_NONE);
+
+    ArithmeticOperationReturn response = wait_matrix_operation(final);
+    assert(response.error_code == ERR_NONE && poll_matrix_operation(final));
+    assert(memcmp(response.result_matrix.head_ptr->data, (int[]){124, 124, 295, 295}, sizeof(int) * 4) == 0);
+
+    // The callback runs on the worker, after `wait_matrix_operation` might already have returned
+    for (int i = 0; i < 5000 && atomic_load(&test.callbacks) < 1; i++) {
+        usleep(1000);
+    }
+    assert(atomic_load(&test.callbacks) == 1);
+
+    // Already finished: the callback runs right away
+    assert(set_matrix_operation_callback(product, count_callback, &test) == ERR_NONE);
+    assert(atomic_load(&test.callbacks) == 2);
+
+    clear_matrix(&response.result_matrix);
+    response = wait_matrix_operation(sum);
+    clear_matrix(&response.result_matrix);
+    response = wait_matrix_operation(product);
+    clear_matrix(&response.result_matrix);
+    release_matrix_operation(final);
+    release_matrix_operation(sum);
+    release_matrix_operation(product);
+
+    // Errors propagate to the dependents, which are skipped
+    MatrixOperation *failing, *skipped;
+    assert(submit_binary_matrix_operation(queue, multiply_2d_matrices, &A, &A, NULL, 0, &failing) == ERR_NONE);
+    assert(submit_binary_matrix_operation(queue, add_matrices, &C, &C, &failing, 1, &skipped) == ERR_NONE);
+    assert(wait_matrix_operation(skipped).error_code == ERR_INVALID_ARGS);
+    assert(wait_matrix_operation(failing).result_matrix.head_ptr == NULL);
+    assert(wait_matrix_operation(skipped).result_matrix.head_ptr == NULL);
+    release_matrix_operation(skipped);
+
+    // Independent operations overlap on the two workers
+    MatrixOperation *first, *second;
+    assert(submit_matrix_operation(queue, wait_for_second_operation, &test, NULL, 0, &first) == ERR_NONE);
+    assert(submit_matrix_operation(queue, wait_for_second_operation, &test, NULL, 0, &second) == ERR_NONE);
+    assert(wait_matrix_operation(first).error_code == ERR_NONE);
+    assert(wait_matrix_operation(second).error_code == ERR_NONE);
+    release_matrix_operation(first);
+
+    // Invalid submissions
+    MatrixQueue* other_queue;
+    MatrixOperation* unused;
+    assert(create_matrix_queue(&other_queue, 1) == ERR_NONE);
+    assert(submit_binary_matrix_operation(other_queue, add_matrices, &C, &C, &failing, 1, &unused) == ERR_INVALID_ARGS);
+    assert(submit_matrix_operation(queue, NULL, NULL, NULL, 0, &unused) == ERR_NULL_PTR);
+    assert(submit_binary_matrix_operation(queue, add_matrices, &C, &C, NULL, 1, &unused) == ERR_NULL_PTR);
+    assert(wait_matrix_operation(NULL).error_code == ERR_NULL_PTR);
+
+    // Unreleased handles (`failing`, `second`) are freed with their queue
+    clear_matrix_queue(other_queue);
+    clear_matrix_queue(queue);
+    clear_matrix(&A);
+    clear_matrix(&B);
+    clear_matrix(&C);
+}
+
+void test_fill_matrix_random() {
+    // Known answer of Philox4x32-10 (counter 0, key 0): the upper 53 bits of the first two 64-bit words
+    MultiDimensionalMatrix matrix;
+    assert(create_matrix(&matrix, 1, (size_t[]){2}, TYPE_DOUBLE) == ERR_NONE);
+    assert(fill_matrix_random(&matrix, RANDOM_UNIFORM, 0.0, 0x1p53, 0) == ERR_NONE);
+    double* values = (double*)matrix.head_ptr->data;
+    assert(values[0] == (double)((0xe169c58d6627e8d5u) >> 11));
+    assert(values[1] == (double)((0x9b00dbd8bc57ac4cu) >> 11));
+    clear_matrix(&matrix);
+
+    // Same values for every number of threads
+    MultiDimensionalMatrix single, parallel;
+    assert(create_matrix(&single, 2, (size_t[]){300, 700}, TYPE_FLOAT) == ERR_NONE);
+    assert(create_matrix(&parallel, 2, (size_t[]){300, 700}, TYPE_FLOAT) == ERR_NONE);
+
+    set_matrix_thread_count(1);
+    assert(fill_matrix_random(&single, RANDOM_NORMAL, 0.0, 1.0, 7) == ERR_NONE);
+    set_matrix_thread_count(4);
+    assert(fill_matrix_random(&parallel, RANDOM_NORMAL, 0.0, 1.0, 7) == ERR_NONE);
+    set_matrix_thread_count(0);
+
+    assert(memcmp(single.head_ptr->data, parallel.head_ptr->data, 300 * 700 * sizeof(float)) == 0);
+
+    // Another seed gives other values
+    assert(fill_matrix_random(&parallel, RANDOM_NORMAL, 0.0, 1.0, 8) == ERR_NONE);
+    assert(memcmp(single.head_ptr->data, parallel.head_ptr->data, 300 * 700 * sizeof(float)) != 0);
+    clear_matrix(&single);
+    clear_matrix(&parallel);
+
+    // Matrices with the same seed start with the same values (also in a partial block)
+    MultiDimensionalMatrix shorter, longer;
+    assert(create_matrix(&shorter, 1, (size_t[]){1001}, TYPE_INT) == ERR_NONE);
+    assert(create_matrix(&longer, 2, (size_t[]){3, 1000}, TYPE_INT) == ERR_NONE);
+    assert(fill_matrix_random(&shorter, RANDOM_UNIFORM, -1000.0, 1000.0, 3) == ERR_NONE);
+    assert(fill_matrix_random(&longer, RANDOM_UNIFORM, -1000.0, 1000.0, 3) == ERR_NONE);
+    assert(memcmp(shorter.head_ptr->data, longer.head_ptr->data, 1001 * sizeof(int)) == 0);
+    clear_matrix(&shorter);
+    clear_matrix(&longer);
+
+    // Uniform reals: bounds and mean
+    size_t count = 200000;
+    assert(create_matrix(&matrix, 1, (size_t[]){count}, TYPE_FLOAT) == ERR_NONE);
+    assert(fill_matrix_random(&matrix, RANDOM_UNIFORM, 2.0, 5.0, 11) == ERR_NONE);
+    float* floats = (float*)matrix.head_ptr->data;
+    double sum = 0.0;
+
+    for (size_t i = 0; i < count; i++) {
+        assert(floats[i] >= 2.0f && floats[i] <= 5.0f);
+        sum += floats[i];
+    }
+
+    assert(fabs(sum / count - 3.5) < 0.01);
+    clear_matrix(&matrix);
+
+    // Normal reals: mean and standard deviation
+    assert(create_matrix(&matrix, 1, (size_t[]){count}, TYPE_DOUBLE) == ERR_NONE);
+    assert(fill_matrix_random(&matrix, RANDOM_NORMAL, 1.0, 2.0, 12) == ERR_NONE);
+    values = (double*)matrix.head_ptr->data;
+    double squares = 0.0;
+    sum = 0.0;
+
+    for (size_t i = 0; i < count; i++) {
+        sum += values[i];
+        squares += values[i] * values[i];
+    }
+
+    double mean = sum / count;
+    assert(fabs(mean - 1.0) < 0.02);
+    assert(fabs(sqrt(squares / count - mean * mean) - 2.0) < 0.02);
+    clear_matrix(&matrix);
+
+    // Uniform integers: every value of [1, 6] about equally often
+    assert(create_matrix(&matrix, 1, (size_t[]){60000}, TYPE_INT) == ERR_NONE);
+    assert(fill_matrix_random(&matrix, RANDOM_UNIFORM, 0.5, 6.0, 13) == ERR_NONE);
+    int* integers = (int*)matrix.head_ptr->data;
+    size_t frequencies[7] = {0};
 
+    for (size_t i = 0; i < 60000; i++) {
+        assert(integers[i] >= 1 && integers[i] <= 6);
+        frequencies[integers[i]]++;
+    }
+
+    for (size_t i = 1; i <= 6; i++) {
+        assert(frequencies[i] > 9500 && frequencies[i] < 10500);
+    }
+
+    // No integer in the range
+    assert(fill_matrix_random(&matrix, RANDOM_UNIFORM, 0.2, 0.8, 13) == ERR_INVALID_ARGS);
+    clear_matrix(&matrix);
+
+    // Narrow data-types: the range is clamped to the data-type
+    assert(create_matrix(&matrix, 1, (size_t[]){10000}, TYPE_UINT8) == ERR_NONE);
+    assert(fill_matrix_random(&matrix, RANDOM_UNIFORM, -100.0, 1000.0, 14) == ERR_NONE);
+    uint8_t* bytes = (uint8_t*)matrix.head_ptr->data;
+    int minimum = 255, maximum = 0;
+
+    for (size_t i = 0; i < 10000; i++) {
+        minimum = bytes[i] < minimum ? bytes[i] : minimum;
+        maximum = bytes[i] > maximum ? bytes[i] : maximum;
+    }
+
+    assert(minimum == 0 && maximum == 255);
+    clear_matrix(&matrix);
+
+    assert(create_matrix(&matrix, 1, (size_t[]){10000}, TYPE_FP16) == ERR_NONE);
+    assert(fill_matrix_random(&matrix, RANDOM_UNIFORM, -1.0, 1.0, 15) == ERR_NONE);
+    fp16_t* halves = (fp16_t*)matrix.head_ptr->data;
+
+    for (size_t i = 0; i < 10000; i++) {
+        float value = fp16_to_float(halves[i]);
+        assert(value >= -1.0f && value <= 1.0f);
+    }
+
+    clear_matrix(&matrix);
+
+    assert(create_matrix(&matrix, 1, (size_t[]){10000}, TYPE_INT64) == ERR_NONE);
+    assert(fill_matrix_random(&matrix, RANDOM_UNIFORM, -1e12, 1e12, 16) == ERR_NONE);
+    int64_t* longs = (int64_t*)matrix.head_ptr->data;
+    int negative = 0;
+
+    for (size_t i = 0; i < 10000; i++) {
+        assert(longs[i] >= -1000000000000 && longs[i] <= 1000000000000);
+        negative += longs[i] < 0;
+    }
+
+    assert(negative > 4500 && negative < 5500);
+
+    // Invalid arguments
+    assert(fill_matrix_random(NULL, RANDOM_UNIFORM, 0.0, 1.0, 0) == ERR_NULL_PTR);
+    assert(fill_matrix_random(&matrix, RANDOM_UNIFORM, 1.0, 0.0, 0) == ERR_INVALID_ARGS);
+    assert(fill_matrix_random(&matrix, RANDOM_NORMAL, 0.0, -1.0, 0) == ERR_INVALID_ARGS);
+    assert(fill_matrix_random(&matrix, RANDOM_NORMAL, NAN, 1.0, 0) == ERR_INVALID_ARGS);
+    assert(fill_matrix_random(&matrix, (RandomDistribution)7, 0.0, 1.0, 0) == ERR_INVALID_ARGS);
+    clear_matrix(&matrix);
 }
@@ -0,0 +1,218 @@
+#include "sparse_matrices_test.h"
+
+
+void test_sparse_conversion() {
+    int dense_array[3][4] = {
+        {0, 2, 0, 0},
+        {1, 0, 0, 3},
+        {0, 0, 0, 0}
+    };
+    MultiDimensionalMatrix dense;
+    create_matrix(&dense, 2, (size_t[]){3, 4}, TYPE_INT);
+    fill_matrix_from_static_array(&dense, dense_array);
+
+    // Dense -> CSR
+    SparseMatrix csr;
+    assert(dense_to_sparse_matrix(&csr, &dense, SPARSE_CSR) == ERR_NONE);
+    assert(csr.format == SPARSE_CSR);
+    assert(csr.number_of_nonzeros == 3);
+    assert(csr.pointers[0] == 0 && csr.pointers[1] == 1 && csr.pointers[2] == 3 && csr.pointers[3] == 3);
+    assert(csr.col_indices[0] == 1 && csr.col_indices[1] == 0 && csr.col_indices[2] == 3);
+    assert(((int*)csr.values)[2] == 3);
+
+    // Dense -> CSC
+    SparseMatrix csc;
+    assert(dense_to_sparse_matrix(&csc, &dense, SPARSE_CSC) == ERR_NONE);
+    assert(csc.pointers[4] == 3);
+    assert(csc.row_indices[0] == 1 && ((int*)csc.values)[0] == 1);
+
+    // Round trip CSC -> COO -> dense
+    SparseMatrix coo;
+    assert(convert_sparse_matrix(&coo, &csc, SPARSE_COO) == ERR_NONE);
+    ArithmeticOperationReturn result = sparse_to_dense_matrix(&coo);
+    assert(result.error_code == ERR_NONE);
+    assert(memcmp(result.result_matrix.head_ptr->data, dense.head_ptr->data, dense.head_ptr->data_size) == 0);
+    clear_matrix(&result.result_matrix);
+
+    result = sparse_to_dense_matrix(&csr);
+    assert(memcmp(result.result_matrix.head_ptr->data, dense.head_ptr->data, dense.head_ptr->data_size) == 0);
+    clear_matrix(&result.result_matrix);
+
+    // Appended entries are sorted and duplicates are summed up
+    SparseMatrix appended, compressed;
+    assert(create_sparse_matrix(&appended, 3, 3, TYPE_DOUBLE, 0) == ERR_NONE);
+    double values[] = {1.5, 2.0, 0.5, 4.0};
+    assert(append_sparse_entry(&appended, 2, 1, &values[0]) == ERR_NONE);
+    assert(append_sparse_entry(&appended, 0, 2, &values[1]) == ERR_NONE);
+    assert(append_sparse_entry(&appended, 2, 1, &values[2]) == ERR_NONE);
+    assert(append_sparse_entry(&appended, 2, 0, &values[3]) == ERR_NONE);
+    assert(append_sparse_entry(&appended, 3, 0, &values[3]) == ERR_INVALID_INDEX);
+    assert(convert_sparse_matrix(&compressed, &appended, SPARSE_CSR) == ERR_NONE);
+    assert(compressed.number_of_nonzeros == 3);
+    assert(compressed.col_indices[1] == 0 && compressed.col_indices[2] == 1);
+    assert(((double*)compressed.values)[2] == 2.0);
+    assert(append_sparse_entry(&compressed, 0, 0, &values[0]) == ERR_INVALID_ARGS);
+
+    // Errors
+    MultiDimensionalMatrix cube;
+    create_matrix(&cube, 3, (size_t[]){2, 2, 2}, TYPE_INT);
+    assert(dense_to_sparse_matrix(&csr, &cube, SPARSE_CSR) == ERR_INVALID_ARGS);
+    assert(create_sparse_matrix(&appended, 0, 3, TYPE_INT, 0) == ERR_INVALID_ARGS);
+
+    clear_sparse_matrix(&csr);
+    clear_sparse_matrix(&csc);
+    clear_sparse_matrix(&coo);
+    clear_sparse_matrix(&appended);
+    clear_sparse_matrix(&compressed);
+    clear_matrix(&dense);
+    clear_matrix(&cube);
+}
+
+void test_sparse_products() {
+    // Banded (rows x cols) matrix, compared with the dense product
+    size_t rows = 300, cols = 200, n = 5;
+    MultiDimensionalMatrix dense, vector, matrix;
+    create_matrix(&dense, 2, (size_t[]){rows, cols}, TYPE_DOUBLE);
+    create_matrix(&vector, 1, (size_t[]){cols}, TYPE_DOUBLE);
+    create_matrix(&matrix, 2, (size_t[]){cols, n}, TYPE_DOUBLE);
+
+    for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols; j++) {
+            ((double*)dense.head_ptr->data)[i * cols + j] = (i % cols == j || (i + 3) % cols == j) ? (double)(i + j + 1) * 0.5 : 0.0;
+        }
+    }
+    for (size_t j = 0; j < cols; j++) {
+        ((double*)vector.head_ptr->data)[j] = (double)(j % 7) - 3.0;
+    }
+    for (size_t i = 0; i < cols * n; i++) {
+        ((double*)matrix.head_ptr->data)[i] = (double)(i % 5) * 0.25;
+    }
+
+    MultiDimensionalMatrix vector_as_matrix;
+    create_matrix(&vector_as_matrix, 2, (size_t[]){cols, 1}, TYPE_DOUBLE);
+    memcpy(vector_as_matrix.head_ptr->data, vector.head_ptr->data, vector.head_ptr->data_size);
+    ArithmeticOperationReturn expected_vector = multiply_2d_matrices(&dense, &vector_as_matrix);
+    ArithmeticOperationReturn expected_matrix = multiply_2d_matrices(&dense, &matrix);
+
+    SparseFormat formats[] = {SPARSE_COO, SPARSE_CSR, SPARSE_CSC};
+    set_matrix_thread_count(4);
+
+    for (size_t f = 0; f < 3; f++) {
+        SparseMatrix sparse;
+        assert(dense_to_sparse_matrix(&sparse, &dense, formats[f]) == ERR_NONE);
+        assert(sparse.number_of_nonzeros == 2 * rows);
+
+        ArithmeticOperationReturn result = sparse_multiply_dense_vector(&sparse, &vector);
+        assert(result.error_code == ERR_NONE);
+        assert(result.result_matrix.head_ptr->number_of_dimensions == 1);
+        for (size_t i = 0; i < rows; i++) {
+            assert(fabs(((double*)result.result_matrix.head_ptr->data)[i] - ((double*)expected_vector.result_matrix.head_ptr->data)[i]) < 1e-9);
+        }
+        clear_matrix(&result.result_matrix);
+
+        result = sparse_multiply_dense_matrix(&sparse, &matrix);
+        assert(result.error_code == ERR_NONE);
+        assert(result.result_matrix.head_ptr->dimensions[0] == rows);
+        assert(result.result_matrix.head_ptr->dimensions[1] == n);
+        for (size_t i = 0; i < rows * n; i++) {
+            assert(fabs(((double*)result.result_matrix.head_ptr->data)[i] - ((double*)expected_matrix.result_matrix.head_ptr->data)[i]) < 1e-9);
+        }
+        clear_matrix(&result.result_matrix);
+
+        // Errors
+        assert(sparse_multiply_dense_vector(&sparse, &matrix).error_code == ERR_INVALID_ARGS);
+        assert(sparse_multiply_dense_matrix(&sparse, &dense).error_code == ERR_DIMENSION_SIZE_MISMATCH);
+
+        clear_sparse_matrix(&sparse);
+    }
+
+    set_matrix_thread_count(0);
+
+    MultiDimensionalMatrix int_vector;
+    create_matrix(&int_vector, 1, (size_t[]){cols}, TYPE_INT);
+    SparseMatrix sparse;
+    dense_to_sparse_matrix(&sparse, &dense, SPARSE_CSR);
+    assert(sparse_multiply_dense_vector(&sparse, &int_vector).error_code == ERR_DATATYPE_MISMATCH);
+
+    clear_sparse_matrix(&sparse);
+
+    // Half precision: every row is summed in `float`
+    fp16_t half_array[2][3] = {
+        {float_to_fp16(0.5f), 0, float_to_fp16(-2.0f)},
+        {0, float_to_fp16(1.5f), 0}
+    };
+    MultiDimensionalMatrix half_dense, half_vector;
+    create_matrix(&half_dense, 2, (size_t[]){2, 3}, TYPE_FP16);
+    create_matrix(&half_vector, 1, (size_t[]){3}, TYPE_FP16);
+    fill_matrix_from_static_array(&half_dense, half_array);
+    fill_matrix_from_static_array(&half_vector, (fp16_t[]){float_to_fp16(4.0f), float_to_fp16(2.0f), float_to_fp16(1.0f)});
+
+    assert(dense_to_sparse_matrix(&sparse, &half_dense, SPARSE_CSR) == ERR_NONE);
+    assert(sparse.number_of_nonzeros == 3);
+    ArithmeticOperationReturn half_result = sparse_multiply_dense_vector(&sparse, &half_vector);
+    assert(half_result.error_code == ERR_NONE);
+    assert(fp16_to_float(((fp16_t*)half_result.result_matrix.head_ptr->data)[0]) == 0.0f);
+    assert(fp16_to_float(((fp16_t*)half_result.result_matrix.head_ptr->data)[1]) == 3.0f);
+
+    clear_matrix(&half_result.result_matrix);
+    clear_sparse_matrix(&sparse);
+    clear_matrix(&half_dense);
+    clear_matrix(&half_vector);
+    clear_matrix(&int_vector);
+    clear_matrix(&expected_vector.result_matrix);
+    clear_matrix(&expected_matrix.result_matrix);
+    clear_matrix(&vector_as_matrix);
+    clear_matrix(&dense);
+    clear_matrix(&vector);
+    clear_matrix(&matrix);
+}
+
+void test_add_sparse_matrices() {
+    float array_A[3][3] = {
+        {1, 0, 2},
+        {0, 0, 0},
+        {0, 3, 0}
+    };
+    float array_B[3][3] = {
+        {0, 4, -2},
+        {5, 0, 0},
+        {0, 1, 6}
+    };
+    MultiDimensionalMatrix dense_A, dense_B;
+    create_matrix(&dense_A, 2, (size_t[]){3, 3}, TYPE_FLOAT);
+    create_matrix(&dense_B, 2, (size_t[]){3, 3}, TYPE_FLOAT);
+    fill_matrix_from_static_array(&dense_A, array_A);
+    fill_matrix_from_static_array(&dense_B, array_B);
+
+    SparseMatrix A, B, sum;
+    dense_to_sparse_matrix(&A, &dense_A, SPARSE_CSR);
+    dense_to_sparse_matrix(&B, &dense_B, SPARSE_COO);
+
+    set_matrix_thread_count(2);
+    assert(add_sparse_matrices(&sum, &A, &B) == ERR_NONE);
+    set_matrix_thread_count(0);
+    assert(sum.format == SPARSE_CSR);
+    // (0, 2) is stored in both operands, it stays as an explicit 0
+    assert(sum.number_of_nonzeros == 6);
+
+    ArithmeticOperationReturn dense_sum = sparse_to_dense_matrix(&sum);
+    ArithmeticOperationReturn expected = add_matrices(&dense_A, &dense_B);
+    assert(memcmp(dense_sum.result_matrix.head_ptr->data, expected.result_matrix.head_ptr->data, 9 * sizeof(float)) == 0);
+
+    // Errors
+    SparseMatrix wrong;
+    create_sparse_matrix(&wrong, 3, 4, TYPE_FLOAT, 0);
+    assert(add_sparse_matrices(&sum, &A, &wrong) == ERR_DIMENSION_SIZE_MISMATCH);
+    clear_sparse_matrix(&wrong);
+    create_sparse_matrix(&wrong, 3, 3, TYPE_INT, 0);
+    assert(add_sparse_matrices(&sum, &A, &wrong) == ERR_DATATYPE_MISMATCH);
+    clear_sparse_matrix(&wrong);
+
+    clear_matrix(&dense_sum.result_matrix);
+    clear_matrix(&expected.result_matrix);
+    clear_sparse_matrix(&A);
+    clear_sparse_matrix(&B);
+    clear_sparse_matrix(&sum);
+    clear_matrix(&dense_A);
+    clear_matrix(&dense_B);
+}
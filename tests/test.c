@@ -2,7 +2,7 @@
 #include "stdlib.h"
 
 
-int main(int argc, const char** argv) {
+int main(void) {
     for (size_t i = 0; i < 20; i++) {
         printf("-");
     }
@@ -19,15 +19,62 @@ int main(int argc, const char** argv) {
     test_scalar_multiply_matrix();
     printf("Testing `multiply_2d_matrices`...\n");
     test_multiply_2d_matrices();
+    printf("Testing `resize_matrix`...\n");
+    test_resize_matrix();
 
-    //
-    // !!! ToDo !!!
-    //printf("Testing `resize_matrix`...\n");
-    //test_resize_matrix();
-    //
+    printf("Testing `matrix_views`...\n");
+    test_matrix_views();
+    printf("Testing `broadcasting`...\n");
+    test_broadcasting();
+    printf("Testing `matrix_expression`...\n");
+    test_matrix_expression();
+    printf("Testing `reductions`...\n");
+    test_reductions();
+    printf("Testing `multiply_batched_matrices`...\n");
+    test_multiply_batched_matrices();
+    printf("Testing `strassen_multiplication`...\n");
+    test_strassen_multiplication();
+    printf("Testing `sparse_conversion`...\n");
+    test_sparse_conversion();
+    printf("Testing `sparse_products`...\n");
+    test_sparse_products();
+    printf("Testing `add_sparse_matrices`...\n");
+    test_add_sparse_matrices();
 
     printf("Testing `change_data_type`...\n");
     test_change_data_type();
+    printf("Testing `compact_data_types`...\n");
+    test_compact_data_types();
+    printf("Testing `mixed_precision_multiplication`...\n");
+    test_mixed_precision_multiplication();
+    printf("Testing `matrix_files`...\n");
+    test_matrix_files();
+    printf("Testing `out_of_core_multiplication`...\n");
+    test_out_of_core_multiplication();
+    printf("Testing `element_batches`...\n");
+    test_element_batches();
+    printf("Testing `bulk_fill`...\n");
+    test_bulk_fill();
+    printf("Testing `blocked_transpose`...\n");
+    test_blocked_transpose();
+    printf("Testing `matrix_vector_products`...\n");
+    test_matrix_vector_products();
+    printf("Testing `map_zip`...\n");
+    test_map_zip();
+    printf("Testing `math_functions`...\n");
+    test_math_functions();
+    printf("Testing `convolution`...\n");
+    test_convolution();
+    printf("Testing `linear_systems`...\n");
+    test_linear_systems();
+    printf("Testing `workspaces`...\n");
+    test_workspaces();
+    printf("Testing `numa_placement`...\n");
+    test_numa_placement();
+    printf("Testing `matrix_queue`...\n");
+    test_matrix_queue();
+    printf("Testing `fill_matrix_random`...\n");
+    test_fill_matrix_random();
 
     printf("\n");
     for (size_t i = 0; i < 20; i++) {